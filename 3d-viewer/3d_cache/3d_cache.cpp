@@ -24,11 +24,17 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 #include <wx/datetime.h>
@@ -49,6 +55,7 @@
 
 #include "3d_cache.h"
 #include "3d_info.h"
+#include "3d_model_data.h"
 #include "3d_plugin_manager.h"
 #include "sg/scenegraph.h"
 #include "plugins/3dapi/ifsg_api.h"
@@ -66,6 +73,10 @@
 static std::mutex mutex3D_cache;
 static std::mutex mutex3D_cacheManager;
 
+// The scene graph nodes are named from global counters while the cache files are
+// read or written, so the cache files are processed one at a time
+static std::mutex mutex3D_cacheFile;
+
 
 static bool isSHA1Same( const unsigned char* shaA, const unsigned char* shaB ) noexcept
 {
@@ -122,6 +133,30 @@ static const wxString sha1ToWXString( const unsigned char* aSHA1Sum )
 }
 
 
+// The model files are named from the hash of the path of the model, so they can be found
+// without reading the model file
+static const wxString modelDataBaseName( const wxString& aFileName )
+{
+    wxScopedCharBuffer path = aFileName.ToUTF8();
+    boost::uuids::detail::sha1 dblock;
+    dblock.process_bytes( path.data(), path.length() );
+
+    unsigned int  digest[5];
+    unsigned char sha1sum[20];
+    dblock.get_digest( digest );
+
+    for( int i = 0; i < 5; ++i )
+    {
+        sha1sum[( i << 2 ) + 0] = ( digest[i] >> 24 ) & 0xff;
+        sha1sum[( i << 2 ) + 1] = ( digest[i] >> 16 ) & 0xff;
+        sha1sum[( i << 2 ) + 2] = ( digest[i] >> 8 ) & 0xff;
+        sha1sum[( i << 2 ) + 3] = digest[i] & 0xff;
+    }
+
+    return sha1ToWXString( sha1sum );
+}
+
+
 class S3D_CACHE_ENTRY
 {
 private:
@@ -138,11 +173,18 @@ public:
     void SetSHA1( const unsigned char* aSHA1Sum );
     const wxString GetCacheBaseName();
 
+    // free the render data, which may be mapped from a model file
+    void ReleaseRenderData();
+
     wxDateTime    modTime;      // file modification time
     unsigned char sha1sum[20];
     std::string   pluginInfo;   // PluginName:Version string
     SCENEGRAPH*   sceneData;
     S3DMODEL*     renderData;
+    S3D_MODEL_DATA* modelData;  // the model file holding renderData, if it was read from it
+
+    std::mutex    loadMutex;    // held while the model is loaded or translated
+    bool          loaded;       // set once a load of the model has been attempted
 };
 
 
@@ -150,6 +192,8 @@ S3D_CACHE_ENTRY::S3D_CACHE_ENTRY()
 {
     sceneData = NULL;
     renderData = NULL;
+    modelData = NULL;
+    loaded = false;
     memset( sha1sum, 0, 20 );
 }
 
@@ -158,8 +202,23 @@ S3D_CACHE_ENTRY::~S3D_CACHE_ENTRY()
 {
     delete sceneData;
 
-    if( NULL != renderData )
+    ReleaseRenderData();
+}
+
+
+void S3D_CACHE_ENTRY::ReleaseRenderData()
+{
+    if( NULL != modelData )
+    {
+        // the meshes are in the model file, they are not allocated
+        delete modelData;
+        modelData = NULL;
+        renderData = NULL;
+    }
+    else if( NULL != renderData )
+    {
         S3D::Destroy3DModel( &renderData );
+    }
 }
 
 
@@ -228,57 +287,82 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
         return NULL;
     }
 
-    // check cache if file is already loaded
+    S3D_CACHE_ENTRY* ep = getCacheEntry( full3Dpath );
+
+    // A second request for a model being loaded waits here for the first one
+    std::lock_guard<std::mutex> lock( ep->loadMutex );
+
+    if( NULL != aCachePtr )
+        *aCachePtr = ep;
+
+    return loadEntry( full3Dpath, ep );
+}
+
+
+S3D_CACHE_ENTRY* S3D_CACHE::getCacheEntry( const wxString& aFileName )
+{
+    // The global lock only protects the cache map: the models are loaded under the
+    // lock of their own entry, so different models may be loaded at the same time
     std::lock_guard<std::mutex> lock( mutex3D_cache );
 
     std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString >::iterator mi;
-    mi = m_CacheMap.find( full3Dpath );
+    mi = m_CacheMap.find( aFileName );
 
     if( mi != m_CacheMap.end() )
-    {
-        wxFileName fname( full3Dpath );
+        return mi->second;
 
-        if( fname.FileExists() )    // Only check if file exists. If not, it will
-        {                           // use the same model in cache.
-            bool reload = false;
-            wxDateTime fmdate = fname.GetModificationTime();
+    S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
+    m_CacheList.push_back( ep );
+    m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >( aFileName, ep ) );
 
-            if( fmdate != mi->second->modTime )
-            {
-                unsigned char hashSum[20];
-                getSHA1( full3Dpath, hashSum );
-                mi->second->modTime = fmdate;
+    return ep;
+}
 
-                if( !isSHA1Same( hashSum, mi->second->sha1sum ) )
-                {
-                    mi->second->SetSHA1( hashSum );
-                    reload = true;
-                }
-            }
 
-            if( reload )
-            {
-                if( NULL != mi->second->sceneData )
-                {
-                    S3D::DestroyNode( mi->second->sceneData );
-                    mi->second->sceneData = NULL;
-                }
+SCENEGRAPH* S3D_CACHE::loadEntry( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( !aCacheItem->loaded )
+    {
+        // a cache item was not loaded yet; search the Filename->Cachename map
+        aCacheItem->loaded = true;
+        return checkCache( aFileName, aCacheItem );
+    }
 
-                if( NULL != mi->second->renderData )
-                    S3D::Destroy3DModel( &mi->second->renderData );
+    wxFileName fname( aFileName );
 
-                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath, mi->second->pluginInfo );
+    if( fname.FileExists() )    // Only check if file exists. If not, it will
+    {                           // use the same model in cache.
+        bool reload = false;
+        wxDateTime fmdate = fname.GetModificationTime();
+
+        if( fmdate != aCacheItem->modTime )
+        {
+            unsigned char hashSum[20];
+            getSHA1( aFileName, hashSum );
+            aCacheItem->modTime = fmdate;
+
+            if( !isSHA1Same( hashSum, aCacheItem->sha1sum ) )
+            {
+                aCacheItem->SetSHA1( hashSum );
+                reload = true;
             }
         }
 
-        if( NULL != aCachePtr )
-            *aCachePtr = mi->second;
+        if( reload )
+        {
+            if( NULL != aCacheItem->sceneData )
+            {
+                S3D::DestroyNode( aCacheItem->sceneData );
+                aCacheItem->sceneData = NULL;
+            }
 
-        return mi->second->sceneData;
+            aCacheItem->ReleaseRenderData();
+
+            aCacheItem->sceneData = m_Plugins->Load3DModel( aFileName, aCacheItem->pluginInfo );
+        }
     }
 
-    // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return aCacheItem->sceneData;
 }
 
 
@@ -288,75 +372,34 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile )
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
 {
-    if( aCachePtr )
-        *aCachePtr = NULL;
-
     unsigned char sha1sum[20];
+    wxFileName fname( aFileName );
+    aCacheItem->modTime = fname.GetModificationTime();
 
     if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
     {
         // just in case we can't get a hash digest (for example, on access issues)
-        // or we do not have a configured cache file directory, we create an
+        // or we do not have a configured cache file directory, we keep the
         // entry to prevent further attempts at loading the file
-        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-        m_CacheList.push_back( ep );
-        wxFileName fname( aFileName );
-        ep->modTime = fname.GetModificationTime();
-
-        if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
-            ( aFileName, ep ) ).second == false )
-        {
-            wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
-                        __FILE__, __FUNCTION__, __LINE__, aFileName );
-
-            m_CacheList.pop_back();
-            delete ep;
-        }
-        else
-        {
-            if( aCachePtr )
-                *aCachePtr = ep;
-
-        }
-
         return NULL;
     }
 
-    S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-    m_CacheList.push_back( ep );
-    wxFileName fname( aFileName );
-    ep->modTime = fname.GetModificationTime();
-
-    if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
-                               ( aFileName, ep ) ).second == false )
-    {
-        wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
-
-        m_CacheList.pop_back();
-        delete ep;
-        return NULL;
-    }
+    aCacheItem->SetSHA1( sha1sum );
 
-    if( aCachePtr )
-        *aCachePtr = ep;
-
-    ep->SetSHA1( sha1sum );
-
-    wxString bname = ep->GetCacheBaseName();
+    wxString bname = aCacheItem->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
-    if( wxFileName::FileExists( cachename ) && loadCacheData( ep ) )
-        return ep->sceneData;
+    if( wxFileName::FileExists( cachename ) && loadCacheData( aCacheItem ) )
+        return aCacheItem->sceneData;
 
-    ep->sceneData = m_Plugins->Load3DModel( aFileName, ep->pluginInfo );
+    aCacheItem->sceneData = m_Plugins->Load3DModel( aFileName, aCacheItem->pluginInfo );
 
-    if( NULL != ep->sceneData )
-        saveCacheData( ep );
+    if( NULL != aCacheItem->sceneData )
+        saveCacheData( aCacheItem );
 
-    return ep->sceneData;
+    return aCacheItem->sceneData;
 }
 
 
@@ -448,6 +491,8 @@ bool S3D_CACHE::loadCacheData( S3D_CACHE_ENTRY* aCacheItem )
     if( NULL != aCacheItem->sceneData )
         S3D::DestroyNode( (SGNODE*) aCacheItem->sceneData );
 
+    std::lock_guard<std::mutex> lock( mutex3D_cacheFile );
+
     aCacheItem->sceneData = (SCENEGRAPH*)S3D::ReadCache( fname.ToUTF8(), m_Plugins, checkTag );
 
     if( NULL == aCacheItem->sceneData )
@@ -506,11 +551,87 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
         }
     }
 
+    std::lock_guard<std::mutex> lock( mutex3D_cacheFile );
+
     return S3D::WriteCache( fname.ToUTF8(), true, (SGNODE*)aCacheItem->sceneData,
         aCacheItem->pluginInfo.c_str() );
 }
 
 
+bool S3D_CACHE::loadModelData( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxFileName fname( aFileName );
+
+    // Only check if file exists. If not, the model in cache is used
+    if( !fname.FileExists() )
+        return NULL != aCacheItem->modelData;
+
+    wxDateTime  fmdate = fname.GetModificationTime();
+    wxULongLong fsize = fname.GetSize();
+
+    if( NULL != aCacheItem->modelData )
+    {
+        if( fmdate == aCacheItem->modTime )
+            return true;
+
+        aCacheItem->ReleaseRenderData();
+    }
+
+    if( m_CacheDir.empty() )
+        return false;
+
+    wxString cachename = m_CacheDir + modelDataBaseName( aFileName ) + wxT( ".3dm" );
+
+    if( !wxFileName::FileExists( cachename ) )
+        return false;
+
+    std::unique_ptr<S3D_MODEL_DATA> modelData( new S3D_MODEL_DATA );
+
+    if( !modelData->Open( cachename ) )
+        return false;
+
+    // The size and the modification time of the model are checked first: the model is
+    // only hashed if they changed, to find out if the model file was only touched
+    bool touched = fsize != modelData->GetSourceSize()
+                   || fmdate != modelData->GetSourceModTime();
+
+    if( touched )
+    {
+        unsigned char sha1sum[20];
+
+        if( !getSHA1( aFileName, sha1sum ) || !isSHA1Same( sha1sum, modelData->GetSourceSHA1() ) )
+            return false;
+
+        // record the new time, for the next loads to skip the hash
+        S3D_MODEL_DATA::Write( cachename, *modelData->GetModel(), fsize, fmdate, sha1sum );
+    }
+
+    aCacheItem->modTime = fmdate;
+    aCacheItem->SetSHA1( modelData->GetSourceSHA1() );
+    aCacheItem->modelData = modelData.release();
+    aCacheItem->renderData = aCacheItem->modelData->GetModel();
+
+    return true;
+}
+
+
+bool S3D_CACHE::saveModelData( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( NULL == aCacheItem->renderData || m_CacheDir.empty() )
+        return false;
+
+    wxFileName fname( aFileName );
+
+    if( !fname.FileExists() )
+        return false;
+
+    wxString cachename = m_CacheDir + modelDataBaseName( aFileName ) + wxT( ".3dm" );
+
+    return S3D_MODEL_DATA::Write( cachename, *aCacheItem->renderData, fname.GetSize(),
+                                  aCacheItem->modTime, aCacheItem->sha1sum );
+}
+
+
 bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
 {
     if( !m_ConfigDir.empty() )
@@ -664,20 +785,28 @@ void S3D_CACHE::ClosePlugins()
 
 S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
 {
-    S3D_CACHE_ENTRY* cp = NULL;
-    SCENEGRAPH* sp = load( aModelFileName, &cp );
+    wxString full3Dpath = m_FNResolver->ResolvePath( aModelFileName );
 
-    if( !sp )
+    if( full3Dpath.empty() )
+    {
+        // the model cannot be found; we cannot proceed
+        wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [3D model] could not find model '%s'\n",
+                    __FILE__, __FUNCTION__, __LINE__, aModelFileName );
         return NULL;
+    }
 
-    if( !cp )
-    {
-        wxLogTrace( MASK_3D_CACHE,
-                    "%s:%s:%d\n  * [BUG] model loaded with no associated S3D_CACHE_ENTRY",
-                    __FILE__, __FUNCTION__, __LINE__ );
+    S3D_CACHE_ENTRY* cp = getCacheEntry( full3Dpath );
+    std::lock_guard<std::mutex> lock( cp->loadMutex );
+
+    // The render data is first searched in the model files, so the scene graph of the
+    // model is neither loaded nor translated
+    if( !cp->loaded && loadModelData( full3Dpath, cp ) )
+        return cp->renderData;
 
+    SCENEGRAPH* sp = loadEntry( full3Dpath, cp );
+
+    if( !sp )
         return NULL;
-    }
 
     if( cp->renderData )
         return cp->renderData;
@@ -685,14 +814,46 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
 
+    if( NULL != mp )
+        saveModelData( full3Dpath, cp );
+
     return mp;
 }
 
+
+void S3D_CACHE::PreloadModels( const std::vector<wxString>& aModelFiles )
+{
+    std::set<wxString> uniqueFiles( aModelFiles.begin(), aModelFiles.end() );
+    std::vector<wxString> files( uniqueFiles.begin(), uniqueFiles.end() );
+
+    if( files.empty() )
+        return;
+
+    // The locale is switched once here, not by each thread
+    LOCALE_IO toggle;
+
+    std::atomic<size_t> nextFile( 0 );
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   files.size() );
+    std::vector<std::future<void>> returns( std::max<size_t>( parallelThreadCount, 1 ) );
+
+    auto load_lambda = [&]()
+    {
+        for( size_t i = nextFile++; i < files.size(); i = nextFile++ )
+            GetModel( files[i] );
+    };
+
+    for( std::future<void>& ret : returns )
+        ret = std::async( std::launch::async, load_lambda );
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
+}
+
 void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
 {
     wxDir         dir;
-    wxString      fileSpec = wxT( "*.3dc" );
-    wxArrayString fileList; // Holds list of ".3dc" files found in cache directory
+    wxArrayString fileList; // Holds list of ".3dc" and ".3dm" files found in cache directory
     size_t        numFilesFound = 0;
 
     wxFileName thisFile;
@@ -708,8 +869,10 @@ void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
     {
         thisFile.SetPath( m_CacheDir ); // Set the base path to the cache folder
 
-        // Get a list of all the ".3dc" files in the cache directory
-        numFilesFound = dir.GetAllFiles( m_CacheDir, &fileList, fileSpec );
+        // Get a list of all the ".3dc" and ".3dm" files in the cache directory
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dc" ) );
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dm" ) );
+        numFilesFound = fileList.GetCount();
 
         for( unsigned int i = 0; i < numFilesFound; i++ )
         {
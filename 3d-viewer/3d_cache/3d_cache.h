@@ -34,6 +34,7 @@
 #include "kicad_string.h"
 #include <list>
 #include <map>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -68,18 +69,19 @@ private:
     wxString            m_CacheDir;
     wxString            m_ConfigDir;       /// base configuration path for 3D items
 
-    /** Find or create cache entry for file name
+    /** Fill a new cache entry for file name
      *
-     * Searches the cache list for the given filename and retrieves
-     * the cache data; a cache entry is created if one does not
-     * already exist.
+     * Loads the scene data of a new cache entry from the cache file
+     * matching the hash of the model file or, if there is no such file,
+     * from the plugins; the cache file is then created.
+     * The caller must hold the load lock of the entry.
      *
-     * @param[in]   aFileName   file name (full or partial path)
-     * @param[out]  aCachePtr   optional return address for cache entry pointer
+     * @param[in]   aFileName   file name (full path)
+     * @param[in]   aCacheItem  the cache entry to fill
      * @return      SCENEGRAPH object associated with file name
      * @retval      NULL    on error
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
 
     /**
      * Function getSHA1
@@ -98,6 +100,27 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
+    /**
+     * Function loadModelData
+     * maps the render data of a model from its model file (.3dm), if the file is still
+     * valid for the model; see S3D_MODEL_DATA.
+     *
+     * @param[in]   aFileName   model file name (full path)
+     * @param[in]   aCacheItem  the cache entry of the model, locked by the caller
+     * @retval      true        the render data of the cache entry is available
+     */
+    bool loadModelData( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
+
+    // save the render data of a cache entry to a model file
+    bool saveModelData( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
+
+    // find or create the cache entry of a model (full path)
+    S3D_CACHE_ENTRY* getCacheEntry( const wxString& aFileName );
+
+    // load the scene data of a cache entry, or reload it if the model file changed;
+    // the caller must hold the load lock of the entry
+    SCENEGRAPH* loadEntry( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
+
     // the real load function (can supply a cache entry pointer to member functions)
     SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL );
 
@@ -184,10 +207,20 @@ public:
      */
     S3DMODEL* GetModel( const wxString& aModelFileName );
 
+    /**
+     * Function PreloadModels
+     * loads a list of models in the cache, using several threads; the models used
+     * by many footprints are loaded only once.  The models are then retrieved
+     * without delay by GetModel().
+     *
+     * @param aModelFiles is the list of the partial or full paths of the models
+     */
+    void PreloadModels( const std::vector<wxString>& aModelFiles );
+
     /**
      * Function Delete up old cache files in cache directory
      *
-     * Deletes ".3dc" files in the cache directory that are older than
+     * Deletes ".3dc" and ".3dm" files in the cache directory that are older than
      * "aNumDaysOld".
      *
      * @param aNumDaysOld is age threshold to delete ".3dc" cache files
@@ -0,0 +1,309 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstring>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/log.h>
+
+#include "3d_model_data.h"
+
+
+#define MASK_3D_CACHE "3D_CACHE"
+
+static const char     MODEL_DATA_MAGIC[8] = { 'K', 'I', 'C', 'A', 'D', '3', 'D', 'M' };
+static const uint32_t MODEL_DATA_VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// The blocks of the file are aligned on this size, for the arrays to be used as they are mapped
+static const uint64_t BLOCK_ALIGNMENT = 16;
+
+
+static uint64_t alignBlock( uint64_t aOffset )
+{
+    return ( aOffset + BLOCK_ALIGNMENT - 1 ) & ~( BLOCK_ALIGNMENT - 1 );
+}
+
+
+/**
+ * Tells if the faces of a mesh can be drawn: the renderers read the face indexes by triangles,
+ * and index the vertex arrays with them without checking them.
+ */
+static bool areFacesValid( const unsigned int* aFaceIdx, unsigned int aFaceIdxSize,
+                           unsigned int aVertexSize )
+{
+    if( aFaceIdx == NULL )
+        return true;
+
+    if( aFaceIdxSize % 3 != 0 )
+        return false;
+
+    for( unsigned int i = 0; i < aFaceIdxSize; ++i )
+    {
+        if( aFaceIdx[i] >= aVertexSize )
+            return false;
+    }
+
+    return true;
+}
+
+
+S3D_MODEL_DATA::S3D_MODEL_DATA()
+{
+    static_assert( sizeof( HEADER ) == 64, "the model file header must be packed" );
+    static_assert( sizeof( unsigned int ) == sizeof( uint32_t ), "face indexes are 32 bits" );
+
+    m_model.m_MeshesSize = 0;
+    m_model.m_Meshes = NULL;
+    m_model.m_MaterialsSize = 0;
+    m_model.m_Materials = NULL;
+}
+
+
+template <typename T>
+T* S3D_MODEL_DATA::getArray( uint64_t aOffset, size_t aCount, bool& aValid ) const
+{
+    if( aOffset == 0 )
+        return NULL;
+
+    if( aOffset > m_file.Size() || ( aOffset % alignof( T ) ) != 0
+            || aCount > ( m_file.Size() - aOffset ) / sizeof( T ) )
+    {
+        aValid = false;
+        return NULL;
+    }
+
+    // The mapping is read only: the renderers never modify the render data
+    return reinterpret_cast<T*>( const_cast<char*>( m_file.Data() ) + aOffset );
+}
+
+
+bool S3D_MODEL_DATA::Open( const wxString& aFileName )
+{
+    m_meshes.clear();
+    m_model.m_MeshesSize = 0;
+    m_model.m_Meshes = NULL;
+    m_model.m_MaterialsSize = 0;
+    m_model.m_Materials = NULL;
+
+    if( !m_file.Open( aFileName ) || m_file.Size() < sizeof( HEADER ) )
+        return false;
+
+    const HEADER* hdr = header();
+
+    if( memcmp( hdr->m_Magic, MODEL_DATA_MAGIC, sizeof( MODEL_DATA_MAGIC ) ) != 0
+            || hdr->m_Version != MODEL_DATA_VERSION || hdr->m_ByteOrder != BYTE_ORDER_MARK )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] not a model file or wrong version '%s'",
+                    aFileName );
+        return false;
+    }
+
+    bool     valid = true;
+    uint64_t offset = alignBlock( sizeof( HEADER ) );
+
+    SMATERIAL* materials = getArray<SMATERIAL>( offset, hdr->m_MaterialsSize, valid );
+    offset = alignBlock( offset + sizeof( SMATERIAL ) * hdr->m_MaterialsSize );
+
+    const MESH_RECORD* records = getArray<const MESH_RECORD>( offset, hdr->m_MeshesSize, valid );
+
+    if( !valid )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] truncated model file '%s'", aFileName );
+        return false;
+    }
+
+    m_meshes.resize( hdr->m_MeshesSize );
+
+    for( uint32_t i = 0; i < hdr->m_MeshesSize && valid; ++i )
+    {
+        const MESH_RECORD& rec = records[i];
+        SMESH&             mesh = m_meshes[i];
+
+        mesh.m_VertexSize = rec.m_VertexSize;
+        mesh.m_Positions = getArray<SFVEC3F>( rec.m_Positions, rec.m_VertexSize, valid );
+        mesh.m_Normals = getArray<SFVEC3F>( rec.m_Normals, rec.m_VertexSize, valid );
+        mesh.m_Texcoords = getArray<SFVEC2F>( rec.m_Texcoords, rec.m_VertexSize, valid );
+        mesh.m_Color = getArray<SFVEC3F>( rec.m_Colors, rec.m_VertexSize, valid );
+        mesh.m_FaceIdxSize = rec.m_FaceIdxSize;
+        mesh.m_FaceIdx = getArray<unsigned int>( rec.m_FaceIdx, rec.m_FaceIdxSize, valid );
+        mesh.m_MaterialIdx = rec.m_MaterialIdx;
+
+        if( rec.m_MaterialIdx >= hdr->m_MaterialsSize
+                || !areFacesValid( mesh.m_FaceIdx, rec.m_FaceIdxSize, rec.m_VertexSize ) )
+        {
+            valid = false;
+        }
+    }
+
+    if( !valid )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] invalid model file '%s'", aFileName );
+        m_meshes.clear();
+        return false;
+    }
+
+    m_model.m_MeshesSize = hdr->m_MeshesSize;
+    m_model.m_Meshes = m_meshes.empty() ? NULL : m_meshes.data();
+    m_model.m_MaterialsSize = hdr->m_MaterialsSize;
+    m_model.m_Materials = hdr->m_MaterialsSize ? materials : NULL;
+
+    return true;
+}
+
+
+wxULongLong S3D_MODEL_DATA::GetSourceSize() const
+{
+    return m_file.Size() >= sizeof( HEADER ) ? wxULongLong( header()->m_SourceSize ) : 0;
+}
+
+
+wxDateTime S3D_MODEL_DATA::GetSourceModTime() const
+{
+    if( m_file.Size() < sizeof( HEADER ) )
+        return wxDateTime();
+
+    return wxDateTime( wxLongLong( header()->m_SourceModTime ) );
+}
+
+
+const unsigned char* S3D_MODEL_DATA::GetSourceSHA1() const
+{
+    static const unsigned char noSHA1[20] = {};
+
+    return m_file.Size() >= sizeof( HEADER ) ? header()->m_SourceSHA1 : noSHA1;
+}
+
+
+bool S3D_MODEL_DATA::Write( const wxString& aFileName, const S3DMODEL& aModel,
+                            const wxULongLong& aSourceSize, const wxDateTime& aSourceModTime,
+                            const unsigned char* aSourceSHA1 )
+{
+    HEADER hdr;
+    memset( &hdr, 0, sizeof( hdr ) );
+    memcpy( hdr.m_Magic, MODEL_DATA_MAGIC, sizeof( MODEL_DATA_MAGIC ) );
+    hdr.m_Version = MODEL_DATA_VERSION;
+    hdr.m_ByteOrder = BYTE_ORDER_MARK;
+    hdr.m_SourceSize = aSourceSize.GetValue();
+    hdr.m_SourceModTime = aSourceModTime.GetValue().GetValue();
+    memcpy( hdr.m_SourceSHA1, aSourceSHA1, sizeof( hdr.m_SourceSHA1 ) );
+    hdr.m_MaterialsSize = aModel.m_Materials ? aModel.m_MaterialsSize : 0;
+    hdr.m_MeshesSize = aModel.m_Meshes ? aModel.m_MeshesSize : 0;
+
+    // Place all the blocks first, the records of the meshes hold their offsets
+    uint64_t materialsOffset = alignBlock( sizeof( HEADER ) );
+    uint64_t recordsOffset = alignBlock( materialsOffset
+                                         + sizeof( SMATERIAL ) * hdr.m_MaterialsSize );
+    uint64_t offset = recordsOffset + sizeof( MESH_RECORD ) * hdr.m_MeshesSize;
+
+    auto place = [&offset]( const void* aArray, size_t aSize ) -> uint64_t
+    {
+        if( aArray == NULL )
+            return 0;
+
+        offset = alignBlock( offset );
+        uint64_t blockOffset = offset;
+        offset += aSize;
+
+        return blockOffset;
+    };
+
+    std::vector<MESH_RECORD> records( hdr.m_MeshesSize );
+
+    for( uint32_t i = 0; i < hdr.m_MeshesSize; ++i )
+    {
+        const SMESH& mesh = aModel.m_Meshes[i];
+        MESH_RECORD& rec = records[i];
+
+        // Do not write a model file that Open() would reject
+        if( !areFacesValid( mesh.m_FaceIdx, mesh.m_FaceIdxSize, mesh.m_VertexSize ) )
+        {
+            wxLogTrace( MASK_3D_CACHE, " * [3D model] invalid faces, not writing '%s'",
+                        aFileName );
+            return false;
+        }
+
+        rec.m_VertexSize = mesh.m_VertexSize;
+        rec.m_FaceIdxSize = mesh.m_FaceIdxSize;
+        rec.m_MaterialIdx = mesh.m_MaterialIdx;
+        rec.m_Reserved = 0;
+        rec.m_Positions = place( mesh.m_Positions, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+        rec.m_Normals = place( mesh.m_Normals, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+        rec.m_Texcoords = place( mesh.m_Texcoords, sizeof( SFVEC2F ) * mesh.m_VertexSize );
+        rec.m_Colors = place( mesh.m_Color, sizeof( SFVEC3F ) * mesh.m_VertexSize );
+        rec.m_FaceIdx = place( mesh.m_FaceIdx, sizeof( unsigned int ) * mesh.m_FaceIdxSize );
+    }
+
+    wxString tmpName = aFileName + wxT( ".tmp" );
+    wxFFile  file( tmpName, wxT( "wb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    uint64_t written = 0;
+
+    // Write the blocks in the order they were placed, with the alignment padding
+    auto write = [&file, &written]( uint64_t aOffset, const void* aData, size_t aSize ) -> bool
+    {
+        static const char padding[BLOCK_ALIGNMENT] = {};
+
+        if( aData == NULL )
+            return true;
+
+        if( aOffset > written && file.Write( padding, aOffset - written ) != aOffset - written )
+            return false;
+
+        written = aOffset + aSize;
+
+        return aSize == 0 || file.Write( aData, aSize ) == aSize;
+    };
+
+    bool ok = write( 0, &hdr, sizeof( hdr ) )
+              && write( materialsOffset, aModel.m_Materials,
+                        sizeof( SMATERIAL ) * hdr.m_MaterialsSize )
+              && write( recordsOffset, records.data(),
+                        sizeof( MESH_RECORD ) * hdr.m_MeshesSize );
+
+    for( uint32_t i = 0; i < hdr.m_MeshesSize && ok; ++i )
+    {
+        const SMESH&       mesh = aModel.m_Meshes[i];
+        const MESH_RECORD& rec = records[i];
+
+        ok = write( rec.m_Positions, mesh.m_Positions, sizeof( SFVEC3F ) * mesh.m_VertexSize )
+             && write( rec.m_Normals, mesh.m_Normals, sizeof( SFVEC3F ) * mesh.m_VertexSize )
+             && write( rec.m_Texcoords, mesh.m_Texcoords, sizeof( SFVEC2F ) * mesh.m_VertexSize )
+             && write( rec.m_Colors, mesh.m_Color, sizeof( SFVEC3F ) * mesh.m_VertexSize )
+             && write( rec.m_FaceIdx, mesh.m_FaceIdx,
+                       sizeof( unsigned int ) * mesh.m_FaceIdxSize );
+    }
+
+    if( !file.Close() || !ok || !wxRenameFile( tmpName, aFileName, true ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] could not write model file '%s'", aFileName );
+        wxRemoveFile( tmpName );
+        return false;
+    }
+
+    return true;
+}
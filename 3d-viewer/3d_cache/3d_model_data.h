@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file 3d_model_data.h
+ * defines the model files of the 3D cache, which store the render data of a model
+ */
+
+#ifndef MODEL_DATA_3D_H
+#define MODEL_DATA_3D_H
+
+#include <cstdint>
+#include <vector>
+
+#include <wx/datetime.h>
+#include <wx/longlong.h>
+#include <wx/string.h>
+
+#include <mapped_file.h>
+#include "plugins/3dapi/c3dmodel.h"
+
+
+/**
+ * S3D_MODEL_DATA
+ *
+ * The render data (S3DMODEL) of a 3D model, read from a model file (.3dm).
+ *
+ * Unlike the .3dc files, which store the scene graph of a model, the model files store
+ * the meshes in the form used by the renderers: the vertex, normal, color and index
+ * arrays are contiguous blocks aligned on 16 bytes.  The file is mapped in memory and
+ * the meshes point directly to its content, so nothing is parsed or copied.
+ *
+ * A model file also stores the size, the modification time and the SHA1 hash of the
+ * model file it was made from, to check if it is still valid.
+ */
+class S3D_MODEL_DATA
+{
+public:
+    S3D_MODEL_DATA();
+
+    S3D_MODEL_DATA( const S3D_MODEL_DATA& ) = delete;
+    S3D_MODEL_DATA& operator=( const S3D_MODEL_DATA& ) = delete;
+
+    /**
+     * Function Open
+     * maps a model file and checks its content.
+     *
+     * The face indexes are checked to be triangles of the vertices of their mesh, so a
+     * corrupted model file is rejected instead of being drawn.
+     *
+     * @param aFileName is the full path of the model file
+     * @return true if the file is a valid model file
+     */
+    bool Open( const wxString& aFileName );
+
+    /**
+     * Function GetModel
+     * @return the render data of the model; the arrays of the meshes are only valid
+     * while this object exists, and must not be modified or freed.
+     */
+    S3DMODEL* GetModel() { return &m_model; }
+
+    wxULongLong GetSourceSize() const;
+    wxDateTime GetSourceModTime() const;
+    const unsigned char* GetSourceSHA1() const;
+
+    /**
+     * Function Write
+     * writes the render data of a model to a model file.  The file is written under
+     * a temporary name and then renamed, so a model file is never read partially written.
+     *
+     * @param aFileName is the full path of the model file
+     * @param aModel is the render data to write
+     * @param aSourceSize is the size of the model file the render data was made from
+     * @param aSourceModTime is the modification time of this file
+     * @param aSourceSHA1 is the SHA1 hash of this file (20 bytes)
+     * @return true on success, false if the file could not be written or if a mesh has
+     *         invalid faces
+     */
+    static bool Write( const wxString& aFileName, const S3DMODEL& aModel,
+                       const wxULongLong& aSourceSize, const wxDateTime& aSourceModTime,
+                       const unsigned char* aSourceSHA1 );
+
+private:
+    /// The header at the beginning of a model file
+    struct HEADER
+    {
+        char     m_Magic[8];
+        uint32_t m_Version;
+        uint32_t m_ByteOrder;       ///< BYTE_ORDER_MARK, as written by the host
+        uint64_t m_SourceSize;
+        int64_t  m_SourceModTime;   ///< milliseconds since the Epoch
+        uint8_t  m_SourceSHA1[20];
+        uint32_t m_MaterialsSize;
+        uint32_t m_MeshesSize;
+        uint32_t m_Reserved;
+    };
+
+    /// The description of a mesh, following the materials.  An offset of 0 is a NULL array
+    struct MESH_RECORD
+    {
+        uint32_t m_VertexSize;
+        uint32_t m_FaceIdxSize;
+        uint32_t m_MaterialIdx;
+        uint32_t m_Reserved;
+        uint64_t m_Positions;
+        uint64_t m_Normals;
+        uint64_t m_Texcoords;
+        uint64_t m_Colors;
+        uint64_t m_FaceIdx;
+    };
+
+    const HEADER* header() const { return reinterpret_cast<const HEADER*>( m_file.Data() ); }
+
+    template <typename T>
+    T* getArray( uint64_t aOffset, size_t aCount, bool& aValid ) const;
+
+    MAPPED_FILE        m_file;
+    S3DMODEL           m_model;
+    std::vector<SMESH> m_meshes;
+};
+
+#endif  // MODEL_DATA_3D_H
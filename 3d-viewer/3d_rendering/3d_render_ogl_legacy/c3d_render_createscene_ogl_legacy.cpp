@@ -907,6 +907,28 @@ void C3D_RENDER_OGL_LEGACY::load_3D_models( REPORTER* aStatusReporter )
        (!m_boardAdapter.GetFlag( FL_MODULE_ATTRIBUTES_VIRTUAL )) )
         return;
 
+    // Load the models not yet in our cache map in the 3D cache first: the cache
+    // loads them in parallel
+    std::vector<wxString> modelFiles;
+
+    for( MODULE* module : m_boardAdapter.GetBoard()->Modules() )
+    {
+        for( const MODULE_3D_SETTINGS& model : module->Models() )
+        {
+            if( model.m_Show && !model.m_Filename.empty()
+                    && m_3dmodel_map.find( model.m_Filename ) == m_3dmodel_map.end() )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    if( !modelFiles.empty() )
+    {
+        if( aStatusReporter )
+            aStatusReporter->Report( _( "Loading 3D models" ) );
+
+        m_boardAdapter.Get3DCacheManager()->PreloadModels( modelFiles );
+    }
+
     // Go for all modules
     for( MODULE* module : m_boardAdapter.GetBoard()->Modules() )
     {
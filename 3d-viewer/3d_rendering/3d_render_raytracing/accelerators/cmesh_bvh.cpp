@@ -0,0 +1,415 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  cmesh_bvh.cpp
+ * @brief Bounding volume hierarchy over the triangles of a 3D model mesh.
+ */
+
+#include "cmesh_bvh.h"
+#include <algorithm>
+#include <wx/debug.h>
+
+
+/// Max count of triangles in a leaf
+#define MAX_TRIANGLES_IN_LEAF 4
+
+/// Depth from which the nodes are always split at the median, to bound the depth of the tree
+#define MAX_MIDDLE_SPLIT_DEPTH 48
+
+/// Size of the traversal stack, larger than the max depth of the tree
+#define MAX_STACK_SIZE 128
+
+
+CMESH_BVH::CMESH_BVH( const SMESH &aMesh )
+{
+    m_bbox.Reset();
+
+    if( ( aMesh.m_Positions == NULL ) || ( aMesh.m_FaceIdx == NULL ) )
+        return;
+
+    m_triangles.reserve( aMesh.m_FaceIdxSize / 3 );
+
+    for( unsigned int faceIdx = 0; faceIdx + 2 < aMesh.m_FaceIdxSize; faceIdx += 3 )
+    {
+        const unsigned int idx0 = aMesh.m_FaceIdx[faceIdx + 0];
+        const unsigned int idx1 = aMesh.m_FaceIdx[faceIdx + 1];
+        const unsigned int idx2 = aMesh.m_FaceIdx[faceIdx + 2];
+
+        wxASSERT( idx0 < aMesh.m_VertexSize );
+        wxASSERT( idx1 < aMesh.m_VertexSize );
+        wxASSERT( idx2 < aMesh.m_VertexSize );
+
+        if( ( idx0 >= aMesh.m_VertexSize ) ||
+            ( idx1 >= aMesh.m_VertexSize ) ||
+            ( idx2 >= aMesh.m_VertexSize ) )
+            continue;
+
+        const SFVEC3F &v0 = aMesh.m_Positions[idx0];
+        const SFVEC3F &v1 = aMesh.m_Positions[idx1];
+        const SFVEC3F &v2 = aMesh.m_Positions[idx2];
+
+        TRIANGLE triangle;
+
+        triangle.m_v0 = v0;
+        triangle.m_e1 = v1 - v0;
+        triangle.m_e2 = v2 - v0;
+        triangle.m_idx[0] = idx0;
+        triangle.m_idx[1] = idx1;
+        triangle.m_idx[2] = idx2;
+
+        m_triangles.push_back( triangle );
+
+        m_bbox.Union( v0 );
+        m_bbox.Union( v1 );
+        m_bbox.Union( v2 );
+    }
+
+    if( m_triangles.empty() )
+        return;
+
+    if( aMesh.m_Normals )
+        m_normals.assign( aMesh.m_Normals, aMesh.m_Normals + aMesh.m_VertexSize );
+
+    std::vector<SFVEC3F> centroids( m_triangles.size() );
+    std::vector<unsigned int> order( m_triangles.size() );
+
+    for( unsigned int i = 0; i < m_triangles.size(); ++i )
+    {
+        const TRIANGLE &triangle = m_triangles[i];
+
+        centroids[i] = triangle.m_v0 + ( triangle.m_e1 + triangle.m_e2 ) * ( 1.0f / 3.0f );
+        order[i] = i;
+    }
+
+    m_nodes.reserve( 2 * m_triangles.size() / MAX_TRIANGLES_IN_LEAF + 1 );
+
+    build( order, centroids, 0, m_triangles.size(), 0 );
+
+    // Store the triangles in the order of the leaves
+    std::vector<TRIANGLE> orderedTriangles;
+    orderedTriangles.reserve( m_triangles.size() );
+
+    for( unsigned int i : order )
+        orderedTriangles.push_back( m_triangles[i] );
+
+    m_triangles.swap( orderedTriangles );
+    m_nodes.shrink_to_fit();
+
+    m_bbox.ScaleNextUp();
+}
+
+
+unsigned int CMESH_BVH::build( std::vector<unsigned int> &aOrder,
+                               const std::vector<SFVEC3F> &aCentroids,
+                               unsigned int aStart, unsigned int aEnd, unsigned int aDepth )
+{
+    const unsigned int nodeIdx = m_nodes.size();
+    m_nodes.emplace_back();
+
+    CBBOX bounds;
+    CBBOX centroidBounds;
+
+    bounds.Reset();
+    centroidBounds.Reset();
+
+    for( unsigned int i = aStart; i < aEnd; ++i )
+    {
+        const TRIANGLE &triangle = m_triangles[aOrder[i]];
+
+        bounds.Union( triangle.m_v0 );
+        bounds.Union( triangle.m_v0 + triangle.m_e1 );
+        bounds.Union( triangle.m_v0 + triangle.m_e2 );
+        centroidBounds.Union( aCentroids[aOrder[i]] );
+    }
+
+    const unsigned int count = aEnd - aStart;
+
+    if( count <= MAX_TRIANGLES_IN_LEAF )
+    {
+        NODE &leaf = m_nodes[nodeIdx];
+
+        leaf.m_min = bounds.Min();
+        leaf.m_max = bounds.Max();
+        leaf.m_offset = aStart;
+        leaf.m_count = count;
+        leaf.m_axis = 0;
+
+        return nodeIdx;
+    }
+
+    const SFVEC3F extent = centroidBounds.GetExtent();
+    unsigned int axis = 0;
+
+    if( extent.y > extent[axis] )
+        axis = 1;
+
+    if( extent.z > extent[axis] )
+        axis = 2;
+
+    // Split at the middle of the centroids, as the scene BVH does, or at the median
+    // if all the centroids fall on the same side (or the tree is getting too deep)
+    unsigned int middle = aStart;
+
+    if( aDepth < MAX_MIDDLE_SPLIT_DEPTH )
+    {
+        const float splitPos = centroidBounds.GetCenter( axis );
+
+        auto it = std::partition( aOrder.begin() + aStart, aOrder.begin() + aEnd,
+                                  [&]( unsigned int aIdx )
+                                  {
+                                      return aCentroids[aIdx][axis] < splitPos;
+                                  } );
+
+        middle = it - aOrder.begin();
+    }
+
+    if( ( middle == aStart ) || ( middle == aEnd ) )
+    {
+        middle = ( aStart + aEnd ) / 2;
+
+        std::nth_element( aOrder.begin() + aStart, aOrder.begin() + middle,
+                          aOrder.begin() + aEnd,
+                          [&]( unsigned int aIdxA, unsigned int aIdxB )
+                          {
+                              return aCentroids[aIdxA][axis] < aCentroids[aIdxB][axis];
+                          } );
+    }
+
+    build( aOrder, aCentroids, aStart, middle, aDepth + 1 );
+    const unsigned int secondChild = build( aOrder, aCentroids, middle, aEnd, aDepth + 1 );
+
+    // m_nodes may have been reallocated by the recursive calls
+    NODE &interior = m_nodes[nodeIdx];
+
+    interior.m_min = bounds.Min();
+    interior.m_max = bounds.Max();
+    interior.m_offset = secondChild;
+    interior.m_count = 0;
+    interior.m_axis = axis;
+
+    return nodeIdx;
+}
+
+
+static inline bool intersectNode( const SFVEC3F &aMin, const SFVEC3F &aMax,
+                                  const SFVEC3F &aOrigin, const SFVEC3F &aInvDir,
+                                  float aMaxDistance )
+{
+    const SFVEC3F t0 = ( aMin - aOrigin ) * aInvDir;
+    const SFVEC3F t1 = ( aMax - aOrigin ) * aInvDir;
+
+    const SFVEC3F tNear = glm::min( t0, t1 );
+    const SFVEC3F tFar = glm::max( t0, t1 );
+
+    const float tEnter = fmaxf( fmaxf( tNear.x, tNear.y ), fmaxf( tNear.z, 0.0f ) );
+    const float tExit = fminf( fminf( tFar.x, tFar.y ), fminf( tFar.z, aMaxDistance ) );
+
+    return tEnter <= tExit;
+}
+
+
+bool CMESH_BVH::intersectTriangle( const TRIANGLE &aTriangle, const SFVEC3F &aOrigin,
+                                   const SFVEC3F &aDir, float aCullSign, float aMaxDistance,
+                                   float &aOutT, float &aOutU, float &aOutV ) const
+{
+    const SFVEC3F pvec = glm::cross( aDir, aTriangle.m_e2 );
+    const float det = glm::dot( aTriangle.m_e1, pvec );
+
+    // det is the opposite of the dot product of the direction with the face normal:
+    // like CTRIANGLE, ignore the faces seen from their back side
+    if( !( det * aCullSign > 0.0f ) )
+        return false;
+
+    const float invDet = 1.0f / det;
+    const SFVEC3F tvec = aOrigin - aTriangle.m_v0;
+    const float u = glm::dot( tvec, pvec ) * invDet;
+
+    if( ( u < 0.0f ) || ( u > 1.0f ) )
+        return false;
+
+    const SFVEC3F qvec = glm::cross( tvec, aTriangle.m_e1 );
+    const float v = glm::dot( aDir, qvec ) * invDet;
+
+    if( ( v < 0.0f ) || ( ( u + v ) > 1.0f ) )
+        return false;
+
+    const float t = glm::dot( aTriangle.m_e2, qvec ) * invDet;
+
+    if( !( ( t > 0.0f ) && ( t < aMaxDistance ) ) )
+        return false;
+
+    aOutT = t;
+    aOutU = u;
+    aOutV = v;
+
+    return true;
+}
+
+
+bool CMESH_BVH::Intersect( const SFVEC3F &aOrigin, const SFVEC3F &aDir, const SFVEC3F &aInvDir,
+                           float aCullSign, MESH_HIT &aHit ) const
+{
+    if( m_nodes.empty() )
+        return false;
+
+    const bool dirIsNeg[3] = { aInvDir.x < 0.0f, aInvDir.y < 0.0f, aInvDir.z < 0.0f };
+
+    unsigned int todo[MAX_STACK_SIZE];
+    unsigned int todoOffset = 0;
+    unsigned int nodeIdx = 0;
+    bool hit = false;
+
+    while( true )
+    {
+        const NODE &node = m_nodes[nodeIdx];
+
+        if( intersectNode( node.m_min, node.m_max, aOrigin, aInvDir, aHit.m_t ) )
+        {
+            if( node.m_count > 0 )
+            {
+                for( unsigned int i = 0; i < node.m_count; ++i )
+                {
+                    float t, u, v;
+
+                    if( intersectTriangle( m_triangles[node.m_offset + i], aOrigin, aDir,
+                                           aCullSign, aHit.m_t, t, u, v ) )
+                    {
+                        aHit.m_t = t;
+                        aHit.m_triIdx = node.m_offset + i;
+                        aHit.m_u = u;
+                        aHit.m_v = v;
+                        hit = true;
+                    }
+                }
+
+                if( todoOffset == 0 )
+                    break;
+
+                nodeIdx = todo[--todoOffset];
+            }
+            else
+            {
+                // Visit first the child nearest to the ray origin
+                if( dirIsNeg[node.m_axis] )
+                {
+                    todo[todoOffset++] = nodeIdx + 1;
+                    nodeIdx = node.m_offset;
+                }
+                else
+                {
+                    todo[todoOffset++] = node.m_offset;
+                    nodeIdx = nodeIdx + 1;
+                }
+            }
+        }
+        else
+        {
+            if( todoOffset == 0 )
+                break;
+
+            nodeIdx = todo[--todoOffset];
+        }
+    }
+
+    return hit;
+}
+
+
+bool CMESH_BVH::IntersectP( const SFVEC3F &aOrigin, const SFVEC3F &aDir, const SFVEC3F &aInvDir,
+                            float aCullSign, float aMaxDistance ) const
+{
+    if( m_nodes.empty() )
+        return false;
+
+    unsigned int todo[MAX_STACK_SIZE];
+    unsigned int todoOffset = 0;
+    unsigned int nodeIdx = 0;
+
+    while( true )
+    {
+        const NODE &node = m_nodes[nodeIdx];
+
+        if( intersectNode( node.m_min, node.m_max, aOrigin, aInvDir, aMaxDistance ) )
+        {
+            if( node.m_count > 0 )
+            {
+                for( unsigned int i = 0; i < node.m_count; ++i )
+                {
+                    float t, u, v;
+
+                    if( intersectTriangle( m_triangles[node.m_offset + i], aOrigin, aDir,
+                                           aCullSign, aMaxDistance, t, u, v ) )
+                        return true;
+                }
+
+                if( todoOffset == 0 )
+                    break;
+
+                nodeIdx = todo[--todoOffset];
+            }
+            else
+            {
+                todo[todoOffset++] = node.m_offset;
+                nodeIdx = nodeIdx + 1;
+            }
+        }
+        else
+        {
+            if( todoOffset == 0 )
+                break;
+
+            nodeIdx = todo[--todoOffset];
+        }
+    }
+
+    return false;
+}
+
+
+SFVEC3F CMESH_BVH::GetNormal( const MESH_HIT &aHit ) const
+{
+    const TRIANGLE &triangle = m_triangles[aHit.m_triIdx];
+
+    // Flat shading if the mesh has no normals
+    if( m_normals.empty() )
+        return glm::cross( triangle.m_e1, triangle.m_e2 );
+
+    // interpolate vertex normals with UVW using Gouraud's shading
+    return ( 1.0f - aHit.m_u - aHit.m_v ) * m_normals[triangle.m_idx[0]] +
+           aHit.m_u * m_normals[triangle.m_idx[1]] +
+           aHit.m_v * m_normals[triangle.m_idx[2]];
+}
+
+
+SFVEC3F CMESH_BVH::GetColor( unsigned int aTriIdx, float aU, float aV ) const
+{
+    wxASSERT( HasVertexColors() );
+    wxASSERT( aTriIdx < m_triangles.size() );
+
+    const TRIANGLE &triangle = m_triangles[aTriIdx];
+
+    return ( 1.0f - aU - aV ) * m_colors[triangle.m_idx[0]] +
+           aU * m_colors[triangle.m_idx[1]] +
+           aV * m_colors[triangle.m_idx[2]];
+}
@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  cmesh_bvh.h
+ * @brief Bounding volume hierarchy over the triangles of a 3D model mesh.
+ *
+ * The triangles are packed in arrays, in the coordinates of the model, and the BVH is
+ * built once per mesh.  It is shared by all the CINSTANCE objects which place the mesh
+ * in the scene, so a model used by many footprints is stored only once.
+ */
+
+#ifndef _CMESH_BVH_H_
+#define _CMESH_BVH_H_
+
+#include "../shapes3D/cbbox.h"
+#include <plugins/3dapi/c3dmodel.h>
+#include <vector>
+
+
+/// The result of a ray intersection with the triangles of a CMESH_BVH
+struct MESH_HIT
+{
+    float        m_t;       ///< distance, in units of the length of the ray direction
+    unsigned int m_triIdx;  ///< the triangle that was hit
+    float        m_u;       ///< barycentric coordinate of the 2nd vertex of the triangle
+    float        m_v;       ///< barycentric coordinate of the 3rd vertex of the triangle
+};
+
+
+class  CMESH_BVH
+{
+public:
+    /**
+     * Constructor CMESH_BVH
+     * packs the faces of \a aMesh (the faces using an invalid vertex index are skipped)
+     * and builds the hierarchy.
+     */
+    explicit CMESH_BVH( const SMESH &aMesh );
+
+    /**
+     * Function SetVertexColors
+     * @param aColors is the color of each vertex of the mesh, in the color space used
+     * to render.  If not set, the mesh has the color of the object using it.
+     */
+    void SetVertexColors( std::vector<SFVEC3F> &&aColors ) { m_colors = std::move( aColors ); }
+
+    bool HasVertexColors() const { return !m_colors.empty(); }
+
+    unsigned int GetTriangleCount() const { return m_triangles.size(); }
+
+    const CBBOX &GetBBox() const { return m_bbox; }
+
+    /**
+     * Function Intersect
+     * finds the nearest triangle hit by a ray given in the coordinates of the model.
+     * The direction of the ray does not need to be normalized.
+     * @param aCullSign - 1.0f, or -1.0f if the mesh is mirrored by its transform (the
+     *                    triangles seen from their back side are ignored)
+     * @param aHit - m_t must be initialized to the max distance of the test; it is set
+     *               to the nearest hit, if any
+     * @return true if a triangle nearer than aHit.m_t was found
+     */
+    bool Intersect( const SFVEC3F &aOrigin, const SFVEC3F &aDir, const SFVEC3F &aInvDir,
+                    float aCullSign, MESH_HIT &aHit ) const;
+
+    /**
+     * Function IntersectP
+     * @return true if the ray hits any triangle nearer than aMaxDistance (shadow test)
+     */
+    bool IntersectP( const SFVEC3F &aOrigin, const SFVEC3F &aDir, const SFVEC3F &aInvDir,
+                     float aCullSign, float aMaxDistance ) const;
+
+    /**
+     * Function GetNormal
+     * @return the normal (not normalized) interpolated at the barycentric coordinates
+     * of a hit, in the coordinates of the model
+     */
+    SFVEC3F GetNormal( const MESH_HIT &aHit ) const;
+
+    /**
+     * Function GetColor
+     * @return the color interpolated at the barycentric coordinates of a hit.  The mesh
+     * must have vertex colors.
+     */
+    SFVEC3F GetColor( unsigned int aTriIdx, float aU, float aV ) const;
+
+private:
+    /// A triangle, stored as needed by the Möller-Trumbore intersection test
+    struct TRIANGLE
+    {
+        SFVEC3F      m_v0;      // 12
+        SFVEC3F      m_e1;      // 12 first edge (v1 - v0)
+        SFVEC3F      m_e2;      // 12 second edge (v2 - v0)
+        unsigned int m_idx[3];  // 12 vertex indexes, for the normals and colors
+                                // 48 bytes
+    };
+
+    /// A node of the hierarchy.  The first child of an interior node follows it in the list.
+    struct NODE
+    {
+        SFVEC3F        m_min;       // 12
+        unsigned int   m_offset;    //  4 first triangle (leaf) or second child (interior node)
+        SFVEC3F        m_max;       // 12
+        unsigned short m_count;     //  2 count of triangles, 0 for interior nodes
+        unsigned short m_axis;      //  2 split axis of interior nodes
+                                    // 32 bytes
+    };
+
+    unsigned int build( std::vector<unsigned int> &aOrder,
+                        const std::vector<SFVEC3F> &aCentroids,
+                        unsigned int aStart, unsigned int aEnd, unsigned int aDepth );
+
+    bool intersectTriangle( const TRIANGLE &aTriangle, const SFVEC3F &aOrigin,
+                            const SFVEC3F &aDir, float aCullSign, float aMaxDistance,
+                            float &aOutT, float &aOutU, float &aOutV ) const;
+
+    std::vector<TRIANGLE> m_triangles;
+    std::vector<NODE>     m_nodes;
+    std::vector<SFVEC3F>  m_normals;
+    std::vector<SFVEC3F>  m_colors;
+    CBBOX                 m_bbox;
+};
+
+#endif // _CMESH_BVH_H_
@@ -34,6 +34,7 @@
 #include "shapes3D/clayeritem.h"
 #include "shapes3D/ccylinder.h"
 #include "shapes3D/ctriangle.h"
+#include "shapes3D/cinstance.h"
 #include "shapes2D/citemlayercsg2d.h"
 #include "shapes2D/cring2d.h"
 #include "shapes2D/cpolygon2d.h"
@@ -464,6 +465,9 @@ void C3D_RENDER_RAYTRACING::Reload( REPORTER* aStatusReporter,
     m_object_container.Clear();
     m_containerWithObjectsToDelete.Clear();
 
+    // The model instances were deleted with the objects of the container
+    m_model_meshes.clear();
+
     setupMaterials();
 
     // Create and add the outline board
@@ -1267,6 +1271,25 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models( CCONTAINER &aDstContainer, bool aSkipMaterialInformation )
 {
+    // Load the displayed models in the 3D cache first: the cache loads them in parallel
+    std::vector<wxString> modelFiles;
+
+    for( auto module : m_boardAdapter.GetBoard()->Modules() )
+    {
+        if( !m_boardAdapter.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+            continue;
+
+        for( const MODULE_3D_SETTINGS& model : module->Models() )
+        {
+            if( ( static_cast<float>( model.m_Opacity ) > FLT_EPSILON ) &&
+                ( model.m_Show && !model.m_Filename.empty() ) )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    if( !modelFiles.empty() )
+        m_boardAdapter.Get3DCacheManager()->PreloadModels( modelFiles );
+
     // Go for all modules
     for( auto module : m_boardAdapter.GetBoard()->Modules() )
     {
@@ -1483,6 +1506,67 @@ MODEL_MATERIALS *C3D_RENDER_RAYTRACING::get_3D_model_material( const S3DMODEL *a
     return materialVector;
 }
 
+const std::vector< std::unique_ptr<CMESH_BVH> > &C3D_RENDER_RAYTRACING::get_3D_model_meshes(
+        const S3DMODEL *a3DModel, bool aSkipMaterialInformation )
+{
+    auto it = m_model_meshes.find( a3DModel );
+
+    if( it != m_model_meshes.end() )
+        return it->second;
+
+    std::vector< std::unique_ptr<CMESH_BVH> > &meshes = m_model_meshes[a3DModel];
+
+    meshes.resize( a3DModel->m_MeshesSize );
+
+    for( unsigned int mesh_i = 0;
+         mesh_i < a3DModel->m_MeshesSize;
+         ++mesh_i )
+    {
+        const SMESH &mesh = a3DModel->m_Meshes[mesh_i];
+
+        // Validate the mesh pointers
+        wxASSERT( mesh.m_Positions != NULL );
+        wxASSERT( mesh.m_FaceIdx != NULL );
+        wxASSERT( mesh.m_Normals != NULL );
+        wxASSERT( mesh.m_FaceIdxSize > 0 );
+        wxASSERT( (mesh.m_FaceIdxSize % 3) == 0 );
+
+        if( (mesh.m_Positions != NULL) &&
+            (mesh.m_Normals != NULL) &&
+            (mesh.m_FaceIdx != NULL) &&
+            (mesh.m_FaceIdxSize > 0) &&
+            (mesh.m_VertexSize > 0) &&
+            ((mesh.m_FaceIdxSize % 3) == 0) &&
+            (mesh.m_MaterialIdx < a3DModel->m_MaterialsSize) )
+        {
+            std::unique_ptr<CMESH_BVH> meshBVH( new CMESH_BVH( mesh ) );
+
+            if( meshBVH->GetTriangleCount() == 0 )
+                continue;
+
+            if( !aSkipMaterialInformation && ( mesh.m_Color != NULL ) )
+            {
+                std::vector<SFVEC3F> colors( mesh.m_VertexSize );
+
+                for( unsigned int idx = 0; idx < mesh.m_VertexSize; ++idx )
+                {
+                    if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
+                        colors[idx] = ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx] ) );
+                    else
+                        colors[idx] = ConvertSRGBToLinear( mesh.m_Color[idx] );
+                }
+
+                meshBVH->SetVertexColors( std::move( colors ) );
+            }
+
+            meshes[mesh_i] = std::move( meshBVH );
+        }
+    }
+
+    return meshes;
+}
+
+
 void C3D_RENDER_RAYTRACING::add_3D_models( CCONTAINER &aDstContainer,
                                            const S3DMODEL *a3DModel,
                                            const glm::mat4 &aModelMatrix,
@@ -1520,109 +1604,44 @@ void C3D_RENDER_RAYTRACING::add_3D_models( CCONTAINER &aDstContainer,
             materialVector = get_3D_model_material( a3DModel );
         }
 
-        const glm::mat3 normalMatrix = glm::transpose( glm::inverse( glm::mat3( aModelMatrix ) ) );
+        // The triangles of the meshes are stored once per model, in the model coordinates:
+        // each footprint adds an instance of them with its own transform and material
+        const std::vector< std::unique_ptr<CMESH_BVH> > &meshes =
+                get_3D_model_meshes( a3DModel, aSkipMaterialInformation );
 
         for( unsigned int mesh_i = 0;
              mesh_i < a3DModel->m_MeshesSize;
              ++mesh_i )
         {
             const SMESH &mesh = a3DModel->m_Meshes[mesh_i];
+            const CMESH_BVH *meshBVH = meshes[mesh_i].get();
 
-            // Validate the mesh pointers
-            wxASSERT( mesh.m_Positions != NULL );
-            wxASSERT( mesh.m_FaceIdx != NULL );
-            wxASSERT( mesh.m_Normals != NULL );
-            wxASSERT( mesh.m_FaceIdxSize > 0 );
-            wxASSERT( (mesh.m_FaceIdxSize % 3) == 0 );
-
-
-            if( (mesh.m_Positions != NULL) &&
-                (mesh.m_Normals != NULL) &&
-                (mesh.m_FaceIdx != NULL) &&
-                (mesh.m_FaceIdxSize > 0) &&
-                (mesh.m_VertexSize > 0) &&
-                ((mesh.m_FaceIdxSize % 3) == 0) &&
-                (mesh.m_MaterialIdx < a3DModel->m_MaterialsSize) )
-            {
-                float moduleTransparency;
-                const CBLINN_PHONG_MATERIAL *blinn_material;
-
-                if( !aSkipMaterialInformation )
-                {
-                    blinn_material = &(*materialVector)[mesh.m_MaterialIdx];
-
-                    moduleTransparency = 1.0f - ( ( 1.0f - blinn_material->GetTransparency() ) * aModuleOpacity );
-                }
-
-                // Add all face triangles
-                for( unsigned int faceIdx = 0;
-                     faceIdx < mesh.m_FaceIdxSize;
-                     faceIdx += 3 )
-                {
-                    const unsigned int idx0 = mesh.m_FaceIdx[faceIdx + 0];
-                    const unsigned int idx1 = mesh.m_FaceIdx[faceIdx + 1];
-                    const unsigned int idx2 = mesh.m_FaceIdx[faceIdx + 2];
-
-                    wxASSERT( idx0 < mesh.m_VertexSize );
-                    wxASSERT( idx1 < mesh.m_VertexSize );
-                    wxASSERT( idx2 < mesh.m_VertexSize );
+            if( meshBVH == NULL )
+                continue;
 
-                    if( ( idx0 < mesh.m_VertexSize ) &&
-                        ( idx1 < mesh.m_VertexSize ) &&
-                        ( idx2 < mesh.m_VertexSize ) )
-                    {
-                        const SFVEC3F &v0 = mesh.m_Positions[idx0];
-                        const SFVEC3F &v1 = mesh.m_Positions[idx1];
-                        const SFVEC3F &v2 = mesh.m_Positions[idx2];
-
-                        const SFVEC3F &n0 = mesh.m_Normals[idx0];
-                        const SFVEC3F &n1 = mesh.m_Normals[idx1];
-                        const SFVEC3F &n2 = mesh.m_Normals[idx2];
-
-                        // Transform vertex with the model matrix
-                        const SFVEC3F vt0 = SFVEC3F( aModelMatrix * glm::vec4( v0, 1.0f) );
-                        const SFVEC3F vt1 = SFVEC3F( aModelMatrix * glm::vec4( v1, 1.0f) );
-                        const SFVEC3F vt2 = SFVEC3F( aModelMatrix * glm::vec4( v2, 1.0f) );
-
-                        const SFVEC3F nt0 = glm::normalize( SFVEC3F( normalMatrix * n0 ) );
-                        const SFVEC3F nt1 = glm::normalize( SFVEC3F( normalMatrix * n1 ) );
-                        const SFVEC3F nt2 = glm::normalize( SFVEC3F( normalMatrix * n2 ) );
+            CINSTANCE *newInstance = new CINSTANCE( meshBVH, aModelMatrix );
 
-                        CTRIANGLE *newTriangle = new  CTRIANGLE( vt0, vt2, vt1,
-                                                                 nt0, nt2, nt1 );
+            newInstance->SetBoardItem( aBoardItem );
 
-                        newTriangle->SetBoardItem( aBoardItem );
+            aDstContainer.Add( newInstance );
 
-                        aDstContainer.Add( newTriangle );
+            if( !aSkipMaterialInformation )
+            {
+                const CBLINN_PHONG_MATERIAL *blinn_material = &(*materialVector)[mesh.m_MaterialIdx];
 
-                        if( !aSkipMaterialInformation )
-                        {
-                            newTriangle->SetMaterial( blinn_material );
-                            newTriangle->SetModelTransparency( moduleTransparency );
+                newInstance->SetMaterial( blinn_material );
+                newInstance->SetModelTransparency(
+                        1.0f - ( ( 1.0f - blinn_material->GetTransparency() ) * aModuleOpacity ) );
 
-                            if( mesh.m_Color == NULL )
-                            {
-                                const SFVEC3F diffuseColor =
-                                    a3DModel->m_Materials[mesh.m_MaterialIdx].m_Diffuse;
+                if( !meshBVH->HasVertexColors() )
+                {
+                    const SFVEC3F diffuseColor =
+                        a3DModel->m_Materials[mesh.m_MaterialIdx].m_Diffuse;
 
-                                if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
-                                    newTriangle->SetColor( ConvertSRGBToLinear( MaterialDiffuseToColorCAD( diffuseColor ) ) );
-                                else
-                                    newTriangle->SetColor( ConvertSRGBToLinear( diffuseColor ) );
-                            }
-                            else
-                            {
-                                if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
-                                    newTriangle->SetColor( ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx0] ) ),
-                                                           ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx1] ) ),
-                                                           ConvertSRGBToLinear( MaterialDiffuseToColorCAD( mesh.m_Color[idx2] ) ) );
-                                else
-                                    newTriangle->SetColor( ConvertSRGBToLinear( mesh.m_Color[idx0] ),
-                                                           ConvertSRGBToLinear( mesh.m_Color[idx1] ),
-                                                           ConvertSRGBToLinear( mesh.m_Color[idx2] ) );
-                            }
-                        }
-                    }
+                    if( m_boardAdapter.MaterialModeGet() == MATERIAL_MODE::CAD_MODE )
+                        newInstance->SetColor( ConvertSRGBToLinear( MaterialDiffuseToColorCAD( diffuseColor ) ) );
+                    else
+                        newInstance->SetColor( ConvertSRGBToLinear( diffuseColor ) );
                 }
             }
         }
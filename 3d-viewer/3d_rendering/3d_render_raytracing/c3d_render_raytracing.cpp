@@ -1222,6 +1222,8 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
                                 (hitPacket[ iLT ].m_HitInfo.pHitObject == hitPacket[ iRT ].m_HitInfo.pHitObject) )
                             {
                                 hitInfoLRT.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
+                                hitInfoLRT.m_UV = hitPacket[ iLT ].m_HitInfo.m_UV;
+                                hitInfoLRT.m_PrimitiveIdx = hitPacket[ iLT ].m_HitInfo.m_PrimitiveIdx;
                                 hitInfoLRT.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
                                                       hitPacket[ iRT ].m_HitInfo.m_tHit ) * 0.5f;
                                 hitInfoLRT.m_HitNormal =
@@ -1299,6 +1301,8 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
                                   hitPacket[ iLB ].m_HitInfo.pHitObject ) )
                             {
                                 hitInfoLTB.pHitObject = hitPacket[ iLT ].m_HitInfo.pHitObject;
+                                hitInfoLTB.m_UV = hitPacket[ iLT ].m_HitInfo.m_UV;
+                                hitInfoLTB.m_PrimitiveIdx = hitPacket[ iLT ].m_HitInfo.m_PrimitiveIdx;
                                 hitInfoLTB.m_tHit = ( hitPacket[ iLT ].m_HitInfo.m_tHit +
                                                       hitPacket[ iLB ].m_HitInfo.m_tHit ) * 0.5f;
                                 hitInfoLTB.m_HitNormal =
@@ -1372,6 +1376,8 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
                               hitPacket[ iRB ].m_HitInfo.pHitObject ) )
                         {
                             hitInfoRTB.pHitObject = hitPacket[ iRT ].m_HitInfo.pHitObject;
+                            hitInfoRTB.m_UV = hitPacket[ iRT ].m_HitInfo.m_UV;
+                            hitInfoRTB.m_PrimitiveIdx = hitPacket[ iRT ].m_HitInfo.m_PrimitiveIdx;
 
                             hitInfoRTB.m_tHit = ( hitPacket[ iRT ].m_HitInfo.m_tHit +
                                                   hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
@@ -1446,6 +1452,8 @@ void C3D_RENDER_RAYTRACING::render_preview( GLubyte *ptrPBO )
                               hitPacket[ iRB ].m_HitInfo.pHitObject ) )
                         {
                             hitInfoLRB.pHitObject = hitPacket[ iLB ].m_HitInfo.pHitObject;
+                            hitInfoLRB.m_UV = hitPacket[ iLB ].m_HitInfo.m_UV;
+                            hitInfoLRB.m_PrimitiveIdx = hitPacket[ iLB ].m_HitInfo.m_PrimitiveIdx;
 
                             hitInfoLRB.m_tHit = ( hitPacket[ iLB ].m_HitInfo.m_tHit +
                                                   hitPacket[ iRB ].m_HitInfo.m_tHit ) * 0.5f;
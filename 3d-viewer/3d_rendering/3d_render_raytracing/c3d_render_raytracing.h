@@ -33,6 +33,7 @@
 #include "../../common_ogl/openGL_includes.h"
 #include "accelerators/ccontainer.h"
 #include "accelerators/caccelerator.h"
+#include "accelerators/cmesh_bvh.h"
 #include "../c3d_render_base.h"
 #include "clight.h"
 #include "../cpostshader_ssao.h"
@@ -40,6 +41,7 @@
 #include <plugins/3dapi/c3dmodel.h>
 
 #include <map>
+#include <memory>
 
 /// Vector of materials
 typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
@@ -47,6 +49,9 @@ typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 /// Maps a S3DMODEL pointer with a created CBLINN_PHONG_MATERIAL vector
 typedef std::map< const S3DMODEL * , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 
+/// Maps a S3DMODEL pointer with the CMESH_BVH of each of its meshes (NULL for invalid meshes)
+typedef std::map< const S3DMODEL *, std::vector< std::unique_ptr<CMESH_BVH> > > MAP_MODEL_MESHES;
+
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
@@ -213,10 +218,15 @@ private:
                         BOARD_ITEM *aBoardItem );
 
     MODEL_MATERIALS *get_3D_model_material( const S3DMODEL *a3DModel );
+    const std::vector< std::unique_ptr<CMESH_BVH> > &get_3D_model_meshes(
+            const S3DMODEL *a3DModel, bool aSkipMaterialInformation );
 
     /// Stores materials of the 3D models
     MAP_MODEL_MATERIALS m_model_materials;
 
+    /// Stores the meshes of the 3D models, shared by all the footprints using a model
+    MAP_MODEL_MESHES m_model_meshes;
+
     void initialize_block_positions();
 
     void render( GLubyte* ptrPBO, REPORTER* aStatusReporter );
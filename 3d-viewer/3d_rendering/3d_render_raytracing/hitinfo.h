@@ -48,6 +48,7 @@ struct HITINFO
 
     SFVEC3F m_HitPoint;                 ///< (12) hit position
     float m_ShadowFactor;               ///< ( 4) Shadow attenuation (1.0 no shadow, 0.0f darkness)
+    unsigned int m_PrimitiveIdx;        ///< ( 4) Primitive hit, in objects made of several ones
 
 #ifdef RAYTRACING_RAY_STATISTICS
     // Statistics
@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  cinstance.cpp
+ * @brief An instance of a 3D model mesh: places a shared CMESH_BVH in the scene.
+ */
+
+#include "cinstance.h"
+
+
+CINSTANCE::CINSTANCE( const CMESH_BVH *aMesh, const glm::mat4 &aTransform )
+        : COBJECT( OBJECT3D_TYPE::INSTANCE )
+{
+    wxASSERT( aMesh != NULL );
+
+    m_mesh = aMesh;
+    m_invTransform = glm::inverse( aTransform );
+    m_normalMatrix = glm::transpose( glm::inverse( glm::mat3( aTransform ) ) );
+
+    // A mirroring transform reverses the winding of the faces
+    m_cullSign = ( glm::determinant( glm::mat3( aTransform ) ) < 0.0f ) ? -1.0f : 1.0f;
+
+    m_diffuseColor = SFVEC3F( 1.0f );
+
+    m_bbox = m_mesh->GetBBox();
+    m_bbox.ApplyTransformationAA( aTransform );
+    m_bbox.ScaleNextUp();
+    m_centroid = m_bbox.GetCenter();
+}
+
+
+bool CINSTANCE::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
+{
+    // The direction is not normalized after the transform, so the distances along
+    // the ray are the same in the mesh and the scene coordinates
+    const SFVEC3F origin = SFVEC3F( m_invTransform * glm::vec4( aRay.m_Origin, 1.0f ) );
+    const SFVEC3F dir = SFVEC3F( m_invTransform * glm::vec4( aRay.m_Dir, 0.0f ) );
+
+    MESH_HIT hit;
+    hit.m_t = aHitInfo.m_tHit;
+
+    if( !m_mesh->Intersect( origin, dir, 1.0f / dir, m_cullSign, hit ) )
+        return false;
+
+    aHitInfo.m_tHit = hit.m_t;
+    aHitInfo.m_HitPoint = aRay.at( hit.m_t );
+    aHitInfo.m_UV = SFVEC2F( hit.m_u, hit.m_v );
+    aHitInfo.m_PrimitiveIdx = hit.m_triIdx;
+
+    aHitInfo.m_HitNormal = glm::normalize( m_normalMatrix * m_mesh->GetNormal( hit ) );
+
+    m_material->PerturbeNormal( aHitInfo.m_HitNormal, aRay, aHitInfo );
+
+    aHitInfo.pHitObject = this;
+
+    return true;
+}
+
+
+bool CINSTANCE::IntersectP( const RAY &aRay, float aMaxDistance ) const
+{
+    const SFVEC3F origin = SFVEC3F( m_invTransform * glm::vec4( aRay.m_Origin, 1.0f ) );
+    const SFVEC3F dir = SFVEC3F( m_invTransform * glm::vec4( aRay.m_Dir, 0.0f ) );
+
+    return m_mesh->IntersectP( origin, dir, 1.0f / dir, m_cullSign, aMaxDistance );
+}
+
+
+bool CINSTANCE::Intersects( const CBBOX &aBBox ) const
+{
+    return m_bbox.Intersects( aBBox );
+}
+
+
+SFVEC3F CINSTANCE::GetDiffuseColor( const HITINFO &aHitInfo ) const
+{
+    if( !m_mesh->HasVertexColors() || ( aHitInfo.m_PrimitiveIdx >= m_mesh->GetTriangleCount() ) )
+        return m_diffuseColor;
+
+    return m_mesh->GetColor( aHitInfo.m_PrimitiveIdx, aHitInfo.m_UV.x, aHitInfo.m_UV.y );
+}
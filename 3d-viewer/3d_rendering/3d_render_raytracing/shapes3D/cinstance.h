@@ -0,0 +1,70 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 1992-2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  cinstance.h
+ * @brief An instance of a 3D model mesh: places a shared CMESH_BVH in the scene.
+ */
+
+#ifndef _CINSTANCE_H_
+#define _CINSTANCE_H_
+
+#include "cobject.h"
+#include "../accelerators/cmesh_bvh.h"
+
+/**
+ * A mesh placed in the scene by a transform, with its own material and color.
+ * The rays are transformed to the coordinates of the mesh to be tested against
+ * its triangles.
+ */
+class  CINSTANCE : public COBJECT
+{
+
+public:
+    /**
+     * @param aMesh - the mesh, it must outlive the instance
+     * @param aTransform - the transform from the mesh to the scene coordinates
+     */
+    CINSTANCE( const CMESH_BVH *aMesh, const glm::mat4 &aTransform );
+
+    /**
+     * Function SetColor
+     * sets the color of the instance, used if the mesh has no vertex colors
+     */
+    void SetColor( const SFVEC3F &aColor ) { m_diffuseColor = aColor; }
+
+    // Imported from COBJECT
+    bool Intersect( const RAY &aRay, HITINFO &aHitInfo ) const override;
+    bool IntersectP(const RAY &aRay , float aMaxDistance ) const override;
+    bool Intersects( const CBBOX &aBBox ) const override;
+    SFVEC3F GetDiffuseColor( const HITINFO &aHitInfo ) const override;
+
+private:
+    const CMESH_BVH *m_mesh;
+    glm::mat4 m_invTransform;   ///< from the scene to the mesh coordinates
+    glm::mat3 m_normalMatrix;   ///< transform of the normals to the scene coordinates
+    float m_cullSign;           ///< -1.0f if the transform mirrors the mesh
+    SFVEC3F m_diffuseColor;
+};
+
+#endif // _CINSTANCE_H_
@@ -142,6 +142,12 @@ static const wxChar DebugZoneFiller[] = wxT( "DebugZoneFiller" );
 
 static const wxChar SkipBoundingBoxFpLoad[] = wxT( "SkipBoundingBoxFpLoad" );
 
+/**
+ * Number of tiles per axis the zone filler splits its boolean, offset and fracture operations
+ * into so they can run in parallel.  0 or 1 disables tiling.
+ */
+static const wxChar ZoneFillTiles[] = wxT( "ZoneFillTiles" );
+
 } // namespace KEYS
 
 
@@ -241,6 +247,8 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_SkipBoundingBoxOnFpLoad   = false;
 
+    m_ZoneFillTiles             = 0;        // monolithic polygon operations
+
     loadFromConfigFile();
 }
 
@@ -321,6 +329,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::SkipBoundingBoxFpLoad, 
                                                 &m_SkipBoundingBoxOnFpLoad, false ) );
 
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ZoneFillTiles,
+                                               &m_ZoneFillTiles, 0, 0, 64 ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     for( PARAM_CFG* param : configParams )
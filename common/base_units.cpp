@@ -40,6 +40,8 @@
 #include <macros.h>
 #include <title_block.h>
 
+#include <cmath>
+
 #if defined( PCBNEW ) || defined( CVPCB ) || defined( EESCHEMA ) || defined( GERBVIEW ) || defined( PL_EDITOR )
 #define IU_TO_MM( x )       ( x / IU_PER_MM )
 #define IU_TO_IN( x )       ( x / IU_PER_MILS / 1000 )
@@ -549,32 +551,68 @@ wxString GetAbbreviatedUnitsLabel( EDA_UNITS aUnit, EDA_DATA_TYPE aType )
 }
 
 
-std::string FormatInternalUnits( int aValue )
+/**
+ * Writes aValue / aScale to aBuf as a decimal number, without exponent and trailing zeros.
+ * aScale is a power of 10, so the text is exact: it is the same as the text printed by
+ * "%.10g" from the double value when it has at most 10 significant digits.
+ * @return the length of the text, which is not null terminated.
+ */
+static int formatFixedPoint( long long aValue, long long aScale, char* aBuf )
 {
-    char    buf[50];
-    double  engUnits = aValue;
-    int     len;
+    char               digits[24];
+    char*              out = aBuf;
+    unsigned long long value = aValue < 0 ? 0ULL - (unsigned long long) aValue : aValue;
+    unsigned long long intPart = value / aScale;
+    unsigned long long fracPart = value % aScale;
+    int                count = 0;
 
-    engUnits /= IU_PER_MM;
+    if( aValue < 0 )
+        *out++ = '-';
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+    do
     {
-        len = snprintf( buf, sizeof(buf), "%.10f", engUnits );
+        digits[count++] = '0' + intPart % 10;
+        intPart /= 10;
+    } while( intPart );
 
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
+    while( count )
+        *out++ = digits[--count];
 
-        if( buf[len] == '.' )
-            buf[len] = '\0';
-        else
-            ++len;
-    }
-    else
+    if( fracPart )
     {
-        len = snprintf( buf, sizeof(buf), "%.10g", engUnits );
+        *out++ = '.';
+
+        for( long long scale = aScale / 10; scale && fracPart; scale /= 10 )
+        {
+            *out++ = '0' + fracPart / scale;
+            fracPart %= scale;
+        }
     }
 
-    return std::string( buf, len );
+    return out - aBuf;
+}
+
+
+/**
+ * Writes the text of FormatInternalUnits( int ) to aBuf, which must hold 24 chars.
+ * @return the length of the text, which is not null terminated.
+ */
+static int formatInternalUnits( int aValue, char* aBuf )
+{
+    // The internal units are a power of 10 of the millimeter for all the applications,
+    // so the values in mm are formatted exactly from the integers
+    static_assert( IU_PER_MM == 1e3 || IU_PER_MM == 1e4 || IU_PER_MM == 1e5
+                           || IU_PER_MM == 1e6, "IU_PER_MM must be a power of 10" );
+
+    return formatFixedPoint( aValue, (long long) IU_PER_MM, aBuf );
+}
+
+
+std::string FormatInternalUnits( int aValue )
+{
+    char buf[24];
+
+    return std::string( buf, formatInternalUnits( aValue, buf ) );
 }
 
 
@@ -583,25 +621,48 @@ std::string FormatAngle( double aAngle )
     char temp[50];
     int len;
 
-    len = snprintf( temp, sizeof(temp), "%.10g", aAngle / 10.0 );
+    // The angles are mostly integers in tenths of degree, which are formatted exactly.
+    // -0.0 is left to snprintf(), which prints its sign.
+    bool negativeZero = aAngle == 0.0 && std::signbit( aAngle );
+
+    if( aAngle == std::floor( aAngle ) && std::fabs( aAngle ) < 1e9 && !negativeZero )
+        len = formatFixedPoint( (long long) aAngle, 10, temp );
+    else
+        len = snprintf( temp, sizeof(temp), "%.10g", aAngle / 10.0 );
 
     return std::string( temp, len );
 }
 
 
+/**
+ * Writes the text of FormatInternalUnits( int ) of both values, separated by a space,
+ * to make the string once.
+ */
+static std::string formatInternalUnitsPair( int aFirst, int aSecond )
+{
+    char buf[50];
+    int  len = formatInternalUnits( aFirst, buf );
+
+    buf[len++] = ' ';
+    len += formatInternalUnits( aSecond, buf + len );
+
+    return std::string( buf, len );
+}
+
+
 std::string FormatInternalUnits( const wxPoint& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatInternalUnitsPair( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const VECTOR2I& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    return formatInternalUnitsPair( aPoint.x, aPoint.y );
 }
 
 
 std::string FormatInternalUnits( const wxSize& aSize )
 {
-    return FormatInternalUnits( aSize.GetWidth() ) + " " + FormatInternalUnits( aSize.GetHeight() );
+    return formatInternalUnitsPair( aSize.GetWidth(), aSize.GetHeight() );
 }
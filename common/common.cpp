@@ -39,8 +39,15 @@
 #include <boost/functional/hash.hpp>
 
 
-// Create only once, as seeding is *very* expensive
-static boost::uuids::random_generator randomGenerator;
+static boost::uuids::uuid newRandomUuid()
+{
+    // Create only once per thread, as seeding is *very* expensive.  The generator is not
+    // thread safe, and items can be created on worker threads (e.g. when GerbView reads
+    // several files at once); each thread seeds its own generator independently.
+    thread_local boost::uuids::random_generator randomGenerator;
+
+    return randomGenerator();
+}
 
 // These don't have the same performance penalty, but might as well be consistent
 static boost::uuids::string_generator stringGenerator;
@@ -59,7 +66,7 @@ KIID& NilUuid()
 
 
 KIID::KIID() :
-        m_uuid( randomGenerator() ),
+        m_uuid( newRandomUuid() ),
         m_cached_timestamp( 0 )
 {
 }
@@ -103,7 +110,7 @@ KIID::KIID( const wxString& aString ) :
         {
             // Failed to parse string representation; best we can do is assign a new
             // random one.
-            m_uuid = randomGenerator();
+            m_uuid = newRandomUuid();
         }
     }
 }
@@ -177,7 +184,7 @@ void KIID::ConvertTimestampToUuid()
         return;
 
     m_cached_timestamp = 0;
-    m_uuid = randomGenerator();
+    m_uuid = newRandomUuid();
 }
 
 
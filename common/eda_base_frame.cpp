@@ -88,6 +88,7 @@ EDA_BASE_FRAME::EDA_BASE_FRAME( wxWindow* aParent, FRAME_T aFrameType,
         m_autoSaveState( false ),
         m_autoSaveInterval(-1 ),
         m_UndoRedoCountMax( DEFAULT_MAX_UNDO_ITEMS ),
+        m_UndoRedoMemoryMax( (size_t) DEFAULT_MAX_UNDO_MEMORY * 1024 * 1024 ),
         m_userUnits( EDA_UNITS::MILLIMETRES ),
         m_isClosing( false ),
         m_isNonUserClose( false )
@@ -903,33 +904,61 @@ void EDA_BASE_FRAME::ClearUndoRedoList()
 }
 
 
-void EDA_BASE_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aNewitem )
+void EDA_BASE_FRAME::pushCommand( UNDO_REDO_LIST aList, PICKED_ITEMS_LIST* aCommand )
 {
-    m_undoList.PushCommand( aNewitem );
+    UNDO_REDO_CONTAINER& list = aList == UNDO_LIST ? m_undoList : m_redoList;
+
+    // The commands holding copies of the items of the new command can own more (or less) of
+    // the data they share with them, e.g. the old fill of a zone after a refill: only these
+    // commands are estimated again
+    auto updateCommands =
+            [&]( UNDO_REDO_CONTAINER& aHolder )
+            {
+                std::set<PICKED_ITEMS_LIST*> commands;
+
+                for( unsigned ii = 0; ii < aCommand->GetCount(); ii++ )
+                    aHolder.FindCommands( aCommand->GetPickedItem( ii ), commands );
+
+                for( PICKED_ITEMS_LIST* command : commands )
+                    aHolder.SetMemoryUsage( command, GetCommandMemoryUsage( *command ) );
+            };
+
+    updateCommands( m_undoList );
+    updateCommands( m_redoList );
+
+    aCommand->SetMemoryUsage( GetCommandMemoryUsage( *aCommand ) );
+    list.PushCommand( aCommand );
 
     // Delete the extra items, if count max reached
     if( m_UndoRedoCountMax > 0 )
     {
-        int extraitems = GetUndoCommandCount() - m_UndoRedoCountMax;
+        int count = aList == UNDO_LIST ? GetUndoCommandCount() : GetRedoCommandCount();
+        int extraitems = count - m_UndoRedoCountMax;
+
+        if( extraitems > 0 )
+            ClearUndoORRedoList( aList, extraitems );
+    }
+
+    // Delete the oldest items, if the memory budget is exceeded
+    if( m_UndoRedoMemoryMax > 0 )
+    {
+        int extraitems = list.GetOverBudgetCount( m_UndoRedoMemoryMax );
 
         if( extraitems > 0 )
-            ClearUndoORRedoList( UNDO_LIST, extraitems );
+            ClearUndoORRedoList( aList, extraitems );
     }
 }
 
 
-void EDA_BASE_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aNewitem )
+void EDA_BASE_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aNewitem )
 {
-    m_redoList.PushCommand( aNewitem );
+    pushCommand( UNDO_LIST, aNewitem );
+}
 
-    // Delete the extra items, if count max reached
-    if( m_UndoRedoCountMax > 0 )
-    {
-        int extraitems = GetRedoCommandCount() - m_UndoRedoCountMax;
 
-        if( extraitems > 0 )
-            ClearUndoORRedoList( REDO_LIST, extraitems );
-    }
+void EDA_BASE_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aNewitem )
+{
+    pushCommand( REDO_LIST, aNewitem );
 }
 
 
@@ -0,0 +1,50 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gal/cairo/cairo_image.h>
+
+using namespace KIGFX;
+
+
+CAIRO_IMAGE_GAL::CAIRO_IMAGE_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, double aDPI )
+    : CAIRO_GAL_BASE( aDisplayOptions )
+{
+    m_clearColor = COLOR4D( 1.0, 1.0, 1.0, 1.0 );
+    SetScreenDPI( aDPI );
+}
+
+
+void CAIRO_IMAGE_GAL::SetSurface( cairo_surface_t* aSurface )
+{
+    // Release the previous surface; the base class releases the last one
+    if( context )
+        cairo_destroy( context );
+
+    if( surface )
+        cairo_surface_destroy( surface );
+
+    surface = cairo_surface_reference( aSurface );
+    context = currentContext = cairo_create( surface );
+
+    if( cairo_surface_get_type( surface ) == CAIRO_SURFACE_TYPE_IMAGE )
+    {
+        SetScreenSize( VECTOR2I( cairo_image_surface_get_width( surface ),
+                                 cairo_image_surface_get_height( surface ) ) );
+    }
+}
@@ -0,0 +1,203 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <mapped_file.h>
+
+#include <wx/file.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+MAPPED_FILE::MAPPED_FILE() :
+        m_data( nullptr ),
+        m_size( 0 ),
+        m_isOpen( false ),
+        m_isMapped( false )
+#ifdef _WIN32
+        , m_fileHandle( nullptr ),
+        m_mappingHandle( nullptr )
+#endif
+{
+}
+
+
+MAPPED_FILE::MAPPED_FILE( const wxString& aFileName ) :
+        MAPPED_FILE()
+{
+    Open( aFileName );
+}
+
+
+MAPPED_FILE::~MAPPED_FILE()
+{
+    Close();
+}
+
+
+bool MAPPED_FILE::Open( const wxString& aFileName )
+{
+    Close();
+
+    m_fileName = aFileName;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW( aFileName.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+
+    if( file == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size;
+
+    if( !GetFileSizeEx( file, &size ) )
+    {
+        CloseHandle( file );
+        return false;
+    }
+
+    // An empty file cannot be mapped, but it is a valid (empty) file
+    if( size.QuadPart == 0 )
+    {
+        CloseHandle( file );
+        m_isOpen = true;
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    void*  view = mapping ? MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+
+    if( !view )
+    {
+        if( mapping )
+            CloseHandle( mapping );
+
+        CloseHandle( file );
+        return readInBuffer( aFileName );
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const char*>( view );
+    m_size = static_cast<size_t>( size.QuadPart );
+#else
+    int fd = open( aFileName.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return false;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) != 0 )
+    {
+        close( fd );
+        return false;
+    }
+
+    // An empty file cannot be mapped, but it is a valid (empty) file
+    if( fileStat.st_size == 0 )
+    {
+        close( fd );
+        m_isOpen = true;
+        return true;
+    }
+
+    void* view = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    // The mapping keeps its own reference to the file
+    close( fd );
+
+    if( view == MAP_FAILED )
+        return readInBuffer( aFileName );
+
+    // Files are usually read from the start to the end: let the system read ahead
+    madvise( view, fileStat.st_size, MADV_SEQUENTIAL );
+
+    m_data = static_cast<const char*>( view );
+    m_size = static_cast<size_t>( fileStat.st_size );
+#endif
+
+    m_isMapped = true;
+    m_isOpen = true;
+
+    return true;
+}
+
+
+bool MAPPED_FILE::readInBuffer( const wxString& aFileName )
+{
+    wxFile file( aFileName );
+
+    if( !file.IsOpened() )
+        return false;
+
+    wxFileOffset length = file.Length();
+
+    if( length < 0 )
+        return false;
+
+    m_buffer.resize( static_cast<size_t>( length ) );
+
+    if( length > 0 && file.Read( m_buffer.data(), m_buffer.size() ) != m_buffer.size() )
+    {
+        m_buffer.clear();
+        return false;
+    }
+
+    m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+    m_size = m_buffer.size();
+    m_isOpen = true;
+
+    return true;
+}
+
+
+void MAPPED_FILE::Close()
+{
+    if( m_isMapped )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile( m_data );
+        CloseHandle( m_mappingHandle );
+        CloseHandle( m_fileHandle );
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        munmap( const_cast<char*>( m_data ), m_size );
+#endif
+    }
+
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+
+    m_data = nullptr;
+    m_size = 0;
+    m_isMapped = false;
+    m_isOpen = false;
+}
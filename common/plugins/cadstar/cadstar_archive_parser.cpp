@@ -25,6 +25,11 @@
 
 #include <plugins/cadstar/cadstar_archive_parser.h>
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+
 
 void CADSTAR_ARCHIVE_PARSER::FORMAT::Parse( XNODE* aNode )
 {
@@ -1899,31 +1904,75 @@ void CADSTAR_ARCHIVE_PARSER::InsertAttributeAtEnd( XNODE* aNode, wxString aValue
 }
 
 
-XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile(
-        const wxString& aFileName, const wxString& aFileTypeIdentifier )
+/**
+ * Reads the nodes of a CADSTAR Archive, or of a section of it, from a lexer.
+ *
+ * The attributes and the children are linked at the end of each node directly: appending them
+ * one by one to the lists of a node with many children would be quadratic.
+ *
+ * @param aFileTypeIdentifier is the expected name of the first node, or empty to not check it.
+ */
+static XNODE* loadArchiveNodes( DSNLEXER& aLexer, const wxString& aFileTypeIdentifier,
+                                wxMBConv& aConv )
 {
-    KEYWORD   emptyKeywords[1] = {};
-    XNODE *   iNode = NULL, *cNode = NULL;
-    int       tok;
-    bool      cadstarFileCheckDone = false;
-    wxString  str;
-    wxCSConv  win1252( wxT( "windows-1252" ) );
-    wxMBConv* conv = &win1252; // Initial testing suggests file encoding to be Windows-1252
-                               // More samples required.
-    FILE* fp = wxFopen( aFileName, wxT( "rt" ) );
+    // The ends of the lists of an open node
+    struct NODE_ENDS
+    {
+        int             count;      ///< Number of attributes
+        wxXmlAttribute* beforeLast;
+        wxXmlAttribute* last;
+        wxXmlNode*      lastChild;
+    };
 
-    if( !fp )
-        THROW_IO_ERROR( wxString::Format( _( "Cannot open file '%s'" ), aFileName ) );
+    std::vector<NODE_ENDS> openNodes;
+
+    XNODE *  iNode = NULL, *cNode = NULL;
+    int      tok;
+    bool     cadstarFileCheckDone = aFileTypeIdentifier.IsEmpty();
+    wxString str;
+
+    auto insertAttributeAtEnd = [&]( const wxString& aValue )
+    {
+        NODE_ENDS& attributes = openNodes.back();
+        wxString   paramName = wxT( "attr" );
+        paramName << attributes.count++;
 
-    DSNLEXER lexer( emptyKeywords, 0, fp, aFileName );
+        wxXmlAttribute* attribute = new wxXmlAttribute( paramName, aValue );
 
-    while( ( tok = lexer.NextTok() ) != DSN_EOF )
+        if( attributes.last )
+            attributes.last->SetNext( attribute );
+        else
+            iNode->SetAttributes( attribute );
+
+        attributes.beforeLast = attributes.last;
+        attributes.last = attribute;
+    };
+
+    while( ( tok = aLexer.NextTok() ) != DSN_EOF )
     {
         if( tok == DSN_RIGHT )
         {
             cNode = iNode;
             if( cNode )
             {
+                NODE_ENDS& attributes = openNodes.back();
+
+                // numAttributes is the index of the last attribute, and it is just before the
+                // last attribute: the same attributes, in the same order, as InsertAttributeAtEnd()
+                if( attributes.count > 0 )
+                {
+                    wxXmlAttribute* numAttributes = new wxXmlAttribute( wxT( "numAttributes" ),
+                            wxString::Format( wxT( "%i" ), attributes.count - 1 ) );
+
+                    if( attributes.beforeLast )
+                        attributes.beforeLast->SetNext( numAttributes );
+                    else
+                        cNode->SetAttributes( numAttributes );
+
+                    numAttributes->SetNext( attributes.last );
+                }
+
+                openNodes.pop_back();
                 iNode = cNode->GetParent();
             }
             else
@@ -1934,31 +1983,36 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile(
         }
         else if( tok == DSN_LEFT )
         {
-            tok   = lexer.NextTok();
-            str   = wxString( lexer.CurText(), *conv );
+            tok   = aLexer.NextTok();
+            str   = wxString( aLexer.CurText(), aConv );
             cNode = new XNODE( wxXML_ELEMENT_NODE, str );
 
             if( iNode )
             {
                 //we will add it as attribute as well as child node
-                InsertAttributeAtEnd( iNode, str );
-                iNode->AddChild( cNode );
+                insertAttributeAtEnd( str );
+                iNode->InsertChildAfter( cNode, openNodes.back().lastChild );
+                openNodes.back().lastChild = cNode;
             }
             else if( !cadstarFileCheckDone )
             {
                 if( cNode->GetName() != aFileTypeIdentifier )
+                {
+                    delete cNode;
                     THROW_IO_ERROR( _( "The selected file is not valid or might be corrupt!" ) );
+                }
 
                 cadstarFileCheckDone = true;
             }
 
             iNode = cNode;
+            openNodes.push_back( { 0, NULL, NULL, NULL } );
         }
         else if( iNode )
         {
-            str = wxString( lexer.CurText(), *conv );
+            str = wxString( aLexer.CurText(), aConv );
             //Insert even if string is empty
-            InsertAttributeAtEnd( iNode, str );
+            insertAttributeAtEnd( str );
         }
         else
         {
@@ -1981,6 +2035,210 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile(
 }
 
 
+/**
+ * Locates the top level sections of a CADSTAR Archive with the same tokenizing rules as
+ * DSNLEXER, without making any token.
+ *
+ * @param aSections receives the offset and the length of each section, parentheses included.
+ * @return false if the text is not a single root node holding only sections, in which case
+ *         it is read serially to report the error.
+ */
+static bool findArchiveSections( const std::string& aText,
+                                 std::vector<std::pair<size_t, size_t>>& aSections )
+{
+    auto isSpace = []( char c )
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\0';
+    };
+
+    size_t pos = 0;
+    size_t len = aText.size();
+    int    depth = 0;
+    bool   rootDone = false;
+    bool   lineStart = true;
+    size_t sectionStart = 0;
+
+    while( pos < len )
+    {
+        char c = aText[pos];
+
+        if( c == '\n' )
+        {
+            lineStart = true;
+            ++pos;
+            continue;
+        }
+
+        if( isSpace( c ) )
+        {
+            ++pos;
+            continue;
+        }
+
+        // If the first non-blank character of a line is #, the line is a comment
+        if( lineStart && c == '#' )
+        {
+            pos = aText.find( '\n', pos );
+            pos = pos == std::string::npos ? len : pos;
+            continue;
+        }
+
+        lineStart = false;
+
+        if( rootDone )
+            return false;       // something after the root node
+
+        if( c == '(' )
+        {
+            if( depth == 1 )
+                sectionStart = pos;
+
+            ++depth;
+            ++pos;
+        }
+        else if( c == ')' )
+        {
+            if( depth == 0 )
+                return false;
+
+            --depth;
+            ++pos;
+
+            if( depth == 1 )
+                aSections.emplace_back( sectionStart, pos - sectionStart );
+            else if( depth == 0 )
+                rootDone = true;
+        }
+        else if( c == '"' )
+        {
+            // a quoted string ends on the same line, \ escapes the next character
+            if( depth < 2 )
+                return false;
+
+            for( ++pos; pos < len && aText[pos] != '"'; ++pos )
+            {
+                if( aText[pos] == '\n' )
+                    return false;
+
+                if( aText[pos] == '\\' )
+                    ++pos;
+            }
+
+            if( pos >= len )
+                return false;
+
+            ++pos;
+        }
+        else
+        {
+            // only the name of the root node is allowed outside of the sections
+            if( depth == 0 || ( depth == 1 && !aSections.empty() ) )
+                return false;
+
+            size_t tokenStart = pos;
+
+            while( pos < len && !isSpace( aText[pos] ) && aText[pos] != '(' && aText[pos] != ')' )
+                ++pos;
+
+            // the root node must only hold its name and its sections
+            if( depth == 1 && ( tokenStart == 0 || aText[tokenStart - 1] != '(' ) )
+                return false;
+        }
+    }
+
+    return rootDone;
+}
+
+
+XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
+        const wxString& aFileTypeIdentifier, bool aReadSectionsConcurrently )
+{
+    wxCSConv  win1252( wxT( "windows-1252" ) );
+    wxMBConv* conv = &win1252; // Initial testing suggests file encoding to be Windows-1252
+                               // More samples required.
+    FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( !fp )
+        THROW_IO_ERROR( wxString::Format( _( "Cannot open file '%s'" ), aFileName ) );
+
+    std::string text;
+    char        buf[65536];
+    size_t      count;
+
+    while( ( count = fread( buf, 1, sizeof( buf ), fp ) ) > 0 )
+        text.append( buf, count );
+
+    fclose( fp );
+
+    std::vector<std::pair<size_t, size_t>> sections;
+
+    if( !aReadSectionsConcurrently || !findArchiveSections( text, sections )
+            || sections.empty() )
+    {
+        DSNLEXER lexer( text, aFileName );
+        return loadArchiveNodes( lexer, aFileTypeIdentifier, *conv );
+    }
+
+    // Check the root node, then read the sections concurrently: the large sections (library,
+    // parts, layout...) are the bulk of the file
+    std::unique_ptr<XNODE> root;
+
+    {
+        DSNLEXER lexer( text.substr( 0, sections[0].first ) + ")", aFileName );
+        root.reset( loadArchiveNodes( lexer, aFileTypeIdentifier, *conv ) );
+    }
+
+    std::vector<std::unique_ptr<XNODE>>    sectionNodes( sections.size() );
+    std::vector<std::unique_ptr<wxCSConv>> sectionConvs;
+    std::vector<std::function<void()>>     sectionLoaders;
+
+    for( size_t ii = 0; ii < sections.size(); ++ii )
+    {
+        // The converters are made here, a converter is only used by one thread
+        sectionConvs.emplace_back( new wxCSConv( wxT( "windows-1252" ) ) );
+
+        sectionLoaders.push_back( [&, ii]()
+        {
+            DSNLEXER lexer( text.substr( sections[ii].first, sections[ii].second ), aFileName );
+            sectionNodes[ii].reset( loadArchiveNodes( lexer, wxEmptyString, *sectionConvs[ii] ) );
+        } );
+    }
+
+    ParseConcurrently( sectionLoaders );
+
+    for( std::unique_ptr<XNODE>& node : sectionNodes )
+    {
+        InsertAttributeAtEnd( root.get(), node->GetName() );
+        root->AddChild( node.release() );
+    }
+
+    return root.release();
+}
+
+
+void CADSTAR_ARCHIVE_PARSER::ParseConcurrently(
+        const std::vector<std::function<void()>>& aParsers )
+{
+    std::atomic<size_t> nextParser( 0 );
+    size_t parallelThreadCount = std::min<size_t>(
+            std::max<size_t>( 1, std::thread::hardware_concurrency() ), aParsers.size() );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        returns[ii] = std::async( std::launch::async, [&]()
+        {
+            for( size_t i = nextParser++; i < aParsers.size(); i = nextParser++ )
+                aParsers[i]();
+        } );
+    }
+
+    // get() rethrows the first error of a parser
+    for( auto& ret : returns )
+        ret.get();
+}
+
+
 bool CADSTAR_ARCHIVE_PARSER::IsValidAttribute( wxXmlAttribute* aAttribute )
 {
     return aAttribute->GetName() != wxT( "numAttributes" );
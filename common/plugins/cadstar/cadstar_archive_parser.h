@@ -27,6 +27,7 @@
 #define CADSTAR_ARCHIVE_PARSER_H_
 
 #include <dsnlexer.h>
+#include <functional>
 #include <macros.h>
 #include <vector>
 #include <wx/log.h>
@@ -1119,9 +1120,22 @@ public:
      * @return XNODE pointing to the top of the tree for further parsing. Each node has the first
      *         element as the node's name and subsequent elements as node attributes ("attr0",
      *         "attr1", "attr2", etc.). Caller is responsible for deleting to avoid memory leaks.
+     *         The top level sections are located by a first scan of the file and read
+     *         concurrently.
+     * @param aReadSectionsConcurrently false to read the whole file in a single pass, as for
+     *        the files which do not hold only sections.  Both give the same tree.
      * @throws IO_ERROR
      */
-    static XNODE* LoadArchiveFile( const wxString& aFileName, const wxString& aFileTypeIdentifier );
+    static XNODE* LoadArchiveFile( const wxString& aFileName, const wxString& aFileTypeIdentifier,
+                                   bool aReadSectionsConcurrently = true );
+
+    /**
+     * @brief Runs parsers which do not depend on each other concurrently, e.g. the parsers of
+     *        the top level sections of an archive, each filling its own structure.
+     * @param aParsers
+     * @throws IO_ERROR the first error thrown by a parser
+     */
+    static void ParseConcurrently( const std::vector<std::function<void()>>& aParsers );
 
     /**
      * @brief
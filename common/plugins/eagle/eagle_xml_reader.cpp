@@ -0,0 +1,334 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <plugins/eagle/eagle_xml_reader.h>
+
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <expat.h>
+
+#include <wx/ffile.h>
+#include <wx/intl.h>
+
+#include <ki_exception.h>
+
+
+/// Size of the blocks of the file given to the parser
+static const size_t READ_BLOCK_SIZE = 64 * 1024;
+
+
+/**
+ * The state of the parser of EAGLE_XML_READER::Read().
+ *
+ * The element trees are built the way wxXmlDocument builds its document: whitespace only
+ * text is skipped, consecutive character data is merged in one text node, and the CDATA
+ * sections and comments get their own nodes.
+ */
+struct EAGLE_XML_READER::PARSE_CONTEXT
+{
+    PARSE_CONTEXT( const EAGLE_XML_READER& aReader, XML_Parser aParser ) :
+            m_reader( aReader ),
+            m_parser( aParser ),
+            m_treeHandler( nullptr ),
+            m_node( nullptr ),
+            m_lastChild( nullptr ),
+            m_lastAsText( nullptr )
+    {}
+
+    static void XMLCALL startElement( void* aData, const XML_Char* aName,
+                                      const XML_Char** aAttributes );
+    static void XMLCALL endElement( void* aData, const XML_Char* aName );
+    static void XMLCALL text( void* aData, const XML_Char* aText, int aLength );
+    static void XMLCALL startCdata( void* aData );
+    static void XMLCALL endCdata( void* aData );
+    static void XMLCALL comment( void* aData, const XML_Char* aText );
+
+    /// Makes an element node with its attributes, and no children
+    wxXmlNode* makeElement( const XML_Char* aName, const XML_Char** aAttributes ) const;
+
+    /// Adds a node after the last child of the current element of m_tree
+    void addChild( wxXmlNode* aNode );
+
+    /// Gives a node to a handler, and stops the parser if the handler throws
+    void callHandler( const HANDLER& aHandler, std::unique_ptr<wxXmlNode> aNode );
+
+    int lineNumber() const
+    {
+        return (int) XML_GetCurrentLineNumber( m_parser );
+    }
+
+    const EAGLE_XML_READER& m_reader;
+    XML_Parser              m_parser;
+
+    std::string             m_path;          ///< the path of the current element
+    std::vector<size_t>     m_pathLengths;   ///< the m_path lengths of the open elements
+
+    std::unique_ptr<wxXmlNode> m_tree;       ///< the element being built for a handler
+    const HANDLER*          m_treeHandler;   ///< the handler of m_tree
+    wxXmlNode*              m_node;          ///< the current element of m_tree
+    wxXmlNode*              m_lastChild;     ///< the last child of m_node
+    wxXmlNode*              m_lastAsText;    ///< the text node of the current character data
+
+    std::exception_ptr      m_error;         ///< the exception which stopped the parser
+};
+
+
+wxXmlNode* EAGLE_XML_READER::PARSE_CONTEXT::makeElement( const XML_Char* aName,
+                                                          const XML_Char** aAttributes ) const
+{
+    wxXmlNode* node = new wxXmlNode( wxXML_ELEMENT_NODE, wxString::FromUTF8( aName ),
+                                     wxEmptyString, lineNumber() );
+
+    for( ; aAttributes[0]; aAttributes += 2 )
+        node->AddAttribute( wxString::FromUTF8( aAttributes[0] ),
+                            wxString::FromUTF8( aAttributes[1] ) );
+
+    return node;
+}
+
+
+void EAGLE_XML_READER::PARSE_CONTEXT::addChild( wxXmlNode* aNode )
+{
+    m_node->InsertChildAfter( aNode, m_lastChild );
+    m_lastChild = aNode;
+}
+
+
+void EAGLE_XML_READER::PARSE_CONTEXT::callHandler( const HANDLER& aHandler,
+                                                   std::unique_ptr<wxXmlNode> aNode )
+{
+    try
+    {
+        aHandler( std::move( aNode ) );
+    }
+    catch( ... )
+    {
+        // Exceptions must not go through the parser: keep it for Read()
+        m_error = std::current_exception();
+        XML_StopParser( m_parser, XML_FALSE );
+    }
+}
+
+
+void XMLCALL EAGLE_XML_READER::PARSE_CONTEXT::startElement( void* aData, const XML_Char* aName,
+                                                            const XML_Char** aAttributes )
+{
+    PARSE_CONTEXT* ctx = static_cast<PARSE_CONTEXT*>( aData );
+
+    if( ctx->m_error )
+        return;
+
+    ctx->m_pathLengths.push_back( ctx->m_path.size() );
+
+    if( !ctx->m_path.empty() )
+        ctx->m_path += '/';
+
+    ctx->m_path += aName;
+
+    if( ctx->m_tree )
+    {
+        wxXmlNode* node = ctx->makeElement( aName, aAttributes );
+
+        ctx->addChild( node );
+        ctx->m_node       = node;
+        ctx->m_lastChild  = nullptr;
+        ctx->m_lastAsText = nullptr;
+        return;
+    }
+
+    auto it = ctx->m_reader.m_handlers.find( ctx->m_path );
+
+    if( it == ctx->m_reader.m_handlers.end() )
+        return;
+
+    std::unique_ptr<wxXmlNode> node( ctx->makeElement( aName, aAttributes ) );
+
+    if( it->second.m_withChildren )
+    {
+        ctx->m_tree        = std::move( node );
+        ctx->m_treeHandler = &it->second.m_handler;
+        ctx->m_node        = ctx->m_tree.get();
+        ctx->m_lastChild   = nullptr;
+        ctx->m_lastAsText  = nullptr;
+    }
+    else
+    {
+        ctx->callHandler( it->second.m_handler, std::move( node ) );
+    }
+}
+
+
+void XMLCALL EAGLE_XML_READER::PARSE_CONTEXT::endElement( void* aData, const XML_Char* aName )
+{
+    PARSE_CONTEXT* ctx = static_cast<PARSE_CONTEXT*>( aData );
+
+    if( ctx->m_error )
+        return;
+
+    ctx->m_path.resize( ctx->m_pathLengths.back() );
+    ctx->m_pathLengths.pop_back();
+
+    if( !ctx->m_tree )
+        return;
+
+    ctx->m_lastAsText = nullptr;
+
+    if( ctx->m_node != ctx->m_tree.get() )
+    {
+        ctx->m_lastChild = ctx->m_node;
+        ctx->m_node      = ctx->m_node->GetParent();
+        return;
+    }
+
+    // The element of the handler is complete
+    const HANDLER* handler = ctx->m_treeHandler;
+
+    ctx->m_treeHandler = nullptr;
+    ctx->m_node        = nullptr;
+    ctx->m_lastChild   = nullptr;
+
+    ctx->callHandler( *handler, std::move( ctx->m_tree ) );
+}
+
+
+void XMLCALL EAGLE_XML_READER::PARSE_CONTEXT::text( void* aData, const XML_Char* aText,
+                                                    int aLength )
+{
+    PARSE_CONTEXT* ctx = static_cast<PARSE_CONTEXT*>( aData );
+
+    if( ctx->m_error || !ctx->m_tree )
+        return;
+
+    wxString str = wxString::FromUTF8( aText, aLength );
+
+    if( ctx->m_lastAsText )
+    {
+        ctx->m_lastAsText->SetContent( ctx->m_lastAsText->GetContent() + str );
+        return;
+    }
+
+    // wxXmlDocument skips the whitespace between the elements
+    if( str.find_first_not_of( wxT( " \t\r\n" ) ) == wxString::npos )
+        return;
+
+    wxXmlNode* node = new wxXmlNode( wxXML_TEXT_NODE, wxT( "text" ), str, ctx->lineNumber() );
+
+    ctx->addChild( node );
+    ctx->m_lastAsText = node;
+}
+
+
+void XMLCALL EAGLE_XML_READER::PARSE_CONTEXT::startCdata( void* aData )
+{
+    PARSE_CONTEXT* ctx = static_cast<PARSE_CONTEXT*>( aData );
+
+    if( ctx->m_error || !ctx->m_tree )
+        return;
+
+    wxXmlNode* node = new wxXmlNode( wxXML_CDATA_SECTION_NODE, wxT( "cdata" ), wxEmptyString,
+                                     ctx->lineNumber() );
+
+    ctx->addChild( node );
+    ctx->m_lastAsText = node;
+}
+
+
+void XMLCALL EAGLE_XML_READER::PARSE_CONTEXT::endCdata( void* aData )
+{
+    PARSE_CONTEXT* ctx = static_cast<PARSE_CONTEXT*>( aData );
+
+    ctx->m_lastAsText = nullptr;
+}
+
+
+void XMLCALL EAGLE_XML_READER::PARSE_CONTEXT::comment( void* aData, const XML_Char* aText )
+{
+    PARSE_CONTEXT* ctx = static_cast<PARSE_CONTEXT*>( aData );
+
+    if( ctx->m_error || !ctx->m_tree )
+        return;
+
+    wxXmlNode* node = new wxXmlNode( wxXML_COMMENT_NODE, wxT( "comment" ),
+                                     wxString::FromUTF8( aText ), ctx->lineNumber() );
+
+    ctx->addChild( node );
+    ctx->m_lastAsText = nullptr;
+}
+
+
+void EAGLE_XML_READER::AddHandler( const wxString& aPath, const HANDLER& aHandler,
+                                   bool aWithChildren )
+{
+    m_handlers[ std::string( aPath.ToUTF8() ) ] = PATH_HANDLER{ aHandler, aWithChildren };
+}
+
+
+void EAGLE_XML_READER::Read( const wxString& aFileName )
+{
+    wxFFile file( aFileName, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ), aFileName ) );
+
+    std::unique_ptr<std::remove_pointer<XML_Parser>::type, decltype( &XML_ParserFree )>
+            parser( XML_ParserCreate( nullptr ), &XML_ParserFree );
+
+    if( !parser )
+        throw std::bad_alloc();
+
+    PARSE_CONTEXT ctx( *this, parser.get() );
+
+    XML_SetUserData( parser.get(), &ctx );
+    XML_SetElementHandler( parser.get(), PARSE_CONTEXT::startElement, PARSE_CONTEXT::endElement );
+    XML_SetCharacterDataHandler( parser.get(), PARSE_CONTEXT::text );
+    XML_SetCdataSectionHandler( parser.get(), PARSE_CONTEXT::startCdata,
+                                PARSE_CONTEXT::endCdata );
+    XML_SetCommentHandler( parser.get(), PARSE_CONTEXT::comment );
+
+    std::vector<char> buffer( READ_BLOCK_SIZE );
+    bool              done = false;
+
+    while( !done )
+    {
+        size_t length = file.Read( buffer.data(), buffer.size() );
+
+        if( file.Error() )
+            THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ), aFileName ) );
+
+        done = length < buffer.size();
+
+        if( XML_Parse( parser.get(), buffer.data(), (int) length, done ) == XML_STATUS_ERROR )
+        {
+            if( ctx.m_error )
+                std::rethrow_exception( ctx.m_error );
+
+            THROW_IO_ERROR( wxString::Format( _( "Error reading file \"%s\" at line %d: %s" ),
+                                              aFileName,
+                                              (int) XML_GetCurrentLineNumber( parser.get() ),
+                                              XML_ErrorString( XML_GetErrorCode( parser.get() ) ) ) );
+        }
+    }
+}
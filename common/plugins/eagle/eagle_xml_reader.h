@@ -0,0 +1,88 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef _EAGLE_XML_READER_H_
+#define _EAGLE_XML_READER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <wx/string.h>
+#include <wx/xml/xml.h>
+
+
+/**
+ * EAGLE_XML_READER
+ * reads an Eagle XML file with an event driven (expat) parser, and hands the elements found
+ * at the registered paths to their handlers as soon as they are complete.
+ *
+ * Only the elements at the registered paths are built, with the same wxXmlNode trees that
+ * wxXmlDocument makes for them.  Each tree belongs to its handler, so the whole document is
+ * never held in memory: a handler either converts its element and drops it, or keeps it for
+ * as long as it needs it.
+ */
+class EAGLE_XML_READER
+{
+public:
+    /// A handler receives the element at its path, and owns it.
+    typedef std::function<void( std::unique_ptr<wxXmlNode> aNode )> HANDLER;
+
+    /**
+     * Function AddHandler
+     * registers the handler of the elements found at a path.
+     *
+     * @param aPath is the slash separated path of the elements from the root element, for
+     *              instance "eagle/drawing/board/signals/signal".
+     * @param aHandler is called with each element found at \a aPath.
+     * @param aWithChildren tells to give the whole element to \a aHandler when its end tag is
+     *                      read.  If false, \a aHandler is called with the element and its
+     *                      attributes only when its start tag is read, and the elements below
+     *                      it can be handled by other handlers.
+     */
+    void AddHandler( const wxString& aPath, const HANDLER& aHandler, bool aWithChildren = true );
+
+    /**
+     * Function Read
+     * parses a file and calls the handlers of the elements found in it, in document order.
+     *
+     * @param aFileName is the name of the file to read.
+     * @throw IO_ERROR if the file cannot be read or is not well formed XML.  The exceptions
+     *                 thrown by the handlers stop the parsing and are passed to the caller.
+     */
+    void Read( const wxString& aFileName );
+
+private:
+    struct PARSE_CONTEXT;
+
+    struct PATH_HANDLER
+    {
+        HANDLER m_handler;
+        bool    m_withChildren;
+    };
+
+    std::map<std::string, PATH_HANDLER> m_handlers;   ///< the handlers by UTF-8 element path
+};
+
+#endif  // _EAGLE_XML_READER_H_
@@ -29,6 +29,10 @@
 #include <richio.h>
 #include <errno.h>
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
 #include <wx/file.h>
 #include <wx/translation.h>
 
@@ -324,6 +328,52 @@ char* INPUTSTREAM_LINE_READER::ReadLine()
 }
 
 
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aMaxLineLength ) :
+    LINE_READER( aMaxLineLength ),
+    m_ndx( 0 )
+{
+    if( !m_file.Open( aFileName ) )
+    {
+        wxString msg = wxString::Format(
+            _( "Unable to open filename \"%s\" for reading" ), aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_source = aFileName;
+}
+
+
+char* MAPPED_FILE_LINE_READER::ReadLine()
+{
+    const char* data = m_file.Data();
+    size_t      remaining = m_file.Size() - m_ndx;
+
+    m_length = 0;
+
+    if( remaining )
+    {
+        // Longer lines are returned in pieces of m_maxLineLength bytes
+        size_t      maxLength = std::min<size_t>( remaining, m_maxLineLength );
+        const char* start = data + m_ndx;
+        const char* nl = static_cast<const char*>( memchr( start, '\n', maxLength ) );
+
+        m_length = nl ? nl - start + 1 : maxLength;     // include the newline, so +1
+
+        if( m_length + 1 > m_capacity )   // +1 for terminating nul
+            expandCapacity( m_length + 1 );
+
+        memcpy( m_line, start, m_length );
+        m_ndx += m_length;
+    }
+
+    ++m_lineNum;      // this gets incremented even if no bytes were read
+    m_line[m_length] = 0;
+
+    return m_length ? m_line : NULL;
+}
+
+
 //-----<OUTPUTFORMATTER>----------------------------------------------------
 
 // factor out a common GetQuoteChar
@@ -367,8 +417,131 @@ const char* OUTPUTFORMATTER::GetQuoteChar( const char* wrapee )
     return GetQuoteChar( wrapee, quoteChar );
 }
 
+/**
+ * Tells if the only conversions of a printf() format are the ones handled by
+ * OUTPUTFORMATTER::fastPrint(): %s, %d, %u, %c and %%, without flags, width or precision.
+ * These are nearly all the conversions of the file formatters.
+ */
+static bool isFastFormat( const char* fmt )
+{
+    for( const char* pct = strchr( fmt, '%' );  pct;  pct = strchr( pct + 2, '%' ) )
+    {
+        switch( pct[1] )
+        {
+        case 's':
+        case 'd':
+        case 'u':
+        case 'c':
+        case '%':
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int OUTPUTFORMATTER::fastPrint( const char* fmt, va_list ap )
+{
+    size_t len = 0;
+
+    auto append = [&]( const char* aText, size_t aCount )
+                  {
+                      if( aCount == 0 )
+                          return;
+
+                      if( len + aCount > m_buffer.size() )
+                          m_buffer.resize( std::max( 2 * m_buffer.size(), len + aCount ) );
+
+                      memcpy( &m_buffer[len], aText, aCount );
+                      len += aCount;
+                  };
+
+    auto appendUnsigned = [&]( unsigned long long aValue, bool aNegative )
+                          {
+                              char  digits[24];
+                              char* start = digits + sizeof( digits );
+
+                              do
+                              {
+                                  *--start = '0' + aValue % 10;
+                                  aValue /= 10;
+                              } while( aValue );
+
+                              if( aNegative )
+                                  *--start = '-';
+
+                              append( start, digits + sizeof( digits ) - start );
+                          };
+
+    while( *fmt )
+    {
+        const char* pct = strchr( fmt, '%' );
+
+        if( !pct )
+        {
+            append( fmt, strlen( fmt ) );
+            break;
+        }
+
+        append( fmt, pct - fmt );
+
+        switch( pct[1] )
+        {
+        case 's':
+        {
+            const char* text = va_arg( ap, const char* );
+
+            if( !text )
+                text = "(null)";    // as printed by the glibc
+
+            append( text, strlen( text ) );
+            break;
+        }
+
+        case 'd':
+        {
+            int value = va_arg( ap, int );
+            appendUnsigned( value < 0 ? 0ULL - (unsigned long long) value : value, value < 0 );
+            break;
+        }
+
+        case 'u':
+            appendUnsigned( va_arg( ap, unsigned ), false );
+            break;
+
+        case 'c':
+        {
+            char c = (char) va_arg( ap, int );
+            append( &c, 1 );
+            break;
+        }
+
+        default:    // '%'
+            append( pct + 1, 1 );
+            break;
+        }
+
+        fmt = pct + 2;
+    }
+
+    if( len > 0 )
+        write( &m_buffer[0], len );
+
+    return len;
+}
+
+
 int OUTPUTFORMATTER::vprint( const char* fmt,  va_list ap )
 {
+    // Most formats are only made of strings and integers, which are copied and formatted
+    // directly to the buffer: vsnprintf() is much slower for them.
+    if( isFastFormat( fmt ) )
+        return fastPrint( fmt, ap );
+
     // This function can call vsnprintf twice.
     // But internally, vsnprintf retrieves arguments from the va_list identified by arg as if
     // va_arg was used on it, and thus the state of the va_list is likely to be altered by the call.
@@ -416,10 +589,15 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
     int result = 0;
     int total  = 0;
 
-    for( int i=0; i<nestLevel;  ++i )
+    // The indentation is written as is, it does not need to be formatted.
+    static const char spaces[] = "                                ";
+    const int         spacesCount = sizeof( spaces ) - 1;
+
+    for( int left = nestLevel * NESTWIDTH; left > 0; left -= spacesCount )
     {
         // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        result = std::min( left, spacesCount );
+        write( spaces, result );
 
         total += result;
     }
@@ -473,14 +651,64 @@ std::string OUTPUTFORMATTER::Quotes( const std::string& aWrapee )
 }
 
 
-std::string OUTPUTFORMATTER::Quotew( const wxString& aWrapee )
+const size_t OUTPUTFORMATTER::QUOTEW_KEPT;
+
+
+void OUTPUTFORMATTER::EnableQuoteCache( size_t aCount )
+{
+    m_quotedMax = std::max( aCount, QUOTEW_KEPT );
+    m_quoteCacheEnabled = true;
+    m_quoteCache.reserve( m_quotedMax );
+
+    for( QUOTED_STRINGS::iterator it = m_quoted.begin(); it != m_quoted.end(); ++it )
+        m_quoteCache[ it->first ] = it;
+}
+
+
+const std::string& OUTPUTFORMATTER::Quotew( const wxString& aWrapee )
 {
     // wxStrings are always encoded as UTF-8 as we convert to a byte sequence.
     // The non-virutal function calls the virtual workhorse function, and if
     // a different quoting or escaping strategy is desired from the standard,
     // a derived class can overload Quotes() above, but
     // should never be a reason to overload this Quotew() here.
-    return Quotes( (const char*) aWrapee.utf8_str() );
+
+    if( m_quoteCacheEnabled )
+    {
+        auto cached = m_quoteCache.find( aWrapee );
+
+        if( cached != m_quoteCache.end() )
+        {
+            m_quoted.splice( m_quoted.begin(), m_quoted, cached->second );
+            return cached->second->second;
+        }
+    }
+
+    // Quote the string in the least recently quoted one, so the strings returned for a
+    // single Print() call stay valid.
+    if( m_quoted.size() < m_quotedMax )
+    {
+        m_quoted.emplace_front();
+    }
+    else
+    {
+        m_quoted.splice( m_quoted.begin(), m_quoted, std::prev( m_quoted.end() ) );
+
+        if( m_quoteCacheEnabled )
+            m_quoteCache.erase( m_quoted.front().first );
+    }
+
+    QUOTED_STRING& entry = m_quoted.front();
+
+    entry.second = Quotes( (const char*) aWrapee.utf8_str() );
+
+    if( m_quoteCacheEnabled )
+    {
+        entry.first = aWrapee;
+        m_quoteCache[ aWrapee ] = m_quoted.begin();
+    }
+
+    return entry.second;
 }
 
 
@@ -517,6 +745,13 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName, const wxC
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    // The formatters write many short strings, use a larger buffer than the default one
+    // to make less system calls.
+    setvbuf( m_fp, NULL, _IOFBF, FILE_OUTPUTFMTBUFZ );
+
+    // The same strings (layer names, net names...) are quoted many times in a file.
+    EnableQuoteCache( 256 );
 }
 
 
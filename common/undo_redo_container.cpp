@@ -61,6 +61,7 @@ ITEM_PICKER::ITEM_PICKER( BASE_SCREEN* aScreen, EDA_ITEM* aItem, UNDO_REDO aUndo
 PICKED_ITEMS_LIST::PICKED_ITEMS_LIST()
 {
     m_Status = UNDO_REDO::UNSPECIFIED;
+    m_memoryUsage = 0;
 }
 
 PICKED_ITEMS_LIST::~PICKED_ITEMS_LIST()
@@ -295,7 +296,8 @@ void PICKED_ITEMS_LIST::ReversePickersListOrder()
 /********** UNDO_REDO_CONTAINER ***************/
 /**********************************************/
 
-UNDO_REDO_CONTAINER::UNDO_REDO_CONTAINER()
+UNDO_REDO_CONTAINER::UNDO_REDO_CONTAINER() :
+        m_memoryUsage( 0 )
 {
 }
 
@@ -306,18 +308,53 @@ UNDO_REDO_CONTAINER::~UNDO_REDO_CONTAINER()
 }
 
 
+void UNDO_REDO_CONTAINER::addCommand( PICKED_ITEMS_LIST* aCommand )
+{
+    m_memoryUsage += aCommand->GetMemoryUsage();
+
+    for( unsigned ii = 0; ii < aCommand->GetCount(); ii++ )
+    {
+        if( EDA_ITEM* item = aCommand->GetPickedItem( ii ) )
+            m_itemCommands.emplace( item, aCommand );
+    }
+}
+
+
+void UNDO_REDO_CONTAINER::removeCommand( PICKED_ITEMS_LIST* aCommand )
+{
+    m_memoryUsage -= aCommand->GetMemoryUsage();
+
+    for( unsigned ii = 0; ii < aCommand->GetCount(); ii++ )
+    {
+        auto range = m_itemCommands.equal_range( aCommand->GetPickedItem( ii ) );
+
+        for( auto it = range.first; it != range.second; ++it )
+        {
+            if( it->second == aCommand )
+            {
+                m_itemCommands.erase( it );
+                break;
+            }
+        }
+    }
+}
+
+
 void UNDO_REDO_CONTAINER::ClearCommandList()
 {
     for( unsigned ii = 0; ii < m_CommandsList.size(); ii++ )
         delete m_CommandsList[ii];
 
     m_CommandsList.clear();
+    m_itemCommands.clear();
+    m_memoryUsage = 0;
 }
 
 
 void UNDO_REDO_CONTAINER::PushCommand( PICKED_ITEMS_LIST* aItem )
 {
     m_CommandsList.push_back( aItem );
+    addCommand( aItem );
 }
 
 
@@ -327,8 +364,53 @@ PICKED_ITEMS_LIST* UNDO_REDO_CONTAINER::PopCommand()
     {
         PICKED_ITEMS_LIST* item = m_CommandsList.back();
         m_CommandsList.pop_back();
+        removeCommand( item );
+        return item;
+    }
+
+    return NULL;
+}
+
+
+PICKED_ITEMS_LIST* UNDO_REDO_CONTAINER::PopOldestCommand()
+{
+    if( m_CommandsList.size() != 0 )
+    {
+        PICKED_ITEMS_LIST* item = m_CommandsList.front();
+        m_CommandsList.erase( m_CommandsList.begin() );
+        removeCommand( item );
         return item;
     }
 
     return NULL;
 }
+
+
+void UNDO_REDO_CONTAINER::SetMemoryUsage( PICKED_ITEMS_LIST* aCommand, size_t aUsage )
+{
+    m_memoryUsage += aUsage - aCommand->GetMemoryUsage();
+    aCommand->SetMemoryUsage( aUsage );
+}
+
+
+void UNDO_REDO_CONTAINER::FindCommands( const EDA_ITEM* aItem,
+                                        std::set<PICKED_ITEMS_LIST*>& aCommands ) const
+{
+    auto range = m_itemCommands.equal_range( aItem );
+
+    for( auto it = range.first; it != range.second; ++it )
+        aCommands.insert( it->second );
+}
+
+
+int UNDO_REDO_CONTAINER::GetOverBudgetCount( size_t aMaxMemory ) const
+{
+    size_t usage = m_memoryUsage;
+    int    count = 0;
+
+    // Remove the oldest commands first, but never the newest one
+    while( usage > aMaxMemory && count + 1 < (int) m_CommandsList.size() )
+        usage -= m_CommandsList[count++]->GetMemoryUsage();
+
+    return count;
+}
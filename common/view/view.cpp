@@ -1097,7 +1097,9 @@ void VIEW::Clear()
 
     m_nextDrawPriority = 0;
 
-    m_gal->ClearCache();
+    // Views used only to reference items for other views have no GAL
+    if( m_gal )
+        m_gal->ClearCache();
 }
 
 
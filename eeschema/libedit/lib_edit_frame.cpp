@@ -1130,13 +1130,11 @@ void LIB_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aItemCou
 
     UNDO_REDO_CONTAINER& list = whichList == UNDO_LIST ? m_undoList : m_redoList;
 
-    for( PICKED_ITEMS_LIST* command : list.m_CommandsList )
+    while( PICKED_ITEMS_LIST* command = list.PopOldestCommand() )
     {
         command->ClearListAndDeleteItems();
         delete command;
     }
-
-    list.m_CommandsList.clear();
 }
 
 
@@ -26,13 +26,19 @@
 #include "netlist_exporter_generic.h"
 
 #include <build_version.h>
+#include <confirm.h>
 #include <sch_base_frame.h>
 #include <class_library.h>
 #include <connection_graph.h>
 #include <refdes_utils.h>
+#include <richio.h>
 
 #include <symbol_lib_table.h>
 
+#include <map>
+#include <memory>
+#include <string>
+
 
 static bool sortPinsByNumber( LIB_PIN* aPin1, LIB_PIN* aPin2 );
 
@@ -40,11 +46,141 @@ bool NETLIST_EXPORTER_GENERIC::WriteNetlist( const wxString& aOutFileName,
                                              unsigned aNetlistOptions )
 {
     // output the XML format netlist.
-    wxXmlDocument   xdoc;
+    try
+    {
+        // Binary mode: the file has the same line ends as when it was saved by wxXmlDocument
+        FILE_OUTPUTFORMATTER formatter( aOutFileName, wxT( "wb" ) );
+        formatXml( &formatter, GNL_ALL | aNetlistOptions );
+    }
+
+    catch( const IO_ERROR& ioe )
+    {
+        DisplayError( NULL, ioe.What() );
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * Escapes \a aText as wxXmlDocument::Save() does, in the content of a node or in the value
+ * of an attribute (\a aAttribute true), and converts it to UTF8.
+ */
+static std::string xmlEscape( const wxString& aText, bool aAttribute )
+{
+    std::string text = TO_UTF8( aText );
+    std::string escaped;
+
+    escaped.reserve( text.size() );
+
+    for( char c : text )
+    {
+        switch( c )
+        {
+        case '<':  escaped += "&lt;";   break;
+        case '>':  escaped += "&gt;";   break;
+        case '&':  escaped += "&amp;";  break;
+        case '\r': escaped += "&#xD;";  break;
+        case '"':  escaped += aAttribute ? "&quot;" : "\"";   break;
+        case '\t': escaped += aAttribute ? "&#x9;" : "\t";    break;
+        case '\n': escaped += aAttribute ? "&#xA;" : "\n";    break;
+        default:   escaped += c;        break;
+        }
+    }
+
+    return escaped;
+}
+
+
+/**
+ * Writes \a aNode to \a aOut as wxXmlDocument::Save() does with an indentation step of 2,
+ * \a aNestLevel being the depth of the node in the document.  An element is written on a
+ * new line.
+ */
+static void formatXmlNode( OUTPUTFORMATTER* aOut, int aNestLevel, const wxXmlNode* aNode )
+{
+    if( aNode->GetType() == wxXML_TEXT_NODE )
+    {
+        aOut->Print( 0, "%s", xmlEscape( aNode->GetContent(), false ).c_str() );
+        return;
+    }
+
+    aOut->Print( 0, "\n" );
+    aOut->Print( aNestLevel, "<%s", TO_UTF8( aNode->GetName() ) );
+
+    for( const wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        aOut->Print( 0, " %s=\"%s\"", TO_UTF8( attr->GetName() ),
+                     xmlEscape( attr->GetValue(), true ).c_str() );
+    }
+
+    if( !aNode->GetChildren() )
+    {
+        aOut->Print( 0, "/>" );
+        return;
+    }
+
+    aOut->Print( 0, ">" );
+
+    const wxXmlNode* last = nullptr;
+
+    for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+    {
+        formatXmlNode( aOut, aNestLevel + 1, child );
+        last = child;
+    }
+
+    // The closing tag follows a text content, or goes on its own line
+    if( last->GetType() != wxXML_TEXT_NODE )
+    {
+        aOut->Print( 0, "\n" );
+        aOut->Print( aNestLevel, "</%s>", TO_UTF8( aNode->GetName() ) );
+    }
+    else
+    {
+        aOut->Print( 0, "</%s>", TO_UTF8( aNode->GetName() ) );
+    }
+}
+
 
-    xdoc.SetRoot( makeRoot( GNL_ALL | aNetlistOptions ) );
+void NETLIST_EXPORTER_GENERIC::formatXml( OUTPUTFORMATTER* aOut, unsigned aCtl )
+{
+    auto formatSection = [aOut]( XNODE* aSection )
+                         {
+                             std::unique_ptr<XNODE> xsection( aSection );
+
+                             formatXmlNode( aOut, 1, xsection.get() );
+                         };
+
+    aOut->Print( 0, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+    aOut->Print( 0, "<export version=\"D\"" );
+
+    if( !( aCtl & GNL_ALL ) )
+    {
+        aOut->Print( 0, "/>\n" );
+        return;
+    }
 
-    return xdoc.Save( aOutFileName, 2 /* indent bug, today was ignored by wxXml lib */ );
+    aOut->Print( 0, ">" );
+
+    if( aCtl & GNL_HEADER )
+        formatSection( makeDesignHeader() );
+
+    if( aCtl & GNL_COMPONENTS )
+        formatXmlComponents( aOut, 1, aCtl );
+
+    if( aCtl & GNL_PARTS )
+        formatSection( makeLibParts() );
+
+    if( aCtl & GNL_LIBRARIES )
+        // must follow makeLibParts()
+        formatSection( makeLibraries() );
+
+    if( aCtl & GNL_NETS )
+        formatXmlListOfNets( aOut, 1 );
+
+    aOut->Print( 0, "\n</export>\n" );
 }
 
 
@@ -229,7 +365,72 @@ void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT*
 XNODE* NETLIST_EXPORTER_GENERIC::makeComponents( unsigned aCtl )
 {
     XNODE* xcomps = node( "components" );
+    XNODE* lastComp = nullptr;
+
+    // AddChild() walks all the children to append a node: insert after the last one instead
+    visitComponents( aCtl, [&]( XNODE* aComponent )
+                           {
+                               xcomps->InsertChildAfter( aComponent, lastComp );
+                               lastComp = aComponent;
+                           } );
+
+    return xcomps;
+}
+
+
+void NETLIST_EXPORTER_GENERIC::formatComponents( OUTPUTFORMATTER* aOut, int aNestLevel,
+                                                 unsigned aCtl )
+{
+    // Same output as XNODE::Format() for the "components" node, each component being
+    // formatted and deleted as soon as it is made
+    aOut->Print( aNestLevel, "(components" );
+
+    visitComponents( aCtl, [&]( XNODE* aComponent )
+                           {
+                               std::unique_ptr<XNODE> xcomp( aComponent );
+
+                               aOut->Print( 0, "\n" );
+                               xcomp->Format( aOut, aNestLevel + 1 );
+                           } );
 
+    aOut->Print( 0, ")" );
+}
+
+
+void NETLIST_EXPORTER_GENERIC::formatXmlComponents( OUTPUTFORMATTER* aOut, int aNestLevel,
+                                                    unsigned aCtl )
+{
+    bool empty = true;
+
+    aOut->Print( 0, "\n" );
+    aOut->Print( aNestLevel, "<components" );
+
+    visitComponents( aCtl, [&]( XNODE* aComponent )
+                           {
+                               std::unique_ptr<XNODE> xcomp( aComponent );
+
+                               if( empty )
+                                   aOut->Print( 0, ">" );
+
+                               empty = false;
+                               formatXmlNode( aOut, aNestLevel + 1, xcomp.get() );
+                           } );
+
+    if( empty )
+    {
+        aOut->Print( 0, "/>" );
+    }
+    else
+    {
+        aOut->Print( 0, "\n" );
+        aOut->Print( aNestLevel, "</components>" );
+    }
+}
+
+
+void NETLIST_EXPORTER_GENERIC::visitComponents( unsigned aCtl,
+                                                const std::function<void( XNODE* )>& aVisitor )
+{
     m_ReferencesAlreadyFound.Clear();
     m_LibParts.clear();
 
@@ -279,8 +480,7 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeComponents( unsigned aCtl )
             // under XSL processing systems which do sequential searching within
             // an element.
 
-            XNODE* xcomp;  // current component being constructed
-            xcomps->AddChild( xcomp = node( "comp" ) );
+            XNODE* xcomp = node( "comp" );  // current component being constructed
 
             xcomp->AddAttribute( "ref", comp->GetRef( &sheet ) );
             addComponentFields( xcomp, comp, &sheetList[ii] );
@@ -335,10 +535,10 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeComponents( unsigned aCtl )
             xsheetpath->AddAttribute( "names", sheet.PathHumanReadable() );
             xsheetpath->AddAttribute( "tstamps", sheet.PathAsString() );
             xcomp->AddChild( node( "tstamp", comp->m_Uuid.AsString() ) );
+
+            aVisitor( xcomp );
         }
     }
-
-    return xcomps;
 }
 
 
@@ -573,11 +773,8 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeLibParts()
 XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets()
 {
     XNODE*      xnets = node( "nets" );      // auto_ptr if exceptions ever get used.
+    XNODE*      lastNet = nullptr;
     wxString    netCodeTxt;
-    wxString    netName;
-    wxString    ref;
-
-    XNODE*      xnet = 0;
 
     /*  output:
         <net code="123" name="/cfcard.sch/WAIT#">
@@ -586,96 +783,210 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets()
         </net>
     */
 
+    visitNets( [&]( int aCode, const wxString& aNetName, const std::vector<NET_NODE>& aNodes )
+               {
+                   XNODE* xnet = node( "net" );
+                   XNODE* lastNode = nullptr;
+
+                   netCodeTxt.Printf( "%d", aCode );
+                   xnet->AddAttribute( "code", netCodeTxt );
+                   xnet->AddAttribute( "name", aNetName );
+
+                   for( const NET_NODE& netNode : aNodes )
+                   {
+                       XNODE* xnode = node( "node" );
+
+                       xnode->AddAttribute( "ref", *netNode.m_Ref );
+                       xnode->AddAttribute( "pin", netNode.m_PinNumber );
+
+                       if( !netNode.m_PinFunction.IsEmpty() )
+                           xnode->AddAttribute( "pinfunction", netNode.m_PinFunction );
+
+                       // AddChild() walks all the children: insert after the last one instead
+                       xnet->InsertChildAfter( xnode, lastNode );
+                       lastNode = xnode;
+                   }
+
+                   xnets->InsertChildAfter( xnet, lastNet );
+                   lastNet = xnet;
+               } );
+
+    return xnets;
+}
+
+
+void NETLIST_EXPORTER_GENERIC::formatListOfNets( OUTPUTFORMATTER* aOut, int aNestLevel )
+{
+    // Same output as XNODE::Format() for the node made by makeListOfNets()
+    aOut->Print( aNestLevel, "(nets" );
+
+    visitNets( [&]( int aCode, const wxString& aNetName, const std::vector<NET_NODE>& aNodes )
+               {
+                   aOut->Print( 0, "\n" );
+                   aOut->Print( aNestLevel + 1, "(net (code %s) (name %s)",
+                                aOut->Quotes( std::to_string( aCode ) ).c_str(),
+                                aOut->Quotew( aNetName ).c_str() );
+
+                   for( const NET_NODE& netNode : aNodes )
+                   {
+                       aOut->Print( 0, "\n" );
+                       aOut->Print( aNestLevel + 2, "(node (ref %s) (pin %s)",
+                                    aOut->Quotew( *netNode.m_Ref ).c_str(),
+                                    aOut->Quotew( netNode.m_PinNumber ).c_str() );
+
+                       if( !netNode.m_PinFunction.IsEmpty() )
+                       {
+                           aOut->Print( 0, " (pinfunction %s)",
+                                        aOut->Quotew( netNode.m_PinFunction ).c_str() );
+                       }
+
+                       aOut->Print( 0, ")" );
+                   }
+
+                   aOut->Print( 0, ")" );
+               } );
+
+    aOut->Print( 0, ")" );
+}
+
+
+void NETLIST_EXPORTER_GENERIC::formatXmlListOfNets( OUTPUTFORMATTER* aOut, int aNestLevel )
+{
+    bool empty = true;
+
+    aOut->Print( 0, "\n" );
+    aOut->Print( aNestLevel, "<nets" );
+
+    // The nets always have nodes
+    visitNets( [&]( int aCode, const wxString& aNetName, const std::vector<NET_NODE>& aNodes )
+               {
+                   if( empty )
+                       aOut->Print( 0, ">" );
+
+                   empty = false;
+
+                   aOut->Print( 0, "\n" );
+                   aOut->Print( aNestLevel + 1, "<net code=\"%d\" name=\"%s\">", aCode,
+                                xmlEscape( aNetName, true ).c_str() );
+
+                   for( const NET_NODE& netNode : aNodes )
+                   {
+                       aOut->Print( 0, "\n" );
+                       aOut->Print( aNestLevel + 2, "<node ref=\"%s\" pin=\"%s\"",
+                                    xmlEscape( *netNode.m_Ref, true ).c_str(),
+                                    xmlEscape( netNode.m_PinNumber, true ).c_str() );
+
+                       if( !netNode.m_PinFunction.IsEmpty() )
+                       {
+                           aOut->Print( 0, " pinfunction=\"%s\"",
+                                        xmlEscape( netNode.m_PinFunction, true ).c_str() );
+                       }
+
+                       aOut->Print( 0, "/>" );
+                   }
+
+                   aOut->Print( 0, "\n" );
+                   aOut->Print( aNestLevel + 1, "</net>" );
+               } );
+
+    if( empty )
+    {
+        aOut->Print( 0, "/>" );
+    }
+    else
+    {
+        aOut->Print( 0, "\n" );
+        aOut->Print( aNestLevel, "</nets>" );
+    }
+}
+
+
+void NETLIST_EXPORTER_GENERIC::visitNets( const NET_VISITOR& aVisitor )
+{
+    // The references of the component instances, by component and sheet path hash (the
+    // sheet path identity, see SCH_SHEET_PATH::operator==).  The map nodes are stable, so
+    // the pins share the reference strings.
+    std::map<std::pair<const SCH_COMPONENT*, size_t>, wxString> references;
+
+    auto getRef = [&references]( SCH_COMPONENT* aComp, const SCH_SHEET_PATH& aSheet )
+                  {
+                      auto key = std::make_pair( (const SCH_COMPONENT*) aComp,
+                                                 aSheet.GetCurrentHash() );
+                      auto it = references.find( key );
+
+                      if( it == references.end() )
+                          it = references.emplace( key, aComp->GetRef( &aSheet ) ).first;
+
+                      return &it->second;
+                  };
+
+    std::vector<NET_NODE> sorted_items;
+
     int code = 0;
 
     for( const auto& it : m_schematic->ConnectionGraph()->GetNetMap() )
     {
-        bool     added     = false;
-        wxString net_name  = it.first.first;
-        auto     subgraphs = it.second;
+        const wxString& net_name  = it.first.first;
 
         // Code starts at 1
         code++;
 
-        XNODE* xnode;
-        std::vector<std::pair<SCH_PIN*, SCH_SHEET_PATH>> sorted_items;
+        sorted_items.clear();
 
-        for( CONNECTION_SUBGRAPH* subgraph : subgraphs )
+        for( CONNECTION_SUBGRAPH* subgraph : it.second )
         {
             const SCH_SHEET_PATH& sheet = subgraph->m_sheet;
 
             for( SCH_ITEM* item : subgraph->m_items )
             {
-                if( item->Type() == SCH_PIN_T )
-                    sorted_items.emplace_back( static_cast<SCH_PIN*>( item ), sheet );
+                if( item->Type() != SCH_PIN_T )
+                    continue;
+
+                SCH_PIN*        pin = static_cast<SCH_PIN*>( item );
+                const wxString* ref = getRef( pin->GetParentComponent(), sheet );
+
+                // Skip power symbols and virtual components
+                if( ( *ref )[0] == wxChar( '#' ) )
+                    continue;
+
+                sorted_items.push_back( { pin, ref, pin->GetNumber(), wxEmptyString } );
             }
         }
 
         // Netlist ordering: Net name, then ref des, then pin name
         std::sort( sorted_items.begin(), sorted_items.end(),
-                   []( const std::pair<SCH_PIN*, SCH_SHEET_PATH>& a,
-                       const std::pair<SCH_PIN*, SCH_SHEET_PATH>& b )
+                   []( const NET_NODE& a, const NET_NODE& b )
                    {
-                       wxString ref_a = a.first->GetParentComponent()->GetRef( &a.second );
-                       wxString ref_b = b.first->GetParentComponent()->GetRef( &b.second );
-
-                       if( ref_a == ref_b )
-                           return a.first->GetNumber() < b.first->GetNumber();
+                       if( a.m_Ref == b.m_Ref || *a.m_Ref == *b.m_Ref )
+                           return a.m_PinNumber < b.m_PinNumber;
 
-                       return ref_a < ref_b;
+                       return *a.m_Ref < *b.m_Ref;
                    } );
 
         // Some duplicates can exist, for example on multi-unit parts with duplicated
         // pins across units.  If the user connects the pins on each unit, they will
         // appear on separate subgraphs.  Remove those here:
         sorted_items.erase( std::unique( sorted_items.begin(), sorted_items.end(),
-                []( const std::pair<SCH_PIN*, SCH_SHEET_PATH>& a,
-                    const std::pair<SCH_PIN*, SCH_SHEET_PATH>& b )
+                []( const NET_NODE& a, const NET_NODE& b )
                 {
-                    wxString ref_a = a.first->GetParentComponent()->GetRef( &a.second );
-                    wxString ref_b = b.first->GetParentComponent()->GetRef( &b.second );
-
-                    return ref_a == ref_b && a.first->GetNumber() == b.first->GetNumber();
+                    return ( a.m_Ref == b.m_Ref || *a.m_Ref == *b.m_Ref )
+                            && a.m_PinNumber == b.m_PinNumber;
                 } ),
                 sorted_items.end() );
 
-        for( const std::pair<SCH_PIN*, SCH_SHEET_PATH>& pair : sorted_items )
-        {
-            SCH_PIN* pin = pair.first;
-            SCH_SHEET_PATH sheet = pair.second;
-
-            wxString refText = pin->GetParentComponent()->GetRef( &sheet );
-            wxString pinText = pin->GetNumber();
-
-            // Skip power symbols and virtual components
-            if( refText[0] == wxChar( '#' ) )
-                continue;
-
-            if( !added )
-            {
-                xnets->AddChild( xnet = node( "net" ) );
-                netCodeTxt.Printf( "%d", code );
-                xnet->AddAttribute( "code", netCodeTxt );
-                xnet->AddAttribute( "name", net_name );
-
-                added = true;
-            }
-
-            xnet->AddChild( xnode = node( "node" ) );
-            xnode->AddAttribute( "ref", refText );
-            xnode->AddAttribute( "pin", pinText );
+        if( sorted_items.empty() )
+            continue;
 
-            wxString pinName;
-
-            if( pin->GetName() != "~" ) //  ~ is a char used to code empty strings in libs.
-                pinName = pin->GetName();
+        for( NET_NODE& netNode : sorted_items )
+        {
+            wxString pinName = netNode.m_Pin->GetName();
 
-            if( !pinName.IsEmpty() )
-                xnode->AddAttribute( "pinfunction", pinName );
+            if( pinName != "~" ) //  ~ is a char used to code empty strings in libs.
+                netNode.m_PinFunction = pinName;
         }
-    }
 
-    return xnets;
+        aVisitor( code, net_name, sorted_items );
+    }
 }
 
 
@@ -26,6 +26,8 @@
 #ifndef NETLIST_EXPORT_GENERIC_H
 #define NETLIST_EXPORT_GENERIC_H
 
+#include <functional>
+
 #include <netlist_exporter.h>
 
 #include <project.h>
@@ -34,6 +36,8 @@
 #include <sch_edit_frame.h>
 
 class CONNECTION_GRAPH;
+class OUTPUTFORMATTER;
+class SCH_PIN;
 class SYMBOL_LIB_TABLE;
 
 #define GENERIC_INTERMEDIATE_NETLIST_EXT wxT( "xml" )
@@ -86,6 +90,19 @@ public:
 #define GNL_ALL     ( GNL_LIBRARIES | GNL_COMPONENTS | GNL_PARTS | GNL_HEADER | GNL_NETS )
 
 protected:
+    /// A pin of a net
+    struct NET_NODE
+    {
+        SCH_PIN*        m_Pin;
+        const wxString* m_Ref;          ///< shared by all the pins of a component instance
+        wxString        m_PinNumber;
+        wxString        m_PinFunction;  ///< empty if the pin has no name
+    };
+
+    /// The visitor of the nets: the net code, the net name and the pins of the net
+    typedef std::function<void( int, const wxString&, const std::vector<NET_NODE>& )>
+            NET_VISITOR;
+
    /**
      * A convenience function that creates a new XNODE with an optional textual child.
      * It also provides some insulation from a possible change in XML library.
@@ -110,6 +127,32 @@ protected:
      */
     XNODE* makeComponents( unsigned aCtl );
 
+    /**
+     * Makes the nodes of the schematic components one by one, in the order of
+     * makeComponents(), and passes them to \a aVisitor, which takes their ownership.
+     */
+    void visitComponents( unsigned aCtl, const std::function<void( XNODE* )>& aVisitor );
+
+    /**
+     * Writes the components to \a aOut in the s-expression format of the XNODE made by
+     * makeComponents(), without building the sub-tree of all the components.
+     */
+    void formatComponents( OUTPUTFORMATTER* aOut, int aNestLevel, unsigned aCtl );
+
+    /**
+     * Writes the XML netlist to \a aOut, with the same bytes as wxXmlDocument::Save() for
+     * the tree made by makeRoot(), but each section is written as soon as it is made, and
+     * the components and the nets are written one by one.
+     * @param aCtl - a bitset or-ed together from GNL_ENUM values
+     */
+    void formatXml( OUTPUTFORMATTER* aOut, unsigned aCtl );
+
+    /**
+     * Writes the components to \a aOut in XML, as wxXmlDocument::Save() writes the XNODE
+     * made by makeComponents() at the depth \a aNestLevel.
+     */
+    void formatXmlComponents( OUTPUTFORMATTER* aOut, int aNestLevel, unsigned aCtl );
+
     /**
      * Fills out a project "design" header into an XML node.
      * @return XNODE* - the design header
@@ -128,6 +171,25 @@ protected:
      */
     XNODE* makeListOfNets();
 
+    /**
+     * Calls \a aVisitor for each net having pins of real components (not power symbols
+     * nor virtual components), with the pins sorted by reference and pin number.
+     * The reference of a component instance is computed once for all its pins.
+     */
+    void visitNets( const NET_VISITOR& aVisitor );
+
+    /**
+     * Writes the list of nets to \a aOut in the s-expression format of the XNODE made by
+     * makeListOfNets(), without building it.
+     */
+    void formatListOfNets( OUTPUTFORMATTER* aOut, int aNestLevel );
+
+    /**
+     * Writes the list of nets to \a aOut in XML, as wxXmlDocument::Save() writes the XNODE
+     * made by makeListOfNets() at the depth \a aNestLevel.
+     */
+    void formatXmlListOfNets( OUTPUTFORMATTER* aOut, int aNestLevel );
+
     /**
      * Fill out an XML node with a list of used libraries and returns it.
      * Must have called makeGenericLibParts() before this function.
@@ -53,7 +53,40 @@ bool NETLIST_EXPORTER_KICAD::WriteNetlist( const wxString& aOutFileName, unsigne
 
 void NETLIST_EXPORTER_KICAD::Format( OUTPUTFORMATTER* aOut, int aCtl )
 {
-    std::unique_ptr<XNODE> xroot( makeRoot( aCtl ) );
+    // Same output as XNODE::Format() for the tree made by makeRoot(), but each section is
+    // written as soon as it is made, and the components and the nets are written one by
+    // one: the tree of the whole netlist is never built.
+    auto formatSection = [aOut]( XNODE* aSection )
+                         {
+                             std::unique_ptr<XNODE> xsection( aSection );
 
-    xroot->Format( aOut, 0 );
+                             aOut->Print( 0, "\n" );
+                             xsection->Format( aOut, 1 );
+                         };
+
+    aOut->Print( 0, "(export (version %s)", aOut->Quotew( "D" ).c_str() );
+
+    if( aCtl & GNL_HEADER )
+        formatSection( makeDesignHeader() );
+
+    if( aCtl & GNL_COMPONENTS )
+    {
+        aOut->Print( 0, "\n" );
+        formatComponents( aOut, 1, aCtl );
+    }
+
+    if( aCtl & GNL_PARTS )
+        formatSection( makeLibParts() );
+
+    if( aCtl & GNL_LIBRARIES )
+        // must follow makeLibParts()
+        formatSection( makeLibraries() );
+
+    if( aCtl & GNL_NETS )
+    {
+        aOut->Print( 0, "\n" );
+        formatListOfNets( aOut, 1 );
+    }
+
+    aOut->Print( 0, ")" );
 }
@@ -33,6 +33,9 @@ void CADSTAR_SCH_ARCHIVE_PARSER::Parse()
 
     XNODE* cNode = fileRootNode->GetChildren();
 
+    // The sections after the header are independent: they are parsed concurrently
+    std::vector<std::function<void()>> sectionParsers;
+
     if( !cNode )
         THROW_MISSING_NODE_IO_ERROR( wxT( "HEADER" ), wxT( "CADSTARSCM" ) );
 
@@ -55,11 +58,11 @@ void CADSTAR_SCH_ARCHIVE_PARSER::Parse()
         }
         else if( cNode->GetName() == wxT( "ASSIGNMENTS" ) )
         {
-            Assignments.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Assignments.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "LIBRARY" ) )
         {
-            Library.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Library.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "DEFAULTS" ) )
         {
@@ -69,15 +72,15 @@ void CADSTAR_SCH_ARCHIVE_PARSER::Parse()
         }
         else if( cNode->GetName() == wxT( "PARTS" ) )
         {
-            Parts.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Parts.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "SHEETS" ) )
         {
-            Sheets.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Sheets.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "SCHEMATIC" ) )
         {
-            Schematic.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Schematic.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "DISPLAY" ) )
         {
@@ -91,6 +94,8 @@ void CADSTAR_SCH_ARCHIVE_PARSER::Parse()
         }
     }
 
+    ParseConcurrently( sectionParsers );
+
     delete fileRootNode;
 }
 
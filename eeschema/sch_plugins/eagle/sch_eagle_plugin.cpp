@@ -35,6 +35,7 @@
 #include <class_libentry.h>
 #include <class_library.h>
 #include <plugins/eagle/eagle_parser.h>
+#include <plugins/eagle/eagle_xml_reader.h>
 #include <gr_text.h>
 #include <lib_arc.h>
 #include <lib_circle.h>
@@ -397,13 +398,10 @@ SCH_SHEET* SCH_EAGLE_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
     wxASSERT( !aFileName || aSchematic != nullptr );
     LOCALE_IO toggle; // toggles on, then off, the C locale.
 
-    // Load the document
-    wxXmlDocument xmlDocument;
-
     m_filename  = aFileName;
     m_schematic = aSchematic;
 
-    if( !xmlDocument.Load( m_filename.GetFullPath() ) )
+    if( !wxFileName::FileExists( m_filename.GetFullPath() ) )
         THROW_IO_ERROR(
                 wxString::Format( _( "Unable to read file \"%s\"" ), m_filename.GetFullPath() ) );
 
@@ -463,18 +461,8 @@ SCH_SHEET* SCH_EAGLE_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
         m_schematic->Prj().SchSymbolLibTable();
     }
 
-    // Retrieve the root as current node
-    wxXmlNode* currentNode = xmlDocument.GetRoot();
-
-    // If the attribute is found, store the Eagle version;
-    // otherwise, store the dummy "0.0" version.
-    m_version = currentNode->GetAttribute( "version", "0.0" );
-
-    // Map all children into a readable dictionary
-    NODE_MAP children = MapChildren( currentNode );
-
     // Load drawing
-    loadDrawing( children["drawing"] );
+    loadDrawing( m_filename.GetFullPath() );
 
     m_pi->SaveLibrary( getLibFileName().GetFullPath() );
 
@@ -482,153 +470,149 @@ SCH_SHEET* SCH_EAGLE_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
 }
 
 
-void SCH_EAGLE_PLUGIN::loadDrawing( wxXmlNode* aDrawingNode )
+void SCH_EAGLE_PLUGIN::loadDrawing( const wxString& aFileName )
 {
-    // Map all children into a readable dictionary
-    NODE_MAP drawingChildren = MapChildren( aDrawingNode );
-
-    // Board nodes should not appear in .sch files
-    // wxXmlNode* board = drawingChildren["board"]
+    // The file is parsed as a stream, twice.  The first pass reads the attributes needed before
+    // the sheets can be loaded: the sheet count, and the sheets of each net.  The second pass
+    // converts each part, library and sheet as soon as it has been read, so the XML document
+    // is never held in full.
+    int partCount    = 0;
+    int libraryCount = 0;
+    int sheetCount   = 0;
 
-    // wxXmlNode* grid = drawingChildren["grid"]
-
-    auto layers = drawingChildren["layers"];
-
-    if( layers )
-        loadLayerDefs( layers );
-
-    // wxXmlNode* library = drawingChildren["library"]
-
-    // wxXmlNode* settings = drawingChildren["settings"]
-
-    // Load schematic
-    auto schematic = drawingChildren["schematic"];
-
-    if( schematic )
-        loadSchematic( schematic );
-}
+    {
+        EAGLE_XML_READER reader;
 
+        reader.AddHandler( "eagle",
+                [&]( std::unique_ptr<wxXmlNode> aEagle )
+                {
+                    // If the attribute is found, store the Eagle version;
+                    // otherwise, store the dummy "0.0" version.
+                    m_version = aEagle->GetAttribute( "version", "0.0" );
+                },
+                false );
+
+        reader.AddHandler( "eagle/drawing/schematic/parts/part",
+                [&]( std::unique_ptr<wxXmlNode> )
+                {
+                    partCount++;
+                },
+                false );
 
-void SCH_EAGLE_PLUGIN::countNets( wxXmlNode* aSchematicNode )
-{
-    // Map all children into a readable dictionary
-    NODE_MAP schematicChildren = MapChildren( aSchematicNode );
-    // Loop through all the sheets
+        reader.AddHandler( "eagle/drawing/schematic/libraries/library",
+                [&]( std::unique_ptr<wxXmlNode> )
+                {
+                    libraryCount++;
+                },
+                false );
 
-    wxXmlNode* sheetNode = getChildrenNodes( schematicChildren, "sheets" );
+        reader.AddHandler( "eagle/drawing/schematic/sheets/sheet",
+                [&]( std::unique_ptr<wxXmlNode> )
+                {
+                    sheetCount++;
+                },
+                false );
 
-    while( sheetNode )
-    {
-        NODE_MAP sheetChildren = MapChildren( sheetNode );
-        // Loop through all nets
+        // find all nets and count how many sheets they appear on.
+        // local labels will be used for nets found only on that sheet.
         // From the DTD: "Net is an electrical connection in a schematic."
-        wxXmlNode* netNode = getChildrenNodes( sheetChildren, "nets" );
-
-        while( netNode )
-        {
-            wxString netName = netNode->GetAttribute( "name" );
-
-            if( m_netCounts.count( netName ) )
-                m_netCounts[netName] = m_netCounts[netName] + 1;
-            else
-                m_netCounts[netName] = 1;
-
-            // Get next net
-            netNode = netNode->GetNext();
-        }
+        reader.AddHandler( "eagle/drawing/schematic/sheets/sheet/nets/net",
+                [&]( std::unique_ptr<wxXmlNode> aNet )
+                {
+                    m_netCounts[aNet->GetAttribute( "name" )]++;
+                },
+                false );
 
-        sheetNode = sheetNode->GetNext();
+        reader.Read( aFileName );
     }
-}
 
+    EAGLE_XML_READER reader;
 
-void SCH_EAGLE_PLUGIN::loadSchematic( wxXmlNode* aSchematicNode )
-{
-    // Map all children into a readable dictionary
-    NODE_MAP schematicChildren = MapChildren( aSchematicNode );
-    auto     partNode          = getChildrenNodes( schematicChildren, "parts" );
-    auto     libraryNode       = getChildrenNodes( schematicChildren, "libraries" );
-    auto     sheetNode         = getChildrenNodes( schematicChildren, "sheets" );
+    reader.AddHandler( "eagle/drawing/layers",
+            [&]( std::unique_ptr<wxXmlNode> aLayers )
+            {
+                loadLayerDefs( aLayers.get() );
+            } );
 
-    if( !partNode || !libraryNode || !sheetNode )
-        return;
+    bool loadSchematic = partCount > 0 && libraryCount > 0 && sheetCount > 0;
+    int  sheetIndex    = 0;
 
-    while( partNode )
+    if( loadSchematic )
     {
-        std::unique_ptr<EPART> epart( new EPART( partNode ) );
+        reader.AddHandler( "eagle/drawing/schematic/libraries/library",
+                [&]( std::unique_ptr<wxXmlNode> aLibrary )
+                {
+                    // Read the library name
+                    wxString libName = aLibrary->GetAttribute( "name" );
 
-        // N.B. Eagle parts are case-insensitive in matching but we keep the display case
-        m_partlist[epart->name.Upper()] = std::move( epart );
-        partNode                        = partNode->GetNext();
-    }
+                    EAGLE_LIBRARY* elib = &m_eagleLibs[libName];
+                    elib->name          = libName;
 
-    // Loop through all the libraries
-    while( libraryNode )
-    {
-        // Read the library name
-        wxString libName = libraryNode->GetAttribute( "name" );
+                    loadLibrary( aLibrary.get(), elib );
 
-        EAGLE_LIBRARY* elib = &m_eagleLibs[libName];
-        elib->name          = libName;
+                    // The symbol nodes belong to the library node deleted on return
+                    elib->SymbolNodes.clear();
+                } );
+
+        reader.AddHandler( "eagle/drawing/schematic/parts/part",
+                [&]( std::unique_ptr<wxXmlNode> aPart )
+                {
+                    std::unique_ptr<EPART> epart( new EPART( aPart.get() ) );
 
-        loadLibrary( libraryNode, &m_eagleLibs[libName] );
+                    // N.B. Eagle parts are case-insensitive in matching but we keep the
+                    // display case
+                    m_partlist[epart->name.Upper()] = std::move( epart );
+                } );
 
-        libraryNode = libraryNode->GetNext();
+        reader.AddHandler( "eagle/drawing/schematic/sheets/sheet",
+                [&]( std::unique_ptr<wxXmlNode> aSheet )
+                {
+                    // All the libraries are read before the sheets
+                    if( sheetIndex == 0 )
+                        m_pi->SaveLibrary( getLibFileName().GetFullPath() );
+
+                    loadSchematicSheet( aSheet.get(), sheetIndex++, sheetCount );
+                } );
     }
 
-    m_pi->SaveLibrary( getLibFileName().GetFullPath() );
+    reader.Read( aFileName );
 
-    // find all nets and count how many sheets they appear on.
-    // local labels will be used for nets found only on that sheet.
-    countNets( aSchematicNode );
+    if( loadSchematic )
+        loadMissingUnits();
+}
 
-    // Loop through all the sheets
-    int sheet_count = countChildren( sheetNode->GetParent(), "sheet" );
 
+void SCH_EAGLE_PLUGIN::loadSchematicSheet( wxXmlNode* aSheetNode, int aSheetIndex,
+                                           int aSheetCount )
+{
     // If eagle schematic has multiple sheets then create corresponding subsheets on the root sheet
-    if( sheet_count > 1 )
+    if( aSheetCount > 1 )
     {
-        int x, y, i;
-        i = 1;
-        x = 1;
-        y = 1;
-
-        while( sheetNode )
-        {
-            wxPoint                    pos = wxPoint( x * Mils2iu( 1000 ), y * Mils2iu( 1000 ) );
-            std::unique_ptr<SCH_SHEET> sheet( new SCH_SHEET( m_rootSheet, pos ) );
-            SCH_SCREEN*                screen = new SCH_SCREEN( m_schematic );
+        // The subsheets are placed in rows of 5
+        int x = 1 + 2 * ( aSheetIndex % 5 );
+        int y = 1 + 2 * ( aSheetIndex / 5 );
 
-            sheet->SetScreen( screen );
-            sheet->GetScreen()->SetFileName( sheet->GetFileName() );
+        wxPoint                    pos = wxPoint( x * Mils2iu( 1000 ), y * Mils2iu( 1000 ) );
+        std::unique_ptr<SCH_SHEET> sheet( new SCH_SHEET( m_rootSheet, pos ) );
+        SCH_SCREEN*                screen = new SCH_SCREEN( m_schematic );
 
-            m_currentSheet = sheet.get();
-            loadSheet( sheetNode, i );
-            m_rootSheet->GetScreen()->Append( sheet.release() );
+        sheet->SetScreen( screen );
+        sheet->GetScreen()->SetFileName( sheet->GetFileName() );
 
-            sheetNode = sheetNode->GetNext();
-            x += 2;
-
-            if( x > 10 ) // start next row
-            {
-                x = 1;
-                y += 2;
-            }
-
-            i++;
-        }
+        m_currentSheet = sheet.get();
+        loadSheet( aSheetNode, aSheetIndex + 1 );
+        m_rootSheet->GetScreen()->Append( sheet.release() );
     }
     else
     {
-        while( sheetNode )
-        {
-            m_currentSheet = m_rootSheet;
-            loadSheet( sheetNode, 0 );
-            sheetNode = sheetNode->GetNext();
-        }
+        m_currentSheet = m_rootSheet;
+        loadSheet( aSheetNode, 0 );
     }
+}
 
 
+void SCH_EAGLE_PLUGIN::loadMissingUnits()
+{
     // Handle the missing component units that need to be instantiated
     // to create the missing implicit connections
 
@@ -129,13 +129,16 @@ public:
     //void SymbolLibOptions( PROPERTIES* aListToAppendTo ) const override;
 
 private:
-    void loadDrawing( wxXmlNode* aDrawingNode );
+    /// Reads the schematic file as a stream, and loads each section as soon as it has been read
+    void loadDrawing( const wxString& aFileName );
     void loadLayerDefs( wxXmlNode* aLayers );
-    void loadSchematic( wxXmlNode* aSchematicNode );
+    void loadSchematicSheet( wxXmlNode* aSheetNode, int aSheetIndex, int aSheetCount );
     void loadSheet( wxXmlNode* aSheetNode, int sheetcount );
     void loadInstance( wxXmlNode* aInstanceNode );
     EAGLE_LIBRARY* loadLibrary( wxXmlNode* aLibraryNode, EAGLE_LIBRARY* aEagleLib );
-    void countNets( wxXmlNode* aSchematicNode );
+
+    /// Instantiates the component units which are not placed, for their implicit connections
+    void loadMissingUnits();
 
     /// Moves any labels on the wire to the new end point of the wire.
     void moveLabels( SCH_ITEM* aWire, const wxPoint& aNewEndPoint );
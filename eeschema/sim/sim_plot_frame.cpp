@@ -767,8 +767,8 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
                 std::vector<double> sub_y( data_y.begin() + offset,
                                            data_y.begin() + offset + inner );
 
-                if( aPanel->AddTrace( name, inner,
-                                      sub_x.data(), sub_y.data(), aDescriptor.GetType() ) )
+                if( aPanel->AddTrace( name, std::move( sub_x ), std::move( sub_y ),
+                                      aDescriptor.GetType() ) )
                 {
                     m_plots[aPanel].m_traces.insert( std::make_pair( name, aDescriptor ) );
                 }
@@ -781,8 +781,9 @@ bool SIM_PLOT_FRAME::updatePlot( const TRACE_DESC& aDescriptor, SIM_PLOT_PANEL*
         }
     }
 
-    if( aPanel->AddTrace( aDescriptor.GetTitle(), size,
-                data_x.data(), data_y.data(), aDescriptor.GetType() ) )
+    // The vectors are moved to the trace: it holds the only copy of the samples
+    if( aPanel->AddTrace( aDescriptor.GetTitle(), std::move( data_x ), std::move( data_y ),
+                aDescriptor.GetType() ) )
     {
         m_plots[aPanel].m_traces.insert( std::make_pair( aDescriptor.GetTitle(), aDescriptor ) );
     }
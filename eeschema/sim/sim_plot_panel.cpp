@@ -263,6 +263,130 @@ public:
 };
 
 
+void TRACE::buildLevels()
+{
+    m_levels.clear();
+    m_drawXs = &m_xs;
+    m_drawYs = &m_ys;
+    m_drawBegin = 0;
+    m_drawEnd = m_xs.size();
+
+    // The levels are found by X, which must be increasing (a DC sweep can decrease)
+    if( m_xs.size() < LOD_MIN_SAMPLES || !std::is_sorted( m_xs.begin(), m_xs.end() ) )
+        return;
+
+    const std::vector<double>* srcXs = &m_xs;
+    const std::vector<double>* srcYs = &m_ys;
+
+    while( srcXs->size() >= LOD_MIN_SAMPLES / 2 )
+    {
+        size_t count = srcXs->size();
+        LEVEL  level;
+
+        level.m_xs.reserve( ( count + 3 ) / 4 * 2 );
+        level.m_ys.reserve( ( count + 3 ) / 4 * 2 );
+
+        for( size_t first = 0; first < count; first += 4 )
+        {
+            size_t last = std::min( first + 4, count );
+            size_t minIdx = first;
+            size_t maxIdx = first;
+
+            for( size_t ii = first + 1; ii < last; ++ii )
+            {
+                if( ( *srcYs )[ii] < ( *srcYs )[minIdx] )
+                    minIdx = ii;
+
+                if( ( *srcYs )[ii] > ( *srcYs )[maxIdx] )
+                    maxIdx = ii;
+            }
+
+            // Keep the order of X; a flat bucket gives the same point twice
+            level.m_xs.push_back( ( *srcXs )[std::min( minIdx, maxIdx )] );
+            level.m_ys.push_back( ( *srcYs )[std::min( minIdx, maxIdx )] );
+            level.m_xs.push_back( ( *srcXs )[std::max( minIdx, maxIdx )] );
+            level.m_ys.push_back( ( *srcYs )[std::max( minIdx, maxIdx )] );
+        }
+
+        m_levels.push_back( std::move( level ) );
+        srcXs = &m_levels.back().m_xs;
+        srcYs = &m_levels.back().m_ys;
+    }
+}
+
+
+void TRACE::Plot( wxDC& aDC, mpWindow& aWindow )
+{
+    if( !m_levels.empty() )
+    {
+        wxCoord leftPx  = aWindow.GetMarginLeft();
+        wxCoord rightPx = aWindow.GetScrX() - aWindow.GetMarginRight();
+        double  minX = s2x( aWindow.p2x( leftPx ) );
+        double  maxX = s2x( aWindow.p2x( rightPx ) );
+
+        if( minX > maxX )
+            std::swap( minX, maxX );
+
+        // The visible samples, and one more on both sides for the lines going out of view
+        size_t first = std::lower_bound( m_xs.begin(), m_xs.end(), minX ) - m_xs.begin();
+        size_t last = std::upper_bound( m_xs.begin(), m_xs.end(), maxX ) - m_xs.begin();
+
+        first = first > 0 ? first - 1 : 0;
+        last = std::min( last + 1, m_xs.size() );
+
+        // Use the coarsest level with at least two buckets per pixel: each column of pixels
+        // still gets the minimum and the maximum of its samples
+        size_t pixels = std::max( rightPx - leftPx, 1 );
+        int    lod = -1;
+
+        while( lod + 1 < (int) m_levels.size()
+                && ( last - first ) / ( (size_t) 4 << ( lod + 1 ) ) >= 2 * pixels )
+        {
+            lod++;
+        }
+
+        if( lod < 0 )
+        {
+            m_drawBegin = first;
+            m_drawEnd = last;
+        }
+        else
+        {
+            size_t bucket = (size_t) 4 << lod;
+
+            m_drawXs = &m_levels[lod].m_xs;
+            m_drawYs = &m_levels[lod].m_ys;
+            m_drawBegin = first / bucket * 2;
+            m_drawEnd = std::min( ( last + bucket - 1 ) / bucket * 2, m_drawXs->size() );
+        }
+    }
+
+    mpFXYVector::Plot( aDC, aWindow );
+
+    m_drawXs = &m_xs;
+    m_drawYs = &m_ys;
+    m_drawBegin = 0;
+    m_drawEnd = m_xs.size();
+}
+
+
+void TRACE::Rewind()
+{
+    m_index = m_drawBegin;
+}
+
+
+bool TRACE::GetNextXY( double& aX, double& aY )
+{
+    if( m_index >= m_drawEnd )
+        return false;
+
+    aX = ( *m_drawXs )[m_index];
+    aY = ( *m_drawYs )[m_index++];
+    return true;
+}
+
+
 void CURSOR::Plot( wxDC& aDC, mpWindow& aWindow )
 {
     if( !m_window )
@@ -481,8 +605,8 @@ void SIM_PLOT_PANEL::UpdateTraceStyle( TRACE* trace )
 }
 
 
-bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
-        const double* aX, const double* aY, SIM_PLOT_TYPE aFlags )
+bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, std::vector<double> aX,
+        std::vector<double> aY, SIM_PLOT_TYPE aFlags )
 {
     TRACE* trace = NULL;
 
@@ -531,23 +655,21 @@ bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
         trace = prev->second;
     }
 
-    std::vector<double> tmp( aY, aY + aPoints );
-
     if( GetType() == ST_AC )
     {
         if( aFlags & SPT_AC_PHASE )
         {
-            for( int i = 0; i < aPoints; i++ )
-                tmp[i] = tmp[i] * 180.0 / M_PI;                 // convert to degrees
+            for( double& y : aY )
+                y = y * 180.0 / M_PI;                   // convert to degrees
         }
         else
         {
-            for( int i = 0; i < aPoints; i++ )
-                tmp[i] = 20 * log( tmp[i] ) / log( 10.0 );      // convert to dB
+            for( double& y : aY )
+                y = 20 * log( y ) / log( 10.0 );        // convert to dB
         }
     }
 
-    trace->SetData( std::vector<double>( aX, aX + aPoints ), tmp );
+    trace->SetData( std::move( aX ), std::move( aY ) );
 
     if( ( aFlags & SPT_AC_PHASE ) || ( aFlags & SPT_CURRENT ) )
         trace->SetScale( m_axis_x, m_axis_y2 );
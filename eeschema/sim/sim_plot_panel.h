@@ -93,7 +93,8 @@ class TRACE : public mpFXYVector
 {
 public:
     TRACE( const wxString& aName ) :
-        mpFXYVector( aName ), m_cursor( nullptr ), m_flags( 0 )
+        mpFXYVector( aName ), m_cursor( nullptr ), m_flags( 0 ),
+        m_drawXs( &m_xs ), m_drawYs( &m_ys ), m_drawBegin( 0 ), m_drawEnd( 0 )
     {
         SetContinuity( true );
         SetDrawOutsideMargins( false );
@@ -111,8 +112,29 @@ public:
             m_cursor->Update();
 
         mpFXYVector::SetData( aX, aY );
+        buildLevels();
     }
 
+    ///> @copydoc SetData()
+    void SetData( std::vector<double>&& aX, std::vector<double>&& aY ) override
+    {
+        if( m_cursor )
+            m_cursor->Update();
+
+        mpFXYVector::SetData( std::move( aX ), std::move( aY ) );
+        buildLevels();
+    }
+
+    /**
+     * @brief Draws the trace with the level of detail matching the zoom: about as many
+     * points as pixels are drawn, whatever the number of samples.
+     */
+    void Plot( wxDC& aDC, mpWindow& aWindow ) override;
+
+    /**
+     * @brief Returns the samples of the trace, at full resolution (as needed by the cursors
+     * and the exports).
+     */
     const std::vector<double>& GetDataX() const
     {
         return m_xs;
@@ -159,9 +181,41 @@ public:
     }
 
 protected:
+    ///> Enumerates the points selected by Plot(), or all the samples out of Plot()
+    void Rewind() override;
+    bool GetNextXY( double& aX, double& aY ) override;
+
+    /**
+     * @brief Builds the levels of detail of the samples, a min/max pyramid.
+     *
+     * The samples of the first level are grouped by buckets of 4, and each bucket is
+     * replaced by its samples of minimal and maximal Y, in the order of X.  Each next level
+     * merges the buckets of the previous one by pairs, until the level is small enough to
+     * be drawn as it is.  The peaks of the trace are kept at all levels, and the pyramid
+     * has about as many points as the samples.
+     */
+    void buildLevels();
+
+    ///> One level of detail: two points for each bucket of samples
+    struct LEVEL
+    {
+        std::vector<double> m_xs;
+        std::vector<double> m_ys;
+    };
+
     CURSOR* m_cursor;
     int m_flags;
     wxColour m_traceColour;
+
+    std::vector<LEVEL> m_levels;        ///< Level n has buckets of 4 << n samples
+
+    const std::vector<double>* m_drawXs;    ///< The points enumerated by GetNextXY()
+    const std::vector<double>* m_drawYs;
+    size_t m_drawBegin;
+    size_t m_drawEnd;
+
+    ///> Traces with fewer samples are always drawn at full resolution
+    static constexpr size_t LOD_MIN_SAMPLES = 8192;
 };
 
 
@@ -195,8 +249,12 @@ public:
         return m_axis_y2 ? m_axis_y2->GetName() : "";
     }
 
-    bool AddTrace( const wxString& aName, int aPoints,
-            const double* aX, const double* aY, SIM_PLOT_TYPE aFlags );
+    /**
+     * @brief Adds a trace, or replaces the data of the trace aName.  The data vectors are
+     * taken by the trace, without copy.
+     */
+    bool AddTrace( const wxString& aName, std::vector<double> aX, std::vector<double> aY,
+            SIM_PLOT_TYPE aFlags );
 
     bool DeleteTrace( const wxString& aName );
 
@@ -75,6 +75,19 @@ enum APERTURE_DEF_HOLETYPE {
 struct APERTURE_MACRO;
 
 
+/**
+ * GERBER_FLASH
+ * is a flash of a D_CODE stored in the flash array of the D_CODE (see D_CODE::m_Flashes):
+ * its position, in XY gerber axis, and the index of the parameters it is drawn with in the
+ * list of its image (see GERBER_FILE_IMAGE::GetFlashParams()).
+ */
+struct GERBER_FLASH
+{
+    wxPoint  m_Pos;
+    unsigned m_ParamsIdx;
+};
+
+
 /**
  * D_CODE
  * holds a gerber DCODE (also called Aperture) definition.
@@ -108,6 +121,9 @@ public:
                                              * complex shapes which are converted to polygon
                                              * (shapes with hole )
                                              */
+    std::vector<GERBER_FLASH> m_Flashes;    ///< the flashes of the flash arrays of this D_CODE
+                                            ///< (see GERBER_DRAW_ITEM::IsFlashArray()), in
+                                            ///< file order
 
 public:
     D_CODE( int num_dcode );
@@ -94,6 +94,9 @@ void GERBVIEW_FRAME::OnSelectHighlightChoice( wxCommandEvent& event )
 {
     auto settings = static_cast<KIGFX::GERBVIEW_PAINTER*>( GetCanvas()->GetView()->GetPainter() )->GetSettings();
 
+    // Redraw the items losing their highlight
+    UpdateHighlightedItems();
+
     switch( event.GetId() )
     {
     case ID_GBR_AUX_TOOLBAR_PCB_CMP_CHOICE:
@@ -110,7 +113,7 @@ void GERBVIEW_FRAME::OnSelectHighlightChoice( wxCommandEvent& event )
 
     }
 
-    GetCanvas()->GetView()->UpdateAllItems( KIGFX::COLOR );
+    UpdateHighlightedItems();
     GetCanvas()->Refresh();
 }
 
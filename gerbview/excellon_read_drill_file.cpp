@@ -76,6 +76,7 @@
 #include <cmath>
 
 #include <html_messagebox.h>
+#include <richio.h>
 
 // Default format for dimensions: they are the default values, not the actual values
 // number of digits in mantissa:
@@ -242,15 +243,8 @@ static EXCELLON_CMD excellon_G_CmdList[] =
 bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
 {
     wxString msg;
-    int layerId = GetActiveLayer();      // current layer used in GerbView
-    GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
-    auto gerber_layer = images->GetGbrImage( layerId );
-
-    // OIf the active layer contains old gerber or nc drill data, remove it
-    if( gerber_layer )
-        Erase_Current_DrawLayer( false );
 
-    EXCELLON_IMAGE* drill_layer = new EXCELLON_IMAGE( layerId );
+    EXCELLON_IMAGE* drill_layer = new EXCELLON_IMAGE( GetActiveLayer() );
 
     // Read the Excellon drill file:
     bool success = drill_layer->LoadFile( aFullFileName );
@@ -263,30 +257,47 @@ bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
         return false;
     }
 
-    layerId = images->AddGbrImage( drill_layer, layerId );
+    return attachExcellonImage( drill_layer );
+}
+
+
+bool GERBVIEW_FRAME::attachExcellonImage( EXCELLON_IMAGE* aDrillLayer )
+{
+    int layerId = GetActiveLayer();      // current layer used in GerbView
+    GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
+    auto gerber_layer = images->GetGbrImage( layerId );
+
+    // OIf the active layer contains old gerber or nc drill data, remove it
+    if( gerber_layer )
+        Erase_Current_DrawLayer( false );
+
+    layerId = images->AddGbrImage( aDrillLayer, layerId );
 
     if( layerId < 0 )
     {
-        delete drill_layer;
+        delete aDrillLayer;
         ShowInfoBarError( _( "No empty layers to load file into." ) );
         return false;
     }
 
+    // The image may have been read before its layer was known
+    aDrillLayer->m_GraphicLayer = layerId;
+
     // Display errors list
-    if( drill_layer->GetMessages().size() > 0 )
+    if( aDrillLayer->GetMessages().size() > 0 )
     {
         HTML_MESSAGE_BOX dlg( this, _( "Error reading EXCELLON drill file" ) );
-        dlg.ListSet( drill_layer->GetMessages() );
+        dlg.ListSet( aDrillLayer->GetMessages() );
         dlg.ShowModal();
     }
 
     if( GetCanvas() )
     {
-        for( GERBER_DRAW_ITEM* item : drill_layer->GetItems() )
+        for( GERBER_DRAW_ITEM* item : aDrillLayer->GetItems() )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
 
-    return success;
+    return true;
 }
 
 /*
@@ -308,25 +319,28 @@ bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName )
     ResetDefaultValues();
     ClearMessageList();
 
-    m_Current_File = wxFopen( aFullFileName, "rt" );
+    std::unique_ptr<MAPPED_FILE_LINE_READER> excellonReader;
 
-    if( m_Current_File == NULL )
+    try
+    {
+        excellonReader = std::make_unique<MAPPED_FILE_LINE_READER>( aFullFileName );
+    }
+    catch( const IO_ERROR& )
+    {
         return false;
+    }
 
     wxString msg;
     m_FileName = aFullFileName;
 
     LOCALE_IO toggleIo;
 
-    // FILE_LINE_READER will close the file.
-    FILE_LINE_READER excellonReader( m_Current_File, m_FileName );
-
     while( true )
     {
-        if( excellonReader.ReadLine() == 0 )
+        if( excellonReader->ReadLine() == 0 )
             break;
 
-        char* line = excellonReader.Line();
+        char* line = excellonReader->Line();
         char* text = StrPurge( line );
 
         if( *text == ';' || *text == 0 )       // comment: skip line or empty malformed line
@@ -381,12 +395,15 @@ bool EXCELLON_IMAGE::LoadFile( const wxString & aFullFileName )
     X2_ATTRIBUTE dummy;
     char* text = (char*)file_attribute;
     int dummyline = 0;
-    dummy.ParseAttribCmd( NULL, NULL, 0, text, dummyline );
+    dummy.ParseAttribCmd( NULL, text, dummyline );
     delete m_FileFunction;
     m_FileFunction = new X2_ATTRIBUTE_FILEFUNCTION( dummy );
 
     m_InUse = true;
 
+    // Build the indexes used to find the items at a given position or with a given attribute
+    BuildItemsIndex();
+
     return true;
 }
 
@@ -105,7 +105,20 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLa
             continue;
 
         for(  GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
-            export_non_copper_item( gerb_item, pcb_layer_number );
+        {
+            if( !gerb_item->IsFlashArray() )
+            {
+                export_non_copper_item( gerb_item, pcb_layer_number );
+                continue;
+            }
+
+            // The flashes of a flash array are exported one by one
+            for( unsigned ii = 0; ii < gerb_item->GetFlashCount(); ii++ )
+            {
+                GERBER_DRAW_ITEM flash = gerb_item->GetFlash( ii );
+                export_non_copper_item( &flash, pcb_layer_number );
+            }
+        }
     }
 
     // Copper layers
@@ -122,7 +135,19 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( LAYER_NUM* aLayerLookUpTable, int aCopperLa
             continue;
 
         for( GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
-            export_copper_item( gerb_item, pcb_layer_number );
+        {
+            if( !gerb_item->IsFlashArray() )
+            {
+                export_copper_item( gerb_item, pcb_layer_number );
+                continue;
+            }
+
+            for( unsigned ii = 0; ii < gerb_item->GetFlashCount(); ii++ )
+            {
+                GERBER_DRAW_ITEM flash = gerb_item->GetFlash( ii );
+                export_copper_item( &flash, pcb_layer_number );
+            }
+        }
     }
 
     // Now write out the holes we collected earlier as vias
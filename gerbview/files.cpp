@@ -35,6 +35,10 @@
 #include <wildcards_and_files_ext.h>
 #include <widgets/progress_reporter.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 // HTML Messages used more than one time:
 #define MSG_NO_MORE_LAYER _( "<b>No more available layers</b> in Gerbview to load files" )
 #define MSG_NOT_LOADED    _( "\n<b>Not loaded:</b> <i>%s</i>" )
@@ -210,8 +214,9 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString& aPath,
     wxString msg;
     WX_STRING_REPORTER reporter( &msg );
 
-    // Create progress dialog (only used if more than 1 file to load
-    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    // The files to read, in the order they are given
+    std::vector<wxString> fileList;
+    std::vector<bool>     isDrillFile;
 
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
@@ -232,72 +237,160 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString& aPath,
             continue;
         }
 
-        m_lastFileName = filename.GetFullPath();
+        bool isDrill = aFileType && (*aFileType)[ii] == 1;
+
+        if( !isDrill && filename.GetExt() == GerberJobFileExtension.c_str() )
+        {
+            //We cannot read a gerber job file as a gerber plot file: skip it
+            wxString txt;
+            txt.Printf(
+                _( "<b>A gerber job file cannot be loaded as a plot file</b> <i>%s</i>" ),
+                filename.GetFullName() );
+            success = false;
+            reporter.Report( txt, RPT_SEVERITY_ERROR );
+            continue;
+        }
+
+        fileList.push_back( filename.GetFullPath() );
+        isDrillFile.push_back( isDrill );
+    }
+
+    // Create progress dialog (only used if more than 1 file to load
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+
+    if( fileList.size() > 1 )
+    {
+        progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
+                        _( "Loading Gerber files..." ), 1, false );
+        progress->SetMaxProgress( fileList.size() );
+        progress->Report( wxString::Format( _( "Loading %zu files" ), fileList.size() ) );
+    }
+
+    // Parse the files.  The readers only work on their own image, so the files are read
+    // in parallel; the images are attached to the GerbView layers afterwards, in order.
+    std::vector<std::unique_ptr<GERBER_FILE_IMAGE>> images( fileList.size() );
+    std::atomic<size_t> nextFile( 0 );
+
+    auto read_lambda =
+            [&]( PROGRESS_REPORTER* aReporter ) -> size_t
+            {
+                size_t num = 0;
+
+                for( size_t i = nextFile++; i < fileList.size(); i = nextFile++ )
+                {
+                    // The layer is set when the image is attached
+                    if( isDrillFile[i] )
+                    {
+                        std::unique_ptr<EXCELLON_IMAGE> drill( new EXCELLON_IMAGE( 0 ) );
+
+                        if( drill->LoadFile( fileList[i] ) )
+                            images[i] = std::move( drill );
+                    }
+                    else
+                    {
+                        std::unique_ptr<GERBER_FILE_IMAGE> gerber( new GERBER_FILE_IMAGE( 0 ) );
+
+                        if( gerber->LoadGerberFile( fileList[i] ) )
+                            images[i] = std::move( gerber );
+                    }
+
+                    if( aReporter )
+                        aReporter->AdvanceProgress();
+
+                    num++;
+                }
+
+                return num;
+            };
+
+    {
+        // The readers switch to the C locale to read numbers.  Do it once here: the nested
+        // LOCALE_IO instances created by the readers then leave the locale alone.
+        LOCALE_IO toggleIo;
 
-        if( !progress && ( aFilenameList.GetCount() > 1 ) )
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                        fileList.size() );
+
+        if( parallelThreadCount <= 1 )
         {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
-                            _( "Loading Gerber files..." ), 1, false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( wxString::Format( _("Loading %u/%zu %s" ), ii+1,
-                                            aFilenameList.GetCount(), m_lastFileName ) );
+            read_lambda( progress.get() );
         }
-        else if( progress )
+        else
         {
-            progress->Report( wxString::Format( _("Loading %u/%zu %s" ), ii+1,
-                                            aFilenameList.GetCount(), m_lastFileName ) );
-            progress->KeepRefreshing();
+            std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, read_lambda, progress.get() );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            {
+                // Here we balance returns with a 100ms timeout to allow UI updating
+                std::future_status status;
+                do
+                {
+                    if( progress )
+                        progress->KeepRefreshing();
+
+                    status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+                } while( status != std::future_status::ready );
+            }
         }
+    }
+
+    for( size_t ii = 0; ii < fileList.size(); ii++ )
+    {
+        m_lastFileName = fileList[ii];
 
         SetActiveLayer( layer, false );
 
         visibility[ layer ] = true;
 
-        if( aFileType && (*aFileType)[ii] == 1 )
+        if( !images[ii] )
         {
-            LoadExcellonFiles( filename.GetFullPath() );
-            layer = GetActiveLayer();   // Loading NC drill file changes the active layer
+            wxString txt;
+            txt.Printf( _( "<b>File could not be read:</b> <i>%s</i>" ), m_lastFileName );
+            success = false;
+            reporter.Report( txt, RPT_SEVERITY_ERROR );
+            continue;
+        }
+
+        if( isDrillFile[ii] )
+        {
+            auto drill = static_cast<EXCELLON_IMAGE*>( images[ii].release() );
+
+            if( !attachExcellonImage( drill ) )
+                continue;
+
+            // Update the list of recent drill files.
+            UpdateFileHistory( m_lastFileName, &m_drillFileHistory );
         }
         else
         {
-            if( filename.GetExt() == GerberJobFileExtension.c_str() )
-            {
-                //We cannot read a gerber job file as a gerber plot file: skip it
-                wxString txt;
-                txt.Printf(
-                    _( "<b>A gerber job file cannot be loaded as a plot file</b> <i>%s</i>" ),
-                    filename.GetFullName() );
-                success = false;
-                reporter.Report( txt, RPT_SEVERITY_ERROR );
-            }
-            else if( Read_GERBER_File( filename.GetFullPath() ) )
-            {
-                UpdateFileHistory( m_lastFileName );
+            if( !attachGerberImage( images[ii].release() ) )
+                continue;
 
-                layer = getNextAvailableLayer( layer );
+            UpdateFileHistory( m_lastFileName );
+        }
 
-                if( layer == NO_AVAILABLE_LAYERS && ii < aFilenameList.GetCount()-1 )
-                {
-                    success = false;
-                    reporter.Report( MSG_NO_MORE_LAYER, RPT_SEVERITY_ERROR );
+        layer = getNextAvailableLayer( layer );
 
-                    // Report the name of not loaded files:
-                    ii += 1;
-                    while( ii < aFilenameList.GetCount() )
-                    {
-                        filename = aFilenameList[ii++];
-                        wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
-                        reporter.Report( txt, RPT_SEVERITY_ERROR );
-                    }
-                    break;
-                }
+        if( layer == NO_AVAILABLE_LAYERS && ii < fileList.size() - 1 )
+        {
+            success = false;
+            reporter.Report( MSG_NO_MORE_LAYER, RPT_SEVERITY_ERROR );
 
-                SetActiveLayer( layer, false );
+            // Report the name of not loaded files:
+            for( ii += 1; ii < fileList.size(); ii++ )
+            {
+                filename = fileList[ii];
+                wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
+                reporter.Report( txt, RPT_SEVERITY_ERROR );
             }
+
+            break;
         }
 
-        if( progress )
-            progress->AdvanceProgress();
+        SetActiveLayer( layer, false );
     }
 
     if( !success )
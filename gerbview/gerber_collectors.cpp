@@ -18,6 +18,9 @@
  */
 
 #include "gerber_collectors.h"
+#include <gbr_layout.h>
+#include <gerber_file_image.h>
+#include <gerber_file_image_list.h>
 
 const KICAD_T GERBER_COLLECTOR::AllItems[] = {
     GERBER_LAYOUT_T,
@@ -60,7 +63,45 @@ void GERBER_COLLECTOR::Collect( EDA_ITEM* aItem, const KICAD_T aScanList[],
     // the Inspect() function.
     SetRefPos( aRefPos );
 
-    aItem->Visit( m_inspector, NULL, m_scanTypes );
+    bool scanLayout = false;
+    bool scanDrawItems = false;
+
+    for( const KICAD_T* p = aScanList; *p != EOT; ++p )
+    {
+        scanLayout |= *p == GERBER_LAYOUT_T;
+        scanDrawItems |= *p == GERBER_DRAW_ITEM_T;
+    }
+
+    if( aItem->Type() == GERBER_LAYOUT_T && scanLayout && scanDrawItems )
+    {
+        // Same scan order as GBR_LAYOUT::Visit(), but only the items of each image whose
+        // hit test area contains aRefPos are inspected
+        GERBER_FILE_IMAGE_LIST* images = static_cast<GBR_LAYOUT*>( aItem )->GetImagesList();
+        SEARCH_RESULT result = SEARCH_RESULT::CONTINUE;
+
+        for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+        {
+            GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+
+            if( gerber == NULL )    // Graphic layer not yet used
+                continue;
+
+            for( GERBER_DRAW_ITEM* item : gerber->QueryItems( aRefPos ) )
+            {
+                result = Inspect( item, NULL );
+
+                if( result == SEARCH_RESULT::QUIT )
+                    break;
+            }
+
+            if( result == SEARCH_RESULT::QUIT )
+                break;
+        }
+    }
+    else
+    {
+        aItem->Visit( m_inspector, NULL, m_scanTypes );
+    }
 
     // record the length of the primary list before concatenating on to it.
     m_PrimaryLength = m_list.size();
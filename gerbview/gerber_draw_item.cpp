@@ -34,6 +34,10 @@
 #include <geometry/shape_arc.h>
 #include <math/util.h>      // for KiROUND
 
+// In case the item has a very tiny width defined, allow it to be selected
+static const int MIN_HIT_TEST_RADIUS = Millimeter2iu( 0.01 );
+
+
 GERBER_DRAW_ITEM::GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberImageFile ) :
     EDA_ITEM( (EDA_ITEM*)NULL, GERBER_DRAW_ITEM_T )
 {
@@ -48,6 +52,9 @@ GERBER_DRAW_ITEM::GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberImageFile ) :
     m_mirrorB       = false;
     m_drawScale.x   = m_drawScale.y = 1.0;
     m_lyrRotation   = 0;
+    m_bboxCached    = false;
+    m_firstFlash    = 0;
+    m_flashCount    = 0;
 
     if( m_GerberImageFile )
         SetLayerParameters();
@@ -59,16 +66,32 @@ GERBER_DRAW_ITEM::~GERBER_DRAW_ITEM()
 }
 
 
-void GERBER_DRAW_ITEM::SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes )
+void GERBER_DRAW_ITEM::SetNetAttributes(
+        const std::shared_ptr<const GBR_NETLIST_METADATA>& aNetAttributes )
 {
     m_netAttributes = aNetAttributes;
+}
+
+
+const GBR_NETLIST_METADATA& GERBER_DRAW_ITEM::GetNetAttributes() const
+{
+    static const GBR_NETLIST_METADATA noNetAttributes;
+
+    return m_netAttributes ? *m_netAttributes : noNetAttributes;
+}
+
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) ||
-        ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
-        m_GerberImageFile->m_ComponentsList.insert( std::make_pair( m_netAttributes.m_Cmpref, 0 ) );
+void GERBER_DRAW_ITEM::SetAperFunction( const std::shared_ptr<const wxString>& aAperFunction )
+{
+    m_aperFunction = aAperFunction;
+}
+
+
+const wxString& GERBER_DRAW_ITEM::GetAperFunction() const
+{
+    static const wxString noAperFunction;
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
-        m_GerberImageFile->m_NetnamesList.insert( std::make_pair( m_netAttributes.m_Netname, 0 ) );
+    return m_aperFunction ? *m_aperFunction : noAperFunction;
 }
 
 
@@ -219,6 +242,101 @@ void GERBER_DRAW_ITEM::SetLayerParameters()
 }
 
 
+bool GERBER_FLASH_PARAMS::operator==( const GERBER_FLASH_PARAMS& aOther ) const
+{
+    return m_UnitsMetric == aOther.m_UnitsMetric
+            && m_LayerNegative == aOther.m_LayerNegative
+            && m_SwapAxis == aOther.m_SwapAxis
+            && m_MirrorA == aOther.m_MirrorA
+            && m_MirrorB == aOther.m_MirrorB
+            && m_DrawScale == aOther.m_DrawScale
+            && m_LayerOffset == aOther.m_LayerOffset
+            && m_LyrRotation == aOther.m_LyrRotation;
+}
+
+
+GERBER_FLASH_PARAMS GERBER_DRAW_ITEM::GetFlashParams() const
+{
+    GERBER_FLASH_PARAMS params;
+
+    params.m_UnitsMetric   = m_UnitsMetric;
+    params.m_LayerNegative = m_LayerNegative;
+    params.m_SwapAxis      = m_swapAxis;
+    params.m_MirrorA       = m_mirrorA;
+    params.m_MirrorB       = m_mirrorB;
+    params.m_DrawScale     = m_drawScale;
+    params.m_LayerOffset   = m_layerOffset;
+    params.m_LyrRotation   = m_lyrRotation;
+
+    return params;
+}
+
+
+void GERBER_DRAW_ITEM::SetFlashParams( const GERBER_FLASH_PARAMS& aParams )
+{
+    m_UnitsMetric   = aParams.m_UnitsMetric;
+    m_LayerNegative = aParams.m_LayerNegative;
+    m_swapAxis      = aParams.m_SwapAxis;
+    m_mirrorA       = aParams.m_MirrorA;
+    m_mirrorB       = aParams.m_MirrorB;
+    m_drawScale     = aParams.m_DrawScale;
+    m_layerOffset   = aParams.m_LayerOffset;
+    m_lyrRotation   = aParams.m_LyrRotation;
+    m_bboxCached    = false;
+}
+
+
+void GERBER_DRAW_ITEM::InitFlashArray( unsigned aFirstFlash )
+{
+    wxASSERT( m_Flashed && GetDcodeDescr() );
+
+    m_firstFlash = aFirstFlash;
+    m_flashCount = 1;
+}
+
+
+bool GERBER_DRAW_ITEM::CanAppendFlash( const GERBER_DRAW_ITEM& aFlash ) const
+{
+    D_CODE* code = GetDcodeDescr();
+
+    // The flashes of an array are consecutive in the flashes of the D_CODE
+    if( !IsFlashArray() || !code || m_firstFlash + m_flashCount != code->m_Flashes.size() )
+        return false;
+
+    return aFlash.m_DCode == m_DCode
+            && aFlash.m_Shape == m_Shape
+            && aFlash.m_Size == m_Size
+            && aFlash.m_LayerNegative == m_LayerNegative
+            && aFlash.m_netAttributes == m_netAttributes;
+}
+
+
+void GERBER_DRAW_ITEM::AppendFlash()
+{
+    wxASSERT( IsFlashArray() && m_firstFlash + m_flashCount < GetDcodeDescr()->m_Flashes.size() );
+
+    m_flashCount++;
+    m_bboxCached = false;
+}
+
+
+GERBER_DRAW_ITEM GERBER_DRAW_ITEM::GetFlash( unsigned aIdx ) const
+{
+    wxASSERT( aIdx < m_flashCount );
+
+    const GERBER_FLASH& flash = GetDcodeDescr()->m_Flashes[m_firstFlash + aIdx];
+    GERBER_DRAW_ITEM    item( *this );
+
+    item.m_firstFlash = 0;
+    item.m_flashCount = 0;
+    item.m_Start      = flash.m_Pos;
+    item.m_End        = flash.m_Pos;
+    item.SetFlashParams( m_GerberImageFile->GetFlashParams( flash.m_ParamsIdx ) );
+
+    return item;
+}
+
+
 wxString GERBER_DRAW_ITEM::ShowGBRShape() const
 {
     switch( m_Shape )
@@ -278,6 +396,19 @@ D_CODE* GERBER_DRAW_ITEM::GetDcodeDescr() const
 
 const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
 {
+    if( m_bboxCached )
+        return m_bbox;
+
+    if( IsFlashArray() )
+    {
+        EDA_RECT bbox = GetFlash( 0 ).GetBoundingBox();
+
+        for( unsigned ii = 1; ii < m_flashCount; ii++ )
+            bbox.Merge( GetFlash( ii ).GetBoundingBox() );
+
+        return bbox;
+    }
+
     // return a rectangle which is (pos,dim) in nature.  therefore the +1
     EDA_RECT bbox( m_Start, wxSize( 1, 1 ) );
     D_CODE* code = GetDcodeDescr();
@@ -417,6 +548,50 @@ const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
 }
 
 
+void GERBER_DRAW_ITEM::CacheBoundingBox()
+{
+    m_bboxCached = false;
+
+    // A segment drawn with a rectangular aperture is drawn as a polygon built on demand.
+    // Build it now: its bounding box is the bounding box of the polygon.
+    if( m_Shape == GBR_SEGMENT && m_Polygon.OutlineCount() == 0 )
+    {
+        D_CODE* code = GetDcodeDescr();
+
+        if( code && code->m_Shape == APT_RECT )
+            ConvertSegmentToPolygon();
+    }
+
+    m_bbox = GetBoundingBox();
+    m_bboxCached = true;
+}
+
+
+const EDA_RECT GERBER_DRAW_ITEM::GetHitTestBoundingBox() const
+{
+    // Must match the tolerances used in HitTest( const wxPoint& ):
+    // thin items are found up to MIN_HIT_TEST_RADIUS and arcs up to their full width
+    // from their centerline.  The tolerances are given in XY gerber axis.
+    int margin = std::max( MIN_HIT_TEST_RADIUS, m_Shape == GBR_ARC ? m_Size.x : 0 );
+    double scale = std::max( std::abs( m_drawScale.x ), std::abs( m_drawScale.y ) );
+
+    // The flashes of a flash array can have different scales
+    for( unsigned ii = 0; ii < m_flashCount; ii++ )
+    {
+        const GERBER_FLASH&        flash = GetDcodeDescr()->m_Flashes[m_firstFlash + ii];
+        const GERBER_FLASH_PARAMS& params = m_GerberImageFile->GetFlashParams( flash.m_ParamsIdx );
+
+        scale = std::max( scale, std::abs( params.m_DrawScale.x ) );
+        scale = std::max( scale, std::abs( params.m_DrawScale.y ) );
+    }
+
+    EDA_RECT bbox = GetBoundingBox();
+    bbox.Inflate( KiROUND( margin * std::max( scale, 1.0 ) ) + 1 );
+
+    return bbox;
+}
+
+
 void GERBER_DRAW_ITEM::MoveAB( const wxPoint& aMoveVector )
 {
     wxPoint xymove = GetXYPosition( aMoveVector );
@@ -426,6 +601,8 @@ void GERBER_DRAW_ITEM::MoveAB( const wxPoint& aMoveVector )
     m_ArcCentre += xymove;
 
     m_Polygon.Move( VECTOR2I( xymove ) );
+    moveFlashes( xymove );
+    m_bboxCached = false;
 }
 
 
@@ -436,6 +613,15 @@ void GERBER_DRAW_ITEM::MoveXY( const wxPoint& aMoveVector )
     m_ArcCentre += aMoveVector;
 
     m_Polygon.Move( VECTOR2I( aMoveVector ) );
+    moveFlashes( aMoveVector );
+    m_bboxCached = false;
+}
+
+
+void GERBER_DRAW_ITEM::moveFlashes( const wxPoint& aMoveVector )
+{
+    for( unsigned ii = 0; ii < m_flashCount; ii++ )
+        GetDcodeDescr()->m_Flashes[m_firstFlash + ii].m_Pos += aMoveVector;
 }
 
 
@@ -461,6 +647,14 @@ void GERBER_DRAW_ITEM::Print( wxDC* aDC, const wxPoint& aOffset, GBR_DISPLAY_OPT
     if( d_codeDescr == NULL )
         d_codeDescr = &dummyD_CODE;
 
+    if( IsFlashArray() )
+    {
+        for( unsigned ii = 0; ii < m_flashCount; ii++ )
+            GetFlash( ii ).Print( aDC, aOffset, aOptions );
+
+        return;
+    }
+
     COLOR4D color = m_GerberImageFile->GetPositiveDrawColor();
 
     /* isDark is true if flash is positive and should use a drawing
@@ -573,6 +767,7 @@ void GERBER_DRAW_ITEM::Print( wxDC* aDC, const wxPoint& aOffset, GBR_DISPLAY_OPT
 
 void GERBER_DRAW_ITEM::ConvertSegmentToPolygon()
 {
+    m_bboxCached = false;
     m_Polygon.RemoveAllContours();
     m_Polygon.NewOutline();
 
@@ -663,15 +858,21 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_
     msg = ShowGBRShape();
     aList.emplace_back( _( "Type" ), msg, DARKCYAN );
 
+    if( IsFlashArray() )
+    {
+        msg.Printf( wxT( "%u" ), m_flashCount );
+        aList.emplace_back( _( "Flashes" ), msg, DARKCYAN );
+    }
+
     // Display D_Code value with its attributes for items using a DCode:
     if( m_Shape == GBR_POLYGON )    // Has no DCode, but can have an attribute
     {
         msg = _( "Attribute" );
 
-        if( m_AperFunction.IsEmpty() )
+        if( GetAperFunction().IsEmpty() )
             text = _( "No attribute" );
         else
-            text = m_AperFunction;
+            text = GetAperFunction();
     }
     else
     {
@@ -712,41 +913,43 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_
     aList.emplace_back( _( "AB axis" ), msg, DARKRED );
 
     // Display net info, if exists
-    if( m_netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
+    const GBR_NETLIST_METADATA& netAttributes = GetNetAttributes();
+
+    if( netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
         return;
 
     // Build full net info:
     wxString net_msg;
     wxString cmp_pad_msg;
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
     {
         net_msg = _( "Net:" );
         net_msg << " ";
 
-        if( m_netAttributes.m_Netname.IsEmpty() )
+        if( netAttributes.m_Netname.IsEmpty() )
             net_msg << "<no net>";
         else
-            net_msg << UnescapeString( m_netAttributes.m_Netname );
+            net_msg << UnescapeString( netAttributes.m_Netname );
     }
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
     {
-        if( m_netAttributes.m_PadPinFunction.IsEmpty() )
+        if( netAttributes.m_PadPinFunction.IsEmpty() )
             cmp_pad_msg.Printf( _( "Cmp: %s  Pad: %s" ),
-                                m_netAttributes.m_Cmpref,
-                                m_netAttributes.m_Padname.GetValue() );
+                                netAttributes.m_Cmpref,
+                                netAttributes.m_Padname.GetValue() );
         else
             cmp_pad_msg.Printf( _( "Cmp: %s  Pad: %s  Fct %s" ),
-                                m_netAttributes.m_Cmpref,
-                                m_netAttributes.m_Padname.GetValue(),
-                                m_netAttributes.m_PadPinFunction.GetValue() );
+                                netAttributes.m_Cmpref,
+                                netAttributes.m_Padname.GetValue(),
+                                netAttributes.m_PadPinFunction.GetValue() );
     }
 
-    else if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
+    else if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
     {
         cmp_pad_msg = _( "Cmp:" );
-        cmp_pad_msg << " " << m_netAttributes.m_Cmpref;
+        cmp_pad_msg << " " << netAttributes.m_Cmpref;
     }
 
     aList.emplace_back( net_msg, cmp_pad_msg, DARKCYAN );
@@ -783,8 +986,16 @@ BITMAP_DEF GERBER_DRAW_ITEM::GetMenuImage() const
 
 bool GERBER_DRAW_ITEM::HitTest( const wxPoint& aRefPos, int aAccuracy ) const
 {
-    // In case the item has a very tiny width defined, allow it to be selected
-    const int MIN_HIT_TEST_RADIUS = Millimeter2iu( 0.01 );
+    if( IsFlashArray() )
+    {
+        for( unsigned ii = 0; ii < m_flashCount; ii++ )
+        {
+            if( GetFlash( ii ).HitTest( aRefPos, aAccuracy ) )
+                return true;
+        }
+
+        return false;
+    }
 
     // calculate aRefPos in XY gerber axis:
     wxPoint ref_pos = GetXYPosition( aRefPos );
@@ -896,6 +1107,17 @@ bool GERBER_DRAW_ITEM::HitTest( const wxPoint& aRefPos, int aAccuracy ) const
 
 bool GERBER_DRAW_ITEM::HitTest( const EDA_RECT& aRefArea, bool aContained, int aAccuracy ) const
 {
+    if( IsFlashArray() )
+    {
+        for( unsigned ii = 0; ii < m_flashCount; ii++ )
+        {
+            if( GetFlash( ii ).HitTest( aRefArea, aContained, aAccuracy ) )
+                return true;
+        }
+
+        return false;
+    }
+
     wxPoint pos = GetABPosition( m_Start );
 
     if( aRefArea.Contains( pos ) )
@@ -1004,6 +1226,16 @@ wxString GERBER_DRAW_ITEM::GetSelectMenuText( EDA_UNITS aUnits ) const
 
     layerName = GERBER_FILE_IMAGE_LIST::GetImagesList().GetDisplayName( GetLayer(), true );
 
+    if( m_flashCount > 1 )
+    {
+        return wxString::Format( _( "%u flashes %s (D%d) on layer %d: %s" ),
+                                 m_flashCount,
+                                 ShowGBRShape(),
+                                 m_DCode,
+                                 GetLayer() + 1,
+                                 layerName );
+    }
+
     return wxString::Format( _( "%s (D%d) on layer %d: %s" ),
                              ShowGBRShape(),
                              m_DCode,
@@ -36,6 +36,8 @@
 #include <dcode.h>
 #include <geometry/shape_poly_set.h>
 
+#include <memory>
+
 class GERBER_FILE_IMAGE;
 class GBR_LAYOUT;
 class D_CODE;
@@ -63,6 +65,27 @@ enum Gbr_Basic_Shapes {
     GBR_LAST                // last value for this list
 };
 
+/**
+ * GERBER_FLASH_PARAMS
+ * holds the parameters a flash is drawn with which can change inside a gerber image: the
+ * layer polarity and the layer parameters set by GERBER_DRAW_ITEM::SetLayerParameters().
+ * The flashes of a flash array store only the index of their parameters, which are stored
+ * once by the image for all the consecutive flashes having the same ones.
+ */
+struct GERBER_FLASH_PARAMS
+{
+    bool        m_UnitsMetric;
+    bool        m_LayerNegative;
+    bool        m_SwapAxis;
+    bool        m_MirrorA;
+    bool        m_MirrorB;
+    wxRealPoint m_DrawScale;
+    wxPoint     m_LayerOffset;
+    double      m_LyrRotation;
+
+    bool operator==( const GERBER_FLASH_PARAMS& aOther ) const;
+};
+
 /***/
 
 class GERBER_DRAW_ITEM : public EDA_ITEM
@@ -90,10 +113,6 @@ public:
                                             // values 0 to 9 can be used for special purposes
                                             // Regions (polygons) doo not use DCode,
                                             // so it is set to 0
-    wxString           m_AperFunction;      // the aperture function set by a %TA.AperFunction, xxx
-                                            // (stores thre xxx value).
-                                            // used for regions that do not have a attached DCode, but
-                                            // have a TA.AperFunction defined
     GERBER_FILE_IMAGE* m_GerberImageFile;   /* Gerber file image source of this item
                                              * Note: some params stored in this class are common
                                              * to the whole gerber file (i.e) the whole graphic
@@ -113,16 +132,34 @@ private:
     wxRealPoint m_drawScale;                // A and B scaling factor
     wxPoint     m_layerOffset;              // Offset for A and B axis, from OF parameter
     double      m_lyrRotation;              // Fine rotation, from OR parameter, in degrees
-    GBR_NETLIST_METADATA m_netAttributes;   ///< the string given by a %TO attribute set in aperture
+    EDA_RECT    m_bbox;                     // The bounding box, if m_bboxCached
+    bool        m_bboxCached;               // true if m_bbox was set by CacheBoundingBox()
+    std::shared_ptr<const GBR_NETLIST_METADATA> m_netAttributes;
+                                            ///< the string given by a %TO attribute set in aperture
                                             ///< (dcode). Stored in each item, because %TO is
-                                            ///< a dynamic object attribute
+                                            ///< a dynamic object attribute, but shared by all the
+                                            ///< items having the same attributes (usually a lot of
+                                            ///< flashes), see GERBER_FILE_IMAGE::GetSharedNetAttributes()
+    std::shared_ptr<const wxString> m_aperFunction;
+                                            ///< the aperture function set by a %TA.AperFunction, xxx
+                                            ///< (stores the xxx value). Used for regions that do not
+                                            ///< have a attached DCode, but have a TA.AperFunction
+                                            ///< defined. Shared by the items created while it does
+                                            ///< not change, see GERBER_FILE_IMAGE::GetSharedAperFunction()
+    unsigned    m_firstFlash;               // Flash arrays: the index of the first flash in the
+                                            // flashes of the D_CODE (D_CODE::m_Flashes)
+    unsigned    m_flashCount;               // Flash arrays: the count of flashes, 0 for the other
+                                            // items
 
 public:
     GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberparams );
     ~GERBER_DRAW_ITEM();
 
-    void SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes );
-    const GBR_NETLIST_METADATA& GetNetAttributes() const { return m_netAttributes; }
+    void SetNetAttributes( const std::shared_ptr<const GBR_NETLIST_METADATA>& aNetAttributes );
+    const GBR_NETLIST_METADATA& GetNetAttributes() const;
+
+    void SetAperFunction( const std::shared_ptr<const wxString>& aAperFunction );
+    const wxString& GetAperFunction() const;
 
     /**
      * Function GetLayer
@@ -174,6 +211,60 @@ public:
         m_LayerNegative = aNegative;
     }
 
+    /**
+     * Function GetFlashParams
+     * @return the layer polarity and the layer parameters of this item.
+     */
+    GERBER_FLASH_PARAMS GetFlashParams() const;
+
+    /**
+     * Function SetFlashParams
+     * sets the layer polarity and the layer parameters of this item.
+     */
+    void SetFlashParams( const GERBER_FLASH_PARAMS& aParams );
+
+    /**
+     * Function IsFlashArray
+     * @return true if this item draws a flash array: consecutive flashes of the same D_CODE,
+     * with the same size and shape, polarity and net attributes, stored in the D_CODE as only
+     * their position and the index of their layer parameters.  The item itself has the
+     * position and the parameters of the first flash.
+     */
+    bool IsFlashArray() const { return m_flashCount > 0; }
+
+    /**
+     * @return the count of flashes of a flash array, 0 if this item is not a flash array.
+     */
+    unsigned GetFlashCount() const { return m_flashCount; }
+
+    /**
+     * Function InitFlashArray
+     * makes this flashed item a flash array having as only flash the flash \a aFirstFlash of
+     * its D_CODE, which must have the position and the parameters of this item.
+     */
+    void InitFlashArray( unsigned aFirstFlash );
+
+    /**
+     * Function CanAppendFlash
+     * @return true if the single flashed item \a aFlash can be added to this flash array:
+     * it flashes the same D_CODE, with the same size, polarity and net attributes, and the
+     * last flash of this array is the last flash of the D_CODE.
+     */
+    bool CanAppendFlash( const GERBER_DRAW_ITEM& aFlash ) const;
+
+    /**
+     * Function AppendFlash
+     * adds the last flash of the D_CODE to this flash array.
+     */
+    void AppendFlash();
+
+    /**
+     * Function GetFlash
+     * @return the flash \a aIdx of this flash array, as a single flashed item which is not
+     * in the items list of the image.  It is drawn and hit tested as any other flashed item.
+     */
+    GERBER_DRAW_ITEM GetFlash( unsigned aIdx ) const;
+
     /**
      * Function MoveAB
      * move this object.
@@ -231,6 +322,21 @@ public:
 
     const EDA_RECT GetBoundingBox() const override;
 
+    /**
+     * Function CacheBoundingBox
+     * computes the bounding box once and keeps it: GetBoundingBox() then returns the cached
+     * box until the item is moved.  Used once the image of the item is fully read, because
+     * computing the bounding box of some shapes (aperture macros) is expensive.
+     */
+    void CacheBoundingBox();
+
+    /**
+     * Function GetHitTestBoundingBox
+     * @return the bounding box of the area where HitTest( const wxPoint& ) can find this item,
+     * i.e. the bounding box inflated by the hit test tolerance.
+     */
+    const EDA_RECT GetHitTestBoundingBox() const;
+
     void Print( wxDC* aDC, const wxPoint& aOffset, GBR_DISPLAY_OPTIONS* aOptions );
 
     /**
@@ -302,6 +408,12 @@ public:
 
     ///> @copydoc EDA_ITEM::GetMenuImage()
     BITMAP_DEF GetMenuImage() const override;
+
+private:
+    /**
+     * Moves the flashes of a flash array by \a aMoveVector, in XY gerber axis.
+     */
+    void moveFlashes( const wxPoint& aMoveVector );
 };
 
 
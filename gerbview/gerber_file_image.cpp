@@ -42,6 +42,18 @@
  */
 extern int scaletoIU( double aCoord, bool isMetric );       // defined it rs274d_read_XY_and_IJ_coordiantes.cpp
 
+// See rs274d.cpp:
+extern void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
+                                 APERTURE_T        aAperture,
+                                 int               Dcode_index,
+                                 const wxPoint&    aPos,
+                                 wxSize            aSize,
+                                 bool              aLayerNegative );
+
+// The max count of flashes of a flash array.  A flash array is indexed, selected and
+// highlighted as one item: the count is limited to keep its flashes near each other.
+static const unsigned FLASH_ARRAY_MAX_COUNT = 1024;
+
 /* Format Gerber: NOTES:
  * Tools and D_CODES
  *   tool number (identification of shapes)
@@ -92,6 +104,7 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
 
     m_Selected_Tool = 0;
     m_FileFunction = NULL;          // file function parameters
+    m_itemsIndexValid = false;
 
     ResetDefaultValues();
 
@@ -102,6 +115,7 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
 
 GERBER_FILE_IMAGE::~GERBER_FILE_IMAGE()
 {
+    m_itemsIndex.RemoveAll();
 
     for( auto item : GetItems() )
         delete item;
@@ -217,6 +231,8 @@ void GERBER_FILE_IMAGE::ResetDefaultValues()
                                                     // (radius or IJ center coord)
     m_LineNum = 0;                                  // line number in file being read
     m_Current_File    = NULL;                       // Gerber file to read
+    m_sharedNetAttributes.reset();                  // Net attributes given to new items
+    m_sharedAperFunction.reset();                   // Aperture function given to new regions
     m_PolygonFillMode = false;
     m_PolygonFillModeState = 0;
     m_Selected_Tool = 0;
@@ -320,6 +336,67 @@ void GERBER_FILE_IMAGE::StepAndRepeatItem( const GERBER_DRAW_ITEM& aItem )
 }
 
 
+void GERBER_FILE_IMAGE::AddFlash( D_CODE* aDCode, const wxPoint& aPos )
+{
+    addFlash( aDCode, aPos );
+
+    // Same copies as StepAndRepeatItem() makes of a flashed item
+    if( GetLayerParams().m_XRepeatCount < 2 &&
+        GetLayerParams().m_YRepeatCount < 2 )
+        return; // Nothing to repeat
+
+    for( int ii = 0; ii < GetLayerParams().m_XRepeatCount; ii++ )
+    {
+        for( int jj = 0; jj < GetLayerParams().m_YRepeatCount; jj++ )
+        {
+            // the first flash already exists
+            if( jj == 0 && ii == 0 )
+                continue;
+
+            wxPoint move_vector;
+            move_vector.x = scaletoIU( ii * GetLayerParams().m_StepForRepeat.x,
+                                   GetLayerParams().m_StepForRepeatMetric );
+            move_vector.y = scaletoIU( jj * GetLayerParams().m_StepForRepeat.y,
+                                   GetLayerParams().m_StepForRepeatMetric );
+            addFlash( aDCode, aPos + move_vector );
+        }
+    }
+}
+
+
+void GERBER_FILE_IMAGE::addFlash( D_CODE* aDCode, const wxPoint& aPos )
+{
+    GERBER_DRAW_ITEM flash( this );
+
+    fillFlashedGBRITEM( &flash, aDCode->m_Shape, aDCode->m_Num_Dcode, aPos, aDCode->m_Size,
+                        GetLayerParams().m_LayerNegative );
+
+    GERBER_DRAW_ITEM* last = m_drawings.empty() ? nullptr : m_drawings.back();
+    bool append = last && last->GetFlashCount() < FLASH_ARRAY_MAX_COUNT
+                  && last->CanAppendFlash( flash );
+
+    GERBER_FLASH_PARAMS params = flash.GetFlashParams();
+
+    if( m_flashParams.empty() || !( m_flashParams.back() == params ) )
+        m_flashParams.push_back( params );
+
+    aDCode->m_Flashes.push_back( { aPos, unsigned( m_flashParams.size() - 1 ) } );
+
+    if( append )
+    {
+        last->AppendFlash();
+        InvalidateItemsIndex();
+    }
+    else
+    {
+        GERBER_DRAW_ITEM* item = new GERBER_DRAW_ITEM( flash );
+
+        item->InitFlashArray( aDCode->m_Flashes.size() - 1 );
+        AddItemToList( item );
+    }
+}
+
+
 /**
  * Function DisplayImageInfo
  * has knowledge about the frame and how and where to put status information
@@ -383,6 +460,137 @@ void GERBER_FILE_IMAGE::DisplayImageInfo(  GERBVIEW_FRAME* aMainFrame  )
 }
 
 
+void GERBER_FILE_IMAGE::BuildItemsIndex()
+{
+    m_itemsIndex.RemoveAll();
+    m_itemsByNetname.clear();
+    m_itemsByComponent.clear();
+    m_itemsByAperFunction.clear();
+
+    for( size_t ii = 0; ii < m_drawings.size(); ii++ )
+    {
+        GERBER_DRAW_ITEM* item = m_drawings[ii];
+
+        item->CacheBoundingBox();
+
+        EDA_RECT area = item->GetHitTestBoundingBox();
+        area.Normalize();
+
+        int min[2] = { area.GetX(), area.GetY() };
+        int max[2] = { area.GetRight(), area.GetBottom() };
+
+        m_itemsIndex.Insert( min, max, ii );
+
+        const GBR_NETLIST_METADATA& netAttributes = item->GetNetAttributes();
+
+        if( !netAttributes.m_Netname.IsEmpty() )
+            m_itemsByNetname[netAttributes.m_Netname].push_back( item );
+
+        if( !netAttributes.m_Cmpref.IsEmpty() )
+            m_itemsByComponent[netAttributes.m_Cmpref].push_back( item );
+
+        D_CODE* dcode = item->GetDcodeDescr();
+
+        if( dcode && !dcode->m_AperFunction.IsEmpty() )
+            m_itemsByAperFunction[dcode->m_AperFunction].push_back( item );
+    }
+
+    m_itemsIndexValid = true;
+}
+
+
+std::vector<GERBER_DRAW_ITEM*> GERBER_FILE_IMAGE::QueryItems( const wxPoint& aPosition ) const
+{
+    if( !HasItemsIndex() )
+        return m_drawings;
+
+    std::vector<size_t> found;
+    int pos[2] = { aPosition.x, aPosition.y };
+
+    auto visitor = [&found]( const size_t& aIndex ) -> bool
+    {
+        found.push_back( aIndex );
+        return true;
+    };
+
+    m_itemsIndex.Search( pos, pos, visitor );
+
+    // Keep the drawing order: callers expect the same order as a full scan of the list
+    std::sort( found.begin(), found.end() );
+
+    std::vector<GERBER_DRAW_ITEM*> items;
+    items.reserve( found.size() );
+
+    for( size_t ii : found )
+        items.push_back( m_drawings[ii] );
+
+    return items;
+}
+
+
+static const std::vector<GERBER_DRAW_ITEM*>& findIndexedItems( bool aIndexValid,
+        const std::map<wxString, std::vector<GERBER_DRAW_ITEM*>>& aIndex, const wxString& aKey )
+{
+    static const std::vector<GERBER_DRAW_ITEM*> empty;
+
+    // Out of date lists can hold items which were removed (and deleted)
+    if( !aIndexValid )
+        return empty;
+
+    auto it = aIndex.find( aKey );
+
+    return it == aIndex.end() ? empty : it->second;
+}
+
+
+const std::vector<GERBER_DRAW_ITEM*>& GERBER_FILE_IMAGE::GetItemsOfNet(
+        const wxString& aNetname ) const
+{
+    return findIndexedItems( HasItemsIndex(), m_itemsByNetname, aNetname );
+}
+
+
+const std::vector<GERBER_DRAW_ITEM*>& GERBER_FILE_IMAGE::GetItemsOfComponent(
+        const wxString& aCmpref ) const
+{
+    return findIndexedItems( HasItemsIndex(), m_itemsByComponent, aCmpref );
+}
+
+
+const std::vector<GERBER_DRAW_ITEM*>& GERBER_FILE_IMAGE::GetItemsOfAperFunction(
+        const wxString& aAperFunction ) const
+{
+    return findIndexedItems( HasItemsIndex(), m_itemsByAperFunction, aAperFunction );
+}
+
+
+const std::shared_ptr<const GBR_NETLIST_METADATA>& GERBER_FILE_IMAGE::GetSharedNetAttributes()
+{
+    if( !m_sharedNetAttributes )
+    {
+        m_sharedNetAttributes = std::make_shared<const GBR_NETLIST_METADATA>( m_NetAttributeDict );
+
+        if( ( m_NetAttributeDict.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) ||
+            ( m_NetAttributeDict.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+            m_ComponentsList.insert( std::make_pair( m_NetAttributeDict.m_Cmpref, 0 ) );
+
+        if( ( m_NetAttributeDict.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+            m_NetnamesList.insert( std::make_pair( m_NetAttributeDict.m_Netname, 0 ) );
+    }
+
+    return m_sharedNetAttributes;
+}
+
+
+const std::shared_ptr<const wxString>& GERBER_FILE_IMAGE::GetSharedAperFunction()
+{
+    if( !m_sharedAperFunction && !m_AperFunction.IsEmpty() )
+        m_sharedAperFunction = std::make_shared<const wxString>( m_AperFunction );
+
+    return m_sharedAperFunction;
+}
+
+
 void GERBER_FILE_IMAGE::RemoveAttribute( X2_ATTRIBUTE& aAttribute )
 {
     /* Called when a %TD command is found
@@ -394,9 +602,13 @@ void GERBER_FILE_IMAGE::RemoveAttribute( X2_ATTRIBUTE& aAttribute )
      */
     wxString cmd = aAttribute.GetPrm( 0 );
     m_NetAttributeDict.ClearAttribute( &cmd );
+    m_sharedNetAttributes.reset();
 
     if( cmd.IsEmpty() || cmd == ".AperFunction" )
+    {
         m_AperFunction.Clear();
+        m_sharedAperFunction.reset();
+    }
 }
 
 
@@ -25,9 +25,14 @@
 #ifndef GERBER_FILE_IMAGE_H
 #define GERBER_FILE_IMAGE_H
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <vector>
 #include <set>
 
+#include <geometry/rtree.h>
+
 #include <dcode.h>
 #include <gerber_draw_item.h>
 #include <am_primitive.h>
@@ -41,6 +46,7 @@ typedef std::vector<GERBER_DRAW_ITEM*> GERBER_DRAW_ITEMS;
 
 class GERBVIEW_FRAME;
 class D_CODE;
+class LINE_READER;
 
 /* gerber files have different parameters to define units and how items must be plotted.
  *  some are for the entire file, and other can change along a file.
@@ -159,7 +165,7 @@ public:
     bool               m_LastCoordIsIJPos;                      // true if a IJ coord was read (for arcs & circles )
     int                m_ArcRadius;                             // A value ( = radius in circular routing in Excellon files )
     LAST_EXTRA_ARC_DATA_TYPE m_LastArcDataType;                 // Identifier for arc data type (IJ (center) or A## (radius))
-    FILE*              m_Current_File;                          // Current file to read
+    LINE_READER*       m_Current_File;                          // Reader of the file being read (only valid while reading)
 
     int                m_Selected_Tool;                         // For highlight: current selected Dcode
     bool               m_Has_DCode;                             // true = DCodes in file
@@ -183,6 +189,26 @@ public:
     std::map<wxString, int> m_NetnamesList;                     // list of net names
 
 private:
+    std::shared_ptr<const GBR_NETLIST_METADATA> m_sharedNetAttributes;  // A copy of m_NetAttributeDict
+                                                                // shared by the items created while
+                                                                // it does not change.  Null when
+                                                                // m_NetAttributeDict was modified
+    std::shared_ptr<const wxString> m_sharedAperFunction;      // A copy of m_AperFunction shared
+                                                                // by the regions created while it
+                                                                // does not change.  Null when
+                                                                // m_AperFunction was modified
+    std::vector<GERBER_FLASH_PARAMS> m_flashParams;             // The parameters of the flashes of
+                                                                // the flash arrays, stored once for
+                                                                // the consecutive flashes having the
+                                                                // same ones (see GERBER_FLASH)
+    RTree<size_t, int, 2, double> m_itemsIndex;                 // Spatial index of the hit test areas of the
+                                                                // items (by their position in m_drawings)
+    bool               m_itemsIndexValid;                       // true if the indexes match the items list;
+                                                                // cleared when an item is added or removed
+    std::map<wxString, std::vector<GERBER_DRAW_ITEM*>> m_itemsByNetname;        // items by %TO.N attribute
+    std::map<wxString, std::vector<GERBER_DRAW_ITEM*>> m_itemsByComponent;      // items by %TO.C attribute
+    std::map<wxString, std::vector<GERBER_DRAW_ITEM*>> m_itemsByAperFunction;   // items by the aperture
+                                                                                // function of their D_CODE
     wxArrayString      m_messagesList;                          // A list of messages created when reading a file
     int                m_hasNegativeItems;                      // true if the image is negative or has some negative items
                                                                 // Used to optimize drawing, because when there are no
@@ -195,27 +221,24 @@ private:
      * test for an end of line
      * if a end of line is found:
      *   read a new line
-     * @param aBuff = buffer (size = GERBER_BUFZ) to fill with a new line
-     * @param aText = pointer to the last useful char in aBuff
+     *   read a new line from m_Current_File
+     * @param aText = pointer to the last useful char in the current line
      *          on return: points the beginning of the next line.
-     * @param aBuffSize = the size in bytes of aBuff
-     * @param aFile = the opened GERBER file to read
      * @return a pointer to the beginning of the next line or NULL if end of file
     */
-    char* GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile );
+    char* GetNextLine( char* aText );
 
-    bool GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* aGerberFile );
+    bool GetEndOfBlock( char*& aText );
 
     /**
       * reads a single RS274X command terminated with a %
      */
-    bool ReadRS274XCommand( char *aBuff, unsigned int aBuffSize, char*& aText );
+    bool ReadRS274XCommand( char*& aText );
 
     /**
      * executes a RS274X command
      */
-    bool ExecuteRS274XCommand( int aCommand, char* aBuff,
-                               unsigned int aBuffSize, char*& aText );
+    bool ExecuteRS274XCommand( int aCommand, char*& aText );
 
     /**
      * reads two bytes of data and assembles them into an int with the first
@@ -229,21 +252,23 @@ private:
 
     /**
      * reads in an aperture macro and saves it in m_aperture_macros.
-     * @param aBuff a character buffer at least GERBER_BUFZ long that can be
-     *          used to read successive lines from the gerber file.
+     * The successive lines of the macro are read from m_Current_File.
      * @param text A reference to a character pointer which gives the initial
      *              text to read from.
-     * @param aBuffSize is the size of aBuff
-     * @param gerber_file Which file to read from for continuation.
      * @return bool - true if a macro was read in successfully, else false.
      */
-    bool ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
-                            char* & text, FILE * gerber_file );
+    bool ReadApertureMacro( char* & text );
 
     // functions to execute G commands or D basic commands:
     bool    Execute_G_Command( char*& text, int G_command );
     bool    Execute_DCODE_Command( char*& text, int D_command );
 
+    /**
+     * adds a flash of \a aDCode at \a aPos to the last item if it is a flash array which
+     * can hold it, else to a new flash array.
+     */
+    void addFlash( D_CODE* aDCode, const wxPoint& aPos );
+
 public:
     GERBER_FILE_IMAGE( int layer );
     virtual ~GERBER_FILE_IMAGE();
@@ -275,6 +300,7 @@ public:
 
     /**
      * @return a reference to the GERBER_DRAW_ITEMS deque list
+     * Callers adding or removing items through it must call InvalidateItemsIndex().
      */
     GERBER_DRAW_ITEMS& GetItems() { return m_drawings; }
 
@@ -290,8 +316,69 @@ public:
     void AddItemToList( GERBER_DRAW_ITEM* aItem )
     {
         m_drawings.push_back( aItem );
+        InvalidateItemsIndex();
+    }
+
+    /**
+     * Remove a GERBER_DRAW_ITEM item from the drawings list (the item is not deleted)
+     * @param aItem is the GERBER_DRAW_ITEM to remove from the list
+     */
+    void RemoveItemFromList( GERBER_DRAW_ITEM* aItem )
+    {
+        auto it = std::find( m_drawings.begin(), m_drawings.end(), aItem );
+
+        if( it != m_drawings.end() )
+        {
+            m_drawings.erase( it );
+            InvalidateItemsIndex();
+        }
     }
 
+    /**
+     * Function BuildItemsIndex
+     * caches the bounding boxes of the items, and builds the spatial index used to find items
+     * at a given position and the indexes of items by net, component and aperture function.
+     * Called once the file is read: if items are added or removed later, the indexes are not
+     * used until they are built again.
+     */
+    void BuildItemsIndex();
+
+    /**
+     * @return true if the indexes built by BuildItemsIndex() are up to date.
+     */
+    bool HasItemsIndex() const { return m_itemsIndexValid; }
+
+    /**
+     * Marks the indexes built by BuildItemsIndex() as out of date, until they are built again.
+     */
+    void InvalidateItemsIndex() { m_itemsIndexValid = false; }
+
+    /**
+     * Function QueryItems
+     * @return the items which can be hit at \a aPosition (the items whose hit test area
+     * contains it), in the order of the items list.  All the items when the spatial index
+     * is not up to date.
+     */
+    std::vector<GERBER_DRAW_ITEM*> QueryItems( const wxPoint& aPosition ) const;
+
+    /**
+     * @return the items having \a aNetname as net attribute (empty if the indexes are not up
+     * to date, see HasItemsIndex()).
+     */
+    const std::vector<GERBER_DRAW_ITEM*>& GetItemsOfNet( const wxString& aNetname ) const;
+
+    /**
+     * @return the items having \a aCmpref as component attribute (empty if the indexes are
+     * not up to date).
+     */
+    const std::vector<GERBER_DRAW_ITEM*>& GetItemsOfComponent( const wxString& aCmpref ) const;
+
+    /**
+     * @return the items drawn with a D_CODE having \a aAperFunction as aperture function
+     * (empty if the indexes are not up to date).
+     */
+    const std::vector<GERBER_DRAW_ITEM*>& GetItemsOfAperFunction( const wxString& aAperFunction ) const;
+
     /**
      * @return the last GERBER_DRAW_ITEM* item of the items list
      */
@@ -309,6 +396,22 @@ public:
         return m_GBRLayerParams;
     }
 
+    /**
+     * Function GetSharedNetAttributes
+     * @return the current net attributes (m_NetAttributeDict) to give to a new item.
+     * The same instance is returned until the attributes change, so the (usually many)
+     * items having the same attributes do not store each their own copy.
+     */
+    const std::shared_ptr<const GBR_NETLIST_METADATA>& GetSharedNetAttributes();
+
+    /**
+     * Function GetSharedAperFunction
+     * @return the current aperture function (m_AperFunction) to give to a new region,
+     * or null if there is none. Like GetSharedNetAttributes(), the same instance is
+     * returned until m_AperFunction changes.
+     */
+    const std::shared_ptr<const wxString>& GetSharedAperFunction();
+
     /**
      * Function HasNegativeItems
      * @return true if at least one item must be drawn in background color
@@ -393,6 +496,26 @@ public:
      */
     APERTURE_MACRO* FindApertureMacro( const APERTURE_MACRO& aLookup );
 
+    /**
+     * Function AddFlash
+     * adds a flash of \a aDCode at \a aPos, and its copies when a step and repeat is active,
+     * to the items list.  Consecutive flashes of the same D_CODE are stored in its flash
+     * array (see GERBER_DRAW_ITEM::IsFlashArray()) instead of as one item per flash.
+     * @param aDCode = the D_CODE to flash
+     * @param aPos = the position of the flash, in XY gerber axis
+     */
+    void            AddFlash( D_CODE* aDCode, const wxPoint& aPos );
+
+    /**
+     * Function GetFlashParams
+     * @return the parameters of the flashes of flash arrays having \a aIdx as parameters
+     * index (see GERBER_FLASH::m_ParamsIdx).
+     */
+    const GERBER_FLASH_PARAMS& GetFlashParams( unsigned aIdx ) const
+    {
+        return m_flashParams[aIdx];
+    }
+
     /**
      * Function StepAndRepeatItem
      * Gerber format has a command Step an Repeat
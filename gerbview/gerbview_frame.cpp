@@ -857,6 +857,48 @@ void GERBVIEW_FRAME::SetActiveLayer( int aLayer, bool doLayerWidgetUpdate )
 }
 
 
+void GERBVIEW_FRAME::UpdateHighlightedItems()
+{
+    KIGFX::VIEW* view = GetCanvas()->GetView();
+    auto settings = static_cast<KIGFX::GERBVIEW_PAINTER*>( view->GetPainter() )->GetSettings();
+
+    for( unsigned layer = 0; layer < GetImagesList()->ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = GetImagesList()->GetGbrImage( layer );
+
+        if( gerber == NULL )    // Graphic layer not yet used
+            continue;
+
+        if( !gerber->HasItemsIndex() )
+        {
+            // Items were added or removed since the file was read: update them all
+            view->UpdateAllItems( KIGFX::COLOR );
+            return;
+        }
+
+        if( !settings->m_netHighlightString.IsEmpty() )
+        {
+            for( GERBER_DRAW_ITEM* item : gerber->GetItemsOfNet( settings->m_netHighlightString ) )
+                view->Update( item, KIGFX::COLOR );
+        }
+
+        if( !settings->m_componentHighlightString.IsEmpty() )
+        {
+            for( GERBER_DRAW_ITEM* item :
+                    gerber->GetItemsOfComponent( settings->m_componentHighlightString ) )
+                view->Update( item, KIGFX::COLOR );
+        }
+
+        if( !settings->m_attributeHighlightString.IsEmpty() )
+        {
+            for( GERBER_DRAW_ITEM* item :
+                    gerber->GetItemsOfAperFunction( settings->m_attributeHighlightString ) )
+                view->Update( item, KIGFX::COLOR );
+        }
+    }
+}
+
+
 void GERBVIEW_FRAME::SetPageSettings( const PAGE_INFO& aPageSettings )
 {
     m_paper = aPageSettings;
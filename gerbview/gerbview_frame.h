@@ -41,6 +41,7 @@ class GERBER_LAYER_WIDGET;
 class GBR_LAYER_BOX_SELECTOR;
 class GERBER_DRAW_ITEM;
 class GERBER_FILE_IMAGE;
+class EXCELLON_IMAGE;
 class GERBER_FILE_IMAGE_LIST;
 class REPORTER;
 class SELECTION;
@@ -196,6 +197,20 @@ private:
     /// Updates the GAL with display settings changes
     void applyDisplaySettingsToGAL();
 
+    /**
+     * Attach a Gerber image already read by GERBER_FILE_IMAGE::LoadGerberFile() to the active
+     * layer, replacing the image already there, and show the messages of the reader.
+     * The frame takes ownership of \a aGerber.
+     */
+    bool attachGerberImage( GERBER_FILE_IMAGE* aGerber );
+
+    /**
+     * Attach a drill image already read by EXCELLON_IMAGE::LoadFile() to the active layer,
+     * replacing the image already there, and show the messages of the reader.
+     * The frame takes ownership of \a aDrillLayer (it is deleted if it cannot be attached).
+     */
+    bool attachExcellonImage( EXCELLON_IMAGE* aDrillLayer );
+
 public:
     GERBVIEW_FRAME( KIWAY* aKiway, wxWindow* aParent );
     ~GERBVIEW_FRAME();
@@ -391,6 +406,13 @@ public:
     /// Handles the changing of the highlighted component/net/attribute
     void OnSelectHighlightChoice( wxCommandEvent& event );
 
+    /**
+     * Updates the color of the items highlighted by the current component/net/attribute
+     * highlight settings of the painter.  Called before and after changing these settings,
+     * to redraw only the items whose highlight state changes.
+     */
+    void UpdateHighlightedItems();
+
     /**
      * Function OnSelectActiveDCode
      * Selects the active DCode for the current active layer.
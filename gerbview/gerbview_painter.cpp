@@ -198,6 +198,18 @@ bool GERBVIEW_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 // Probably that can be refactored in GERBER_DRAW_ITEM to allow const here.
 void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
 {
+    // The flashes of a flash array are drawn one by one, in file order
+    if( aItem->IsFlashArray() )
+    {
+        for( unsigned ii = 0; ii < aItem->GetFlashCount(); ii++ )
+        {
+            GERBER_DRAW_ITEM flash = aItem->GetFlash( ii );
+            draw( &flash, aLayer );
+        }
+
+        return;
+    }
+
     VECTOR2D start( aItem->GetABPosition( aItem->m_Start ) );   // TODO(JE) Getter
     VECTOR2D end( aItem->GetABPosition( aItem->m_End ) );       // TODO(JE) Getter
     int      width = aItem->m_Size.x;   // TODO(JE) Getter
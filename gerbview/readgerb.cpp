@@ -31,6 +31,7 @@
 
 #include <html_messagebox.h>
 #include <macros.h>
+#include <richio.h>
 
 /* Read a gerber file, RS274D, RS274X or RS274X2 format.
  */
@@ -38,16 +39,7 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 {
     wxString msg;
 
-    int layer = GetActiveLayer();
-    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
-    GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
-
-    if( gerber != NULL )
-    {
-        Erase_Current_DrawLayer( false );
-    }
-
-    gerber = new GERBER_FILE_IMAGE( layer );
+    GERBER_FILE_IMAGE* gerber = new GERBER_FILE_IMAGE( GetActiveLayer() );
 
     // Read the gerber file. The image will be added only if it can be read
     // to avoid broken data.
@@ -61,13 +53,31 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
         return false;
     }
 
-    images->AddGbrImage( gerber, layer );
+    return attachGerberImage( gerber );
+}
+
+
+bool GERBVIEW_FRAME::attachGerberImage( GERBER_FILE_IMAGE* aGerber )
+{
+    wxString msg;
+
+    int layer = GetActiveLayer();
+    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
+
+    if( GetGbrImage( layer ) != NULL )
+    {
+        Erase_Current_DrawLayer( false );
+    }
+
+    // The image may have been read before its layer was known
+    aGerber->m_GraphicLayer = layer;
+    images->AddGbrImage( aGerber, layer );
 
     // Display errors list
-    if( gerber->GetMessages().size() > 0 )
+    if( aGerber->GetMessages().size() > 0 )
     {
         HTML_MESSAGE_BOX dlg( this, _("Errors") );
-        dlg.ListSet(gerber->GetMessages());
+        dlg.ListSet(aGerber->GetMessages());
         dlg.ShowModal();
     }
 
@@ -76,9 +86,9 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
      * or has missing definitions,
      * warn the user:
      */
-    if( gerber->GetItemsCount() && gerber->m_Has_MissingDCode )
+    if( aGerber->GetItemsCount() && aGerber->m_Has_MissingDCode )
     {
-        if( !gerber->m_Has_DCode )
+        if( !aGerber->m_Has_DCode )
             msg = _("Warning: this file has no D-Code definition\n"
                     "Therefore the size of some items is undefined");
         else
@@ -90,13 +100,13 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 
     if( GetCanvas() )
     {
-        if( gerber->m_ImageNegative )
+        if( aGerber->m_ImageNegative )
         {
             // TODO: find a way to handle negative images
             // (maybe convert geometry into positives?)
         }
 
-        for( auto item : gerber->GetItems() )
+        for( auto item : aGerber->GetItems() )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
 
@@ -108,8 +118,6 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 // size of a single line of text from a gerber file.
 // warning: some files can have *very long* lines, so the buffer must be large.
 #define GERBER_BUFZ 1000000
-// A large buffer to store one line
-static char lineBuffer[GERBER_BUFZ+1];
 
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
@@ -120,12 +128,21 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     ClearMessageList( );
     ResetDefaultValues();
 
-    // Read the gerber file */
-    m_Current_File = wxFopen( aFullFileName, wxT( "rt" ) );
+    // Read the gerber file.  The file is mapped in memory and read line by line: each load
+    // has its own reader, so several files can be read at once on different threads.
+    // Lines longer than GERBER_BUFZ are read in several pieces.
+    std::unique_ptr<MAPPED_FILE_LINE_READER> reader;
 
-    if( m_Current_File == 0 )
+    try
+    {
+        reader = std::make_unique<MAPPED_FILE_LINE_READER>( aFullFileName, GERBER_BUFZ );
+    }
+    catch( const IO_ERROR& )
+    {
         return false;
+    }
 
+    m_Current_File = reader.get();
     m_FileName = aFullFileName;
 
     LOCALE_IO toggleIo;
@@ -134,11 +151,11 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     while( true )
     {
-        if( fgets( lineBuffer, GERBER_BUFZ, m_Current_File ) == NULL )
+        if( m_Current_File->ReadLine() == NULL )
             break;
 
         m_LineNum++;
-        text = StrPurge( lineBuffer );
+        text = StrPurge( m_Current_File->Line() );
 
         while( text && *text )
         {
@@ -195,7 +212,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
                 if( m_CommandState != ENTER_RS274X_CMD )
                 {
                     m_CommandState = ENTER_RS274X_CMD;
-                    ReadRS274XCommand( lineBuffer, GERBER_BUFZ, text );
+                    ReadRS274XCommand( text );
                 }
                 else        //Error
                 {
@@ -214,9 +231,12 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
         }
     }
 
-    fclose( m_Current_File );
+    m_Current_File = nullptr;
 
     m_InUse = true;
 
+    // Build the indexes used to find the items at a given position or with a given attribute
+    BuildItemsIndex();
+
     return true;
 }
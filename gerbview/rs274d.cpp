@@ -110,7 +110,7 @@ void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     aGbrItem->m_DCode = Dcode_index;
     aGbrItem->SetLayerPolarity( aLayerNegative );
     aGbrItem->m_Flashed = true;
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     switch( aAperture )
     {
@@ -169,7 +169,7 @@ void fillLineGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
     aGbrItem->m_DCode = Dcode_index;
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 }
 
 
@@ -214,7 +214,7 @@ void fillArcGBRITEM(  GERBER_DRAW_ITEM* aGbrItem, int Dcode_index,
     aGbrItem->m_Flashed = false;
 
     if( aGbrItem->m_GerberImageFile )
-        aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+        aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     if( aMultiquadrant )
         center = aStart + aRelCenter;
@@ -337,7 +337,7 @@ static void fillArcPOLY(  GERBER_DRAW_ITEM* aGbrItem,
     /* in order to calculate arc parameters, we use fillArcGBRITEM
      * so we muse create a dummy track and use its geometric parameters
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( NULL );
+    GERBER_DRAW_ITEM dummyGbrItem( NULL );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
@@ -345,7 +345,7 @@ static void fillArcPOLY(  GERBER_DRAW_ITEM* aGbrItem,
                      aStart, aEnd, rel_center, wxSize(0, 0),
                      aClockwise, aMultiquadrant, aLayerNegative );
 
-    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->m_NetAttributeDict );
+    aGbrItem->SetNetAttributes( aGbrItem->m_GerberImageFile->GetSharedNetAttributes() );
 
     wxPoint   center;
     center = dummyGbrItem.m_ArcCentre;
@@ -492,7 +492,7 @@ bool GERBER_FILE_IMAGE::Execute_G_Command( char*& text, int G_command )
 
             char* cptr = (char*)x2buf.data();
             int code_command = ReadXCommandID( cptr );
-            ExecuteRS274XCommand( code_command, NULL, 0, cptr );
+            ExecuteRS274XCommand( code_command, cptr );
         }
 
         while( *text && (*text != '*') )
@@ -632,8 +632,8 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
 
                 if( gbritem->m_GerberImageFile )
                 {
-                    gbritem->SetNetAttributes( gbritem->m_GerberImageFile->m_NetAttributeDict );
-                    gbritem->m_AperFunction = gbritem->m_GerberImageFile->m_AperFunction;
+                    gbritem->SetNetAttributes( gbritem->m_GerberImageFile->GetSharedNetAttributes() );
+                    gbritem->SetAperFunction( gbritem->m_GerberImageFile->GetSharedAperFunction() );
                 }
             }
 
@@ -760,11 +760,13 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
 
         case 3:     // code D3: flash aperture
             tool = GetDCODE( m_Current_Tool );
+
             if( tool )
             {
-                size     = tool->m_Size;
-                dcode    = tool->m_Num_Dcode;
-                aperture = tool->m_Shape;
+                // Stored in the flash array of the D_CODE
+                AddFlash( tool, m_CurrentPos );
+                m_PreviousPos = m_CurrentPos;
+                break;
             }
 
             gbritem = new GERBER_DRAW_ITEM( this );
@@ -33,6 +33,7 @@
 #include <gerber_file_image.h>
 #include <X2_gerber_attributes.h>
 #include <gbr_metadata.h>
+#include <richio.h>
 
 extern int ReadInt( char*& text, bool aSkipSeparator = true );
 extern double ReadDouble( char*& text, bool aSkipSeparator = true );
@@ -138,7 +139,7 @@ int GERBER_FILE_IMAGE::ReadXCommandID( char*& text )
 }
 
 
-bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize, char*& aText )
+bool GERBER_FILE_IMAGE::ReadRS274XCommand( char*& aText )
 {
     bool ok = true;
     int  code_command;
@@ -168,7 +169,7 @@ bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize,
 
             default:
                 code_command = ReadXCommandID( aText );
-                ok = ExecuteRS274XCommand( code_command, aBuff, aBuffSize, aText );
+                ok = ExecuteRS274XCommand( code_command, aText );
 
                 if( !ok )
                     goto exit;
@@ -178,14 +179,14 @@ bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize,
         }
 
         // end of current line, read another one.
-        if( fgets( aBuff, aBuffSize, m_Current_File ) == NULL )
+        if( m_Current_File->ReadLine() == NULL )
         {
             // end of file
             ok = false;
             break;
         }
         m_LineNum++;
-        aText = aBuff;
+        aText = m_Current_File->Line();
     }
 
 exit:
@@ -193,8 +194,7 @@ exit:
 }
 
 
-bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
-                                              unsigned int aBuffSize, char*& aText )
+bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char*& aText )
 {
     int      code;
     int      seq_len;    // not used, just provided
@@ -226,7 +226,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
 
             case 'D':       // Non-standard option for all zeros (leading + tailing)
                 msg.Printf( _( "RS274X: Invalid GERBER format command '%c' at line %d: \"%s\"" ),
-                        'D', m_LineNum, aBuff );
+                        'D', m_LineNum, m_Current_File->Line() );
                 AddMessageToList( msg );
                 msg.Printf( _("GERBER file \"%s\" may not display as intended." ),
                         m_FileName.ToAscii() );
@@ -321,7 +321,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
                 msg.Printf( wxT( "Unknown id (%c) in FS command" ),
                            *aText );
                 AddMessageToList( msg );
-                GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+                GetEndOfBlock( aText );
                 ok = false;
                 break;
             }
@@ -385,7 +385,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
         m_IsX2_file = true;
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_Current_File, aText, m_LineNum );
 
         if( dummy.IsFileFunction() )
         {
@@ -406,7 +406,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case APERTURE_ATTRIBUTE:    // Command %TA
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_Current_File, aText, m_LineNum );
 
         if( dummy.GetAttribute() == ".AperFunction" )
         {
@@ -415,6 +415,8 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
             // A few function values can have other parameters. Add them
             for( int ii = 2; ii < dummy.GetPrmCount(); ii++ )
                 m_AperFunction << "," << dummy.GetPrm( ii );
+
+            m_sharedAperFunction.reset();
         }
     }
         break;
@@ -423,7 +425,10 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     {
         X2_ATTRIBUTE dummy;
 
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_Current_File, aText, m_LineNum );
+
+        // The items created from now on have new attributes
+        m_sharedNetAttributes.reset();
 
         if( dummy.GetAttribute() == ".N" )
         {
@@ -457,7 +462,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case REMOVE_APERTURE_ATTRIBUTE:    // Command %TD ...
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_Current_File, aText, m_LineNum );
         RemoveAttribute( dummy );
     }
         break;
@@ -684,7 +689,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case AP_MACRO:  // lines like %AMMYMACRO*
                     // 5,1,8,0,0,1.08239X$1,22.5*
                     // %
-        /*ok = */ReadApertureMacro( aBuff, aBuffSize, aText, m_Current_File );
+        /*ok = */ReadApertureMacro( aText );
         break;
 
     case AP_DEFINITION:
@@ -894,17 +899,17 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
 
     (void) seq_len;     // quiet g++, or delete the unused variable.
 
-    ok = GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+    ok = GetEndOfBlock( aText );
 
     return ok;
 }
 
 
-bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* gerber_file )
+bool GERBER_FILE_IMAGE::GetEndOfBlock( char*& aText )
 {
     for( ; ; )
     {
-        while( (aText < aBuff + aBuffSize) && *aText )
+        while( *aText )
         {
             if( *aText == '*' )
                 return true;
@@ -915,18 +920,18 @@ bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char
             aText++;
         }
 
-        if( fgets( aBuff, aBuffSize, gerber_file ) == NULL )
+        if( m_Current_File->ReadLine() == NULL )
             break;
 
         m_LineNum++;
-        aText = aBuff;
+        aText = m_Current_File->Line();
     }
 
     return false;
 }
 
 
-char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile )
+char* GERBER_FILE_IMAGE::GetNextLine( char* aText )
 {
     for( ; ; )
     {
@@ -938,12 +943,12 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
                 ++aText;
                 break;
 
-            case 0:    // End of text found in aBuff: Read a new string
-                if( fgets( aBuff, aBuffSize, aFile ) == NULL )
+            case 0:    // End of text found in the current line: Read a new line
+                if( m_Current_File->ReadLine() == NULL )
                     return NULL;
 
                 m_LineNum++;
-                aText = aBuff;
+                aText = m_Current_File->Line();
                 return aText;
 
             default:
@@ -954,9 +959,7 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
 }
 
 
-bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
-                                char*&    aText,
-                                FILE*     gerber_file )
+bool GERBER_FILE_IMAGE::ReadApertureMacro( char*& aText )
 {
     wxString       msg;
     APERTURE_MACRO am;
@@ -979,7 +982,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         if( *aText == '*' )
             ++aText;
 
-        aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+        aText = GetNextLine( aText );
 
         if( aText == NULL )  // End of File
             return false;
@@ -1005,7 +1008,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         {
             am.m_localparamStack.push_back( AM_PARAM() );
             AM_PARAM& param = am.m_localparamStack.back();
-            aText = GetNextLine(  aBuff, aBuffSize, aText, gerber_file );
+            aText = GetNextLine( aText );
             if( aText == NULL)   // End of File
                 return false;
             param.ReadParam( aText );
@@ -1014,7 +1017,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
         else if( !isdigit(*aText)  )     // Ill. symbol
         {
             msg.Printf( wxT( "RS274X: Aperture Macro \"%s\": ill. symbol, line: \"%s\"" ),
-                        GetChars( am.name ), GetChars( FROM_UTF8( aBuff ) ) );
+                        GetChars( am.name ), GetChars( FROM_UTF8( m_Current_File->Line() ) ) );
             AddMessageToList( msg );
             primitive_type = AMP_COMMENT;
         }
@@ -1072,7 +1075,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
         default:
             msg.Printf( wxT( "RS274X: Aperture Macro \"%s\": Invalid primitive id code %d, line %d: \"%s\"" ),
-                        GetChars( am.name ), primitive_type, m_LineNum, GetChars( FROM_UTF8( aBuff ) ) );
+                        GetChars( am.name ), primitive_type, m_LineNum, GetChars( FROM_UTF8( m_Current_File->Line() ) ) );
             AddMessageToList( msg );
             return false;
         }
@@ -1090,7 +1093,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
             AM_PARAM& param = prim.params.back();
 
-            aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+            aText = GetNextLine( aText );
 
             if( aText == NULL)   // End of File
                 return false;
@@ -1124,7 +1127,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
 
                 AM_PARAM& param = prim.params.back();
 
-                aText = GetNextLine( aBuff, aBuffSize, aText, gerber_file );
+                aText = GetNextLine( aText );
 
                 if( aText == NULL )  // End of File
                     return false;
@@ -157,6 +157,9 @@ int GERBVIEW_CONTROL::HighlightControl( const TOOL_EVENT& aEvent )
         item = static_cast<GERBER_DRAW_ITEM*>( selection[0] );
     }
 
+    // Redraw the items losing their highlight
+    m_frame->UpdateHighlightedItems();
+
     if( aEvent.IsAction( &GERBVIEW_ACTIONS::highlightClear ) )
     {
         m_frame->m_SelComponentBox->SetSelection( 0 );
@@ -190,7 +193,7 @@ int GERBVIEW_CONTROL::HighlightControl( const TOOL_EVENT& aEvent )
         }
     }
 
-    canvas()->GetView()->UpdateAllItems( KIGFX::COLOR );
+    m_frame->UpdateHighlightedItems();
     canvas()->Refresh();
 
     return 0;
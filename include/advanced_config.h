@@ -147,6 +147,12 @@ public:
      */
     bool m_SkipBoundingBoxOnFpLoad;
 
+    /**
+     * Number of tiles per axis used to split the zone filler's polygon operations across
+     * threads.  0 or 1 uses the monolithic (single-threaded) operations.
+     */
+    int m_ZoneFillTiles;
+
 private:
     ADVANCED_CFG();
 
@@ -88,6 +88,7 @@ enum id_librarytype {
 
 #define DEFAULT_MAX_UNDO_ITEMS 0
 #define ABS_MAX_UNDO_ITEMS (INT_MAX / 2)
+#define DEFAULT_MAX_UNDO_MEMORY 512     // in MB; 0 for no limit
 
 /// This is the handler functor for the update UI events
 typedef std::function< void( wxUpdateUIEvent& ) > UIUpdateHandler;
@@ -160,6 +161,7 @@ protected:
     wxTimer*        m_autoSaveTimer;
 
     int             m_UndoRedoCountMax;     // undo/Redo command Max depth
+    size_t          m_UndoRedoMemoryMax;    // memory budget of each undo/redo list, in bytes
 
     UNDO_REDO_CONTAINER m_undoList;         // Objects list for the undo command (old data)
     UNDO_REDO_CONTAINER m_redoList;         // Objects list for the redo command (old data)
@@ -619,6 +621,18 @@ public:
      */
     virtual void PushCommandToRedoList( PICKED_ITEMS_LIST* aItem );
 
+    /**
+     * Function GetCommandMemoryUsage
+     * returns an estimate of the memory held by an undo/redo command, i.e. by the
+     * copies of the changed items and the deleted items it owns.  When the memory
+     * held by a list exceeds its budget, its oldest commands are deleted.
+     * The default implementation returns 0, so the memory budget is not used.
+     */
+    virtual size_t GetCommandMemoryUsage( const PICKED_ITEMS_LIST& aCommand ) const
+    {
+        return 0;
+    }
+
     /** PopCommandFromUndoList
      * return the last command to undo and remove it from list
      * nothing is deleted.
@@ -636,11 +650,22 @@ public:
 
     int GetMaxUndoItems() const { return m_UndoRedoCountMax; }
 
+    /// @return the memory budget of the undo and redo lists, in MB (0 for no limit)
+    int GetMaxUndoMemory() const { return m_UndoRedoMemoryMax / ( 1024 * 1024 ); }
+
     bool NonUserClose( bool aForce )
     {
         m_isNonUserClose = true;
         return Close( aForce );
     }
+
+private:
+    /**
+     * Pushes a command to the undo or redo list, then deletes the oldest commands of the
+     * list over the count limit or the memory budget.  The memory held by the commands
+     * sharing items with the new one is estimated again.
+     */
+    void pushCommand( UNDO_REDO_LIST aList, PICKED_ITEMS_LIST* aCommand );
 };
 
 
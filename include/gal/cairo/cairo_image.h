@@ -0,0 +1,53 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _CAIRO_IMAGE_H_
+#define _CAIRO_IMAGE_H_
+
+#include <gal/cairo/cairo_gal.h>
+
+namespace KIGFX
+{
+/**
+ * CAIRO_IMAGE_GAL draws into a Cairo surface owned by the caller, without any window.
+ * It renders views offscreen, e.g. to export images of a board.
+ *
+ * The surface can be changed between two drawings, so a single GAL can render the tiles
+ * of a large image one after the other.  Each GAL has its own Cairo context: several GALs
+ * can draw into different surfaces from different threads.
+ */
+class CAIRO_IMAGE_GAL : public CAIRO_GAL_BASE
+{
+public:
+    /**
+     * @param aDPI is the resolution of the surfaces, used to compute the world scale.
+     */
+    CAIRO_IMAGE_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, double aDPI );
+
+    /**
+     * Function SetSurface
+     * sets the surface to draw into, and creates a new Cairo context for it.  For image
+     * surfaces, the screen size is set to the size of the surface; for other surfaces,
+     * it must be set with SetScreenSize().
+     */
+    void SetSurface( cairo_surface_t* aSurface );
+};
+} // namespace KIGFX
+
+#endif /* _CAIRO_IMAGE_H_ */
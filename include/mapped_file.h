@@ -0,0 +1,95 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <wx/string.h>
+
+
+/**
+ * MAPPED_FILE
+ * is a read only view of the whole content of a file.
+ *
+ * The file is mapped in memory when the platform allows it, so the pages are only read when
+ * they are accessed and are shared with the system file cache.  When the file cannot be
+ * mapped, it is read in a buffer, so the content is always available through Data().
+ */
+class MAPPED_FILE
+{
+public:
+    MAPPED_FILE();
+
+    /**
+     * Open and map @a aFileName.  See Open().
+     */
+    MAPPED_FILE( const wxString& aFileName );
+
+    ~MAPPED_FILE();
+
+    MAPPED_FILE( const MAPPED_FILE& ) = delete;
+    MAPPED_FILE& operator=( const MAPPED_FILE& ) = delete;
+
+    /**
+     * Map the content of @a aFileName, closing the file mapped before if any.
+     *
+     * @return true if the file could be opened and read.
+     */
+    bool Open( const wxString& aFileName );
+
+    /**
+     * Unmap the file.  Data() is no longer valid after this call.
+     */
+    void Close();
+
+    bool IsOpen() const { return m_isOpen; }
+
+    /**
+     * @return the content of the file, or nullptr if the file is empty or not open.
+     */
+    const char* Data() const { return m_data; }
+
+    size_t Size() const { return m_size; }
+
+    const wxString& GetFileName() const { return m_fileName; }
+
+private:
+    bool        readInBuffer( const wxString& aFileName );
+
+    wxString          m_fileName;
+    const char*       m_data;
+    size_t            m_size;
+    bool              m_isOpen;
+    bool              m_isMapped;   ///< true if m_data is a mapping, false if it is m_buffer
+    std::vector<char> m_buffer;     ///< the content when the file cannot be mapped
+
+#ifdef _WIN32
+    void*             m_fileHandle;
+    void*             m_mappingHandle;
+#endif
+};
+
+#endif  // MAPPED_FILE_H_
@@ -29,6 +29,8 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <list>
+#include <unordered_map>
 #include <vector>
 #include <utf8.h>
 
@@ -37,8 +39,10 @@
 #include <cstdio>
 #include <wx/string.h>
 #include <wx/stream.h>
+#include <wx/hashmap.h>
 
 #include <ki_exception.h>
+#include <mapped_file.h>
 
 
 /**
@@ -307,7 +311,50 @@ public:
 };
 
 
+/**
+ * MAPPED_FILE_LINE_READER
+ * is a LINE_READER that reads from a memory mapped file.  It avoids the per character
+ * overhead of FILE_LINE_READER, which matters for very large files.
+ * <p>
+ * Unlike the other LINE_READERs, a line longer than the maximum line length does not
+ * throw: it is returned in several pieces, as fgets() does, because some files (Gerber
+ * files for instance) are sometimes written as a single huge line.
+ */
+class MAPPED_FILE_LINE_READER : public LINE_READER
+{
+protected:
+    MAPPED_FILE m_file;
+    size_t      m_ndx;      ///< offset of the next line in the mapped file
+
+public:
+
+    /**
+     * Constructor MAPPED_FILE_LINE_READER
+     *
+     * @param aFileName is the name of the file to map and to use for error reporting purposes.
+     * @param aMaxLineLength is the maximum length of a line returned by ReadLine().
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName,
+            unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    char* ReadLine() override;
+
+    /**
+     * Function Rewind
+     * rewinds the file and resets the line number back to zero.
+     */
+    void Rewind()
+    {
+        m_ndx = 0;
+        m_lineNum = 0;
+    }
+};
+
+
 #define OUTPUTFMTBUFZ    500        ///< default buffer size for any OUTPUT_FORMATTER
+#define FILE_OUTPUTFMTBUFZ  ( 64 * 1024 )  ///< size of the file buffer of FILE_OUTPUTFORMATTER
 
 /**
  * OUTPUTFORMATTER
@@ -327,16 +374,37 @@ public:
  */
 class OUTPUTFORMATTER
 {
+    /// A string quoted by Quotew(), and its quoted UTF8 text
+    typedef std::pair<wxString, std::string>    QUOTED_STRING;
+    typedef std::list<QUOTED_STRING>            QUOTED_STRINGS;
+
     std::vector<char>   m_buffer;
     char                quoteChar[2];
 
+    /// The last strings quoted by Quotew(), the most recently quoted first
+    QUOTED_STRINGS      m_quoted;
+    size_t              m_quotedMax;        ///< The number of strings kept in m_quoted
+
+    /// m_quoted by string, if the quoted strings are cached
+    std::unordered_map<wxString, QUOTED_STRINGS::iterator, wxStringHash, wxStringEqual>
+                        m_quoteCache;
+    bool                m_quoteCacheEnabled;
+
     int sprint( const char* fmt, ... );
     int vprint( const char* fmt,  va_list ap );
 
+    /**
+     * Formats to m_buffer and writes a printf() format made only of the conversions
+     * %s, %d, %u, %c and %%, without calling vsnprintf().
+     */
+    int fastPrint( const char* fmt,  va_list ap );
+
 
 protected:
     OUTPUTFORMATTER( int aReserve = OUTPUTFMTBUFZ, char aQuoteChar = '"' ) :
-            m_buffer( aReserve, '\0' )
+            m_buffer( aReserve, '\0' ),
+            m_quotedMax( QUOTEW_KEPT ),
+            m_quoteCacheEnabled( false )
     {
         quoteChar[0] = aQuoteChar;
         quoteChar[1] = '\0';
@@ -344,6 +412,14 @@ protected:
 
     virtual ~OUTPUTFORMATTER() {}
 
+    /**
+     * Function EnableQuoteCache
+     * makes Quotew() look up the last \a aCount quoted strings before quoting a string, so
+     * the strings quoted many times (layer names, net names...) are converted and escaped
+     * only once.  It is worth it for the formatters writing whole files.
+     */
+    void EnableQuoteCache( size_t aCount );
+
     /**
      * Function GetQuoteChar
      * performs quote character need determination according to the Specctra DSN
@@ -432,7 +508,16 @@ public:
      */
      virtual std::string Quotes( const std::string& aWrapee );
 
-     std::string Quotew( const wxString& aWrapee );
+    /**
+     * Function Quotew
+     * is Quotes() for a wxString, converted to UTF8.
+     * @return the quoted string, kept by the formatter until at least QUOTEW_KEPT other
+     *         strings are quoted, so it can be passed to Print() with other quoted strings.
+     */
+     const std::string& Quotew( const wxString& aWrapee );
+
+    /// The minimum number of strings quoted by Quotew() kept by the formatter
+    static const size_t QUOTEW_KEPT = 16;
 
     //-----</interface functions>-----------------------------------------
 };
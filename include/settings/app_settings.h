@@ -143,6 +143,7 @@ public:
     {
         bool                  first_run_shown;
         int                   max_undo_items;
+        int                   max_undo_memory;  ///< Memory budget of the undo list, in MB
         std::vector<wxString> file_history;
         int                   units;
         int                   last_metric_units;
@@ -25,6 +25,8 @@
 
 #ifndef _CLASS_UNDOREDO_CONTAINER_H
 #define _CLASS_UNDOREDO_CONTAINER_H
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <base_struct.h>
@@ -142,11 +144,22 @@ public:
 
 private:
     std::vector <ITEM_PICKER> m_ItemsList;
+    size_t                    m_memoryUsage;  // estimate of the memory held by the command
 
 public:
     PICKED_ITEMS_LIST();
     ~PICKED_ITEMS_LIST();
 
+    /**
+     * Function SetMemoryUsage
+     * sets the estimate of the memory held by the command (the picked copies and
+     * deleted items), see EDA_BASE_FRAME::GetCommandMemoryUsage().  Use
+     * UNDO_REDO_CONTAINER::SetMemoryUsage() for a command held by an undo/redo list.
+     */
+    void SetMemoryUsage( size_t aUsage ) { m_memoryUsage = aUsage; }
+
+    size_t GetMemoryUsage() const { return m_memoryUsage; }
+
     /**
      * Function PushItem
      * pushes \a aItem to the top of the list
@@ -322,6 +335,16 @@ class UNDO_REDO_CONTAINER
 {
 public:
     std::vector <PICKED_ITEMS_LIST*> m_CommandsList;   // the list of possible undo/redo commands
+                                                       // (only changed by the functions below)
+
+private:
+    size_t m_memoryUsage;       // the total of the memory usage of the commands
+
+    // the commands by picked item, to find the commands holding copies of an item
+    std::unordered_multimap<const EDA_ITEM*, PICKED_ITEMS_LIST*> m_itemCommands;
+
+    void addCommand( PICKED_ITEMS_LIST* aCommand );
+    void removeCommand( PICKED_ITEMS_LIST* aCommand );
 
 public:
 
@@ -332,7 +355,40 @@ public:
 
     PICKED_ITEMS_LIST* PopCommand();
 
+    /**
+     * Function PopOldestCommand
+     * removes the oldest command from the list, nothing is deleted.
+     * @return the command removed, or NULL if the list is empty
+     */
+    PICKED_ITEMS_LIST* PopOldestCommand();
+
     void ClearCommandList();
+
+    /**
+     * Function GetMemoryUsage
+     * @return the estimate of the memory held by all the commands
+     */
+    size_t GetMemoryUsage() const { return m_memoryUsage; }
+
+    /**
+     * Function SetMemoryUsage
+     * sets the estimate of the memory held by \a aCommand, a command of the list, and
+     * updates the total of the list.
+     */
+    void SetMemoryUsage( PICKED_ITEMS_LIST* aCommand, size_t aUsage );
+
+    /**
+     * Function FindCommands
+     * adds the commands of the list which picked \a aItem to \a aCommands.
+     */
+    void FindCommands( const EDA_ITEM* aItem, std::set<PICKED_ITEMS_LIST*>& aCommands ) const;
+
+    /**
+     * Function GetOverBudgetCount
+     * @return the count of the oldest commands to delete for the memory held by the
+     * other commands to fit in \a aMaxMemory.  The newest command is always kept.
+     */
+    int GetOverBudgetCount( size_t aMaxMemory ) const;
 };
 
 
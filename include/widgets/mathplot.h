@@ -1579,6 +1579,11 @@ public:
      */
     virtual void SetData( const std::vector<double>& xs, const std::vector<double>& ys );
 
+    /** Changes the internal data, taking the vectors instead of copying them.
+     * @sa SetData
+     */
+    virtual void SetData( std::vector<double>&& xs, std::vector<double>&& ys );
+
     /** Clears all the data, leaving the layer empty.
      * @sa SetData
      */
@@ -1597,6 +1602,10 @@ protected:
      */
     double m_minX, m_maxX, m_minY, m_maxY;
 
+    /** Updates the bounding box from the internal data
+     */
+    void UpdateBoundingBox();
+
     /** Rewind value enumeration with mpFXY::GetNextXY.
      *  Overridden in this implementation.
      */
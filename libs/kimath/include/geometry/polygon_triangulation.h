@@ -47,15 +47,24 @@
 #define __POLYGON_TRIANGULATION_H
 
 #include <algorithm>
-#include <deque>
 #include <cmath>
+#include <limits>
+#include <vector>
 
-#include <clipper.hpp>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <math/box2.h>
 #include <math/vector2d.h>
 
+/**
+ * Ear-clipping triangulator for a single outline.
+ *
+ * Vertices live in one contiguous vector and are linked by index rather than by pointer, so a
+ * polygon costs a handful of allocations instead of one node per vertex.  The ear test looks up
+ * candidate vertices in a z-order (Morton code) sorted array and skips the parts of the code
+ * range that fall outside the ear's bounding box, rather than walking every vertex in between.
+ * An instance holds no global state; separate instances may triangulate on separate threads.
+ */
 class PolygonTriangulation
 {
 
@@ -66,175 +75,256 @@ public:
     {};
 
 private:
+    ///> Index of a missing link in the vertex rings
+    static constexpr int NONE = -1;
+
     struct Vertex
     {
-        Vertex( size_t aIndex, double aX, double aY, PolygonTriangulation* aParent ) :
-                i( aIndex ), x( aX ), y( aY ), parent( aParent )
+        Vertex( int aIndex, double aX, double aY ) :
+                x( aX ), y( aY ), i( aIndex )
         {
         }
-        Vertex& operator=( const Vertex& ) = delete;
-        Vertex& operator=( Vertex&& ) = delete;
 
-        bool operator==( const Vertex& rhs ) const
-        {
-            return this->x == rhs.x && this->y == rhs.y;
-        }
-        bool operator!=( const Vertex& rhs ) const { return !( *this == rhs ); }
+        double x;
+        double y;
 
+        // index of the point in the result
+        int i;
 
-        /**
-         * Function split
-         * Splits the referenced polygon between the reference point and
-         * vertex b, assuming they are in the same polygon.  Notes that while we
-         * create a new vertex pointer for the linked list, we maintain the same
-         * vertex index value from the original polygon.  In this way, we have
-         * two polygons that both share the same vertices.
-         *
-         * Returns the pointer to the newly created vertex in the polygon that
-         * does not include the reference vertex.
-         */
-        Vertex* split( Vertex* b )
-        {
-            parent->m_vertices.emplace_back( i, x, y, parent );
-            Vertex* a2 = &parent->m_vertices.back();
-            parent->m_vertices.emplace_back( b->i, b->x, b->y, parent );
-            Vertex* b2 = &parent->m_vertices.back();
-            Vertex* an = next;
-            Vertex* bp = b->prev;
+        // previous and next vertices nodes in a polygon ring
+        int prev = NONE;
+        int next = NONE;
 
-            next = b;
-            b->prev = this;
+        // z-order curve value
+        int32_t z = 0;
 
-            a2->next = an;
-            an->prev = a2;
+        // position in m_zOrder and index of the run holding it
+        int zPos = NONE;
+        int zRun = NONE;
+    };
 
-            b2->next = a2;
-            a2->prev = b2;
+    /**
+     * Entry of the z-ordered index.  Each ring is sorted into a contiguous run of entries
+     * bracketed by sentinels, so ear tests scan a flat array instead of chasing list nodes.
+     * The coordinates are copied in so most candidates are rejected without touching the
+     * vertex itself.
+     */
+    struct ZEntry
+    {
+        int32_t z;
+        int     vertex;     // NONE once the vertex has been clipped off
+        double  x;
+        double  y;
+    };
 
-            bp->next = b2;
-            b2->prev = bp;
+    BOX2I m_bbox;
+    std::vector<Vertex> m_vertices;
+    std::vector<int> m_zSortBuffer;
+    std::vector<ZEntry> m_zOrder;
+    std::vector<std::pair<int, int>> m_zRuns;    // first and last sentinel of each run
+    SHAPE_POLY_SET::TRIANGULATED_POLYGON& m_result;
 
-            return b2;
-        }
+    bool samePoint( int a, int b ) const
+    {
+        return m_vertices[a].x == m_vertices[b].x && m_vertices[a].y == m_vertices[b].y;
+    }
 
-        /**
-         * Function remove
-         * Removes the node from the linked list and z-ordered linked list.
-         */
-        void remove()
-        {
-            next->prev = prev;
-            prev->next = next;
-
-            if( prevZ )
-                prevZ->nextZ = nextZ;
-            if( nextZ )
-                nextZ->prevZ = prevZ;
-            next = NULL;
-            prev = NULL;
-            nextZ = NULL;
-            prevZ = NULL;
-        }
+    /**
+     * Function split
+     * Splits the referenced polygon between vertex a and vertex b, assuming they are in the
+     * same polygon.  Notes that while we create a new vertex node for the linked list, we
+     * maintain the same vertex index value from the original polygon.  In this way, we have
+     * two polygons that both share the same vertices.
+     *
+     * Returns the index of the newly created vertex in the polygon that does not include
+     * vertex a.
+     */
+    int split( int a, int b )
+    {
+        const Vertex va = m_vertices[a];
+        const Vertex vb = m_vertices[b];
 
+        int a2 = static_cast<int>( m_vertices.size() );
+        m_vertices.emplace_back( va.i, va.x, va.y );
+        int b2 = static_cast<int>( m_vertices.size() );
+        m_vertices.emplace_back( vb.i, vb.x, vb.y );
 
-        void updateOrder()
-        {
-            if( !z )
-                z = parent->zOrder( x, y );
-        }
+        int an = va.next;
+        int bp = vb.prev;
 
-        /**
-         * Function updateList
-         * After inserting or changing nodes, this function should be called to
-         * remove duplicate vertices and ensure z-ordering is correct
-         */
-        void updateList()
-        {
-            Vertex* p = next;
+        m_vertices[a].next = b;
+        m_vertices[b].prev = a;
 
-            while( p != this )
-            {
-                /**
-                 * Remove duplicates
-                 */
-                if( *p == *p->next )
-                {
-                    p = p->prev;
-                    p->next->remove();
+        m_vertices[a2].next = an;
+        m_vertices[an].prev = a2;
 
-                    if( p == p->next )
-                        break;
-                }
+        m_vertices[b2].next = a2;
+        m_vertices[a2].prev = b2;
 
-                p->updateOrder();
-                p = p->next;
-            };
+        m_vertices[bp].next = b2;
+        m_vertices[b2].prev = bp;
 
-            updateOrder();
-            zSort();
-        }
+        return b2;
+    }
 
-        /**
-         * Sort all vertices in this vertex's list by their Morton code
-         */
-        void zSort()
-        {
-            std::deque<Vertex*> queue;
+    /**
+     * Function remove
+     * Removes the node from the linked list and z-ordered linked list.
+     */
+    void remove( int p )
+    {
+        Vertex& v = m_vertices[p];
 
-            queue.push_back( this );
+        m_vertices[v.next].prev = v.prev;
+        m_vertices[v.prev].next = v.next;
 
-            for( auto p = next; p && p != this; p = p->next )
-                queue.push_back( p );
+        if( v.zPos != NONE )
+            m_zOrder[v.zPos].vertex = NONE;
 
-            std::sort( queue.begin(), queue.end(), []( const Vertex* a, const Vertex* b)
-            {
-                return a->z < b->z;
-            } );
+        v.next = NONE;
+        v.prev = NONE;
+        v.zPos = NONE;
+        v.zRun = NONE;
+    }
+
+
+    void updateOrder( int p )
+    {
+        Vertex& v = m_vertices[p];
+
+        if( !v.z )
+            v.z = zOrder( v.x, v.y );
+    }
+
+    /**
+     * Function updateList
+     * After inserting or changing nodes, this function should be called to
+     * remove duplicate vertices and ensure z-ordering is correct
+     */
+    void updateList( int aStart )
+    {
+        int p = m_vertices[aStart].next;
 
-            Vertex* prev_elem = nullptr;
-            for( auto elem : queue )
+        while( p != aStart )
+        {
+            /**
+             * Remove duplicates
+             */
+            if( samePoint( p, m_vertices[p].next ) )
             {
-                if( prev_elem )
-                    prev_elem->nextZ = elem;
+                p = m_vertices[p].prev;
+                remove( m_vertices[p].next );
 
-                elem->prevZ = prev_elem;
-                prev_elem = elem;
+                if( p == m_vertices[p].next )
+                    break;
             }
 
-            prev_elem->nextZ = nullptr;
+            updateOrder( p );
+            p = m_vertices[p].next;
+        };
+
+        updateOrder( aStart );
+        zSort( aStart );
+    }
+
+    /**
+     * Sort all vertices in aStart's list by their Morton code into a new run of m_zOrder
+     */
+    void zSort( int aStart )
+    {
+        std::vector<int>& queue = m_zSortBuffer;
+
+        queue.clear();
+        queue.push_back( aStart );
+
+        for( int p = m_vertices[aStart].next; p != NONE && p != aStart; p = m_vertices[p].next )
+            queue.push_back( p );
+
+        std::sort( queue.begin(), queue.end(), [this]( int a, int b )
+        {
+            return m_vertices[a].z < m_vertices[b].z;
+        } );
+
+        // Morton codes are never negative and fit in 30 bits, so the sentinels stop the scans
+        // in isEar() at either end of the run
+        int run = static_cast<int>( m_zRuns.size() );
+        int first = static_cast<int>( m_zOrder.size() );
+
+        m_zOrder.push_back( { std::numeric_limits<int32_t>::min(), NONE, 0.0, 0.0 } );
+
+        for( int elem : queue )
+        {
+            Vertex& v = m_vertices[elem];
+
+            v.zPos = static_cast<int>( m_zOrder.size() );
+            v.zRun = run;
+            m_zOrder.push_back( { v.z, elem, v.x, v.y } );
         }
 
+        m_zRuns.emplace_back( first, static_cast<int>( m_zOrder.size() ) );
+        m_zOrder.push_back( { std::numeric_limits<int32_t>::max(), NONE, 0.0, 0.0 } );
+    }
 
-        /**
-         * Check to see if triangle surrounds our current vertex
-         */
-        bool inTriangle( const Vertex& a, const Vertex& b, const Vertex& c )
+
+    /**
+     * Index of the first entry after aPos with a code of at least aZ, searching up to the run
+     * end sentinel aEnd.  Gallops from aPos as the target is usually close by.
+     */
+    int seekForward( int aPos, int aEnd, int32_t aZ ) const
+    {
+        const ZEntry* zs = m_zOrder.data();
+        int           lo = aPos;
+        int           step = 1;
+
+        while( lo + step < aEnd && zs[lo + step].z < aZ )
         {
-            return     ( c.x - x ) * ( a.y - y ) - ( a.x - x ) * ( c.y - y ) >= 0
-                    && ( a.x - x ) * ( b.y - y ) - ( b.x - x ) * ( a.y - y ) >= 0
-                    && ( b.x - x ) * ( c.y - y ) - ( c.x - x ) * ( b.y - y ) >= 0;
+            lo += step;
+            step *= 2;
         }
 
-        const size_t i;
-        const double x;
-        const double y;
-        PolygonTriangulation* parent;
+        int hi = std::min( lo + step, aEnd );
 
-        // previous and next vertices nodes in a polygon ring
-        Vertex* prev = nullptr;
-        Vertex* next = nullptr;
+        return std::lower_bound( zs + lo + 1, zs + hi + 1, aZ,
+                                 []( const ZEntry& e, int32_t z )
+                                 {
+                                     return e.z < z;
+                                 } ) - zs;
+    }
 
-        // z-order curve value
-        int32_t z = 0;
+    /**
+     * Index of the last entry before aPos with a code of at most aZ, searching down to the
+     * run start sentinel aFirst
+     */
+    int seekBackward( int aPos, int aFirst, int32_t aZ ) const
+    {
+        const ZEntry* zs = m_zOrder.data();
+        int           hi = aPos;
+        int           step = 1;
 
-        // previous and next nodes in z-order
-        Vertex* prevZ = nullptr;
-        Vertex* nextZ = nullptr;
-    };
+        while( hi - step > aFirst && zs[hi - step].z > aZ )
+        {
+            hi -= step;
+            step *= 2;
+        }
 
-    BOX2I m_bbox;
-    std::deque<Vertex> m_vertices;
-    SHAPE_POLY_SET::TRIANGULATED_POLYGON& m_result;
+        int lo = std::max( hi - step, aFirst );
+
+        return std::upper_bound( zs + lo, zs + hi, aZ,
+                                 []( int32_t z, const ZEntry& e )
+                                 {
+                                     return z < e.z;
+                                 } ) - zs - 1;
+    }
+
+    /**
+     * Check to see if triangle a, b, c surrounds vertex p
+     */
+    static bool inTriangle( const Vertex& a, const Vertex& b, const Vertex& c, const Vertex& p )
+    {
+        return     ( c.x - p.x ) * ( a.y - p.y ) - ( a.x - p.x ) * ( c.y - p.y ) >= 0
+                && ( a.x - p.x ) * ( b.y - p.y ) - ( b.x - p.x ) * ( a.y - p.y ) >= 0
+                && ( b.x - p.x ) * ( c.y - p.y ) - ( c.x - p.x ) * ( b.y - p.y ) >= 0;
+    }
 
     /**
      * Calculate the Morton code of the Vertex
@@ -260,83 +350,148 @@ private:
     }
 
     /**
-     * Function removeNullTriangles
-     * Iterates through the list to remove NULL triangles if they exist.
-     * This should only be called as a last resort when tesselation fails
-     * as the NULL triangles are inserted as Steiner points to improve the
-     * triangulation regularity of polygons
+     * Sets bit aBit of the Morton code aZ and clears the lower bits of the same axis (aOne),
+     * or clears it and sets the lower bits (!aOne)
      */
-    Vertex* removeNullTriangles( Vertex* aStart )
+    static uint32_t zLoad( uint32_t aZ, int aBit, bool aOne )
     {
-        Vertex* retval = nullptr;
-        Vertex* p = aStart->next;
+        const uint32_t axis = ( aBit & 1 ) ? 0xAAAAAAAA : 0x55555555;
+        const uint32_t lower = axis & ( ( 1u << aBit ) - 1 );
 
-        while( p != aStart )
-        {
-            if( area( p->prev, p, p->next ) == 0.0 )
-            {
-                p = p->prev;
-                p->next->remove();
-                retval = aStart;
+        if( aOne )
+            return ( aZ | ( 1u << aBit ) ) & ~lower;
+        else
+            return ( aZ & ~( 1u << aBit ) ) | lower;
+    }
 
-                if( p == p->next )
-                    break;
-            }
-            p = p->next;
-        };
+    /**
+     * Highest bit where aZ, aMinZ and aMaxZ are not all the same; bigMin() and litMax() have
+     * nothing to do above it
+     */
+    static int highestDifferingBit( int32_t aZ, int32_t aMinZ, int32_t aMaxZ )
+    {
+        const uint32_t diff = uint32_t( aZ ^ aMinZ ) | uint32_t( aMinZ ^ aMaxZ );
+        int            bit = 31;
 
-        // We needed an end point above that wouldn't be removed, so
-        // here we do the final check for this as a Steiner point
-        if( area( aStart->prev, aStart, aStart->next ) == 0.0 )
-        {
-            retval = p->next;
-            p->remove();
-        }
+        while( bit > 0 && !( diff & ( 1u << bit ) ) )
+            bit--;
 
-        return retval;
+        return bit;
     }
 
     /**
-     * Function createList
-     * Takes a Clipper path and converts it into a circular, doubly-linked
-     * list for triangulation
+     * Smallest Morton code greater than aZ lying inside the box spanned by aMinZ and aMaxZ
+     * (BIGMIN of Tropf and Herzog).  aZ must lie outside the box, between aMinZ and aMaxZ.
      */
-    Vertex* createList( const ClipperLib::Path& aPath )
+    static int32_t bigMin( int32_t aZ, int32_t aMinZ, int32_t aMaxZ )
     {
-        Vertex* tail = nullptr;
-        double sum = 0.0;
-        auto len = aPath.size();
+        uint32_t zmin = aMinZ;
+        uint32_t zmax = aMaxZ;
+        uint32_t result = zmax;
 
-        // Check for winding order
-        for( size_t i = 0; i < len; i++ )
+        for( int bit = highestDifferingBit( aZ, aMinZ, aMaxZ ); bit >= 0; bit-- )
         {
-            auto p1 = aPath.at( i );
-            auto p2 = aPath.at( ( i + 1 ) < len ? i + 1 : 0 );
+            const uint32_t mask = 1u << bit;
+            const bool     v = aZ & mask;
+            const bool     lo = zmin & mask;
+            const bool     hi = zmax & mask;
 
-            sum += ( ( p2.X - p1.X ) * ( p2.Y + p1.Y ) );
+            if( !v && !lo && hi )
+            {
+                result = zLoad( zmin, bit, true );
+                zmax = zLoad( zmax, bit, false );
+            }
+            else if( !v && lo && hi )
+            {
+                return zmin;
+            }
+            else if( v && !lo && !hi )
+            {
+                return result;
+            }
+            else if( v && !lo && hi )
+            {
+                zmin = zLoad( zmin, bit, true );
+            }
         }
 
-        if( sum <= 0.0 )
+        return result;
+    }
+
+    /**
+     * Largest Morton code smaller than aZ lying inside the box spanned by aMinZ and aMaxZ
+     * (LITMAX of Tropf and Herzog).  aZ must lie outside the box, between aMinZ and aMaxZ.
+     */
+    static int32_t litMax( int32_t aZ, int32_t aMinZ, int32_t aMaxZ )
+    {
+        uint32_t zmin = aMinZ;
+        uint32_t zmax = aMaxZ;
+        uint32_t result = zmin;
+
+        for( int bit = highestDifferingBit( aZ, aMinZ, aMaxZ ); bit >= 0; bit-- )
         {
-            for( auto point : aPath )
-                tail = insertVertex( VECTOR2I( point.X, point.Y ), tail );
+            const uint32_t mask = 1u << bit;
+            const bool     v = aZ & mask;
+            const bool     lo = zmin & mask;
+            const bool     hi = zmax & mask;
+
+            if( !v && !lo && hi )
+            {
+                zmax = zLoad( zmax, bit, false );
+            }
+            else if( !v && lo && hi )
+            {
+                return result;
+            }
+            else if( v && !lo && !hi )
+            {
+                return zmax;
+            }
+            else if( v && !lo && hi )
+            {
+                result = zLoad( zmax, bit, false );
+                zmin = zLoad( zmin, bit, true );
+            }
         }
-        else
+
+        return result;
+    }
+
+    /**
+     * Function removeNullTriangles
+     * Iterates through the list to remove NULL triangles if they exist.
+     * This should only be called as a last resort when tesselation fails
+     * as the NULL triangles are inserted as Steiner points to improve the
+     * triangulation regularity of polygons
+     */
+    int removeNullTriangles( int aStart )
+    {
+        int retval = NONE;
+        int p = m_vertices[aStart].next;
+
+        while( p != aStart )
         {
-            for( size_t i = 0; i < len; i++ )
+            if( area( m_vertices[p].prev, p, m_vertices[p].next ) == 0.0 )
             {
-                auto p = aPath.at( len - i - 1 );
-                tail = insertVertex( VECTOR2I( p.X, p.Y ), tail );
+                p = m_vertices[p].prev;
+                remove( m_vertices[p].next );
+                retval = aStart;
+
+                if( p == m_vertices[p].next )
+                    break;
             }
-        }
+            p = m_vertices[p].next;
+        };
 
-        if( tail && ( *tail == *tail->next ) )
+        // We needed an end point above that wouldn't be removed, so
+        // here we do the final check for this as a Steiner point
+        if( area( m_vertices[aStart].prev, aStart, m_vertices[aStart].next ) == 0.0 )
         {
-            tail->next->remove();
+            retval = m_vertices[p].next;
+            remove( p );
         }
 
-        return tail;
-
+        return retval;
     }
 
     /**
@@ -344,9 +499,9 @@ private:
      * Takes the SHAPE_LINE_CHAIN and links each point into a
      * circular, doubly-linked list
      */
-    Vertex* createList( const SHAPE_LINE_CHAIN& points )
+    int createList( const SHAPE_LINE_CHAIN& points )
     {
-        Vertex* tail = nullptr;
+        int tail = NONE;
         double sum = 0.0;
 
         // Check for winding order
@@ -365,9 +520,9 @@ private:
             for( int i = 0; i < points.PointCount(); i++ )
                 tail = insertVertex( points.CPoint( i ), tail );
 
-        if( tail && ( *tail == *tail->next ) )
+        if( tail != NONE && samePoint( tail, m_vertices[tail].next ) )
         {
-            tail->next->remove();
+            remove( m_vertices[tail].next );
         }
 
         return tail;
@@ -384,46 +539,71 @@ private:
      * there is an intersection (not technically allowed by KiCad, but could exist in an edited file),
      * we create a single triangle and remove both vertices before attempting to
      */
-    bool earcutList( Vertex* aPoint, int pass = 0 )
+    bool earcutList( int aPoint, int pass = 0 )
     {
-        if( !aPoint )
+        if( aPoint == NONE )
             return true;
 
-        Vertex* stop = aPoint;
-        Vertex* prev;
-        Vertex* next;
+        int stop = aPoint;
+        int prev;
+        int next;
 
-        while( aPoint->prev != aPoint->next )
+        // Clipped vertices stay in the z-order run as dead entries; re-sort the ring once they
+        // outnumber the live ones so the ear tests do not scan mostly dead space
+        int live = 1;
+        int dead = 0;
+
+        for( int p = m_vertices[aPoint].next; p != aPoint; p = m_vertices[p].next )
+            live++;
+
+        auto compact =
+                [&]( int aRemoved )
+                {
+                    dead += aRemoved;
+
+                    if( dead > live / 2 && m_vertices[aPoint].next != NONE )
+                    {
+                        zSort( aPoint );
+                        live -= dead;
+                        dead = 0;
+                    }
+                };
+
+        while( m_vertices[aPoint].prev != m_vertices[aPoint].next )
         {
-            prev = aPoint->prev;
-            next = aPoint->next;
+            prev = m_vertices[aPoint].prev;
+            next = m_vertices[aPoint].next;
 
             if( isEar( aPoint ) )
             {
-                m_result.AddTriangle( prev->i, aPoint->i, next->i );
-                aPoint->remove();
+                m_result.AddTriangle( m_vertices[prev].i, m_vertices[aPoint].i,
+                                      m_vertices[next].i );
+                remove( aPoint );
 
                 // Skip one vertex as the triangle will account for the prev node
-                aPoint = next->next;
-                stop = next->next;
+                aPoint = m_vertices[next].next;
+                stop = aPoint;
+                compact( 1 );
 
                 continue;
             }
 
-            Vertex* nextNext = next->next;
+            int nextNext = m_vertices[next].next;
 
-            if( *prev != *nextNext && intersects( prev, aPoint, next, nextNext ) &&
+            if( !samePoint( prev, nextNext ) && intersects( prev, aPoint, next, nextNext ) &&
                     locallyInside( prev, nextNext ) &&
                     locallyInside( nextNext, prev ) )
             {
-                m_result.AddTriangle( prev->i, aPoint->i, nextNext->i );
+                m_result.AddTriangle( m_vertices[prev].i, m_vertices[aPoint].i,
+                                      m_vertices[nextNext].i );
 
                 // remove two nodes involved
-                next->remove();
-                aPoint->remove();
+                remove( next );
+                remove( aPoint );
 
                 aPoint = nextNext;
                 stop = nextNext;
+                compact( 2 );
 
                 continue;
             }
@@ -438,7 +618,9 @@ private:
             {
                 // First, try to remove the remaining steiner points
                 // If aPoint is a steiner, we need to re-assign both the start and stop points
-                if( auto newPoint = removeNullTriangles( aPoint ) )
+                int newPoint = removeNullTriangles( aPoint );
+
+                if( newPoint != NONE )
                 {
                     aPoint = newPoint;
                     stop = newPoint;
@@ -454,7 +636,7 @@ private:
         /**
          * At this point, our polygon should be fully tesselated.
          */
-        return( aPoint->prev == aPoint->next );
+        return( m_vertices[aPoint].prev == m_vertices[aPoint].next );
     }
 
     /**
@@ -466,49 +648,89 @@ private:
      *
      * Returns true if aEar is the apex point of a ear in the polygon
      */
-    bool isEar( Vertex* aEar ) const
+    bool isEar( int aEar ) const
     {
-        const Vertex* a = aEar->prev;
-        const Vertex* b = aEar;
-        const Vertex* c = aEar->next;
+        const Vertex* v = m_vertices.data();
+        const int     a = v[aEar].prev;
+        const int     c = v[aEar].next;
+        const Vertex& va = v[a];
+        const Vertex& vb = v[aEar];
+        const Vertex& vc = v[c];
 
         // If the area >=0, then the three points for a concave sequence
         // with b as the reflex point
-        if( area( a, b, c ) >= 0 )
+        if( area( va, vb, vc ) >= 0 )
             return false;
 
         // triangle bbox
-        const double minTX = std::min( a->x, std::min( b->x, c->x ) );
-        const double minTY = std::min( a->y, std::min( b->y, c->y ) );
-        const double maxTX = std::max( a->x, std::max( b->x, c->x ) );
-        const double maxTY = std::max( a->y, std::max( b->y, c->y ) );
+        const double minTX = std::min( va.x, std::min( vb.x, vc.x ) );
+        const double minTY = std::min( va.y, std::min( vb.y, vc.y ) );
+        const double maxTX = std::max( va.x, std::max( vb.x, vc.x ) );
+        const double maxTY = std::max( va.y, std::max( vb.y, vc.y ) );
 
-        // z-order range for the current triangle bounding box
+        // z-order range for the current triangle bounding box.  The range also covers points
+        // outside the bbox, so those are rejected cheaply before the full triangle test
         const int32_t minZ = zOrder( minTX, minTY );
         const int32_t maxZ = zOrder( maxTX, maxTY );
 
-        // first look for points inside the triangle in increasing z-order
-        Vertex* p = aEar->nextZ;
+        if( vb.zPos == NONE )
+            return true;
+
+        auto blocksEar =
+                [&]( const ZEntry& e )
+                {
+                    return e.vertex != NONE && e.vertex != a && e.vertex != c
+                            && e.x >= minTX && e.x <= maxTX && e.y >= minTY && e.y <= maxTY
+                            && inTriangle( va, vb, vc, v[e.vertex] )
+                            && area( v[v[e.vertex].prev], v[e.vertex], v[v[e.vertex].next] ) >= 0;
+                };
+
+        const ZEntry*                 zs = m_zOrder.data();
+        const std::pair<int, int>&    run = m_zRuns[vb.zRun];
+        constexpr uint32_t            xAxis = 0x55555555;
+        constexpr uint32_t            yAxis = 0xAAAAAAAA;
+
+        // The z-range of the bbox also holds long stretches of points outside it; these are
+        // skipped by searching for the next code that falls back inside the bbox
+        auto inZBox =
+                [&]( uint32_t z )
+                {
+                    return ( z & xAxis ) >= ( uint32_t( minZ ) & xAxis )
+                            && ( z & xAxis ) <= ( uint32_t( maxZ ) & xAxis )
+                            && ( z & yAxis ) >= ( uint32_t( minZ ) & yAxis )
+                            && ( z & yAxis ) <= ( uint32_t( maxZ ) & yAxis );
+                };
 
-        while( p && p->z <= maxZ )
+        // first look for points inside the triangle in increasing z-order
+        for( int k = vb.zPos + 1; zs[k].z <= maxZ; )
         {
-            if( p != a && p != c
-                    && p->inTriangle( *a, *b, *c )
-                    && area( p->prev, p, p->next ) >= 0 )
-                return false;
-            p = p->nextZ;
+            if( inZBox( zs[k].z ) )
+            {
+                if( blocksEar( zs[k] ) )
+                    return false;
+
+                k++;
+            }
+            else
+            {
+                k = seekForward( k, run.second, bigMin( zs[k].z, minZ, maxZ ) );
+            }
         }
 
         // then look for points in decreasing z-order
-        p = aEar->prevZ;
-
-        while( p && p->z >= minZ )
+        for( int k = vb.zPos - 1; zs[k].z >= minZ; )
         {
-            if( p != a && p != c
-                    && p->inTriangle( *a, *b, *c )
-                    && area( p->prev, p, p->next ) >= 0 )
-                return false;
-            p = p->prevZ;
+            if( inZBox( zs[k].z ) )
+            {
+                if( blocksEar( zs[k] ) )
+                    return false;
+
+                k--;
+            }
+            else
+            {
+                k = seekBackward( k, run.first, litMax( zs[k].z, minZ, maxZ ) );
+            }
         }
 
         return true;
@@ -521,29 +743,31 @@ private:
      * independently.  This is assured to generate at least one new ear if the
      * split is successful
      */
-    void splitPolygon( Vertex* start )
+    void splitPolygon( int start )
     {
-        Vertex* origPoly = start;
+        int origPoly = start;
         do
         {
-            Vertex* marker = origPoly->next->next;
-            while( marker != origPoly->prev )
+            int marker = m_vertices[m_vertices[origPoly].next].next;
+
+            while( marker != m_vertices[origPoly].prev )
             {
                 // Find a diagonal line that is wholly enclosed by the polygon interior
-                if( origPoly->i != marker->i && goodSplit( origPoly, marker ) )
+                if( m_vertices[origPoly].i != m_vertices[marker].i
+                        && goodSplit( origPoly, marker ) )
                 {
-                    Vertex* newPoly = origPoly->split( marker );
+                    int newPoly = split( origPoly, marker );
 
-                    origPoly->updateList();
-                    newPoly->updateList();
+                    updateList( origPoly );
+                    updateList( newPoly );
 
                     earcutList( origPoly );
                     earcutList( newPoly );
                     return;
                 }
-                marker = marker->next;
+                marker = m_vertices[marker].next;
             }
-            origPoly = origPoly->next;
+            origPoly = m_vertices[origPoly].next;
         } while( origPoly != start );
     }
 
@@ -555,10 +779,10 @@ private:
      * the segment is enclosed by the local triangles, we distinguish between
      * these two cases and no further checks are needed.
      */
-    bool goodSplit( const Vertex* a, const Vertex* b ) const
+    bool goodSplit( int a, int b ) const
     {
-        return a->next->i != b->i &&
-               a->prev->i != b->i &&
+        return m_vertices[m_vertices[a].next].i != m_vertices[b].i &&
+               m_vertices[m_vertices[a].prev].i != m_vertices[b].i &&
                !intersectsPolygon( a, b ) &&
                locallyInside( a, b );
     }
@@ -568,9 +792,14 @@ private:
      * Returns the twice the signed area of the triangle formed by vertices
      * p, q, r.
      */
-    double area( const Vertex* p, const Vertex* q, const Vertex* r ) const
+    double area( int p, int q, int r ) const
     {
-        return ( q->y - p->y ) * ( r->x - q->x ) - ( q->x - p->x ) * ( r->y - q->y );
+        return area( m_vertices[p], m_vertices[q], m_vertices[r] );
+    }
+
+    static double area( const Vertex& p, const Vertex& q, const Vertex& r )
+    {
+        return ( q.y - p.y ) * ( r.x - q.x ) - ( q.x - p.x ) * ( r.y - q.y );
     }
 
     /**
@@ -578,9 +807,10 @@ private:
      * Checks for intersection between two segments, end points included.
      * Returns true if p1-p2 intersects q1-q2
      */
-    bool intersects( const Vertex* p1, const Vertex* q1, const Vertex* p2, const Vertex* q2 ) const
+    bool intersects( int p1, int q1, int p2, int q2 ) const
     {
-        if( ( *p1 == *q1 && *p2 == *q2 ) || ( *p1 == *q2 && *p2 == *q1 ) )
+        if( ( samePoint( p1, q1 ) && samePoint( p2, q2 ) )
+                || ( samePoint( p1, q2 ) && samePoint( p2, q1 ) ) )
             return true;
 
         return ( area( p1, q1, p2 ) > 0 ) != ( area( p1, q1, q2 ) > 0 )
@@ -593,18 +823,23 @@ private:
      * of the polygon of which vertex a is a member.
      * Return true if the segment intersects the edge of the polygon
      */
-    bool intersectsPolygon( const Vertex* a, const Vertex* b ) const
+    bool intersectsPolygon( int a, int b ) const
     {
-        const Vertex* p = a->next;
+        const int ai = m_vertices[a].i;
+        const int bi = m_vertices[b].i;
+        int          p = m_vertices[a].next;
+
         do
         {
-            if( p->i != a->i &&
-                p->next->i != a->i &&
-                p->i != b->i &&
-                p->next->i != b->i && intersects( p, p->next, a, b ) )
+            const int pn = m_vertices[p].next;
+
+            if( m_vertices[p].i != ai &&
+                m_vertices[pn].i != ai &&
+                m_vertices[p].i != bi &&
+                m_vertices[pn].i != bi && intersects( p, pn, a, b ) )
                 return true;
 
-            p = p->next;
+            p = pn;
         } while( p != a );
 
         return false;
@@ -618,37 +853,43 @@ private:
      * immediately adjacent to vertex a.
      * Returns true if the segment from a->b is inside a's polygon next to vertex a
      */
-    bool locallyInside( const Vertex* a, const Vertex* b ) const
+    bool locallyInside( int a, int b ) const
     {
-        if( area( a->prev, a, a->next ) < 0 )
-            return area( a, b, a->next ) >= 0 && area( a, a->prev, b ) >= 0;
+        const int prev = m_vertices[a].prev;
+        const int next = m_vertices[a].next;
+
+        if( area( prev, a, next ) < 0 )
+            return area( a, b, next ) >= 0 && area( a, prev, b ) >= 0;
         else
-            return area( a, b, a->prev ) < 0 || area( a, a->next, b ) < 0;
+            return area( a, b, prev ) < 0 || area( a, next, b ) < 0;
     }
 
     /**
      * Function insertVertex
      * Creates an entry in the vertices lookup and optionally inserts the newly
      * created vertex into an existing linked list.
-     * Returns a pointer to the newly created vertex
+     * Returns the index of the newly created vertex
      */
-    Vertex* insertVertex( const VECTOR2I& pt, Vertex* last )
+    int insertVertex( const VECTOR2I& pt, int last )
     {
         m_result.AddVertex( pt );
-        m_vertices.emplace_back( m_result.GetVertexCount() - 1, pt.x, pt.y, this );
+        m_vertices.emplace_back( static_cast<int>( m_result.GetVertexCount() ) - 1, pt.x, pt.y );
+
+        int p = static_cast<int>( m_vertices.size() ) - 1;
 
-        Vertex* p = &m_vertices.back();
-        if( !last )
+        if( last == NONE )
         {
-            p->prev = p;
-            p->next = p;
+            m_vertices[p].prev = p;
+            m_vertices[p].next = p;
         }
         else
         {
-            p->next = last->next;
-            p->prev = last;
-            last->next->prev = p;
-            last->next = p;
+            int lastNext = m_vertices[last].next;
+
+            m_vertices[p].next = lastNext;
+            m_vertices[p].prev = last;
+            m_vertices[lastNext].prev = p;
+            m_vertices[last].next = p;
         }
         return p;
     }
@@ -664,17 +905,27 @@ public:
         if( !m_bbox.GetWidth() || !m_bbox.GetHeight() )
             return false;
 
+        // Each split adds two nodes; leave some headroom so most polygons never reallocate
+        m_vertices.clear();
+        m_vertices.reserve( aPoly.PointCount() + aPoly.PointCount() / 4 + 8 );
+        m_zOrder.clear();
+        m_zOrder.reserve( aPoly.PointCount() + 2 );
+        m_zRuns.clear();
+
         /// Place the polygon Vertices into a circular linked list
         /// and check for lists that have only 0, 1 or 2 elements and
         /// therefore cannot be polygons
-        Vertex* firstVertex = createList( aPoly );
-        if( !firstVertex || firstVertex->prev == firstVertex->next )
+        int firstVertex = createList( aPoly );
+
+        if( firstVertex == NONE || m_vertices[firstVertex].prev == m_vertices[firstVertex].next )
             return false;
 
-        firstVertex->updateList();
+        updateList( firstVertex );
 
         auto retval = earcutList( firstVertex );
         m_vertices.clear();
+        m_zOrder.clear();
+        m_zRuns.clear();
         return retval;
     }
 };
@@ -928,6 +928,42 @@ class SHAPE_POLY_SET : public SHAPE
         void BooleanIntersection( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                                   POLYGON_MODE aFastMode );
 
+        /**
+         * Tiled, multi-threaded variants of the boolean operations above.
+         *
+         * The operands are partitioned into a grid of aTileCount x aTileCount spatial tiles
+         * covering their bounding box.  Each tile only sees the contours which touch it and is
+         * processed by Clipper on its own thread; the per-tile results are then stitched back
+         * together by a parallel pairwise union.  The result is equivalent to the monolithic
+         * operation, except that edges crossing a seam get an extra vertex rounded to the
+         * nearest unit.  A tile count of 1 or less falls back to the monolithic operation.
+         */
+        void BooleanAddTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode, int aTileCount );
+
+        void BooleanSubtractTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                   int aTileCount );
+
+        void BooleanIntersectionTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                       int aTileCount );
+
+        /**
+         * Limits the threads used by the tiled operations (and the parallel triangulation)
+         * started from the calling thread, as long as the object lives.  By default they use
+         * one thread per core: callers which already run on several worker threads give each
+         * worker its share of the cores, so the workers don't start a thread per core each.
+         * The threads of the tiled operations themselves never start more threads.
+         */
+        class TILED_THREAD_BUDGET
+        {
+        public:
+            ///> @param aThreadCount is the count of threads to use, at least 1
+            TILED_THREAD_BUDGET( size_t aThreadCount );
+            ~TILED_THREAD_BUDGET();
+
+        private:
+            size_t m_previous;
+        };
+
         enum CORNER_STRATEGY    ///< define how inflate transform build inflated polygon
         {
             ALLOW_ACUTE_CORNERS,    ///< just inflate the polygon. Acute angles create spikes
@@ -961,6 +997,16 @@ class SHAPE_POLY_SET : public SHAPE
             Inflate( -aAmount, aCircleSegmentsCount, aCornerStrategy );
         }
 
+        /**
+         * Tiled, multi-threaded variant of Inflate().  Polygons are grouped by the tile holding
+         * the centre of their bounding box, each group is offset on its own thread and the
+         * groups are merged back.  Only sets with many polygons benefit; a single huge polygon
+         * is still offset in one piece.  For deflation the polygons must not overlap (which is
+         * always the case for the result of a boolean operation).
+         */
+        void InflateTiled( int aAmount, int aCircleSegmentsCount, CORNER_STRATEGY aCornerStrategy,
+                           int aTileCount );
+
         /**
          * Performs outline inflation/deflation, using round corners.  Polygons can have holes,
          * and/or linked holes with main outlines.  The resulting polygons are laso polygons with
@@ -973,6 +1019,10 @@ class SHAPE_POLY_SET : public SHAPE
         ///> For aFastMode meaning, see function booleanOp
         void Fracture( POLYGON_MODE aFastMode );
 
+        ///> Tiled, multi-threaded variant of Fracture(): simplification is tiled and the
+        ///> resulting outlines are fractured in parallel.  See BooleanAddTiled().
+        void FractureTiled( POLYGON_MODE aFastMode, int aTileCount );
+
         ///> Converts a single outline slitted ("fractured") polygon into a set ouf outlines
         ///> with holes.
         void Unfracture( POLYGON_MODE aFastMode );
@@ -988,6 +1038,9 @@ class SHAPE_POLY_SET : public SHAPE
         ///> For aFastMode meaning, see function booleanOp
         void Simplify( POLYGON_MODE aFastMode );
 
+        ///> Tiled, multi-threaded variant of Simplify().  See BooleanAddTiled().
+        void SimplifyTiled( POLYGON_MODE aFastMode, int aTileCount );
+
         /**
          * Function NormalizeAreaOutlines
          * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s)
@@ -1193,6 +1246,15 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Deletes aIdx-th polygon from the set
         void DeletePolygon( int aIdx );
 
+        /**
+         * Function DeletePolygons
+         * deletes several polygons in a single pass, the other polygons keep their order.
+         * Use it rather than DeletePolygon() in a loop, which moves the end of the set each time.
+         * @param aDelete tells for each polygon of the set if it must be deleted.  The polygons
+         *                beyond its size are kept.
+         */
+        void DeletePolygons( const std::vector<bool>& aDelete );
+
         /**
          * Function Chamfer
          * returns a chamfered version of the aIndex-th polygon.
@@ -1313,6 +1375,16 @@ class SHAPE_POLY_SET : public SHAPE
         void booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
                         const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
 
+        /** Function booleanOpTiled
+         * tiled, multi-threaded version of booleanOp().  Each contour of both operands is
+         * binned into the tiles its bounding box touches, every tile is computed on its own
+         * thread and clipped to the tile, and the tiles are merged back with a pairwise union.
+         * @param aTileCount is the number of tiles along each axis.
+         */
+        void booleanOpTiled( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
+                             const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode,
+                             int aTileCount );
+
         /**
          * containsSingle function
          * Checks whether the point aP is inside the aSubpolyIndex-th polygon of the polyset. If
@@ -1370,7 +1442,25 @@ class SHAPE_POLY_SET : public SHAPE
 
         SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& );
 
+        /**
+         * Function CacheTriangulation
+         * triangulates the outlines of the set, after fracturing them and, if \a aPartition
+         * is true, cutting them into a grid of cells.  Does nothing if the cached
+         * triangulation is up to date.
+         *
+         * An outline which cannot be triangulated is simplified and fractured again for
+         * another pass; an outline which disappears when simplified (such as a degenerate
+         * one) has no triangles.  If outlines still fail after the last pass, the result is
+         * partial: the triangles of the other outlines are kept, but the triangulation is
+         * not valid (m_triangulationValid is false), so IsTriangulationUpToDate() returns
+         * false and the next call triangulates the whole set again.
+         */
         void CacheTriangulation( bool aPartition = true );
+
+        /**
+         * @return true if the cached triangulation covers all the outlines and matches the
+         * current content of the set.
+         */
         bool IsTriangulationUpToDate() const;
 
         MD5_HASH GetHash() const;
@@ -28,13 +28,16 @@
 
 #include <algorithm>
 #include <assert.h>                          // for assert
+#include <atomic>
 #include <cmath>                             // for sqrt, cos, hypot, isinf
 #include <cstdio>
+#include <future>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <memory>
 #include <set>
 #include <string>                            // for char_traits, operator!=
+#include <thread>
 #include <type_traits>                       // for swap, move
 #include <unordered_set>
 #include <vector>
@@ -530,6 +533,488 @@ void SHAPE_POLY_SET::BooleanIntersection( const SHAPE_POLY_SET& a,
 }
 
 
+// Threads parallelFor() may use on the calling thread, 0 for one per core
+static thread_local size_t s_tiledThreadBudget = 0;
+
+
+SHAPE_POLY_SET::TILED_THREAD_BUDGET::TILED_THREAD_BUDGET( size_t aThreadCount ) :
+        m_previous( s_tiledThreadBudget )
+{
+    s_tiledThreadBudget = std::max<size_t>( 1, aThreadCount );
+}
+
+
+SHAPE_POLY_SET::TILED_THREAD_BUDGET::~TILED_THREAD_BUDGET()
+{
+    s_tiledThreadBudget = m_previous;
+}
+
+
+/**
+ * Runs aFunc( i ) for every i in [0, aCount) using one worker per core, or the thread budget of
+ * the calling thread.  Workers pick the next index from a shared counter, so uneven items
+ * balance out as they do in the zone filler.
+ */
+template <typename FUNC>
+static void parallelFor( size_t aCount, FUNC aFunc )
+{
+    size_t threads = s_tiledThreadBudget ? s_tiledThreadBudget
+                                         : std::thread::hardware_concurrency();
+    size_t parallelThreadCount = std::max<size_t>( 1, std::min<size_t>( threads, aCount ) );
+    std::atomic<size_t> nextItem( 0 );
+
+    auto worker =
+            [&]() -> size_t
+            {
+                // The items never start threads of their own
+                SHAPE_POLY_SET::TILED_THREAD_BUDGET budget( 1 );
+                size_t                              num = 0;
+
+                for( size_t i = nextItem++; i < aCount; i = nextItem++ )
+                {
+                    aFunc( i );
+                    num++;
+                }
+
+                return num;
+            };
+
+    if( parallelThreadCount <= 1 )
+    {
+        worker();
+        return;
+    }
+
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, worker );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].wait();
+}
+
+
+/**
+ * A regular grid of square-ish tiles over a bounding box, used by the tiled polygon operations.
+ * Tiles overlap their neighbours by TILE_OVERLAP so that rounding of the intersection points
+ * Clipper creates along the tile borders can never open a gap between adjacent results.
+ */
+class POLY_TILE_GRID
+{
+public:
+    static constexpr cInt TILE_OVERLAP = 2;
+
+    POLY_TILE_GRID( const BOX2I& aExtents, int aTileCount ) :
+        m_x0( aExtents.GetX() ),
+        m_y0( aExtents.GetY() ),
+        m_count( aTileCount )
+    {
+        m_w = std::max<cInt>( 1, ( (cInt) aExtents.GetWidth() + aTileCount ) / aTileCount );
+        m_h = std::max<cInt>( 1, ( (cInt) aExtents.GetHeight() + aTileCount ) / aTileCount );
+    }
+
+    size_t Count() const { return (size_t) m_count * m_count; }
+
+    int Index( int aCol, int aRow ) const { return aRow * m_count + aCol; }
+
+    int Col( cInt aX ) const { return clampCell( ( aX - m_x0 ) / m_w ); }
+    int Row( cInt aY ) const { return clampCell( ( aY - m_y0 ) / m_h ); }
+
+    ///> Tile index of the tile containing aP
+    int TileAt( const VECTOR2I& aP ) const { return Index( Col( aP.x ), Row( aP.y ) ); }
+
+    ///> Clipper rectangle of tile aIndex, including the overlap with its neighbours
+    Path TileRect( size_t aIndex ) const
+    {
+        cInt left   = m_x0 + ( aIndex % m_count ) * m_w - TILE_OVERLAP;
+        cInt top    = m_y0 + ( aIndex / m_count ) * m_h - TILE_OVERLAP;
+        cInt right  = left + m_w + 2 * TILE_OVERLAP;
+        cInt bottom = top + m_h + 2 * TILE_OVERLAP;
+
+        Path rect;
+        rect.emplace_back( left, top );
+        rect.emplace_back( right, top );
+        rect.emplace_back( right, bottom );
+        rect.emplace_back( left, bottom );
+        return rect;
+    }
+
+    /**
+     * Morton (Z-order) key of a tile.  Merging tiles in this order keeps every pairwise union
+     * between spatial neighbours, which keeps the seams short.
+     */
+    uint32_t MortonKey( size_t aIndex ) const
+    {
+        uint32_t key = 0;
+        uint32_t col = aIndex % m_count;
+        uint32_t row = aIndex / m_count;
+
+        for( int bit = 0; bit < 16; ++bit )
+        {
+            key |= ( ( col >> bit ) & 1 ) << ( 2 * bit );
+            key |= ( ( row >> bit ) & 1 ) << ( 2 * bit + 1 );
+        }
+
+        return key;
+    }
+
+private:
+    int clampCell( cInt aCell ) const
+    {
+        return (int) std::max<cInt>( 0, std::min<cInt>( m_count - 1, aCell ) );
+    }
+
+    cInt m_x0, m_y0, m_w, m_h;
+    int  m_count;
+};
+
+
+/**
+ * Converts every contour of aPolys to a Clipper path and bins it into all the tiles of aGrid
+ * its bounding box touches.  aNeedsClip is set for tiles holding at least one contour which
+ * extends outside of them.
+ */
+static void binTiledPaths( const std::vector<SHAPE_POLY_SET::POLYGON>& aPolys,
+                           const POLY_TILE_GRID& aGrid, Paths& aPaths,
+                           std::vector<std::vector<size_t>>& aBins,
+                           std::vector<char>& aNeedsClip )
+{
+    for( const SHAPE_POLY_SET::POLYGON& poly : aPolys )
+    {
+        for( size_t i = 0; i < poly.size(); i++ )
+            aPaths.push_back( poly[i].convertToClipper( i == 0 ) );
+    }
+
+    for( size_t ii = 0; ii < aPaths.size(); ++ii )
+    {
+        const Path& path = aPaths[ii];
+
+        if( path.empty() )
+            continue;
+
+        cInt minX = path[0].X, maxX = path[0].X;
+        cInt minY = path[0].Y, maxY = path[0].Y;
+
+        for( const IntPoint& pt : path )
+        {
+            minX = std::min( minX, pt.X );
+            maxX = std::max( maxX, pt.X );
+            minY = std::min( minY, pt.Y );
+            maxY = std::max( maxY, pt.Y );
+        }
+
+        int col0 = aGrid.Col( minX - POLY_TILE_GRID::TILE_OVERLAP );
+        int col1 = aGrid.Col( maxX + POLY_TILE_GRID::TILE_OVERLAP );
+        int row0 = aGrid.Row( minY - POLY_TILE_GRID::TILE_OVERLAP );
+        int row1 = aGrid.Row( maxY + POLY_TILE_GRID::TILE_OVERLAP );
+        bool straddles = col0 != col1 || row0 != row1;
+
+        for( int row = row0; row <= row1; ++row )
+        {
+            for( int col = col0; col <= col1; ++col )
+            {
+                int tile = aGrid.Index( col, row );
+
+                aBins[tile].push_back( ii );
+
+                if( straddles )
+                    aNeedsClip[tile] = true;
+            }
+        }
+    }
+}
+
+
+/**
+ * The result of one tile, split by what has to happen to it during stitching.
+ */
+struct POLY_TILE_RESULT
+{
+    ///> Polygons lying entirely inside the tile (away from the overlap with its neighbours).
+    ///> No other tile can contribute to them, so they are final.
+    std::vector<SHAPE_POLY_SET::POLYGON> m_final;
+
+    ///> Outlines reaching the tile border, with the holes that also reach it.  These have to be
+    ///> unioned with the neighbouring tiles.
+    Paths m_seam;
+
+    ///> For each seam outline, its holes lying entirely inside the tile.  They are kept out of
+    ///> the union and re-attached to whichever merged outline absorbed their owner.
+    std::vector<Paths> m_heldHoles;
+};
+
+
+/**
+ * Returns true if aPath is entirely inside tile aTile of aGrid, out of reach of the overlap of
+ * any neighbouring tile.
+ */
+static bool isInsideTileCore( const Path& aPath, const POLY_TILE_GRID& aGrid, size_t aTile )
+{
+    for( const IntPoint& pt : aPath )
+    {
+        for( cInt dx : { -POLY_TILE_GRID::TILE_OVERLAP, POLY_TILE_GRID::TILE_OVERLAP } )
+        {
+            for( cInt dy : { -POLY_TILE_GRID::TILE_OVERLAP, POLY_TILE_GRID::TILE_OVERLAP } )
+            {
+                if( (size_t) aGrid.Index( aGrid.Col( pt.X + dx ), aGrid.Row( pt.Y + dy ) ) != aTile )
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+static void splitTileResult( const PolyTree& aTree, const POLY_TILE_GRID& aGrid, size_t aTile,
+                             POLY_TILE_RESULT& aResult )
+{
+    for( PolyNode* n = aTree.GetFirst(); n; n = n->GetNext() )
+    {
+        if( n->IsHole() )
+            continue;
+
+        if( isInsideTileCore( n->Contour, aGrid, aTile ) )
+        {
+            SHAPE_POLY_SET::POLYGON paths;
+            paths.reserve( n->Childs.size() + 1 );
+            paths.push_back( n->Contour );
+
+            for( PolyNode* hole : n->Childs )
+                paths.push_back( hole->Contour );
+
+            aResult.m_final.push_back( std::move( paths ) );
+            continue;
+        }
+
+        Paths held;
+
+        aResult.m_seam.push_back( n->Contour );
+
+        for( PolyNode* hole : n->Childs )
+        {
+            if( isInsideTileCore( hole->Contour, aGrid, aTile ) )
+                held.push_back( hole->Contour );
+            else
+                aResult.m_seam.push_back( hole->Contour );
+        }
+
+        if( !held.empty() )
+            aResult.m_heldHoles.push_back( std::move( held ) );
+    }
+}
+
+
+/**
+ * Unions a set of partial results into aSolution.  Neighbouring parts are merged pairwise and
+ * in parallel until only two are left; the final union then builds the outline/hole tree.
+ */
+static void mergeTiledResults( std::vector<Paths>& aParts, bool aStrictlySimple,
+                               PolyTree& aSolution )
+{
+    aParts.erase( std::remove_if( aParts.begin(), aParts.end(),
+                                  []( const Paths& aPart )
+                                  {
+                                      return aPart.empty();
+                                  } ),
+                  aParts.end() );
+
+    while( aParts.size() > 2 )
+    {
+        std::vector<Paths> merged( ( aParts.size() + 1 ) / 2 );
+
+        parallelFor( merged.size(),
+                [&]( size_t aIdx )
+                {
+                    if( 2 * aIdx + 1 >= aParts.size() )
+                    {
+                        merged[aIdx] = std::move( aParts[2 * aIdx] );
+                        return;
+                    }
+
+                    Clipper c;
+
+                    c.StrictlySimple( aStrictlySimple );
+                    c.AddPaths( aParts[2 * aIdx], ptSubject, true );
+                    c.AddPaths( aParts[2 * aIdx + 1], ptClip, true );
+                    c.Execute( ctUnion, merged[aIdx], pftNonZero, pftNonZero );
+                } );
+
+        aParts = std::move( merged );
+    }
+
+    Clipper c;
+
+    c.StrictlySimple( aStrictlySimple );
+
+    for( const Paths& part : aParts )
+        c.AddPaths( part, ptSubject, true );
+
+    c.Execute( ctUnion, aSolution, pftNonZero, pftNonZero );
+}
+
+
+void SHAPE_POLY_SET::booleanOpTiled( ClipperLib::ClipType aType,
+        const SHAPE_POLY_SET& aShape,
+        const SHAPE_POLY_SET& aOtherShape,
+        POLYGON_MODE aFastMode,
+        int aTileCount )
+{
+    if( aTileCount <= 1 || aShape.m_polys.empty() )
+    {
+        booleanOp( aType, aShape, aOtherShape, aFastMode );
+        return;
+    }
+
+    // Difference and intersection results never extend outside of the subject, so only the
+    // subject needs to be tiled for them.
+    bool  clipExtendsResult = ( aType == ctUnion || aType == ctXor );
+    BOX2I extents = aShape.BBox();
+
+    if( clipExtendsResult && !aOtherShape.m_polys.empty() )
+        extents.Merge( aOtherShape.BBox() );
+
+    POLY_TILE_GRID                   grid( extents, aTileCount );
+    Paths                            subjectPaths, clipPaths;
+    std::vector<std::vector<size_t>> subjectBins( grid.Count() ), clipBins( grid.Count() );
+    std::vector<char>                needsClip( grid.Count(), false );
+    std::vector<POLY_TILE_RESULT>    tileResults( grid.Count() );
+    bool                             strictlySimple = ( aFastMode == PM_STRICTLY_SIMPLE );
+
+    binTiledPaths( aShape.m_polys, grid, subjectPaths, subjectBins, needsClip );
+    binTiledPaths( aOtherShape.m_polys, grid, clipPaths, clipBins, needsClip );
+
+    parallelFor( grid.Count(),
+            [&]( size_t aTile )
+            {
+                if( subjectBins[aTile].empty() && ( !clipExtendsResult || clipBins[aTile].empty() ) )
+                    return;
+
+                Clipper  c;
+                PolyTree tileSolution;
+
+                c.StrictlySimple( strictlySimple );
+
+                for( size_t idx : subjectBins[aTile] )
+                    c.AddPath( subjectPaths[idx], ptSubject, true );
+
+                for( size_t idx : clipBins[aTile] )
+                    c.AddPath( clipPaths[idx], ptClip, true );
+
+                if( !needsClip[aTile] )
+                {
+                    c.Execute( aType, tileSolution, pftNonZero, pftNonZero );
+                }
+                else
+                {
+                    // Contours crossing the tile border were included whole; trim the result
+                    // to the tile so that each tile only contributes its own area.
+                    Paths   untrimmed;
+                    Clipper trim;
+
+                    c.Execute( aType, untrimmed, pftNonZero, pftNonZero );
+
+                    trim.StrictlySimple( strictlySimple );
+                    trim.AddPaths( untrimmed, ptSubject, true );
+                    trim.AddPath( grid.TileRect( aTile ), ptClip, true );
+                    trim.Execute( ctIntersection, tileSolution, pftNonZero, pftNonZero );
+                }
+
+                splitTileResult( tileSolution, grid, aTile, tileResults[aTile] );
+            } );
+
+    std::vector<size_t> order( grid.Count() );
+
+    for( size_t ii = 0; ii < order.size(); ++ii )
+        order[ii] = ii;
+
+    std::sort( order.begin(), order.end(),
+               [&]( size_t a, size_t b )
+               {
+                   return grid.MortonKey( a ) < grid.MortonKey( b );
+               } );
+
+    std::vector<Paths> seams;
+    seams.reserve( order.size() );
+
+    for( size_t tile : order )
+        seams.push_back( std::move( tileResults[tile].m_seam ) );
+
+    PolyTree solution;
+
+    mergeTiledResults( seams, strictlySimple, solution );
+
+    importTree( &solution );
+
+    // Re-attach the held-back holes.  All holes of one tile outline end up in the same merged
+    // polygon: the innermost merged outline containing any of them.  Only the merged outlines
+    // can own them, and the final polygons of the tiles are appended once all of them are in.
+    size_t              mergedCount = m_polys.size();
+    std::vector<BOX2I>  bboxes;
+    std::vector<double> areas;
+
+    for( const POLYGON& poly : m_polys )
+    {
+        bboxes.push_back( poly[0].BBox() );
+        areas.push_back( std::abs( poly[0].Area() ) );
+    }
+
+    for( POLY_TILE_RESULT& tile : tileResults )
+    {
+        for( Paths& holes : tile.m_heldHoles )
+        {
+            VECTOR2I probe( holes[0][0].X, holes[0][0].Y );
+            int      owner = -1;
+
+            for( size_t ii = 0; ii < mergedCount; ++ii )
+            {
+                if( !bboxes[ii].Contains( probe ) || !m_polys[ii][0].PointInside( probe ) )
+                    continue;
+
+                if( owner < 0 || areas[ii] < areas[owner] )
+                    owner = ii;
+            }
+
+            assert( owner >= 0 );
+
+            if( owner < 0 )
+                continue;
+
+            for( const Path& hole : holes )
+                m_polys[owner].push_back( hole );
+        }
+    }
+
+    for( POLY_TILE_RESULT& tile : tileResults )
+    {
+        for( POLYGON& poly : tile.m_final )
+            m_polys.push_back( std::move( poly ) );
+    }
+}
+
+
+void SHAPE_POLY_SET::BooleanAddTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                      int aTileCount )
+{
+    booleanOpTiled( ctUnion, *this, b, aFastMode, aTileCount );
+}
+
+
+void SHAPE_POLY_SET::BooleanSubtractTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                           int aTileCount )
+{
+    booleanOpTiled( ctDifference, *this, b, aFastMode, aTileCount );
+}
+
+
+void SHAPE_POLY_SET::BooleanIntersectionTiled( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode,
+                                               int aTileCount )
+{
+    booleanOpTiled( ctIntersection, *this, b, aFastMode, aTileCount );
+}
+
+
 void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, int aCircleSegmentsCount,
                                              POLYGON_MODE aFastMode )
 {
@@ -622,6 +1107,62 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
 }
 
 
+void SHAPE_POLY_SET::InflateTiled( int aAmount, int aCircleSegmentsCount,
+                                   CORNER_STRATEGY aCornerStrategy, int aTileCount )
+{
+    if( aTileCount <= 1 || m_polys.size() < 2 )
+    {
+        Inflate( aAmount, aCircleSegmentsCount, aCornerStrategy );
+        return;
+    }
+
+    POLY_TILE_GRID              grid( BBox(), aTileCount );
+    std::vector<SHAPE_POLY_SET> groups( grid.Count() );
+
+    for( POLYGON& poly : m_polys )
+        groups[ grid.TileAt( poly[0].BBox().Centre() ) ].m_polys.push_back( std::move( poly ) );
+
+    m_polys.clear();
+
+    parallelFor( groups.size(),
+            [&]( size_t aGroup )
+            {
+                if( !groups[aGroup].m_polys.empty() )
+                    groups[aGroup].Inflate( aAmount, aCircleSegmentsCount, aCornerStrategy );
+            } );
+
+    // Shrinking never makes disjoint polygons overlap, so deflated groups can simply be
+    // collected.  Grown groups may overlap their neighbours and must be merged.
+    if( aAmount <= 0 )
+    {
+        for( SHAPE_POLY_SET& group : groups )
+        {
+            for( POLYGON& poly : group.m_polys )
+                m_polys.push_back( std::move( poly ) );
+        }
+
+        return;
+    }
+
+    std::vector<Paths> parts( groups.size() );
+
+    for( size_t ii = 0; ii < groups.size(); ++ii )
+    {
+        for( const POLYGON& poly : groups[ii].m_polys )
+        {
+            for( size_t i = 0; i < poly.size(); i++ )
+                parts[ii].push_back( poly[i].convertToClipper( i == 0 ) );
+        }
+    }
+
+    PolyTree solution;
+
+    mergeTiledResults( parts, false, solution );
+
+    importTree( &solution );
+}
+
+
 void SHAPE_POLY_SET::importTree( PolyTree* tree )
 {
     m_polys.clear();
@@ -862,6 +1403,25 @@ void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
 }
 
 
+void SHAPE_POLY_SET::FractureTiled( POLYGON_MODE aFastMode, int aTileCount )
+{
+    if( aTileCount <= 1 )
+    {
+        Fracture( aFastMode );
+        return;
+    }
+
+    SimplifyTiled( aFastMode, aTileCount );    // remove overlapping holes/degeneracy
+
+    // Each outline is fractured independently of the others
+    parallelFor( m_polys.size(),
+            [&]( size_t aIdx )
+            {
+                fractureSingle( m_polys[aIdx] );
+            } );
+}
+
+
 void SHAPE_POLY_SET::unfractureSingle( SHAPE_POLY_SET::POLYGON& aPoly )
 {
     assert( aPoly.size() == 1 );
@@ -1057,6 +1617,14 @@ void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 }
 
 
+void SHAPE_POLY_SET::SimplifyTiled( POLYGON_MODE aFastMode, int aTileCount )
+{
+    SHAPE_POLY_SET empty;
+
+    booleanOpTiled( ctUnion, *this, empty, aFastMode, aTileCount );
+}
+
+
 int SHAPE_POLY_SET::NormalizeAreaOutlines()
 {
     // We are expecting only one main outline, but this main outline can have holes
@@ -1341,6 +1909,25 @@ void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 }
 
 
+void SHAPE_POLY_SET::DeletePolygons( const std::vector<bool>& aDelete )
+{
+    size_t kept = 0;
+
+    for( size_t ii = 0; ii < m_polys.size(); ++ii )
+    {
+        if( ii < aDelete.size() && aDelete[ii] )
+            continue;
+
+        if( kept != ii )
+            m_polys[kept] = std::move( m_polys[ii] );
+
+        kept++;
+    }
+
+    m_polys.erase( m_polys.begin() + kept, m_polys.end() );
+}
+
+
 void SHAPE_POLY_SET::Append( const SHAPE_POLY_SET& aSet )
 {
     m_polys.insert( m_polys.end(), aSet.m_polys.begin(), aSet.m_polys.end() );
@@ -2011,6 +2598,10 @@ static void partitionPolyIntoRegularCellGrid(
 }
 
 
+///> Point count below which CacheTriangulation() does not spread outlines over threads
+static const size_t TRIANGULATION_PARALLEL_MIN_POINTS = 10000;
+
+
 void SHAPE_POLY_SET::CacheTriangulation( bool aPartition )
 {
     bool recalculate = !m_hash.IsValid();
@@ -2039,35 +2630,77 @@ void SHAPE_POLY_SET::CacheTriangulation( bool aPartition )
         // This partitions into regularly-sized grids (1cm in pcbnew)
         partitionPolyIntoRegularCellGrid( *this, 1e7, tmpSet );
     else
-    {
         tmpSet = *this;
 
-        if( tmpSet.HasHoles() )
-            tmpSet.Fracture( PM_FAST );
-    }
+    // Only the outlines get triangulated.  This also covers a set too small to partition,
+    // which comes back as it was.
+    if( tmpSet.HasHoles() )
+        tmpSet.Fracture( PM_FAST );
 
     m_triangulatedPolys.clear();
-    m_triangulationValid = true;
+    m_triangulationValid = false;
+
+    // Outlines are independent, so triangulate them all in parallel.  If the tesselation of an
+    // outline fails, we re-fracture the failures, which will first simplify them before
+    // fracturing and removing the holes.  This may result in multiple, disjoint polygons, which
+    // get another pass; a bounded number of passes keeps a pathological outline from looping.
+    const int maxPasses = 4;
 
-    while( tmpSet.OutlineCount() > 0 )
+    for( int pass = 0; pass < maxPasses && tmpSet.OutlineCount() > 0; pass++ )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        PolygonTriangulation tess( *m_triangulatedPolys.back() );
+        size_t count = tmpSet.OutlineCount();
+        size_t pointCount = 0;
+
+        for( size_t ii = 0; ii < count; ii++ )
+            pointCount += tmpSet.CPolygon( ii ).front().PointCount();
+
+        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> results( count );
+        std::vector<char>                                  succeeded( count, 0 );
 
-        // If the tesselation fails, we re-fracture the polygon, which will
-        // first simplify the system before fracturing and removing the holes
-        // This may result in multiple, disjoint polygons.
-        if( !tess.TesselatePolygon( tmpSet.Polygon( 0 ).front() ) )
+        auto triangulate =
+                [&]( size_t ii )
+                {
+                    results[ii] = std::make_unique<TRIANGULATED_POLYGON>();
+                    PolygonTriangulation tess( *results[ii] );
+
+                    succeeded[ii] = tess.TesselatePolygon( tmpSet.CPolygon( ii ).front() );
+                };
+
+        // Callers such as the zone filler already triangulate many sets at once, so small sets
+        // are not worth the threads
+        if( pointCount < TRIANGULATION_PARALLEL_MIN_POINTS )
         {
-            tmpSet.Fracture( PM_FAST );
-            m_triangulationValid = false;
-            continue;
+            for( size_t ii = 0; ii < count; ii++ )
+                triangulate( ii );
+        }
+        else
+        {
+            parallelFor( count, triangulate );
         }
 
-        tmpSet.DeletePolygon( 0 );
-        m_triangulationValid = true;
+        SHAPE_POLY_SET failed;
+
+        for( size_t ii = 0; ii < count; ii++ )
+        {
+            if( succeeded[ii] )
+                m_triangulatedPolys.push_back( std::move( results[ii] ) );
+            else
+                failed.AddOutline( tmpSet.CPolygon( ii ).front() );
+        }
+
+        if( failed.OutlineCount() == 0 )
+        {
+            m_triangulationValid = true;
+            break;
+        }
+
+        failed.Fracture( PM_FAST );
+        tmpSet = failed;
     }
 
+    if( tmpSet.OutlineCount() == 0 )
+        m_triangulationValid = true;
+
     if( m_triangulationValid )
         m_hash = checksum();
 }
@@ -915,11 +915,10 @@ void PL_EDITOR_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aItemCo
 
     for( unsigned ii = 0; ii < icnt; ii++ )
     {
-        if( list.m_CommandsList.size() == 0 )
-            break;
+        PICKED_ITEMS_LIST* curr_cmd = list.PopOldestCommand();
 
-        PICKED_ITEMS_LIST* curr_cmd = list.m_CommandsList[0];
-        list.m_CommandsList.erase( list.m_CommandsList.begin() );
+        if( !curr_cmd )
+            break;
 
         curr_cmd->ClearListAndDeleteItems();
         delete curr_cmd;    // Delete command
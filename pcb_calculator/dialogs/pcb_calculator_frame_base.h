@@ -238,6 +238,7 @@ class PCB_CALCULATOR_FRAME_BASE : public KIWAY_PLAYER
 		wxStaticText* m_Message6;
 		wxStaticText* m_left_message7;
 		wxStaticText* m_Message7;
+		wxButton* m_buttonTranslineSweep;
 		wxButton* m_buttonTransLineReset;
 		wxPanel* m_panelViaSize;
 		wxStaticText* m_staticTextHoleDia;
@@ -396,6 +397,7 @@ class PCB_CALCULATOR_FRAME_BASE : public KIWAY_PLAYER
 		virtual void OnTranslineRho_Button( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnTranslineAnalyse( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnTranslineSynthetize( wxCommandEvent& event ) { event.Skip(); }
+		virtual void OnTranslineSweep( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnTransLineResetButtonClick( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnViaCalculate( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnViaRho_Button( wxCommandEvent& event ) { event.Skip(); }
@@ -19,27 +19,150 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <dialog_helpers.h>
-#include <pcb_calculator.h>
-#include <wx/wx.h>
-
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <future>
 #include <iostream>
+#include <limits>
 #include <string>
-
-#ifdef BENCHMARK
-#include <sys/time.h>
-#endif
-
+#include <thread>
 #include <vector>
 
 #include "eserie.h"
 #include "profile.h"
 
-wxString eseries_help =
-#include "eserie_help.h"
+/*
+ * Values of one decade for the series E24 and E192 as defined by IEC 60063. E48 and E96
+ * are every 4th and every 2nd value of E192. The irregular rounding rule of E192 (920
+ * instead of the calculated 919) is never used by E48 and E96.
+ */
+static const std::vector<int> e24_decade = { 10, 11, 12, 13, 15, 16, 18, 20, 22, 24, 27, 30,
+                                             33, 36, 39, 43, 47, 51, 56, 62, 68, 75, 82, 91 };
+
+static const std::vector<int> e192_decade = {
+    100, 101, 102, 104, 105, 106, 107, 109, 110, 111, 113, 114, 115, 117, 118, 120,
+    121, 123, 124, 126, 127, 129, 130, 132, 133, 135, 137, 138, 140, 142, 143, 145,
+    147, 149, 150, 152, 154, 156, 158, 160, 162, 164, 165, 167, 169, 172, 174, 176,
+    178, 180, 182, 184, 187, 189, 191, 193, 196, 198, 200, 203, 205, 208, 210, 213,
+    215, 218, 221, 223, 226, 229, 232, 234, 237, 240, 243, 246, 249, 252, 255, 258,
+    261, 264, 267, 271, 274, 277, 280, 284, 287, 291, 294, 298, 301, 305, 309, 312,
+    316, 320, 324, 328, 332, 336, 340, 344, 348, 352, 357, 361, 365, 370, 374, 379,
+    383, 388, 392, 397, 402, 407, 412, 417, 422, 427, 432, 437, 442, 448, 453, 459,
+    464, 470, 475, 481, 487, 493, 499, 505, 511, 517, 523, 530, 536, 542, 549, 556,
+    562, 569, 576, 583, 590, 597, 604, 612, 619, 626, 634, 642, 649, 657, 665, 673,
+    681, 690, 698, 706, 715, 723, 732, 741, 750, 759, 768, 777, 787, 796, 806, 816,
+    825, 835, 845, 856, 866, 876, 887, 898, 909, 920, 931, 942, 953, 965, 976, 988
+};
+
+// Number of 2R combinations given at once to a 4R search thread, smaller tables use no thread
+#define CMB_CHUNK 4096
+
+/*
+ * The best 3R or 4R combination found so far: e_first is the index of the single value
+ * (3R) or of the first 2R combination (4R), e_second the index of the other 2R combination
+ */
+struct r_best {
+                  double   e_dev;
+                  uint32_t e_first;
+                  uint32_t e_second;
+                  bool     e_parallel;
+              };
+
+/*
+ * BOM string of a value, the unit letter used as decimal point: 10R2, 1K02, 2K2 or 1M
+ */
+static std::string bomName( double aValue )
+{
+    const char* unit = "R";
+    char        buf[32];
+
+    if( aValue >= 1e6 )
+    {
+        aValue /= 1e6;
+        unit = "M";
+    }
+    else if( aValue >= 1e3 )
+    {
+        aValue /= 1e3;
+        unit = "K";
+    }
+
+    snprintf( buf, sizeof( buf ), "%.3g", aValue );
+
+    std::string s( buf );
+    size_t      dot = s.find( '.' );
+
+    if( dot == std::string::npos )
+        return s.append( unit );
+
+    return s.replace( dot, 1, unit );
+}
+
+/*
+ * 6 decade lookup table from 10 Ohms to 1M, from every aStep value of one decade
+ */
+static std::vector<r_data> buildSerie( const std::vector<int>& aDecade, int aScale, size_t aStep )
+{
+    std::vector<r_data> lut;
+
+    for( double decade = 10; decade < 1e6; decade *= 10 )
+    {
+        for( size_t i = 0; i < aDecade.size(); i += aStep )
+        {
+            double value = aDecade[i] * decade / aScale; // exact division for the BOM string
+            lut.push_back( { true, bomName( value ), value } );
+        }
+    }
+
+    lut.push_back( { true, "1M", 1e6 } );
+    return lut;
+}
+
+/*
+ * Calls aCheck with the 2R combinations closest to aValue, below and above it. Series and
+ * parallel combinations grow with both of their values, so the combination of any value
+ * closest to a required value is always one of the two closest to the complementary value.
+ */
+template <typename FUNC>
+static void checkClosest( const std::vector<r_comb>& aLut, uint32_t aSize, double aValue,
+                          FUNC aCheck )
+{
+    auto end = aLut.begin() + aSize;
+    auto it = std::lower_bound( aLut.begin(), end, aValue,
+                                []( const r_comb& aComb, double aVal )
+                                {
+                                    return aComb.e_value < aVal;
+                                } );
+
+    if( it != end )
+        aCheck( uint32_t( it - aLut.begin() ) );
+
+    if( it != aLut.begin() )
+        aCheck( uint32_t( it - aLut.begin() - 1 ) );
+}
+
+/*
+ * Value of the element aComb to combine in parallel with aValue to get aReqR. If aValue is
+ * not above aReqR, the largest element is the closest solution.
+ */
+static double parallelComplement( double aValue, double aReqR )
+{
+    if( aValue <= aReqR )
+        return std::numeric_limits<double>::infinity();
+
+    return aValue * aReqR / ( aValue - aReqR );
+}
 
-    eserie r;
+eserie::eserie()
+{
+    luts.push_back( buildSerie( e24_decade, 10, 1 ) );   // E24
+    luts.push_back( buildSerie( e192_decade, 100, 4 ) ); // E48
+    luts.push_back( buildSerie( e192_decade, 100, 2 ) ); // E96
+    luts.push_back( buildSerie( e192_decade, 100, 1 ) ); // E192
+}
 
 void eserie::set_reqR( double aR )
 {
@@ -66,8 +189,8 @@ void eserie::exclude( double aValue )
     if( aValue ) // if there is a value to exclude other than a wire jumper
     {
         for( r_data& i : luts[rb_state] ) // then search it in the selected E-Serie lookup table
-        {
-            if( i.e_value == aValue )     // if value to exclude found
+        {                                 // tolerating the rounding of the KOhm conversion
+            if( std::abs( i.e_value - aValue ) <= i.e_value * 1e-9 ) // if value to exclude found
             {
                 i.e_use = false;          // disable its use
             }
@@ -77,25 +200,33 @@ void eserie::exclude( double aValue )
 
 void eserie::simple_solution( uint32_t aSize )
 {
-    uint32_t i;
-
     results[S2R].e_value = std::numeric_limits<double>::max(); // assume no 2R solution or max deviation
 
-    for( i = 0; i < aSize; i++ )
-    {
-        if( abs( cmb_lut[i].e_value - reqR ) < abs( results[S2R].e_value ) )
-        {
-            results[S2R].e_value = cmb_lut[i].e_value - reqR; // save signed deviation in Ohms
-            results[S2R].e_name  = cmb_lut[i].e_name;         // save combination text
-            results[S2R].e_use   = true;                      // this is a possible solution
-        }
-    }
+    checkClosest( cmb_lut, aSize, reqR,
+            [&]( uint32_t i )
+            {
+                double tmp = cmb_lut[i].e_value - reqR;
+
+                if( std::abs( tmp ) < std::abs( results[S2R].e_value ) )
+                {
+                    results[S2R].e_value = tmp;  // save signed deviation in Ohms
+                    results[S2R].e_use   = true; // this is a possible solution
+                    results[S2R].e_name  = cmb_name( cmb_lut[i] ); // save combination text
+                }
+            } );
+}
+
+std::string eserie::cmb_name( const r_comb& aComb )
+{
+    std::string s = luts[rb_state][aComb.e_first].e_name;
+
+    s.append( aComb.e_parallel ? " | " : " + " );
+    return s.append( luts[rb_state][aComb.e_second].e_name );
 }
 
 void eserie::combine4( uint32_t aSize )
 {
-    uint32_t    i,j;
-    double      tmp;
+    r_best      best = { std::abs( results[S3R].e_value ), UINT32_MAX, 0, false };
     std::string s;
 
     results[S4R].e_use = false;                          // disable 4R solution, until
@@ -105,45 +236,98 @@ void eserie::combine4( uint32_t aSize )
         PROF_COUNTER combine4_timer;                     // start timer to count execution time
     #endif
 
-    for( i = 0; i < aSize; i++ )                         // 4R search outer loop
-    {                                                    // scan valid intermediate 2R solutions
-        for( j = 0; j < aSize; j++ )                     // inner loop combines all with itself
+    // Every thread keeps its own best solution of the chunks of 2R combinations it gets
+    size_t chunks = ( aSize + CMB_CHUNK - 1 ) / CMB_CHUNK;
+    size_t parallelThreadCount =
+            std::max<size_t>( 1, std::min<size_t>( std::thread::hardware_concurrency(), chunks ) );
+
+    std::vector<r_best> bests( parallelThreadCount, best );
+    std::atomic<size_t> nextChunk( 0 );
+
+    auto search = [&]( r_best& aBest )
+    {
+        for( size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++ )
         {
-            tmp = cmb_lut[i].e_value + cmb_lut[j].e_value;       // calculate 2R+2R serial
-            tmp -= reqR;                                         // calculate 4R deviation
+            uint32_t last = std::min<uint32_t>( aSize, ( chunk + 1 ) * CMB_CHUNK );
 
-            if( abs( tmp ) < abs( results[S4R].e_value ) )       // if new 4R is better
+            for( uint32_t i = chunk * CMB_CHUNK; i < last; i++ ) // scan 2R solutions
             {
-                results[S4R].e_value = tmp;                      // save amount of benefit
-                std::string s = "( ";
-                s.append( cmb_lut[i].e_name );                   // mention 1st 2 component
-                s.append( " ) + ( " );                           // in series
-                s.append( cmb_lut[j].e_name );                   // with 2nd 2 components
-                s.append( " )" );
-                results[S4R].e_name = s;                         // save the result and
-                results[S4R].e_use = true;                       // enable for later use
+                double first = cmb_lut[i].e_value;
+
+                checkClosest( cmb_lut, aSize, reqR - first,      // 2R+2R serial
+                        [&]( uint32_t j )
+                        {
+                            double tmp = first + cmb_lut[j].e_value - reqR;
+
+                            if( std::abs( tmp ) < aBest.e_dev )  // if new 4R is better
+                                aBest = { std::abs( tmp ), i, j, false };
+                        } );
+
+                checkClosest( cmb_lut, aSize, parallelComplement( first, reqR ), // 2R|2R
+                        [&]( uint32_t j )
+                        {
+                            double tmp = first * cmb_lut[j].e_value /
+                                         ( first + cmb_lut[j].e_value ) - reqR;
+
+                            if( std::abs( tmp ) < aBest.e_dev )  // if new 4R is better
+                                aBest = { std::abs( tmp ), i, j, true };
+                        } );
             }
+        }
+    };
 
-            tmp = ( cmb_lut[i].e_value * cmb_lut[j].e_value ) /
-                  ( cmb_lut[i].e_value + cmb_lut[j].e_value );   // calculate 2R|2R parallel
-            tmp -= reqR;                                         // calculate 4R deviation
+    if( parallelThreadCount == 1 )
+    {
+        search( bests[0] );
+    }
+    else
+    {
+        std::vector<std::future<void>> returns( parallelThreadCount );
 
-            if( abs( tmp ) < abs( results[S4R].e_value ) )       // if new 4R is better
-            {
-                results[S4R].e_value = tmp;                      // save amount of benefit
-                std::string s = "( ";
-                s.append( cmb_lut[i].e_name );                   // mention 1st 2 component
-                s.append( " ) | ( " );                           // in parallel
-                s.append( cmb_lut[j].e_name );                   // with 2nd 2 components
-                s.append( " )" );
-                results[S4R].e_name = s;                         // save the result
-                results[S4R].e_use  = true;                      // enable later use
-            }
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, search, std::ref( bests[ii] ) );
+
+        for( auto& ret : returns )
+            ret.wait();
+    }
+
+    // Solutions of equal deviation are ordered by their 1st combination, for the result
+    // not to depend on how the chunks were shared by the threads
+    for( const r_best& threadBest : bests )
+    {
+        if( threadBest.e_dev < best.e_dev
+                || ( threadBest.e_dev == best.e_dev && threadBest.e_first < best.e_first ) )
+        {
+            best = threadBest;
         }
     }
 
+    if( best.e_dev < std::abs( results[S3R].e_value ) )
+    {
+        const r_comb& first  = cmb_lut[best.e_first];
+        const r_comb& second = cmb_lut[best.e_second];
+
+        if( best.e_parallel )
+        {
+            results[S4R].e_value = first.e_value * second.e_value /
+                                   ( first.e_value + second.e_value ) - reqR;
+        }
+        else
+        {
+            results[S4R].e_value = first.e_value + second.e_value - reqR;
+        }
+
+        s = "( ";
+        s.append( cmb_name( first ) );                   // mention 1st 2 component
+        s.append( best.e_parallel ? " ) | ( " : " ) + ( " ); // in parallel or in series
+        s.append( cmb_name( second ) );                  // with 2nd 2 components
+        s.append( " )" );
+        results[S4R].e_name = s;                         // save the result and
+        results[S4R].e_use = true;                       // enable for later use
+    }
+
     #ifdef BENCHMARK
-        if( rb_state == E12 )
+        if( rb_state >= E12 )
         {
              std::cout<<"4R Time = "<<combine4_timer.msecs()<<" mSec"<<std::endl;
         }
@@ -152,10 +336,7 @@ void eserie::combine4( uint32_t aSize )
 
 void eserie::new_calc( void )
 {
-    for( r_data& i : cmb_lut )
-    {
-        i.e_use = false; // before any calculation is done, assume that
-    }
+    cmb_lut.clear(); // before any calculation is done, assume that
 
     for( r_data& i : results )
     {
@@ -170,41 +351,46 @@ void eserie::new_calc( void )
 
 uint32_t eserie::combine2( void )
 {
-    uint32_t    combi2R = 0;                // target index counts calculated 2R combinations
-    std::string s;
+    const std::vector<r_data>& lut = luts[rb_state];
 
-    for( const r_data& i : luts[rb_state] ) // outer loop to sweep selected source lookup table
+    cmb_lut.clear();
+
+    for( uint16_t i = 0; i < lut.size(); i++ )     // outer loop to sweep selected source lookup table
     {
-        if( i.e_use )
+        if( !lut[i].e_use )
+            continue;
+
+        for( uint16_t j = i; j < lut.size(); j++ ) // inner loop to combine values with itself
         {
-            for( const r_data& j : luts[rb_state] ) // inner loop to combine values with itself
-            {
-                if( j.e_use )
-                {
-                    cmb_lut[combi2R].e_use    = true;
-                    cmb_lut[combi2R].e_value  = i.e_value + j.e_value; // calculate 2R serial
-                    s = i.e_name;
-                    s.append( " + " );
-                    cmb_lut[combi2R].e_name = s.append(j.e_name);
-                    combi2R++;                                         // next destination
-                    cmb_lut[combi2R].e_use    = true;                  // calculate 2R parallel
-                    cmb_lut[combi2R].e_value = i.e_value * j.e_value /
-                                             ( i.e_value + j.e_value );
-                    s = i.e_name;
-                    s.append( " | " );
-                    cmb_lut[combi2R].e_name = s.append( j.e_name );
-                    combi2R++;                                         // next destination
-                }
-            }
+            if( !lut[j].e_use )
+                continue;
+
+            cmb_lut.push_back( { lut[i].e_value + lut[j].e_value, i, j, false } ); // 2R serial
+            cmb_lut.push_back( { lut[i].e_value * lut[j].e_value /
+                                 ( lut[i].e_value + lut[j].e_value ), i, j, true } ); // 2R parallel
         }
     }
-    return ( combi2R );
+
+    std::sort( cmb_lut.begin(), cmb_lut.end(),
+               []( const r_comb& a, const r_comb& b )
+               {
+                   if( a.e_value != b.e_value )
+                       return a.e_value < b.e_value;
+
+                   if( a.e_first != b.e_first )
+                       return a.e_first < b.e_first;
+
+                   if( a.e_second != b.e_second )
+                       return a.e_second < b.e_second;
+
+                   return a.e_parallel < b.e_parallel;
+               } );
+
+    return ( cmb_lut.size() );
 }
 
 void eserie::combine3( uint32_t aSize )
 {
-    uint32_t    j   = 0;
-    double      tmp = 0; // avoid warning for being uninitialized
     std::string s;
 
     results[S3R].e_use   = false;                // disable 3R solution, until
@@ -212,45 +398,48 @@ void eserie::combine3( uint32_t aSize )
 
     for( const r_data& i : luts[rb_state] )      // 3R  Outer loop to selected primary E serie LUT
     {
-        if( i.e_use )                            // skip all excluded values
-        {
-            for( j = 0; j < aSize; j++ )  // inner loop combines with all 2R intermediate results
-            {                                                  //  R+2R serial combi
-                tmp  = cmb_lut[j].e_value + i.e_value;
-                tmp -= reqR;                                   // calculate deviation
-
-                if( abs( tmp ) < abs( results[S3R].e_value ) ) // compare if better
-                {                                              // then take it
-                    s = i.e_name;                              // mention 3rd component
-                    s.append( " + ( " );                       // in series
-                    s.append( cmb_lut[j].e_name );             // with 2R combination
-                    s.append( " )" );
-                    results[S3R].e_name = s;                   // save S3R result
-                    results[S3R].e_value = tmp;                // save amount of benefit
-                    results[S3R].e_use = true;                 // enable later use
-                }
+        if( !i.e_use )                           // skip all excluded values
+            continue;
 
-                tmp =   i.e_value * cmb_lut[j].e_value /
-                      ( i.e_value + cmb_lut[j].e_value );      // calculate R + 2R parallel
-                tmp -= reqR;                                   // calculate deviation
-
-                if( abs( tmp ) < abs( results[S3R].e_value ) ) // compare if better
-                {                                              // then take it
-                    s = i.e_name;                              // mention 3rd component
-                    s.append( " | ( " );                       // in parallel
-                    s.append( cmb_lut[j].e_name );             // with 2R combination
-                    s.append( " )" );
-                    results[S3R].e_name  = s;
-                    results[S3R].e_value = tmp;                // save amount of benefit
-                    results[S3R].e_use   = true;               // enable later use
-                }
-            }
-        }
+        checkClosest( cmb_lut, aSize, reqR - i.e_value,        //  R+2R serial combi
+                [&]( uint32_t j )
+                {
+                    double tmp = cmb_lut[j].e_value + i.e_value - reqR; // calculate deviation
+
+                    if( std::abs( tmp ) < std::abs( results[S3R].e_value ) ) // compare if better
+                    {                                                 // then take it
+                        s = i.e_name;                                 // mention 3rd component
+                        s.append( " + ( " );                          // in series
+                        s.append( cmb_name( cmb_lut[j] ) );           // with 2R combination
+                        s.append( " )" );
+                        results[S3R].e_name = s;                      // save S3R result
+                        results[S3R].e_value = tmp;                   // save amount of benefit
+                        results[S3R].e_use = true;                    // enable later use
+                    }
+                } );
+
+        checkClosest( cmb_lut, aSize, parallelComplement( i.e_value, reqR ), // R|2R parallel
+                [&]( uint32_t j )
+                {
+                    double tmp = i.e_value * cmb_lut[j].e_value /
+                                 ( i.e_value + cmb_lut[j].e_value ) - reqR; // calculate deviation
+
+                    if( std::abs( tmp ) < std::abs( results[S3R].e_value ) ) // compare if better
+                    {                                                 // then take it
+                        s = i.e_name;                                 // mention 3rd component
+                        s.append( " | ( " );                          // in parallel
+                        s.append( cmb_name( cmb_lut[j] ) );           // with 2R combination
+                        s.append( " )" );
+                        results[S3R].e_name  = s;
+                        results[S3R].e_value = tmp;                   // save amount of benefit
+                        results[S3R].e_use   = true;                  // enable later use
+                    }
+                } );
     }
                                                  // if there is a 3R result with remaining deviation
-    if( ( results[S3R].e_use == true ) && tmp )
+    if( ( results[S3R].e_use == true ) && results[S3R].e_value )
     {                                            // consider to search a possibly better 4R solution
-        combine4( aSize );                       // calculate 4R for small series always
+        combine4( aSize );
     }
 }
 
@@ -306,122 +495,3 @@ void eserie::strip4( void )
         }
     }
 }
-
-void PCB_CALCULATOR_FRAME::OnCalculateESeries( wxCommandEvent& event )
-{
-    double   reqr;            // required resistor stored in local copy
-    double   error, err3 = 0;
-    wxString es, fs;          // error and formula strings
-
-    reqr = ( 1000 * DoubleFromString( m_ResRequired->GetValue() ) );
-    r.set_reqR(reqr); // keep a local copy of requred resistor value
-    r.new_calc();     // assume all values available
-    /*
-     * Exclude itself. For the case, a value from the available series is found as required value,
-     * the calculator assumes this value needs a replacement for the reason of being not available.
-     * Two further exclude values can be entered to exclude and are skipped as not being availabe.
-     * All values entered in KiloOhms are converted to Ohm for internal calculation
-     */
-    r.exclude( 1000 * DoubleFromString( m_ResRequired->GetValue() ) );
-    r.exclude( 1000 * DoubleFromString( m_ResExclude1->GetValue() ) );
-    r.exclude( 1000 * DoubleFromString( m_ResExclude2->GetValue() ) );
-    r.calculate();
-
-    fs = r.get_rslt()[S2R].e_name;               // show 2R solution formula string
-    m_ESeries_Sol2R->SetValue( fs );
-    error = reqr + r.get_rslt()[S2R].e_value;    // absolute value of solution
-    error = ( reqr / error - 1 ) * 100;          // error in percent
-
-    if( error )
-    {
-        if( std::abs( error ) < 0.01 )
-        {
-            es.Printf( "<0.01" );
-        }
-        else
-        {
-            es.Printf( "%+.2f",error);
-        }
-    }
-    else
-    {
-        es = "Exact";
-    }
-
-    m_ESeriesError2R->SetValue( es );            // anyway show 2R error string
-
-    if( r.get_rslt()[S3R].e_use )                // if 3R solution available
-    {
-        err3 = reqr + r.get_rslt()[S3R].e_value; // calculate the 3R
-        err3 = ( reqr / err3 - 1 ) * 100;        // error in percent
-
-        if( err3 )
-        {
-            if( std::abs( err3 ) < 0.01 )
-            {
-                es.Printf( "<0.01" );
-            }
-            else
-            {
-                es.Printf( "%+.2f",err3);
-            }
-        }
-        else
-        {
-            es = "Exact";
-        }
-
-        m_ESeriesError3R->SetValue( es );         // show 3R error string
-        fs = r.get_rslt()[S3R].e_name;
-        m_ESeries_Sol3R->SetValue( fs );         // show 3R formula string
-    }
-    else                                         // nothing better than 2R found
-    {
-        fs = "Not worth using";
-        m_ESeries_Sol3R->SetValue( fs );
-        m_ESeriesError3R->SetValue( wxEmptyString );
-    }
-
-    fs = wxEmptyString;
-
-    if( r.get_rslt()[S4R].e_use )                 // show 4R solution if available
-    {
-        fs = r.get_rslt()[S4R].e_name;
-
-        error = reqr + r.get_rslt()[S4R].e_value; // absolute value of solution
-        error = ( reqr / error - 1 ) * 100;       // error in percent
-
-        if( error )
-        {
-            es.Printf( "%+.2f",error );
-        }
-        else
-        {
-            es = "Exact";
-        }
-
-        m_ESeriesError4R->SetValue( es );
-    }
-    else                                          // no 4R solution
-    {
-        fs = "Not worth using";
-        es = wxEmptyString;
-        m_ESeriesError4R->SetValue( es );
-    }
-
-    m_ESeries_Sol4R->SetValue( fs );
-}
-
-void PCB_CALCULATOR_FRAME::OnESerieSelection( wxCommandEvent& event )
-{
-    r.set_rb ( event.GetSelection() );
-}
-
-void PCB_CALCULATOR_FRAME::ES_Init()    // initialize ESeries tab at each pcb-calculator start
-{
-    wxString msg;
-
-    // show markdown formula explanation in lower help panel
-    ConvertMarkdown2Html( wxGetTranslation( eseries_help ), msg );
-    m_panelESeriesHelp->SetPage( msg );
-}
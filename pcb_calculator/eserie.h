@@ -22,15 +22,19 @@
  * @file eserie.h
  */
 
-extern double DoubleFromString( const wxString& TextValue );
+#ifndef ESERIE_H
+#define ESERIE_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 /**
- * If BENCHMARK is defined, any 4R E12 calculations will print its execution time to console
- * My Hasswell Enthusiast reports 225 mSec what are reproducable within plusminus 2 percent 
+ * If BENCHMARK is defined (e.g. with -DBENCHMARK in CMAKE_CXX_FLAGS), any 4R calculation
+ * from E12 on will print its execution time to console
  */
 
-#define BENCHMARK
-
 /**
  * E-Values derived from a geometric sequence formula by Charles Renard were already
  * accepted and widely used before the ISO recommendation no. 3 has been published.
@@ -40,7 +44,7 @@ extern double DoubleFromString( const wxString& TextValue );
  * also used to lookup non calculatable but readable BOM value strings. Supported E-series are:
  */
 
-enum             { E1, E3, E6, E12 };
+enum             { E1, E3, E6, E12, E24, E48, E96, E192 };
 
 /**
  * This calculator suggests solutions for 2R, 3R and 4R replacement combinations
@@ -50,7 +54,8 @@ enum             { S2R, S3R, S4R };
 
 /**
  * 6 decade E-series values from 10 Ohms to 1M and its associated BOM strings. 
- * Series E3,E6,E12 are defined by additional values for cumulative use with previous series
+ * Series E3,E6,E12 are defined by additional values for cumulative use with previous series.
+ * Series E24 to E192 are built from the values of one decade when the calculator starts.
  */
 
 #define E1_VAL   { true, "1K", 1000 },\
@@ -124,6 +129,17 @@ struct r_data {
                   double      e_value;
               };
 
+/**
+ * A 2R combination of the selected E-serie. Both values are given by their index in the
+ * E-serie lookup table, what keeps the combination table small enough for E192
+ */
+struct r_comb {
+                  double      e_value;
+                  uint16_t    e_first;
+                  uint16_t    e_second;
+                  bool        e_parallel;
+              };
+
 class eserie
 {
     private:
@@ -133,24 +149,7 @@ class eserie
                                               { E1_VAL, E3_ADD, E6_ADD },
                                               { E1_VAL, E3_ADD, E6_ADD, E12_ADD }
                                           };
-/*
- * TODO: Manual array size calculation is dangerous. Unlike legacy ANSI-C Arrays 
- * std::array can not drop length param by providing aggregate init list up
- * to C++17. Reserved array size should be 2*E12² of std::vector primary list.
- * Exceeding memory limit 7442 will crash the calculator without any warnings !
- * Compare to previous MAX_COMB macro for legacy ANSI-C array automatic solution
- * #define E12_SIZE sizeof ( e12_lut ) / sizeof ( r_data )
- *  #define MAX_COMB (2 * E12_SIZE * E12_SIZE)
- * 2 component combinations including redundant swappable terms are for the moment
- * 72 combinations for E1
- * 512 combinations for E3
- * 1922 combinations for E6
- * 7442 combinations for E12
- */
-
-#define MAX_CMB 7442			// maximum combinations for E12
-
-    std::array<r_data,MAX_CMB> cmb_lut;	// intermediate 2R combinations
+    std::vector<r_comb> cmb_lut;        // intermediate 2R combinations, sorted by value
     std::array<r_data,S4R+1> results;	// 2R, 3R and 4R results
     uint32_t rb_state = E6;		// Radio Button State
     uint32_t cb_state = false;          // Check Box 4R enable
@@ -159,11 +158,18 @@ class eserie
 /**
  * Build all 2R combinations from the selected E-serie values 
  * 
- * Pre-calculated value combinations are saved in intermediate look up table cmb_lut
+ * Pre-calculated value combinations are saved in intermediate look up table cmb_lut,
+ * sorted by their value to find the closest combinations to any value by binary search.
+ * Swapped terms give the same values, so they are only combined once.
  * @return is the number of found combinations what also depends from exclude values
 */
     uint32_t combine2( void );
 
+/**
+ * Build the text of a 2R combination from the BOM strings of its values
+ */
+    std::string cmb_name( const r_comb& aComb );
+
 /**
  * Search for closest two component solution
  *
@@ -176,7 +182,8 @@ class eserie
  * Check if there is a better 3 R solution than previous one using only two components.
  *
  * @param aSize gives the number of available combinations to be checked inside cmb_lut
- * Therefore cmb_lut is combinated with the primary E-serie look up table
+ * Therefore cmb_lut is combinated with the primary E-serie look up table. For each value,
+ * only the 2R combinations closest to the remaining required value need to be checked
  * The 3R result with smallest deviation will be saved in results if better than 2R
  */
     void combine3( uint32_t aSize );
@@ -184,10 +191,10 @@ class eserie
 /**
  * Check if there is a better four component solution. 
  *
- * @param aSsize gives the number of 2R combinations to be checked inside cmb_lut
- * Occupied calculation time depends from number of available E-serie values 
- * with the power of 4 why execution for E12 is conditional with 4R check box
- * for the case the previously found 3R solution is already exact
+ * @param aSize gives the number of 2R combinations to be checked inside cmb_lut
+ * Each 2R combination is combined with the 2R combinations closest to the remaining
+ * required value, what is searched in parallel threads for the large E-series.
+ * Execution is skipped for the case the previously found 3R solution is already exact
 */
     void combine4( uint32_t aSize );
 
@@ -211,6 +218,11 @@ class eserie
 
 public:
 
+/**
+ * Build the lookup tables of the series E24 to E192
+ */
+    eserie();
+
 /**
  * If any value of the selected E-serie not available, it can be entered as an exclude value.
  *
@@ -239,3 +251,5 @@ public:
     void                     set_reqR  ( double aR );
     std::array<r_data,S4R+1> get_rslt  ( void );
 };
+
+#endif  // ESERIE_H
@@ -0,0 +1,159 @@
+/*
+ * This program source code file
+ * is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 <janvi@veith.net>
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <dialog_helpers.h>
+#include <pcb_calculator.h>
+#include <wx/wx.h>
+
+#include "eserie.h"
+
+extern double DoubleFromString( const wxString& TextValue );
+
+wxString eseries_help =
+#include "eserie_help.h"
+
+    eserie r;
+
+void PCB_CALCULATOR_FRAME::OnCalculateESeries( wxCommandEvent& event )
+{
+    double   reqr;            // required resistor stored in local copy
+    double   error, err3 = 0;
+    wxString es, fs;          // error and formula strings
+
+    reqr = ( 1000 * DoubleFromString( m_ResRequired->GetValue() ) );
+    r.set_reqR(reqr); // keep a local copy of requred resistor value
+    r.new_calc();     // assume all values available
+    /*
+     * Exclude itself. For the case, a value from the available series is found as required value,
+     * the calculator assumes this value needs a replacement for the reason of being not available.
+     * Two further exclude values can be entered to exclude and are skipped as not being availabe.
+     * All values entered in KiloOhms are converted to Ohm for internal calculation
+     */
+    r.exclude( 1000 * DoubleFromString( m_ResRequired->GetValue() ) );
+    r.exclude( 1000 * DoubleFromString( m_ResExclude1->GetValue() ) );
+    r.exclude( 1000 * DoubleFromString( m_ResExclude2->GetValue() ) );
+    r.calculate();
+
+    fs = r.get_rslt()[S2R].e_name;               // show 2R solution formula string
+    m_ESeries_Sol2R->SetValue( fs );
+    error = reqr + r.get_rslt()[S2R].e_value;    // absolute value of solution
+    error = ( reqr / error - 1 ) * 100;          // error in percent
+
+    if( error )
+    {
+        if( std::abs( error ) < 0.01 )
+        {
+            es.Printf( "<0.01" );
+        }
+        else
+        {
+            es.Printf( "%+.2f",error);
+        }
+    }
+    else
+    {
+        es = "Exact";
+    }
+
+    m_ESeriesError2R->SetValue( es );            // anyway show 2R error string
+
+    if( r.get_rslt()[S3R].e_use )                // if 3R solution available
+    {
+        err3 = reqr + r.get_rslt()[S3R].e_value; // calculate the 3R
+        err3 = ( reqr / err3 - 1 ) * 100;        // error in percent
+
+        if( err3 )
+        {
+            if( std::abs( err3 ) < 0.01 )
+            {
+                es.Printf( "<0.01" );
+            }
+            else
+            {
+                es.Printf( "%+.2f",err3);
+            }
+        }
+        else
+        {
+            es = "Exact";
+        }
+
+        m_ESeriesError3R->SetValue( es );         // show 3R error string
+        fs = r.get_rslt()[S3R].e_name;
+        m_ESeries_Sol3R->SetValue( fs );         // show 3R formula string
+    }
+    else                                         // nothing better than 2R found
+    {
+        fs = "Not worth using";
+        m_ESeries_Sol3R->SetValue( fs );
+        m_ESeriesError3R->SetValue( wxEmptyString );
+    }
+
+    fs = wxEmptyString;
+
+    if( r.get_rslt()[S4R].e_use )                 // show 4R solution if available
+    {
+        fs = r.get_rslt()[S4R].e_name;
+
+        error = reqr + r.get_rslt()[S4R].e_value; // absolute value of solution
+        error = ( reqr / error - 1 ) * 100;       // error in percent
+
+        if( error )
+        {
+            if( std::abs( error ) < 0.01 )
+            {
+                es.Printf( "<0.01" );
+            }
+            else
+            {
+                es.Printf( "%+.2f",error );
+            }
+        }
+        else
+        {
+            es = "Exact";
+        }
+
+        m_ESeriesError4R->SetValue( es );
+    }
+    else                                          // no 4R solution
+    {
+        fs = "Not worth using";
+        es = wxEmptyString;
+        m_ESeriesError4R->SetValue( es );
+    }
+
+    m_ESeries_Sol4R->SetValue( fs );
+}
+
+void PCB_CALCULATOR_FRAME::OnESerieSelection( wxCommandEvent& event )
+{
+    r.set_rb ( event.GetSelection() );
+}
+
+void PCB_CALCULATOR_FRAME::ES_Init()    // initialize ESeries tab at each pcb-calculator start
+{
+    wxString msg;
+
+    // show markdown formula explanation in lower help panel
+    ConvertMarkdown2Html( wxGetTranslation( eseries_help ), msg );
+    m_panelESeriesHelp->SetPage( msg );
+}
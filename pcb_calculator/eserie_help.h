@@ -9,12 +9,13 @@ _HKI( "E-series defined in IEC 60063 are a widely accepted system of preferred\n
 "	E6:  1,0  -  1,5  -  2,2  -  3,3  -  4,7  -  6,8  -\n"
 "	E3:  1,0  -   -   -  2,2  -   -   -  4,7  -   -   -\n"
 "	E1:  1,0  -   -   -   -   -   -   -   -   -   -   -\n"
+"Series E24, E48, E96 and E192 are also available, with the values of\n"
+"IEC 60063.\n"
 "If your design requires any resistor value which is not readily available,\n"
 "this calculator will find a combination of standard E-series components to\n"
 "create it.  You can enter the required resistance from 0,0025 to 4000 KOhm. \n"
 "Solutions using 3 or 4 resistors are given if a better match can be found. \n"
-"The 4R checkbox option will take longer to process is considered for the E12\n"
-"series only.  Optionally it is possible to exclude up to two additional\n"
+"Optionally it is possible to exclude up to two additional\n"
 "values from the solution for the reason of being not available.  If a\n"
 "E-series value is entered to the required input field, it is always excluded\n"
 "from any solution as it is assumed that this value is unavailable.\n"
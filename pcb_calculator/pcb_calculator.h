@@ -279,6 +279,13 @@ private:
      */
     void OnTranslineSynthetize( wxCommandEvent& event ) override;
 
+    /**
+     * Function OnTranslineSweep
+     * Analyze the current transline over a grid of widths, spacings and heights
+     * around the current values, and export the results to a CSV file
+     */
+    void OnTranslineSweep( wxCommandEvent& event ) override;
+
     /**
      * Function OnTranslineEpsilonR_Button
      * Shows a list of current relative dielectric constant(Er)
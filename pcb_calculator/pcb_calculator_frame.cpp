@@ -18,6 +18,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <wx/wx.h>
+#include <wx/filedlg.h>
 
 #include <pgm_base.h>
 #include <pcb_calculator.h>
@@ -26,6 +27,7 @@
 #include <bitmaps.h>
 #include <geometry/shape_poly_set.h>
 #include <kiface_i.h>
+#include <transline_sweep.h>
 
 
 // extension of pcb_calculator data filename:
@@ -261,6 +263,89 @@ void PCB_CALCULATOR_FRAME::OnTranslineSynthetize( wxCommandEvent& event )
 }
 
 
+// Number of values of each swept parameter, from half to 1.5 times its current value
+#define TRANSLINE_SWEEP_STEPS 21
+
+/**
+ * Function OnTranslineSweep
+ * Analyze the current transline over a grid of widths, spacings and heights
+ * around the current values, and export the results to a CSV file
+ */
+void PCB_CALCULATOR_FRAME::OnTranslineSweep( wxCommandEvent& event )
+{
+    if( !m_currTransLine )
+        return;
+
+    wxFileDialog dlg( this, _( "Export Transmission Line Sweep" ), wxEmptyString,
+                      wxEmptyString, _( "CSV files (*.csv)|*.csv" ),
+                      wxFD_SAVE | wxFD_OVERWRITE_PROMPT );
+
+    if( dlg.ShowModal() == wxID_CANCEL )
+        return;
+
+    TransfDlgDataToTranslineParams();
+
+    TRANSLINE_IDENT*      tr_ident = m_transline_list[m_currTransLineType];
+    TRANSLINE_SWEEP       sweep( *m_currTransLine );
+    std::vector<wxString> columns;
+    std::vector<double>   scales;
+
+    // The base values are the ones an analysis would read in the dialog
+    for( int ii = 0; ii < DUMMY_PRM; ++ii )
+        sweep.SetBaseValue( (PRMS_ID) ii, GetPrmValue( (PRMS_ID) ii ) );
+
+    // Sweep the dimensions of the line (but not its length) and the height of the substrate
+    for( unsigned ii = 0; ii < tr_ident->GetPrmsCount(); ii++ )
+    {
+        TRANSLINE_PRM* prm = tr_ident->GetPrm( ii );
+
+        if( !( prm->m_Type == PRM_TYPE_PHYS && prm->m_Id != PHYS_LEN_PRM )
+                && prm->m_Id != H_PRM )
+        {
+            continue;
+        }
+
+        UNIT_SELECTOR* unit_ctrl = (UNIT_SELECTOR*) prm->m_UnitCtrl;
+        double         value = prm->m_NormalizedValue;
+
+        sweep.AddAxis( prm->m_Id, TRANSLINE_SWEEP::LinearValues( value * 0.5, value * 1.5,
+                                                                 TRANSLINE_SWEEP_STEPS ) );
+
+        wxString name( prm->m_KeyWord );
+
+        if( unit_ctrl )
+            name << " (" << unit_ctrl->GetUnitName() << ")";
+
+        columns.push_back( name );
+        scales.push_back( unit_ctrl ? unit_ctrl->GetUnitScale() : 1.0 );
+    }
+
+    if( m_currTransLineType == C_MICROSTRIP_TYPE )
+    {
+        sweep.AddResult( Z0_E_PRM );
+        sweep.AddResult( Z0_O_PRM );
+        columns.push_back( "Z0e (Ohm)" );
+        columns.push_back( "Z0o (Ohm)" );
+    }
+    else
+    {
+        sweep.AddResult( Z0_PRM );
+        sweep.AddResult( EPSILON_EFF_PRM );
+        sweep.AddResult( LOSS_CONDUCTOR_PRM );
+        sweep.AddResult( LOSS_DIELECTRIC_PRM );
+        columns.push_back( "Z0 (Ohm)" );
+        columns.push_back( "EpsilonEff" );
+        columns.push_back( "ConductorLoss (dB)" );
+        columns.push_back( "DielectricLoss (dB)" );
+    }
+
+    sweep.Run();
+
+    if( !sweep.WriteCSV( dlg.GetPath(), columns, scales ) )
+        wxMessageBox( wxString::Format( _( "Unable to write file \"%s\"" ), dlg.GetPath() ) );
+}
+
+
 void PCB_CALCULATOR_FRAME::OnPaintTranslinePanel( wxPaintEvent& event )
 {
     wxPaintDC           dc( m_panelDisplayshape );
@@ -76,6 +76,16 @@ C_MICROSTRIP::~C_MICROSTRIP()
 }
 
 
+TRANSLINE* C_MICROSTRIP::clone() const
+{
+    C_MICROSTRIP* line = new C_MICROSTRIP( *this );
+
+    // The auxiliary microstrip is not shared, the copy makes its own
+    line->aux_ms = nullptr;
+    return line;
+}
+
+
 /*
  * delta_u_thickness_single() computes the thickness effect on
  * normalized width for a single microstrip line
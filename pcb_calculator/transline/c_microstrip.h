@@ -34,6 +34,8 @@ public:
     C_MICROSTRIP();
     ~C_MICROSTRIP();
 
+    TRANSLINE* clone() const override;
+
 private:
     double h;                  // height of substrate
     double ht;                 // height to the top of box
@@ -32,6 +32,8 @@ class COAX : public TRANSLINE
 public:
     COAX();
 
+    TRANSLINE* clone() const override { return new COAX( *this ); }
+
 private:
     void   calcAnalyze() override;
     void   calcSynthesize() override;
@@ -32,6 +32,8 @@ class COPLANAR : public TRANSLINE
 public:
     COPLANAR();
 
+    TRANSLINE* clone() const override { return new COPLANAR( *this ); }
+
 public:
     void calcSynthesize() override;
 
@@ -50,6 +52,8 @@ class GROUNDEDCOPLANAR : public COPLANAR
 {
 public:
     GROUNDEDCOPLANAR();
+
+    TRANSLINE* clone() const override { return new GROUNDEDCOPLANAR( *this ); }
 };
 
 #endif // __COPLANAR_H
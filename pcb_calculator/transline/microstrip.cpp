@@ -306,8 +306,9 @@ void MICROSTRIP::dispersion()
     D    = Z0_dispersion( u, e_r, e_r_eff_0, e_r_eff_f, f_n );
     Z0_f = Z0_0 * D;
 
-    er_eff               = e_r_eff_f;
-    m_parameters[Z0_PRM] = Z0_f;
+    er_eff                        = e_r_eff_f;
+    m_parameters[EPSILON_EFF_PRM] = e_r_eff_f;
+    m_parameters[Z0_PRM]          = Z0_f;
 }
 
 
@@ -378,6 +379,10 @@ void MICROSTRIP::attenuation()
 
     atten_cond       = conductor_losses() * m_parameters[PHYS_LEN_PRM];
     atten_dielectric = dielectric_losses() * m_parameters[PHYS_LEN_PRM];
+
+    // also stored as parameters, like the other lines, for the analysis out of the dialog
+    m_parameters[LOSS_CONDUCTOR_PRM]  = atten_cond;
+    m_parameters[LOSS_DIELECTRIC_PRM] = atten_dielectric;
 }
 
 
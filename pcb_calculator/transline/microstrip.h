@@ -32,6 +32,8 @@ class MICROSTRIP : public TRANSLINE
 public:
     MICROSTRIP();
 
+    TRANSLINE* clone() const override { return new MICROSTRIP( *this ); }
+
     friend class C_MICROSTRIP;
 
 private:
@@ -35,6 +35,8 @@ class RECTWAVEGUIDE : public TRANSLINE
 public:
     RECTWAVEGUIDE();
 
+    TRANSLINE* clone() const override { return new RECTWAVEGUIDE( *this ); }
+
 
 private:
     double mur;              // magnetic permeability of substrate
@@ -32,6 +32,8 @@ class STRIPLINE : public TRANSLINE
 public:
     STRIPLINE();
 
+    TRANSLINE* clone() const override { return new STRIPLINE( *this ); }
+
 private:
     void   calcAnalyze() override;
     void   calcSynthesize() override;
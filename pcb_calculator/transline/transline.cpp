@@ -86,11 +86,6 @@ TRANSLINE::~TRANSLINE()
 
 void TRANSLINE::Init( void )
 {
-    wxColour wxcol = wxSystemSettings::GetColour( wxSYS_COLOUR_WINDOW );
-    okCol          = KIGFX::COLOR4D( wxcol );
-    okCol.r        = wxcol.Red() / 255.0;
-    okCol.g        = wxcol.Green() / 255.0;
-    okCol.b        = wxcol.Blue() / 255.0;
     int i;
     // Initialize these variables mainly to avoid warnings from a static analyzer
     for( i = 0; i < EXTRA_PRMS_COUNT; ++i )
@@ -219,6 +214,21 @@ void TRANSLINE::synthesize()
 }
 
 
+/**
+ * @function analyzeParameters
+ *
+ * Computes the extra parameters usually set by getProperties() and analyzes the line,
+ * from the parameters already set by setParameter().
+ **/
+void TRANSLINE::analyzeParameters()
+{
+    m_parameters[SIGMA_PRM]       = 1.0 / m_parameters[RHO_PRM];
+    m_parameters[EPSILON_EFF_PRM] = 1.0;
+    m_parameters[SKIN_DEPTH_PRM]  = skin_depth();
+    calcAnalyze();
+}
+
+
 /**
  * @function skin_depth
  * calculate skin depth
@@ -431,7 +441,16 @@ void TRANSLINE::setErrorLevel( PRMS_ID aP, char aErrorLevel )
         SetPropertyBgColorInDialog( aP, &errCol );
         break;
     default:
+    {
+        // The window colour is read here rather than in Init(): the lines used out of the
+        // dialog never use it
+        wxColour wxcol = wxSystemSettings::GetColour( wxSYS_COLOUR_WINDOW );
+        okCol          = KIGFX::COLOR4D( wxcol );
+        okCol.r        = wxcol.Red() / 255.0;
+        okCol.g        = wxcol.Green() / 255.0;
+        okCol.b        = wxcol.Blue() / 255.0;
         SetPropertyBgColorInDialog( aP, &okCol );
         break;
     }
+    }
 }
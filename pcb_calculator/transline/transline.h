@@ -112,6 +112,23 @@ public:
      **/
     virtual void   show_results(){};
     void           analyze();
+
+    /**
+     * Function clone
+     * @return a copy of this line, with its parameters.
+     */
+    virtual TRANSLINE* clone() const = 0;
+
+    /**
+     * Functions setParameter, getParameter, analyzeParameters
+     * Analyze the line with parameters given by the caller instead of the dialog.
+     * Nothing is read from or written to the dialog, so lines can be analyzed out of the
+     * GUI thread (see TRANSLINE_SWEEP).
+     */
+    void   setParameter( int aPrmId, double aValue ) { m_parameters[aPrmId] = aValue; }
+    double getParameter( int aPrmId ) const { return m_parameters[aPrmId]; }
+    void   analyzeParameters();
+
     KIGFX::COLOR4D errCol  = KIGFX::COLOR4D( 1, 0.63, 0.63, 1 );
     KIGFX::COLOR4D warnCol = KIGFX::COLOR4D( 1, 1, 0.57, 1 );
     KIGFX::COLOR4D okCol   = KIGFX::COLOR4D( 1, 1, 1, 1 );
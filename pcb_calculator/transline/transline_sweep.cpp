@@ -0,0 +1,232 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <future>
+#include <thread>
+
+#include <wx/ffile.h>
+
+#include <common.h>     // for LOCALE_IO
+#include <profile.h>
+
+#include "transline_sweep.h"
+
+
+// Number of points given at once to a thread
+#define SWEEP_BLOCK_SIZE 256
+
+
+TRANSLINE_SWEEP::TRANSLINE_SWEEP( const TRANSLINE& aLine ) :
+        m_line( aLine.clone() ),
+        m_threadCount( 0 ),
+        m_runTime( 0.0 )
+{
+}
+
+
+void TRANSLINE_SWEEP::SetBaseValue( PRMS_ID aPrmId, double aValue )
+{
+    m_line->setParameter( aPrmId, aValue );
+}
+
+
+void TRANSLINE_SWEEP::AddAxis( PRMS_ID aPrmId, const std::vector<double>& aValues )
+{
+    m_axes.push_back( aPrmId );
+    m_axisValues.push_back( aValues );
+}
+
+
+void TRANSLINE_SWEEP::AddResult( int aPrmId )
+{
+    m_resultIds.push_back( aPrmId );
+}
+
+
+size_t TRANSLINE_SWEEP::GetPointCount() const
+{
+    if( m_axes.empty() )
+        return 0;
+
+    size_t count = 1;
+
+    for( const std::vector<double>& values : m_axisValues )
+        count *= values.size();
+
+    return count;
+}
+
+
+std::vector<double> TRANSLINE_SWEEP::LinearValues( double aStart, double aEnd, int aCount )
+{
+    std::vector<double> values;
+
+    if( aCount == 1 )
+        values.push_back( aStart );
+
+    for( int ii = 0; aCount > 1 && ii < aCount; ++ii )
+        values.push_back( aStart + ( aEnd - aStart ) * ii / ( aCount - 1 ) );
+
+    return values;
+}
+
+
+void TRANSLINE_SWEEP::analyzeBlock( TRANSLINE& aLine, size_t aFirst, size_t aLast )
+{
+    for( size_t pt = aFirst; pt < aLast; ++pt )
+    {
+        for( size_t axis = 0; axis < m_axes.size(); ++axis )
+            aLine.setParameter( m_axes[axis], m_inputs[axis][pt] );
+
+        aLine.analyzeParameters();
+
+        for( size_t res = 0; res < m_resultIds.size(); ++res )
+            m_results[res][pt] = aLine.getParameter( m_resultIds[res] );
+    }
+}
+
+
+void TRANSLINE_SWEEP::Run()
+{
+    PROF_COUNTER timer;
+    size_t       count = GetPointCount();
+
+    // Expand the grid: the swept values of each point are stored contiguously per axis
+    m_inputs.assign( m_axes.size(), std::vector<double>( count ) );
+    m_results.assign( m_resultIds.size(), std::vector<double>( count ) );
+
+    if( count == 0 )
+        return;
+
+    size_t stride = count;
+
+    for( size_t axis = 0; axis < m_axes.size(); ++axis )
+    {
+        const std::vector<double>& values = m_axisValues[axis];
+        std::vector<double>&       inputs = m_inputs[axis];
+
+        stride /= values.size();
+
+        for( size_t pt = 0; pt < count; ++pt )
+            inputs[pt] = values[( pt / stride ) % values.size()];
+    }
+
+    size_t blocks = ( count + SWEEP_BLOCK_SIZE - 1 ) / SWEEP_BLOCK_SIZE;
+    size_t parallelThreadCount = m_threadCount ? m_threadCount
+                                               : std::thread::hardware_concurrency();
+
+    parallelThreadCount = std::max<size_t>( 1, std::min<size_t>( parallelThreadCount, blocks ) );
+
+    // The lines are copied here: the threads never construct them
+    std::vector<std::unique_ptr<TRANSLINE>> lines;
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        lines.emplace_back( m_line->clone() );
+
+    std::atomic<size_t> nextBlock( 0 );
+
+    auto analyzeBlocks = [&]( TRANSLINE* aLine )
+    {
+        for( size_t block = nextBlock++; block < blocks; block = nextBlock++ )
+        {
+            analyzeBlock( *aLine, block * SWEEP_BLOCK_SIZE,
+                          std::min( count, ( block + 1 ) * SWEEP_BLOCK_SIZE ) );
+        }
+    };
+
+    if( parallelThreadCount == 1 )
+    {
+        analyzeBlocks( lines[0].get() );
+    }
+    else
+    {
+        std::vector<std::future<void>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, analyzeBlocks, lines[ii].get() );
+
+        for( auto& ret : returns )
+            ret.wait();
+    }
+
+    m_runTime = timer.msecs();
+}
+
+
+bool TRANSLINE_SWEEP::WriteCSV( const wxString& aFileName, const std::vector<wxString>& aColumns,
+                                const std::vector<double>& aScales ) const
+{
+    wxFFile file( aFileName, "w" );
+
+    if( !file.IsOpened() )
+        return false;
+
+    LOCALE_IO   toggle;     // the values use a dot as decimal separator
+    std::string line;
+    char        buf[32];
+
+    for( size_t col = 0; col < aColumns.size(); ++col )
+    {
+        line += col ? "," : "";
+        line += aColumns[col].ToStdString();
+    }
+
+    line += "\n";
+
+    std::vector<const std::vector<double>*> columns;
+
+    for( const std::vector<double>& inputs : m_inputs )
+        columns.push_back( &inputs );
+
+    for( const std::vector<double>& results : m_results )
+        columns.push_back( &results );
+
+    size_t count = m_inputs.empty() ? 0 : m_inputs[0].size();
+
+    // The lines are formatted by blocks, to write large sweeps with few calls
+    for( size_t pt = 0; pt < count; ++pt )
+    {
+        for( size_t col = 0; col < columns.size(); ++col )
+        {
+            double scale = col < aScales.size() ? aScales[col] : 1.0;
+
+            snprintf( buf, sizeof( buf ), col ? ",%.6g" : "%.6g", ( *columns[col] )[pt] / scale );
+            line += buf;
+        }
+
+        line += "\n";
+
+        if( line.size() > 65536 )
+        {
+            if( file.Write( line.data(), line.size() ) != line.size() )
+                return false;
+
+            line.clear();
+        }
+    }
+
+    return file.Write( line.data(), line.size() ) == line.size() && file.Close();
+}
@@ -0,0 +1,123 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef TRANSLINE_SWEEP_H
+#define TRANSLINE_SWEEP_H
+
+#include <memory>
+#include <vector>
+
+#include <transline.h>
+
+
+/**
+ * TRANSLINE_SWEEP analyzes a transmission line over a grid of geometries, for instance
+ * the impedance of a microstrip over the widths and dielectric heights of a stackup.
+ *
+ * The grid is the product of the values of the swept parameters (the axes); the other
+ * parameters keep their base value.  The swept values and the results are stored as
+ * structures of arrays, one array per parameter indexed by the grid point, so the points
+ * are read and written contiguously.
+ *
+ * The points are analyzed by blocks, shared by several threads.  Each thread analyzes
+ * its own copy of the line, without the dialog.
+ */
+class TRANSLINE_SWEEP
+{
+public:
+    /**
+     * @param aLine is the line to analyze: its type and its parameters are copied, they
+     * are the base values of the sweep.
+     */
+    TRANSLINE_SWEEP( const TRANSLINE& aLine );
+
+    ///> Sets the value of a parameter which is not swept, in normalized units
+    void SetBaseValue( PRMS_ID aPrmId, double aValue );
+
+    /**
+     * Function AddAxis
+     * sweeps a parameter over a list of values, in normalized units.  The values of the
+     * last added axis change first from one point of the grid to the next.
+     */
+    void AddAxis( PRMS_ID aPrmId, const std::vector<double>& aValues );
+
+    ///> Adds a parameter to record for each point, a PRMS_ID or an EXTRA_PRMS_ID
+    void AddResult( int aPrmId );
+
+    ///> Sets the number of threads, 0 to use all the cores
+    void SetThreadCount( size_t aCount ) { m_threadCount = aCount; }
+
+    /**
+     * Function Run
+     * analyzes the line at all the points of the grid.
+     */
+    void Run();
+
+    ///> Returns the number of points of the grid
+    size_t GetPointCount() const;
+
+    ///> Returns the values of the swept parameter aAxis, for each point
+    const std::vector<double>& GetInputs( size_t aAxis ) const { return m_inputs[aAxis]; }
+
+    ///> Returns the values of the result aResult (in the order of AddResult), for each point
+    const std::vector<double>& GetResults( size_t aResult ) const { return m_results[aResult]; }
+
+    ///> Returns the time spent by the last Run(), in milliseconds
+    double GetRunTime() const { return m_runTime; }
+
+    /**
+     * Function WriteCSV
+     * writes the sweep to a CSV file: a header line with the given column names, then one
+     * line per point with the swept values followed by the results.
+     *
+     * @param aFileName is the file to write.
+     * @param aColumns are the names of the swept parameters then of the results.
+     * @param aScales are the units the values are divided by, in the same order.
+     * @return true if successful.
+     */
+    bool WriteCSV( const wxString& aFileName, const std::vector<wxString>& aColumns,
+                   const std::vector<double>& aScales ) const;
+
+    /**
+     * Function LinearValues
+     * @return aCount values evenly spaced from aStart to aEnd, both included.
+     */
+    static std::vector<double> LinearValues( double aStart, double aEnd, int aCount );
+
+private:
+    ///> Analyzes the points aFirst to aLast - 1 with aLine
+    void analyzeBlock( TRANSLINE& aLine, size_t aFirst, size_t aLast );
+
+    std::unique_ptr<TRANSLINE>       m_line;
+    std::vector<PRMS_ID>             m_axes;
+    std::vector<std::vector<double>> m_axisValues;
+    std::vector<int>                 m_resultIds;
+
+    std::vector<std::vector<double>> m_inputs;      ///< Swept values, per axis and point
+    std::vector<std::vector<double>> m_results;     ///< Results, per result and point
+
+    size_t m_threadCount;
+    double m_runTime;
+};
+
+#endif // TRANSLINE_SWEEP_H
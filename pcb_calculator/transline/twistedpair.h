@@ -31,6 +31,8 @@ class TWISTEDPAIR : public TRANSLINE
 public:
     TWISTEDPAIR();
 
+    TRANSLINE* clone() const override { return new TWISTEDPAIR( *this ); }
+
 private:
     void calcAnalyze() override;
     void calcSynthesize() override;
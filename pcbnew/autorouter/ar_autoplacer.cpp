@@ -40,7 +40,10 @@
 
 #include "ar_autoplacer.h"
 #include "ar_matrix.h"
+#include <atomic>
+#include <future>
 #include <memory>
+#include <thread>
 #include <ratsnest/ratsnest_data.h>
 
 #define AR_GAIN            16
@@ -431,115 +434,101 @@ void AR_AUTOPLACER::genModuleOnRoutingMatrix( MODULE* Module )
 }
 
 
-/* Test if the rectangular area (ux, ux .. y0, y1):
- * - is a free zone (except OCCUPED_By_MODULE returns)
- * - is on the working surface of the board (otherwise returns OUT_OF_BOARD)
- *
- * Returns OUT_OF_BOARD, or OCCUPED_By_MODULE or FREE_CELL if OK
- */
-int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side )
+void AR_AUTOPLACER::buildAreaTables()
 {
-    EDA_RECT rect = aRect;
+    for( int side = 0; side < AR_MAX_ROUTING_LAYERS_COUNT; side++ )
+    {
+        if( m_matrix.m_BoardSide[side] == nullptr )
+            continue;
+
+        m_matrix.BuildCellCountTable( side, CELL_IS_ZONE, m_zoneCellCount[side] );
+        m_matrix.BuildCellCountTable( side, CELL_IS_MODULE, m_moduleCellCount[side] );
+        m_matrix.BuildDistSumTable( side, m_keepOutSum[side] );
+    }
+}
 
-    rect.Inflate( m_matrix.m_GridRouting / 2 );
 
-    wxPoint start   = rect.GetOrigin();
-    wxPoint end     = rect.GetEnd();
+bool AR_AUTOPLACER::getCellRange( const EDA_RECT& aRect, int& aRowMin, int& aRowMax,
+                                  int& aColMin, int& aColMax ) const
+{
+    wxPoint start   = aRect.GetOrigin();
+    wxPoint end     = aRect.GetEnd();
 
     start   -= m_matrix.m_BrdBox.GetOrigin();
     end     -= m_matrix.m_BrdBox.GetOrigin();
 
-    int row_min = start.y / m_matrix.m_GridRouting;
-    int row_max = end.y / m_matrix.m_GridRouting;
-    int col_min = start.x / m_matrix.m_GridRouting;
-    int col_max = end.x / m_matrix.m_GridRouting;
-
-    if( start.y > row_min * m_matrix.m_GridRouting )
-        row_min++;
+    aRowMin = start.y / m_matrix.m_GridRouting;
+    aRowMax = end.y / m_matrix.m_GridRouting;
+    aColMin = start.x / m_matrix.m_GridRouting;
+    aColMax = end.x / m_matrix.m_GridRouting;
 
-    if( start.x > col_min * m_matrix.m_GridRouting )
-        col_min++;
+    if( start.y > aRowMin * m_matrix.m_GridRouting )
+        aRowMin++;
 
-    if( row_min < 0 )
-        row_min = 0;
+    if( start.x > aColMin * m_matrix.m_GridRouting )
+        aColMin++;
 
-    if( row_max >= ( m_matrix.m_Nrows - 1 ) )
-        row_max = m_matrix.m_Nrows - 1;
+    if( aRowMin < 0 )
+        aRowMin = 0;
 
-    if( col_min < 0 )
-        col_min = 0;
+    if( aRowMax >= ( m_matrix.m_Nrows - 1 ) )
+        aRowMax = m_matrix.m_Nrows - 1;
 
-    if( col_max >= ( m_matrix.m_Ncols - 1 ) )
-        col_max = m_matrix.m_Ncols - 1;
+    if( aColMin < 0 )
+        aColMin = 0;
 
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            unsigned int data = m_matrix.GetCell( row, col, side );
-
-            if( ( data & CELL_IS_ZONE ) == 0 )
-                return AR_OUT_OF_BOARD;
-
-            if( (data & CELL_IS_MODULE) )
-                return AR_OCCUIPED_BY_MODULE;
-        }
-    }
+    if( aColMax >= ( m_matrix.m_Ncols - 1 ) )
+        aColMax = m_matrix.m_Ncols - 1;
 
-    return AR_FREE_CELL;
+    return aRowMin <= aRowMax && aColMin <= aColMax;
 }
 
 
-/* Calculates and returns the clearance area of the rectangular surface
- * aRect):
- * (Sum of cells in terms of distance)
+/* Test if the rectangular area (ux, ux .. y0, y1):
+ * - is a free zone (except OCCUPED_By_MODULE returns)
+ * - is on the working surface of the board (otherwise returns OUT_OF_BOARD)
+ *
+ * Returns OUT_OF_BOARD, or OCCUPED_By_MODULE or FREE_CELL if OK
+ * The cells are counted from the summed area tables, in constant time.
  */
-unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int side )
+int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side ) const
 {
-    wxPoint start   = aRect.GetOrigin();
-    wxPoint end     = aRect.GetEnd();
+    EDA_RECT rect = aRect;
 
-    start   -= m_matrix.m_BrdBox.GetOrigin();
-    end     -= m_matrix.m_BrdBox.GetOrigin();
+    rect.Inflate( m_matrix.m_GridRouting / 2 );
 
-    int row_min = start.y / m_matrix.m_GridRouting;
-    int row_max = end.y / m_matrix.m_GridRouting;
-    int col_min = start.x / m_matrix.m_GridRouting;
-    int col_max = end.x / m_matrix.m_GridRouting;
+    int row_min, row_max, col_min, col_max;
 
-    if( start.y > row_min * m_matrix.m_GridRouting )
-        row_min++;
+    if( !getCellRange( rect, row_min, row_max, col_min, col_max ) )
+        return AR_FREE_CELL;
 
-    if( start.x > col_min * m_matrix.m_GridRouting )
-        col_min++;
+    int cellCount = ( row_max - row_min + 1 ) * ( col_max - col_min + 1 );
 
-    if( row_min < 0 )
-        row_min = 0;
+    if( m_matrix.SumAreaTable( m_zoneCellCount[side], row_min, row_max, col_min, col_max )
+            < cellCount )
+        return AR_OUT_OF_BOARD;
 
-    if( row_max >= ( m_matrix.m_Nrows - 1 ) )
-        row_max = m_matrix.m_Nrows - 1;
+    if( m_matrix.SumAreaTable( m_moduleCellCount[side], row_min, row_max, col_min, col_max ) > 0 )
+        return AR_OCCUIPED_BY_MODULE;
 
-    if( col_min < 0 )
-        col_min = 0;
+    return AR_FREE_CELL;
+}
 
-    if( col_max >= ( m_matrix.m_Ncols - 1 ) )
-        col_max = m_matrix.m_Ncols - 1;
 
-    unsigned int keepOutCost = 0;
+/* Calculates and returns the clearance area of the rectangular surface
+ * aRect):
+ * (Sum of cells in terms of distance)
+ */
+unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int side ) const
+{
+    int row_min, row_max, col_min, col_max;
 
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            // m_matrix.GetDist returns the "cost" of the cell
-            // at position (row, col)
-            // in autoplace this is the cost of the cell, if it is
-            // inside aRect
-            keepOutCost += m_matrix.GetDist( row, col, side );
-        }
-    }
+    if( !getCellRange( aRect, row_min, row_max, col_min, col_max ) )
+        return 0;
 
-    return keepOutCost;
+    // m_matrix.GetDist returns the "cost" of a cell; the table sums them
+    return (unsigned int) m_matrix.SumAreaTable( m_keepOutSum[side], row_min, row_max,
+                                                 col_min, col_max );
 }
 
 
@@ -547,7 +536,8 @@ unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int sid
  * Returns the value TstRectangle().
  * Module is known by its bounding box
  */
-int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const wxPoint& aOffset )
+int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide,
+                                      const EDA_RECT& aFpBBox ) const
 {
     int side = AR_SIDE_TOP;
     int otherside = AR_SIDE_BOTTOM;
@@ -557,21 +547,16 @@ int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const
         side = AR_SIDE_BOTTOM; otherside = AR_SIDE_TOP;
     }
 
-    EDA_RECT    fpBBox = aModule->GetFootprintRect();
-    fpBBox.Move( -aOffset );
+    EDA_RECT    fpBBox = aFpBBox;
 
-    buildFpAreas( aModule, 0 );
-
-    int diag = //testModuleByPolygon( aModule, side, aOffset );
-        testRectangle( fpBBox, side );
+    int diag = testRectangle( fpBBox, side );
 
     if( diag != AR_FREE_CELL )
         return diag;
 
     if( TstOtherSide )
     {
-        diag = //testModuleByPolygon( aModule, otherside, aOffset );
-                testRectangle( fpBBox, otherside );
+        diag = testRectangle( fpBBox, otherside );
 
         if( diag != AR_FREE_CELL )
             return diag;
@@ -588,7 +573,7 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
 {
     int     error = 1;
     wxPoint LastPosOK;
-    double  min_cost, curr_cost, Score;
+    double  min_cost;
     bool    TstOtherSide;
 
     aModule->CalculateBoundingBox();
@@ -612,9 +597,6 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
     initialPos.x    -= initialPos.x % m_matrix.m_GridRouting;
     initialPos.y    -= initialPos.y % m_matrix.m_GridRouting;
 
-    m_curPosition = initialPos;
-    auto moduleOffset = mod_pos - m_curPosition;
-
     /* Examine pads, and set TstOtherSide to true if a footprint
      * has at least 1 pad through.
      */
@@ -634,43 +616,77 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
         }
     }
 
-    fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
+    std::vector<PAD_CONNECTIONS> connections = buildPadConnections( aModule );
 
-    min_cost = -1.0;
-//    m_frame->SetStatusText( wxT( "Score ??, pos ??" ) );
+    // The positions are tried by columns, each column in its own thread.  The best position
+    // of each column is kept, and the columns are then compared in the order of the serial
+    // scan, so the result does not depend on the thread count.
+    struct PLACEMENT
+    {
+        wxPoint m_Pos;
+        double  m_Cost = -1.0;
+    };
 
+    std::vector<int> columns;
 
-    for( ; m_curPosition.x < xylimit.x; m_curPosition.x += m_matrix.m_GridRouting )
-    {
-        m_curPosition.y = initialPos.y;
+    for( int x = initialPos.x; x < xylimit.x; x += m_matrix.m_GridRouting )
+        columns.push_back( x );
 
-        for( ; m_curPosition.y < xylimit.y; m_curPosition.y += m_matrix.m_GridRouting )
-        {
+    std::vector<PLACEMENT> bestInColumn( columns.size() );
+    std::atomic<size_t>    nextColumn( 0 );
 
-            fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-            moduleOffset = mod_pos - m_curPosition;
-            int keepOutCost = testModuleOnBoard( aModule, TstOtherSide, moduleOffset );
+    auto place_lambda = [&]()
+    {
+        for( size_t i = nextColumn++; i < columns.size(); i = nextColumn++ )
+        {
+            PLACEMENT& best = bestInColumn[i];
+            EDA_RECT   bbox = fpBBox;
+            wxPoint    pos( columns[i], initialPos.y );
 
-            if( keepOutCost >= 0 )    // i.e. if the module can be put here
+            for( ; pos.y < xylimit.y; pos.y += m_matrix.m_GridRouting )
             {
-                error = 0;
-                // m_frame->build_ratsnest_module( aModule ); // fixme
-                curr_cost   = computePlacementRatsnestCost( aModule, moduleOffset );
-                Score       = curr_cost + keepOutCost;
+                bbox.SetOrigin( fpBBoxOrg + pos );
+                int keepOutCost = testModuleOnBoard( aModule, TstOtherSide, bbox );
 
-                if( (min_cost >= Score ) || (min_cost < 0 ) )
+                if( keepOutCost < 0 )    // i.e. if the module cannot be put here
+                    continue;
+
+                double Score = computePlacementRatsnestCost( connections, mod_pos - pos )
+                               + keepOutCost;
+
+                if( ( best.m_Cost >= Score ) || ( best.m_Cost < 0 ) )
                 {
-                    LastPosOK   = m_curPosition;
-                    min_cost    = Score;
-                    wxString msg;
-/*                    msg.Printf( wxT( "Score %g, pos %s, %s" ),
-                                min_cost,
-                                GetChars( ::CoordinateToString( LastPosOK.x ) ),
-                                GetChars( ::CoordinateToString( LastPosOK.y ) ) );
-                    m_frame->SetStatusText( msg );*/
+                    best.m_Pos  = pos;
+                    best.m_Cost = Score;
                 }
             }
         }
+    };
+
+    size_t parallelThreadCount = std::min<size_t>( std::max<size_t>( 1,
+            std::thread::hardware_concurrency() ), columns.size() );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( std::future<void>& ret : returns )
+        ret = std::async( std::launch::async, place_lambda );
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
+
+    min_cost = -1.0;
+
+    for( const PLACEMENT& best : bestInColumn )
+    {
+        if( best.m_Cost < 0 )
+            continue;
+
+        error = 0;
+
+        if( ( min_cost >= best.m_Cost ) || ( min_cost < 0 ) )
+        {
+            LastPosOK   = best.m_Pos;
+            min_cost    = best.m_Cost;
+        }
     }
 
     // Regeneration of the modified variable.
@@ -681,39 +697,40 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
 }
 
 
-const D_PAD* AR_AUTOPLACER::nearestPad( MODULE *aRefModule, D_PAD* aRefPad, const wxPoint& aOffset)
+std::vector<AR_AUTOPLACER::PAD_CONNECTIONS>
+AR_AUTOPLACER::buildPadConnections( MODULE* aModule ) const
 {
-    const D_PAD* nearest = nullptr;
-    int64_t nearestDist = INT64_MAX;
+    std::vector<PAD_CONNECTIONS> connections;
 
-    for ( auto mod : m_board->Modules() )
+    for( auto refPad : aModule->Pads() )
     {
-        if ( mod == aRefModule )
-            continue;
-
-        if( !m_matrix.m_BrdBox.Contains( mod->GetPosition() ) )
-            continue;
+        PAD_CONNECTIONS conn;
+        conn.m_PadPos = refPad->GetPosition();
 
-        for ( auto pad: mod->Pads() )
+        for( auto mod : m_board->Modules() )
         {
-            if ( pad->GetNetCode() != aRefPad->GetNetCode() || pad->GetNetCode() <= 0 )
+            if( mod == aModule || refPad->GetNetCode() <= 0 )
                 continue;
 
-            auto dist = (VECTOR2I( aRefPad->GetPosition() - aOffset ) - VECTOR2I( pad->GetPosition() ) ).EuclideanNorm();
+            if( !m_matrix.m_BrdBox.Contains( mod->GetPosition() ) )
+                continue;
 
-            if ( dist < nearestDist )
+            for( auto pad : mod->Pads() )
             {
-                nearestDist = dist;
-                nearest = pad;
+                if( pad->GetNetCode() == refPad->GetNetCode() )
+                    conn.m_Targets.push_back( pad->GetPosition() );
             }
         }
+
+        connections.push_back( std::move( conn ) );
     }
 
-    return nearest;
+    return connections;
 }
 
 
-double AR_AUTOPLACER::computePlacementRatsnestCost( MODULE *aModule, const wxPoint& aOffset )
+double AR_AUTOPLACER::computePlacementRatsnestCost(
+        const std::vector<PAD_CONNECTIONS>& aConnections, const wxPoint& aOffset ) const
 {
     double  curr_cost;
     VECTOR2I start;      // start point of a ratsnest
@@ -722,19 +739,29 @@ double AR_AUTOPLACER::computePlacementRatsnestCost( MODULE *aModule, const wxPoi
 
     curr_cost = 0;
 
-    for ( auto pad : aModule->Pads() )
+    for( const PAD_CONNECTIONS& conn : aConnections )
     {
-        auto nearest = nearestPad( aModule, pad, aOffset );
+        start = VECTOR2I( conn.m_PadPos ) - VECTOR2I( aOffset );
+
+        // Search the nearest connected pad
+        const wxPoint* nearest = nullptr;
+        int64_t nearestDist = INT64_MAX;
+
+        for( const wxPoint& target : conn.m_Targets )
+        {
+            auto dist = ( start - VECTOR2I( target ) ).EuclideanNorm();
+
+            if( dist < nearestDist )
+            {
+                nearestDist = dist;
+                nearest = &target;
+            }
+        }
 
         if( !nearest )
             continue;
 
-        start   = VECTOR2I( pad->GetPosition() ) - VECTOR2I(aOffset);
-        end     = VECTOR2I( nearest->GetPosition() );
-
-        //m_overlay->SetIsStroke( true );
-        //m_overlay->SetStrokeColor( COLOR4D(0.0, 1.0, 0.0, 1.0) );
-        //m_overlay->Line( start, end );
+        end = VECTOR2I( *nearest );
 
         // Cost of the ratsnest.
         dx  = end.x - start.x;
@@ -936,6 +963,7 @@ AR_RESULT AR_AUTOPLACER::AutoplaceModules( std::vector<MODULE*>& aModules, BOARD
             genModuleOnRoutingMatrix( m );
     }
 
+    buildAreaTables();
 
     int         cnt = 0;
     wxString    msg;
@@ -1056,6 +1084,7 @@ end_of_tst:
 
         module->CalculateBoundingBox();
         genModuleOnRoutingMatrix( module );
+        buildAreaTables();
         module->SetIsPlaced( true );
         module->SetNeedsPlaced( false );
         drawPlacementRoutingMatrix();
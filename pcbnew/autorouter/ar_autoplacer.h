@@ -95,11 +95,38 @@ private:
     bool         fillMatrix();
     void         genModuleOnRoutingMatrix( MODULE* Module );
 
-    int          testRectangle( const EDA_RECT& aRect, int side );
-    unsigned int calculateKeepOutArea( const EDA_RECT& aRect, int side );
-    int          testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const wxPoint& aOffset );
+    /**
+     * The pads of the placed modules connected to a pad of the module to place, gathered
+     * once for all the positions tried by getOptimalModulePlacement()
+     */
+    struct PAD_CONNECTIONS
+    {
+        wxPoint              m_PadPos;      ///< the pad of the module to place
+        std::vector<wxPoint> m_Targets;     ///< the pads of the same net on placed modules
+    };
+
+    /** builds the summed area tables of m_matrix used by testRectangle() and
+     * calculateKeepOutArea().  Must be called after m_matrix is modified.
+     */
+    void         buildAreaTables();
+
+    /** calculates the cells of m_matrix inside aRect
+     * @return false if there are no cells inside aRect
+     */
+    bool         getCellRange( const EDA_RECT& aRect, int& aRowMin, int& aRowMax,
+                               int& aColMin, int& aColMax ) const;
+
+    int          testRectangle( const EDA_RECT& aRect, int side ) const;
+    unsigned int calculateKeepOutArea( const EDA_RECT& aRect, int side ) const;
+
+    /** @param aFpBBox is the footprint rect of aModule at the tested position
+     */
+    int          testModuleOnBoard( MODULE* aModule, bool TstOtherSide,
+                                    const EDA_RECT& aFpBBox ) const;
     int          getOptimalModulePlacement( MODULE* aModule );
-    double       computePlacementRatsnestCost( MODULE* aModule, const wxPoint& aOffset );
+    std::vector<PAD_CONNECTIONS> buildPadConnections( MODULE* aModule ) const;
+    double       computePlacementRatsnestCost( const std::vector<PAD_CONNECTIONS>& aConnections,
+                                               const wxPoint& aOffset ) const;
 
     /**
      * Find the "best" module place. The criteria are:
@@ -109,7 +136,6 @@ private:
     MODULE*      pickModule();
 
     void         placeModule( MODULE* aModule, bool aDoNotRecreateRatsnest, const wxPoint& aPos );
-    const D_PAD* nearestPad( MODULE* aRefModule, D_PAD* aRefPad, const wxPoint& aOffset );
 
     // Add a polygonal shape (rectangle) to m_fpAreaFront and/or m_fpAreaBack
     void         addFpBody( wxPoint aStart, wxPoint aEnd, LSET aLayerMask );
@@ -122,6 +148,12 @@ private:
     void         buildFpAreas( MODULE* aFootprint, int aFpClearance );
 
     AR_MATRIX m_matrix;
+
+    // Summed area tables of the m_matrix sides, see buildAreaTables()
+    std::vector<int>     m_zoneCellCount[AR_MAX_ROUTING_LAYERS_COUNT];
+    std::vector<int>     m_moduleCellCount[AR_MAX_ROUTING_LAYERS_COUNT];
+    std::vector<int64_t> m_keepOutSum[AR_MAX_ROUTING_LAYERS_COUNT];
+
     SHAPE_POLY_SET m_topFreeArea;       // The polygonal description of the top side free areas;
     SHAPE_POLY_SET m_bottomFreeArea;    // The polygonal description of the bottom side free areas;
     SHAPE_POLY_SET m_boardShape;        // The polygonal description of the board;
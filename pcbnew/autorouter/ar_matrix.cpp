@@ -250,6 +250,51 @@ void AR_MATRIX::SetDist( int aRow, int aCol, int aSide, DIST_CELL x )
 }
 
 
+// build the summed area table of a side for a cell value, see SumAreaTable()
+template <typename T, typename CELL, typename VALUE>
+static void buildAreaTable( const CELL* aCells, int aNrows, int aNcols, std::vector<T>& aTable,
+                            VALUE aValue )
+{
+    int stride = aNcols + 1;
+
+    aTable.assign( (size_t) ( aNrows + 1 ) * stride, 0 );
+
+    for( int row = 0; row < aNrows; row++ )
+    {
+        const CELL* cells = aCells + (size_t) row * aNcols;
+        const T*    prev  = &aTable[(size_t) row * stride];
+        T*          curr  = &aTable[(size_t) ( row + 1 ) * stride];
+        T           rowSum = 0;
+
+        for( int col = 0; col < aNcols; col++ )
+        {
+            rowSum += aValue( cells[col] );
+            curr[col + 1] = prev[col + 1] + rowSum;
+        }
+    }
+}
+
+
+void AR_MATRIX::BuildCellCountTable( int aSide, MATRIX_CELL aMask, std::vector<int>& aTable ) const
+{
+    buildAreaTable( m_BoardSide[aSide], m_Nrows, m_Ncols, aTable,
+                    [aMask]( MATRIX_CELL aCell ) -> int
+                    {
+                        return ( aCell & aMask ) ? 1 : 0;
+                    } );
+}
+
+
+void AR_MATRIX::BuildDistSumTable( int aSide, std::vector<int64_t>& aTable ) const
+{
+    buildAreaTable( m_DistSide[aSide], m_Nrows, m_Ncols, aTable,
+                    []( DIST_CELL aDist ) -> int64_t
+                    {
+                        return aDist;
+                    } );
+}
+
+
 /*
 ** x is the direction to enter the cell of interest.
 ** y is the direction to exit the cell of interest.
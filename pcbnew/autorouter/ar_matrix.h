@@ -29,6 +29,9 @@
 #ifndef __AR_MATRIX_H
 #define __AR_MATRIX_H
 
+#include <cstdint>
+#include <vector>
+
 #include <eda_rect.h>
 #include <layers_id_colors_and_visibility.h>
 
@@ -130,6 +133,41 @@ public:
     DIST_CELL   GetDist( int aRow, int aCol, int aSide );
     void        SetDist( int aRow, int aCol, int aSide, DIST_CELL );
 
+    /**
+     * Function BuildCellCountTable
+     * builds the summed area table of the cells of \a aSide having one of the bits of
+     * \a aMask, to count them in any rectangle with SumAreaTable().
+     * The table is a snapshot: it must be rebuilt after the cells are modified.
+     */
+    void BuildCellCountTable( int aSide, MATRIX_CELL aMask, std::vector<int>& aTable ) const;
+
+    /**
+     * Function BuildDistSumTable
+     * builds the summed area table of the distances of \a aSide, to sum them in any
+     * rectangle with SumAreaTable().
+     * The table is a snapshot: it must be rebuilt after the distances are modified.
+     */
+    void BuildDistSumTable( int aSide, std::vector<int64_t>& aTable ) const;
+
+    /**
+     * Function SumAreaTable
+     * @return the sum of the cells of the rectangle aRowMin..aRowMax, aColMin..aColMax
+     * (limits included) from a table built by BuildCellCountTable() or BuildDistSumTable().
+     * The rectangle must be inside the matrix; the sum is calculated in constant time.
+     */
+    template <typename T>
+    T SumAreaTable( const std::vector<T>& aTable, int aRowMin, int aRowMax, int aColMin,
+                    int aColMax ) const
+    {
+        // The table has an extra first row and first column of 0
+        int stride = m_Ncols + 1;
+
+        return aTable[( aRowMax + 1 ) * stride + aColMax + 1]
+               - aTable[aRowMin * stride + aColMax + 1]
+               - aTable[( aRowMax + 1 ) * stride + aColMin]
+               + aTable[aRowMin * stride + aColMin];
+    }
+
     void TraceSegmentPcb( PCB_SHAPE* pt_segm, int color, int marge, AR_MATRIX::CELL_OP op_logic );
     void CreateKeepOutRectangle(
             int ux0, int uy0, int ux1, int uy1, int marge, int aKeepOut, LSET aLayerMask );
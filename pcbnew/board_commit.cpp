@@ -34,6 +34,7 @@
 #include <connectivity/connectivity_data.h>
 
 #include <functional>
+#include <set>
 using namespace std::placeholders;
 
 #include "pcb_draw_panel_gal.h"
@@ -42,6 +43,7 @@ BOARD_COMMIT::BOARD_COMMIT( PCB_TOOL_BASE* aTool )
 {
     m_toolMgr = aTool->GetManager();
     m_editModules = aTool->EditingModules();
+    m_rebuildConnectivity = false;
 }
 
 
@@ -49,6 +51,15 @@ BOARD_COMMIT::BOARD_COMMIT( EDA_DRAW_FRAME* aFrame )
 {
     m_toolMgr = aFrame->GetToolManager();
     m_editModules = aFrame->IsType( FRAME_FOOTPRINT_EDITOR );
+    m_rebuildConnectivity = false;
+}
+
+
+BOARD_COMMIT::BOARD_COMMIT()
+{
+    m_toolMgr = nullptr;
+    m_editModules = false;
+    m_rebuildConnectivity = false;
 }
 
 
@@ -83,6 +94,12 @@ COMMIT& BOARD_COMMIT::Stage( const PICKED_ITEMS_LIST& aItems, UNDO_REDO aModFlag
 
 void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool aSetDirtyBit )
 {
+    if( !m_toolMgr )
+    {
+        pushToModel();
+        return;
+    }
+
     // Objects potentially interested in changes:
     PICKED_ITEMS_LIST   undoList;
     KIGFX::VIEW*        view = m_toolMgr->GetView();
@@ -92,6 +109,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     std::set<EDA_ITEM*> savedModules;
     SELECTION_TOOL*     selTool = m_toolMgr->GetTool<SELECTION_TOOL>();
     bool                itemsDeselected = false;
+    bool                rebuildConnectivity = m_rebuildConnectivity && !m_editModules;
+    std::set<BOARD_ITEM*> removedItems;     // board items removed in one pass if rebuilding
 
     if( Empty() )
         return;
@@ -227,7 +246,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                     view->Remove( boardItem );
 
                     if( !( changeFlags & CHT_DONE ) )
-                        board->Remove( boardItem );
+                    {
+                        if( rebuildConnectivity )
+                            removedItems.insert( boardItem );
+                        else
+                            board->Remove( boardItem );
+                    }
 
                     break;
 
@@ -241,7 +265,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                     module->ClearFlags();
 
                     if( !( changeFlags & CHT_DONE ) )
-                        board->Remove( module );        // handles connectivity
+                    {
+                        if( rebuildConnectivity )
+                            removedItems.insert( module );
+                        else
+                            board->Remove( module );    // handles connectivity
+                    }
                 }
                 break;
 
@@ -278,10 +307,14 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                     undoList.PushItem( itemWrapper );
                 }
 
-                if( ent.m_copy )
-                    connectivity->MarkItemNetAsDirty( static_cast<BOARD_ITEM*>( ent.m_copy ) );
+                if( !rebuildConnectivity )
+                {
+                    if( ent.m_copy )
+                        connectivity->MarkItemNetAsDirty( static_cast<BOARD_ITEM*>( ent.m_copy ) );
+
+                    connectivity->Update( boardItem );
+                }
 
-                connectivity->Update( boardItem );
                 view->Update( boardItem );
 
                 if( m_editModules )
@@ -311,7 +344,16 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     {
         size_t num_changes = m_changes.size();
 
-        connectivity->RecalculateRatsnest( this );
+        if( rebuildConnectivity )
+        {
+            board->RemoveItems( removedItems );
+            connectivity->Build( board, nullptr, this );
+        }
+        else
+        {
+            connectivity->RecalculateRatsnest( this );
+        }
+
         connectivity->ClearDynamicRatsnest();
         frame->GetCanvas()->RedrawRatsnest();
 
@@ -382,8 +424,48 @@ EDA_ITEM* BOARD_COMMIT::parentObject( EDA_ITEM* aItem ) const
 }
 
 
+void BOARD_COMMIT::pushToModel()
+{
+    for( COMMIT_LINE& ent : m_changes )
+    {
+        int         changeType = ent.m_type & CHT_TYPE;
+        int         changeFlags = ent.m_type & CHT_FLAGS;
+        BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( ent.m_item );
+        auto        parent = static_cast<BOARD_ITEM_CONTAINER*>( boardItem->GetParent() );
+
+        switch( changeType )
+        {
+        case CHT_ADD:
+            if( !( changeFlags & CHT_DONE ) )
+                parent->Add( boardItem );
+
+            break;
+
+        case CHT_REMOVE:
+            if( !( changeFlags & CHT_DONE ) )
+                parent->Remove( boardItem );
+
+            delete boardItem;
+            break;
+
+        case CHT_MODIFY:
+            delete ent.m_copy;
+            break;
+
+        default:
+            wxASSERT( false );
+            break;
+        }
+    }
+
+    clear();
+}
+
+
 void BOARD_COMMIT::Revert()
 {
+    wxCHECK_RET( m_toolMgr, wxT( "a commit without tool manager cannot be reverted" ) );
+
     PICKED_ITEMS_LIST undoList;
     KIGFX::VIEW* view = m_toolMgr->GetView();
     BOARD* board = (BOARD*) m_toolMgr->GetModel();
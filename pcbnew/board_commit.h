@@ -40,6 +40,13 @@ public:
     BOARD_COMMIT( EDA_DRAW_FRAME* aFrame );
     BOARD_COMMIT( PCB_TOOL_BASE *aTool );
 
+    /**
+     * A commit without tool manager, to run the board editing functions out of the editor
+     * (utilities, tests).  Pushing it only applies the changes to the board (see pushToModel()),
+     * and it cannot be reverted.
+     */
+    BOARD_COMMIT();
+
     virtual ~BOARD_COMMIT();
 
     virtual void Push( const wxString& aMessage = wxT( "A commit" ),
@@ -56,9 +63,26 @@ public:
      */
     bool         HasRemoveEntry( EDA_ITEM* aItem );
 
+    /**
+     * Rebuilds the connectivity once when the commit is pushed, instead of updating it for
+     * each changed item, and removes the items from the board in one pass.  It is faster for
+     * the commits changing a large part of the board (netlist updates).
+     */
+    void SetRebuildConnectivity( bool aRebuild ) { m_rebuildConnectivity = aRebuild; }
+
 private:
     TOOL_MANAGER* m_toolMgr;
     bool m_editModules;
+    bool m_rebuildConnectivity;
+
+    /**
+     * Pushes a commit without tool manager: the items still to add or remove are added to or
+     * removed from their parent, and the removed items and the copies of the modified items
+     * are deleted, as there is no undo list to take them.  The view and the connectivity are
+     * not updated.
+     */
+    void pushToModel();
+
     virtual EDA_ITEM* parentObject( EDA_ITEM* aItem ) const override;
 };
 
@@ -272,20 +272,20 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygon( PCB_LAYER_ID aLayer,
                                                          SHAPE_POLY_SET& aCornerBuffer,
                                                          int aError ) const
 {
-    if( !m_FilledPolysList.count( aLayer ) || m_FilledPolysList.at( aLayer ).IsEmpty() )
+    if( !m_FilledPolysList.count( aLayer ) || m_FilledPolysList.at( aLayer )->IsEmpty() )
         return;
 
     // Just add filled areas if filled polygons outlines have no thickness
     if( !GetFilledPolysUseThickness() || GetMinThickness() == 0 )
     {
-        const SHAPE_POLY_SET& polys = m_FilledPolysList.at( aLayer );
+        const SHAPE_POLY_SET& polys = *m_FilledPolysList.at( aLayer );
         aCornerBuffer.Append( polys );
         return;
     }
 
     // Filled areas have polygons with outline thickness.
     // we must create the polygons and add inflated polys
-    SHAPE_POLY_SET polys = m_FilledPolysList.at( aLayer );
+    SHAPE_POLY_SET polys = *m_FilledPolysList.at( aLayer );
 
     auto board = GetBoard();
     int maxError = ARC_HIGH_DEF;
@@ -694,7 +694,7 @@ void ZONE_CONTAINER::TransformShapeWithClearanceToPolygon( SHAPE_POLY_SET& aCorn
     if( !m_FilledPolysList.count( aLayer ) )
         return;
 
-    aCornerBuffer = m_FilledPolysList.at( aLayer );
+    aCornerBuffer = *m_FilledPolysList.at( aLayer );
 
     int numSegs = GetArcToSegmentCount( aClearance, aError, 360.0 );
     aCornerBuffer.Inflate( aClearance, numSegs );
@@ -0,0 +1,350 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
+
+#include <cairo.h>
+
+#ifdef CAIRO_HAS_SVG_SURFACE
+#include <cairo-svg.h>
+#endif
+
+#include <wx/filename.h>
+
+#include <board_snapshot.h>
+#include <class_board.h>
+#include <class_marker_pcb.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <convert_to_biu.h>
+#include <gal/cairo/cairo_image.h>
+#include <macros.h>
+#include <pcb_draw_panel_gal.h>
+#include <pcb_painter.h>
+#include <profile.h>
+#include <settings/color_settings.h>
+#include <view/view.h>
+
+
+struct BOARD_SNAPSHOT::RENDERER
+{
+    KIGFX::GAL_DISPLAY_OPTIONS              m_options;
+    std::unique_ptr<KIGFX::CAIRO_IMAGE_GAL> m_gal;
+    std::unique_ptr<KIGFX::PCB_PAINTER>     m_painter;
+    std::unique_ptr<KIGFX::VIEW>            m_view;
+};
+
+
+BOARD_SNAPSHOT::BOARD_SNAPSHOT( BOARD* aBoard, KIGFX::VIEW* aView ) :
+        m_board( aBoard ),
+        m_view( aView ),
+        m_colorSettings( nullptr ),
+        m_dpi( 300.0 ),
+        m_threadCount( 0 ),
+        m_tileSize( 256 ),
+        m_renderTime( 0.0 )
+{
+    m_layers = aBoard->GetVisibleLayers() & aBoard->GetEnabledLayers();
+
+    if( m_view )
+        return;
+
+    m_ownView = std::make_unique<KIGFX::VIEW>( false );
+    PCB_DRAW_PANEL_GAL::SetDefaultLayerOrder( m_ownView.get() );
+    PCB_DRAW_PANEL_GAL::SetDefaultLayerDeps( m_ownView.get(), false );
+
+    auto add = [this]( BOARD_ITEM* aItem )
+               {
+                   m_ownView->Add( aItem );
+                   m_ownViewItems.push_back( aItem );
+               };
+
+    for( BOARD_ITEM* drawing : aBoard->Drawings() )
+        add( drawing );
+
+    for( TRACK* track : aBoard->Tracks() )
+        add( track );
+
+    for( MODULE* module : aBoard->Modules() )
+    {
+        module->RunOnChildren( add );
+        add( module );
+    }
+
+    for( ZONE_CONTAINER* zone : aBoard->Zones() )
+        add( zone );
+
+    for( MARKER_PCB* marker : aBoard->Markers() )
+        add( marker );
+
+    m_view = m_ownView.get();
+}
+
+
+BOARD_SNAPSHOT::~BOARD_SNAPSHOT()
+{
+    if( m_ownView )
+    {
+        // Detach the items from the view, so the board can be displayed later by another view
+        m_ownView->Clear();
+
+        for( BOARD_ITEM* item : m_ownViewItems )
+            KIGFX::VIEW::OnDestroy( item );
+    }
+}
+
+
+std::unique_ptr<BOARD_SNAPSHOT::RENDERER> BOARD_SNAPSHOT::makeRenderer( double aDPI ) const
+{
+    std::unique_ptr<RENDERER> renderer = std::make_unique<RENDERER>();
+
+    renderer->m_gal = std::make_unique<KIGFX::CAIRO_IMAGE_GAL>( renderer->m_options, aDPI );
+    renderer->m_gal->SetWorldUnitLength( 1e-9 /* 1 nm */ / 0.0254 /* 1 inch in meters */ );
+
+    renderer->m_painter = std::make_unique<KIGFX::PCB_PAINTER>( renderer->m_gal.get() );
+
+    KIGFX::PCB_RENDER_SETTINGS* settings = renderer->m_painter->GetSettings();
+    settings->LoadColors( m_colorSettings ? m_colorSettings : m_defaultColors.get() );
+    renderer->m_gal->SetClearColor( settings->GetBackgroundColor() );
+
+    renderer->m_view = m_view->DataReference();
+
+    KIGFX::VIEW* view = renderer->m_view.get();
+
+    view->SetGAL( renderer->m_gal.get() );
+    view->SetPainter( renderer->m_painter.get() );
+    view->SetScaleLimits( 10e9, 0.0001 );
+    view->SetScale( 1.0 );
+
+    for( int i = 0; i < KIGFX::VIEW::VIEW_MAX_LAYERS; ++i )
+    {
+        view->SetLayerVisible( i, false );
+        view->SetLayerTarget( i, KIGFX::TARGET_NONCACHED );
+    }
+
+    for( LSEQ seq = m_layers.Seq(); seq; ++seq )
+    {
+        view->SetLayerVisible( *seq, true );
+        view->SetLayerVisible( ZONE_LAYER_FOR( *seq ), true );
+    }
+
+    // Honor the visibility of the items set in the editor
+    for( GAL_LAYER_ID layer : { LAYER_MOD_FR, LAYER_MOD_BK, LAYER_MOD_VALUES,
+                                LAYER_MOD_REFERENCES, LAYER_MOD_TEXT_FR, LAYER_MOD_TEXT_BK,
+                                LAYER_MOD_TEXT_INVISIBLE, LAYER_PAD_FR, LAYER_PAD_BK,
+                                LAYER_PADS_TH, LAYER_TRACKS, LAYER_VIAS, LAYER_NO_CONNECTS,
+                                LAYER_DRC_WARNING, LAYER_DRC_ERROR, LAYER_DRC_EXCLUSION } )
+    {
+        view->SetLayerVisible( layer, m_board->IsElementVisible( layer ) );
+    }
+
+    // Keep certain items always enabled and just rely on the finer visibility controls
+    for( GAL_LAYER_ID layer : { LAYER_ZONES, LAYER_PADS, LAYER_VIA_MICROVIA, LAYER_VIA_BBLIND,
+                                LAYER_VIA_THROUGH, LAYER_VIAS_HOLES, LAYER_PADS_PLATEDHOLES,
+                                LAYER_NON_PLATEDHOLES } )
+    {
+        view->SetLayerVisible( layer, true );
+    }
+
+    return renderer;
+}
+
+
+bool BOARD_SNAPSHOT::Write( const wxString& aFileName )
+{
+    m_renderTime = 0.0;
+    m_imageSize = VECTOR2I( 0, 0 );
+
+    if( m_dpi <= 0.0 || m_tileSize <= 0 )
+        return false;
+
+    if( !m_colorSettings && !m_defaultColors )
+    {
+        m_defaultColors = std::make_unique<COLOR_SETTINGS>();
+        m_defaultColors->ResetToDefaults();
+    }
+
+    // The pads build their shapes when they are first needed: build them now rather than
+    // in the rendering threads
+    for( MODULE* module : m_board->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            pad->GetEffectiveShape();
+    }
+
+    if( wxFileName( aFileName ).GetExt().CmpNoCase( wxT( "svg" ) ) == 0 )
+        return writeSVG( aFileName );
+
+    return writePNG( aFileName );
+}
+
+
+bool BOARD_SNAPSHOT::writePNG( const wxString& aFileName )
+{
+    EDA_RECT bbox = m_board->ComputeBoundingBox();
+    double   iuPerPixel = IU_PER_MILS * 1000.0 / m_dpi;
+
+    m_imageSize.x = std::max( 1, (int) std::ceil( bbox.GetWidth() / iuPerPixel ) );
+    m_imageSize.y = std::max( 1, (int) std::ceil( bbox.GetHeight() / iuPerPixel ) );
+
+    cairo_surface_t* image = cairo_image_surface_create( CAIRO_FORMAT_ARGB32, m_imageSize.x,
+                                                         m_imageSize.y );
+
+    if( cairo_surface_status( image ) != CAIRO_STATUS_SUCCESS )
+    {
+        cairo_surface_destroy( image );
+        return false;
+    }
+
+    // The tiles are surfaces sharing the pixels of the image, so the threads draw directly
+    // into it and nothing has to be copied
+    cairo_surface_flush( image );
+    unsigned char* data = cairo_image_surface_get_data( image );
+    int            stride = cairo_image_surface_get_stride( image );
+
+    std::vector<BOX2I> tiles;
+
+    for( int y = 0; y < m_imageSize.y; y += m_tileSize )
+    {
+        for( int x = 0; x < m_imageSize.x; x += m_tileSize )
+        {
+            tiles.emplace_back( VECTOR2I( x, y ),
+                                VECTOR2I( std::min( m_tileSize, m_imageSize.x - x ),
+                                          std::min( m_tileSize, m_imageSize.y - y ) ) );
+        }
+    }
+
+    size_t parallelThreadCount = m_threadCount ? m_threadCount
+                                               : std::thread::hardware_concurrency();
+    parallelThreadCount = std::max<size_t>( 1, std::min( parallelThreadCount, tiles.size() ) );
+
+    PROF_COUNTER timer;
+
+    // The GALs are made by this thread: the first one loads the stroke font they all share
+    std::vector<std::unique_ptr<RENDERER>> renderers;
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        renderers.push_back( makeRenderer( m_dpi ) );
+
+    const VECTOR2D      center( bbox.Centre() );
+    const VECTOR2D      imageCenter = VECTOR2D( m_imageSize ) / 2.0;
+    std::atomic<size_t> nextTile( 0 );
+
+    auto renderTiles = [&]( RENDERER* aRenderer )
+    {
+        for( size_t i = nextTile++; i < tiles.size(); i = nextTile++ )
+        {
+            const BOX2I&     tile = tiles[i];
+            cairo_surface_t* tileSurface = cairo_image_surface_create_for_data(
+                    data + tile.GetY() * stride + tile.GetX() * 4, CAIRO_FORMAT_ARGB32,
+                    tile.GetWidth(), tile.GetHeight(), stride );
+
+            aRenderer->m_gal->SetSurface( tileSurface );
+
+            VECTOR2D tileCenter = VECTOR2D( tile.GetPosition() )
+                                  + VECTOR2D( tile.GetSize() ) / 2.0;
+            aRenderer->m_view->SetCenter( center + ( tileCenter - imageCenter ) * iuPerPixel );
+
+            {
+                KIGFX::GAL_DRAWING_CONTEXT ctx( aRenderer->m_gal.get() );
+                aRenderer->m_view->Redraw();
+            }
+
+            cairo_surface_flush( tileSurface );
+            cairo_surface_destroy( tileSurface );
+        }
+    };
+
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, renderTiles, renderers[ii].get() );
+
+    for( auto& ret : returns )
+        ret.wait();
+
+    renderers.clear();
+    m_renderTime = timer.msecs();
+
+    cairo_surface_mark_dirty( image );
+    cairo_status_t status = cairo_surface_write_to_png( image, TO_UTF8( aFileName ) );
+    cairo_surface_destroy( image );
+
+    return status == CAIRO_STATUS_SUCCESS;
+}
+
+
+bool BOARD_SNAPSHOT::writeSVG( const wxString& aFileName )
+{
+#ifdef CAIRO_HAS_SVG_SURFACE
+    // The unit of the SVG surfaces is the point
+    const double dpi = 72.0;
+
+    EDA_RECT bbox = m_board->ComputeBoundingBox();
+    double   iuPerPoint = IU_PER_MILS * 1000.0 / dpi;
+
+    m_imageSize.x = std::max( 1, (int) std::ceil( bbox.GetWidth() / iuPerPoint ) );
+    m_imageSize.y = std::max( 1, (int) std::ceil( bbox.GetHeight() / iuPerPoint ) );
+
+    PROF_COUNTER timer;
+
+    cairo_surface_t* svg = cairo_svg_surface_create( TO_UTF8( aFileName ), m_imageSize.x,
+                                                     m_imageSize.y );
+
+    if( cairo_surface_status( svg ) != CAIRO_STATUS_SUCCESS )
+    {
+        cairo_surface_destroy( svg );
+        return false;
+    }
+
+    // A vector image is not split in tiles: a single thread renders it
+    std::unique_ptr<RENDERER> renderer = makeRenderer( dpi );
+
+    renderer->m_gal->SetSurface( svg );
+    renderer->m_gal->SetScreenSize( m_imageSize );
+    renderer->m_view->SetCenter( VECTOR2D( bbox.Centre() ) );
+
+    {
+        KIGFX::GAL_DRAWING_CONTEXT ctx( renderer->m_gal.get() );
+        renderer->m_view->Redraw();
+    }
+
+    renderer.reset();
+
+    cairo_surface_finish( svg );
+    cairo_status_t status = cairo_surface_status( svg );
+    cairo_surface_destroy( svg );
+
+    m_renderTime = timer.msecs();
+
+    return status == CAIRO_STATUS_SUCCESS;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,121 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef BOARD_SNAPSHOT_H
+#define BOARD_SNAPSHOT_H
+
+#include <memory>
+#include <vector>
+
+#include <layers_id_colors_and_visibility.h>
+#include <math/vector2d.h>
+
+class BOARD;
+class BOARD_ITEM;
+class COLOR_SETTINGS;
+class wxString;
+
+namespace KIGFX
+{
+class CAIRO_IMAGE_GAL;
+class PCB_PAINTER;
+class VIEW;
+}
+
+
+/**
+ * BOARD_SNAPSHOT renders images of a board offscreen, with the Cairo GAL and the board
+ * painter: no window is needed, so it can be used from scripts and command line tools.
+ *
+ * PNG images are split into tiles rendered in parallel.  Each thread has its own view,
+ * sharing the items of the board view, its own painter and its own GAL, and draws its
+ * tiles directly into the final image.  SVG images are rendered by a single thread.
+ */
+class BOARD_SNAPSHOT
+{
+public:
+    /**
+     * @param aBoard is the board to render.
+     * @param aView is the view displaying the board, if any.  The items of a board can be
+     * in a single view: when the board is opened in the editor, the snapshots must be made
+     * from the editor view.  Otherwise the snapshot makes its own view of the board.
+     */
+    BOARD_SNAPSHOT( BOARD* aBoard, KIGFX::VIEW* aView = nullptr );
+    ~BOARD_SNAPSHOT();
+
+    ///> Sets the resolution of the PNG images (the SVG images are always 72 DPI)
+    void SetDPI( double aDPI ) { m_dpi = aDPI; }
+
+    ///> Sets the board layers to render, the visible layers of the board by default
+    void SetLayers( const LSET& aLayers ) { m_layers = aLayers; }
+
+    ///> Sets the colors to use, the default colors if nullptr
+    void SetColorSettings( const COLOR_SETTINGS* aSettings ) { m_colorSettings = aSettings; }
+
+    ///> Sets the number of rendering threads, 0 to use all the cores
+    void SetThreadCount( size_t aCount ) { m_threadCount = aCount; }
+
+    ///> Sets the size of the square tiles of the PNG images, in pixels
+    void SetTileSize( int aSize ) { m_tileSize = aSize; }
+
+    /**
+     * Function Write
+     * renders the board and writes the image to a file.
+     *
+     * @param aFileName is the file to write, a PNG or a SVG image depending on its extension.
+     * @return true if successful.
+     */
+    bool Write( const wxString& aFileName );
+
+    ///> Returns the time spent rendering the last image, in milliseconds
+    double GetRenderTime() const { return m_renderTime; }
+
+    ///> Returns the size of the last image, in pixels for PNG images or points for SVG images
+    const VECTOR2I& GetImageSize() const { return m_imageSize; }
+
+private:
+    ///> The GAL, painter and view of a rendering thread
+    struct RENDERER;
+
+    std::unique_ptr<RENDERER> makeRenderer( double aDPI ) const;
+
+    bool writePNG( const wxString& aFileName );
+    bool writeSVG( const wxString& aFileName );
+
+    BOARD*                          m_board;
+    KIGFX::VIEW*                    m_view;
+    std::unique_ptr<KIGFX::VIEW>    m_ownView;          ///< The view made if the board has none
+    std::vector<BOARD_ITEM*>        m_ownViewItems;     ///< The items added to m_ownView
+
+    const COLOR_SETTINGS*           m_colorSettings;
+    std::unique_ptr<COLOR_SETTINGS> m_defaultColors;
+
+    LSET     m_layers;
+    double   m_dpi;
+    size_t   m_threadCount;
+    int      m_tileSize;
+    double   m_renderTime;
+    VECTOR2I m_imageSize;
+};
+
+#endif // BOARD_SNAPSHOT_H
@@ -714,6 +714,38 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem )
 }
 
 
+void BOARD::RemoveItems( const std::set<BOARD_ITEM*>& aItems )
+{
+    auto isRemoved = [&aItems]( BOARD_ITEM* aItem )
+                     {
+                         return aItems.count( aItem ) > 0;
+                     };
+
+    m_tracks.erase( std::remove_if( m_tracks.begin(), m_tracks.end(), isRemoved ),
+                    m_tracks.end() );
+
+    m_modules.erase( std::remove_if( m_modules.begin(), m_modules.end(), isRemoved ),
+                     m_modules.end() );
+
+    for( BOARD_ITEM* item : aItems )
+    {
+        switch( item->Type() )
+        {
+        case PCB_TRACE_T:
+        case PCB_ARC_T:
+        case PCB_VIA_T:
+        case PCB_MODULE_T:
+            m_connectivity->Remove( item );
+            InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, item );
+            break;
+
+        default:
+            Remove( item );
+        }
+    }
+}
+
+
 wxString BOARD::GetSelectMenuText( EDA_UNITS aUnits ) const
 {
     return wxString::Format( _( "PCB" ) );
@@ -339,6 +339,12 @@ public:
 
     void Remove( BOARD_ITEM* aBoardItem ) override;
 
+    /**
+     * Removes a set of items from the board, as Remove() does for each of them, but removes
+     * the tracks and the footprints from their lists in one pass instead of searching each one.
+     */
+    void RemoveItems( const std::set<BOARD_ITEM*>& aItems );
+
     /**
      * Gets the first module in the list (used in footprint viewer/editor) or NULL if none
      * @return first module or null pointer
@@ -180,14 +180,56 @@ EDA_ITEM* ZONE_CONTAINER::Clone() const
 }
 
 
+// The fill data is shared by the copies of a zone until one of them changes it: the
+// polygons are then copied for this zone only
+static SHAPE_POLY_SET& unshare( std::shared_ptr<SHAPE_POLY_SET>& aPolys )
+{
+    if( aPolys.use_count() > 1 )
+        aPolys = std::make_shared<SHAPE_POLY_SET>( *aPolys );
+
+    return *aPolys;
+}
+
+
+SHAPE_POLY_SET& ZONE_CONTAINER::RawPolysList( PCB_LAYER_ID aLayer )
+{
+    wxASSERT( m_RawPolysList.count( aLayer ) );
+    return unshare( m_RawPolysList.at( aLayer ) );
+}
+
+
+size_t ZONE_CONTAINER::GetMemoryUsage() const
+{
+    size_t usage = sizeof( ZONE_CONTAINER );
+
+    usage += m_Poly->TotalVertices() * sizeof( VECTOR2I );
+    usage += m_borderHatchLines.size() * sizeof( SEG );
+
+    // The owners of a shared fill count a share each, so the shares add up to the fill
+    for( const auto& pair : m_FilledPolysList )
+        usage += pair.second->TotalVertices() * sizeof( VECTOR2I ) / pair.second.use_count();
+
+    for( const auto& pair : m_RawPolysList )
+        usage += pair.second->TotalVertices() * sizeof( VECTOR2I ) / pair.second.use_count();
+
+    for( const std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
+        usage += pair.second.size() * sizeof( SEG );
+
+    return usage;
+}
+
+
 bool ZONE_CONTAINER::UnFill()
 {
     bool change = false;
 
-    for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
+    for( auto& pair : m_FilledPolysList )
     {
-        change |= !pair.second.IsEmpty();
-        pair.second.RemoveAllContours();
+        if( !pair.second->IsEmpty() )
+        {
+            change = true;
+            pair.second = std::make_shared<SHAPE_POLY_SET>();
+        }
     }
 
     for( std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
@@ -263,8 +305,8 @@ void ZONE_CONTAINER::SetLayerSet( LSET aLayerSet )
         for( PCB_LAYER_ID layer : aLayerSet.Seq() )
         {
             m_FillSegmList[layer]     = {};
-            m_FilledPolysList[layer]  = {};
-            m_RawPolysList[layer]     = {};
+            m_FilledPolysList[layer]  = std::make_shared<SHAPE_POLY_SET>();
+            m_RawPolysList[layer]     = std::make_shared<SHAPE_POLY_SET>();
             m_filledPolysHash[layer]  = {};
             m_insulatedIslands[layer] = {};
         }
@@ -487,7 +529,7 @@ bool ZONE_CONTAINER::HitTestFilledArea( PCB_LAYER_ID aLayer, const wxPoint &aRef
     if( !m_FilledPolysList.count( aLayer ) )
         return false;
 
-    return m_FilledPolysList.at( aLayer ).Contains( VECTOR2I( aRefPos.x, aRefPos.y ), -1,
+    return m_FilledPolysList.at( aLayer )->Contains( VECTOR2I( aRefPos.x, aRefPos.y ), -1,
                                                     aAccuracy );
 }
 
@@ -652,7 +694,7 @@ void ZONE_CONTAINER::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PA
 
         if( layer_it != m_FilledPolysList.end() )
         {
-            msg.Printf( wxT( "%d" ), layer_it->second.TotalVertices() );
+            msg.Printf( wxT( "%d" ), layer_it->second->TotalVertices() );
             aList.emplace_back( MSG_PANEL_ITEM( _( "Corner Count" ), msg, BLUE ) );
         }
     }
@@ -668,8 +710,8 @@ void ZONE_CONTAINER::Move( const wxPoint& offset )
 
     HatchBorder();
 
-    for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
-        pair.second.Move( offset );
+    for( auto& pair : m_FilledPolysList )
+        unshare( pair.second ).Move( offset );
 
     for( std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
     {
@@ -705,8 +747,8 @@ void ZONE_CONTAINER::Rotate( const wxPoint& aCentre, double aAngle )
     HatchBorder();
 
     /* rotate filled areas: */
-    for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
-        pair.second.Rotate( aAngle, VECTOR2I( aCentre ) );
+    for( auto& pair : m_FilledPolysList )
+        unshare( pair.second ).Rotate( aAngle, VECTOR2I( aCentre ) );
 
     for( std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
     {
@@ -742,8 +784,11 @@ void ZONE_CONTAINER::Mirror( const wxPoint& aMirrorRef, bool aMirrorLeftRight )
 
     HatchBorder();
 
-    for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
-        pair.second.Mirror( aMirrorLeftRight, !aMirrorLeftRight, VECTOR2I( aMirrorRef ) );
+    for( auto& pair : m_FilledPolysList )
+    {
+        unshare( pair.second ).Mirror( aMirrorLeftRight, !aMirrorLeftRight,
+                                       VECTOR2I( aMirrorRef ) );
+    }
 
     for( std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
     {
@@ -1105,13 +1150,17 @@ void ZONE_CONTAINER::CacheTriangulation( PCB_LAYER_ID aLayer )
 {
     if( aLayer == UNDEFINED_LAYER )
     {
-        for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
-            pair.second.CacheTriangulation();
+        for( auto& pair : m_FilledPolysList )
+        {
+            if( !pair.second->IsTriangulationUpToDate() )
+                unshare( pair.second ).CacheTriangulation();
+        }
     }
     else
     {
-        if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ].CacheTriangulation();
+        if( m_FilledPolysList.count( aLayer )
+                && !m_FilledPolysList[ aLayer ]->IsTriangulationUpToDate() )
+            unshare( m_FilledPolysList[ aLayer ] ).CacheTriangulation();
     }
 }
 
@@ -1240,16 +1289,16 @@ double ZONE_CONTAINER::CalculateFilledArea()
 
     // Iterate over each outline polygon in the zone and then iterate over
     // each hole it has to compute the total area.
-    for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
+    for( const auto& pair : m_FilledPolysList )
     {
-        SHAPE_POLY_SET& poly = pair.second;
+        const SHAPE_POLY_SET& poly = *pair.second;
 
         for( int i = 0; i < poly.OutlineCount(); i++ )
         {
-            m_area += poly.Outline( i ).Area();
+            m_area += poly.COutline( i ).Area();
 
             for( int j = 0; j < poly.HoleCount( i ); j++ )
-                m_area -= poly.Hole( i, j ).Area();
+                m_area -= poly.CHole( i, j ).Area();
         }
     }
 
@@ -1355,7 +1404,7 @@ std::shared_ptr<SHAPE> ZONE_CONTAINER::GetEffectiveShape( PCB_LAYER_ID aLayer )
     }
     else
     {
-        shape.reset( m_FilledPolysList.at( aLayer ).Clone() );
+        shape.reset( m_FilledPolysList.at( aLayer )->Clone() );
     }
 
     return shape;
@@ -30,6 +30,7 @@
 #define CLASS_ZONE_H_
 
 
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <gr_basic.h>
@@ -608,10 +609,10 @@ public:
      */
     void ClearFilledPolysList()
     {
-        for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
+        for( auto& pair : m_FilledPolysList )
         {
             m_insulatedIslands[pair.first].clear();
-            pair.second.RemoveAllContours();
+            pair.second = std::make_shared<SHAPE_POLY_SET>();
         }
     }
 
@@ -628,7 +629,7 @@ public:
     const SHAPE_POLY_SET& GetFilledPolysList( PCB_LAYER_ID aLayer ) const
     {
         wxASSERT( m_FilledPolysList.count( aLayer ) );
-        return m_FilledPolysList.at( aLayer );
+        return *m_FilledPolysList.at( aLayer );
     }
 
     /** (re)create a list of triangles that "fill" the solid areas.
@@ -642,7 +643,7 @@ public:
      */
     void SetFilledPolysList( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aPolysList )
     {
-        m_FilledPolysList[aLayer] = aPolysList;
+        m_FilledPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
     }
 
     /**
@@ -651,7 +652,7 @@ public:
       */
     void SetRawPolysList( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aPolysList )
     {
-        m_RawPolysList[aLayer] = aPolysList;
+        m_RawPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
     }
 
     /**
@@ -709,11 +710,15 @@ public:
         m_FillSegmList[aLayer] = aSegments;
     }
 
-    SHAPE_POLY_SET& RawPolysList( PCB_LAYER_ID aLayer )
-    {
-        wxASSERT( m_RawPolysList.count( aLayer ) );
-        return m_RawPolysList.at( aLayer );
-    }
+    SHAPE_POLY_SET& RawPolysList( PCB_LAYER_ID aLayer );
+
+    /**
+     * Function GetMemoryUsage
+     * @return an estimate of the memory used by the zone.  The fill data shared with
+     * other copies of the zone is split between them, so each copy counts its share and
+     * the whole fill is counted once it has no other owner (e.g. after a refill).
+     */
+    size_t GetMemoryUsage() const;
 
     wxString GetSelectMenuText( EDA_UNITS aUnits ) const override;
 
@@ -817,7 +822,7 @@ public:
         if( !m_FilledPolysList.count( aLayer ) )
             return;
 
-        m_filledPolysHash[aLayer] = m_FilledPolysList.at( aLayer ).GetHash();
+        m_filledPolysHash[aLayer] = m_FilledPolysList.at( aLayer )->GetHash();
     }
 
 
@@ -918,9 +923,12 @@ protected:
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
      * described by m_Poly can have many filled areas
+     *
+     * The filled polygons are shared by the copies of the zone (the copies held by the
+     * undo list for instance) until one of them changes them.
      */
-    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_FilledPolysList;
-    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_RawPolysList;
+    std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> m_FilledPolysList;
+    std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> m_RawPolysList;
 
     /// Temp variables used while filling
     EDA_RECT                               m_bboxCache;
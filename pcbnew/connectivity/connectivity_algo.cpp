@@ -33,6 +33,7 @@
 #include <mutex>
 #include <algorithm>
 #include <future>
+#include <unordered_map>
 
 #ifdef PROFILE
 #include <profile.h>
@@ -561,35 +562,36 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( ZONE_CONTAINER* aZone,
 
 void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones )
 {
+    // The island lists of the zones, to collect all the islands in one pass over the clusters
+    std::unordered_map<const BOARD_CONNECTED_ITEM*, CN_ZONE_ISOLATED_ISLAND_LIST*> zoneLists;
+
     for( auto& z : aZones )
     {
         Remove( z.m_zone );
         Add( z.m_zone );
+
+        zoneLists[z.m_zone] = &z;
     }
 
     m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
 
-    for( auto& zone : aZones )
+    for( const auto& cluster : m_connClusters )
     {
-        for( PCB_LAYER_ID layer : zone.m_zone->GetLayerSet().Seq() )
+        if( !cluster->IsOrphaned() )
+            continue;
+
+        // The items of a zone are its filled polygons (CN_ZONE_LAYER), one per layer and subpoly
+        for( auto z : *cluster )
         {
-            if( zone.m_zone->GetFilledPolysList( layer ).IsEmpty() )
+            auto zoneList = zoneLists.find( z->Parent() );
+
+            if( zoneList == zoneLists.end() )
                 continue;
 
-            for( const auto& cluster : m_connClusters )
-            {
-                if( cluster->Contains( zone.m_zone ) && cluster->IsOrphaned() )
-                {
-                    for( auto z : *cluster )
-                    {
-                        if( z->Parent() == zone.m_zone && z->Layer() == layer )
-                        {
-                            zone.m_islands[layer].push_back(
-                                    static_cast<CN_ZONE_LAYER*>( z )->SubpolyIndex() );
-                        }
-                    }
-                }
-            }
+            PCB_LAYER_ID layer = static_cast<PCB_LAYER_ID>( z->Layer() );
+
+            zoneList->second->m_islands[layer].push_back(
+                    static_cast<CN_ZONE_LAYER*>( z )->SubpolyIndex() );
         }
     }
 }
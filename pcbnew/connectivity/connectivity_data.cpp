@@ -82,7 +82,8 @@ bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 }
 
 
-void CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
+void CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter,
+                               BOARD_COMMIT* aCommit )
 {
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_connAlgo->Build( aBoard, aReporter );
@@ -93,7 +94,7 @@ void CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
         if( net->GetNetClass()->GetName() != NETCLASS::Default )
             m_netclassMap[net->GetNet()] = net->GetNetClass()->GetName();
 
-    RecalculateRatsnest();
+    RecalculateRatsnest( aCommit );
 }
 
 
@@ -93,8 +93,11 @@ public:
     /**
      * Function Build()
      * Builds the connectivity database for the board aBoard.
+     * @param aCommit is the commit recording the net changes made by the net propagation,
+     *                if any
      */
-    void Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter = nullptr );
+    void Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter = nullptr,
+                BOARD_COMMIT* aCommit = nullptr );
 
     /**
      * Function Build()
@@ -26,6 +26,8 @@
 
 #include <connectivity/connectivity_items.h>
 
+#include <algorithm>
+
 int CN_ITEM::AnchorCount() const
 {
     if( !m_valid )
@@ -349,7 +351,11 @@ bool CN_ANCHOR::IsDangling() const
     // the minimal number of items connected to item_ref
     // at this anchor point to decide the anchor is *not* dangling
     size_t minimal_count = 1;
-    size_t connected_count = m_item->ConnectedItems().size();
+
+    // Removed items stay in the connected items until the connections are searched again
+    size_t connected_count = std::count_if( m_item->ConnectedItems().begin(),
+                                            m_item->ConnectedItems().end(),
+                                            []( CN_ITEM* aItem ) { return aItem->Valid(); } );
 
     // a via can be removed if connected to only one other item.
     if( Parent()->Type() == PCB_VIA_T )
@@ -366,6 +372,9 @@ bool CN_ANCHOR::IsDangling() const
     connected_count = 0;
     for( auto item : m_item->ConnectedItems() )
     {
+        if( !item->Valid() )
+            continue;
+
         if( item->Parent()->Type() == PCB_ZONE_AREA_T )
         {
             ZONE_CONTAINER* zone = static_cast<ZONE_CONTAINER*>( item->Parent() );
@@ -391,6 +400,9 @@ int CN_ANCHOR::ConnectedItemsCount() const
 
     for( auto item : m_item->ConnectedItems() )
     {
+        if( !item->Valid() )
+            continue;
+
         if( item->Parent()->Type() == PCB_ZONE_AREA_T )
         {
             ZONE_CONTAINER* zone = static_cast<ZONE_CONTAINER*>( item->Parent() );
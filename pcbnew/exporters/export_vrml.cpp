@@ -24,9 +24,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <exception>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <wx/dir.h>
 
@@ -56,15 +62,7 @@
 // offset for plating
 #define  PLATE_OFFSET 0.005
 
-static S3D_CACHE* cache;
-static bool USE_INLINES;            // true to use legacy inline{} behavior
-static bool USE_DEFS;               // true to reuse component definitions
-static bool USE_RELPATH;            // true to use relative paths in VRML inline{}
-static double WORLD_SCALE = 1.0;    // scaling from 0.1 in to desired VRML unit
-static double BOARD_SCALE;          // scaling from mm to desired VRML world scale
 static const int PRECISION = 6;     // legacy precision factor (now set to 6)
-static wxString SUBDIR_3D;          // legacy 3D subdirectory
-static wxString PROJ_DIR;           // project directory
 
 struct VRML_COLOR
 {
@@ -133,9 +131,10 @@ enum VRML_COLOR_INDEX
     VRML_COLOR_LAST
 };
 
-static VRML_COLOR colors[VRML_COLOR_LAST];
-static SGNODE* sgmaterial[VRML_COLOR_LAST] = { NULL };
-
+/**
+ * MODEL_VRML holds the whole state of a VRML export: the exporter functions only use the
+ * model they are given, so several boards can be exported at once.
+ */
 class MODEL_VRML
 {
 private:
@@ -144,7 +143,25 @@ private:
     int         m_iMaxSeg;                  // max. sides to a small circle
     double      m_arcMinLen, m_arcMaxLen;   // min and max lengths of an arc chord
 
+    VRML_COLOR  m_colors[VRML_COLOR_LAST];
+    SGNODE*     m_sgmaterial[VRML_COLOR_LAST];
+
 public:
+    S3D_CACHE*  m_cache;
+    bool        m_useInlines;       // true to use legacy inline{} behavior
+    bool        m_useDefs;          // true to reuse component definitions
+    bool        m_useRelPath;       // true to use relative paths in VRML inline{}
+    double      m_worldScale;       // scaling from 0.1 in to desired VRML unit
+    double      m_boardScale;       // scaling from mm to desired VRML world scale
+    wxString    m_subdir3D;         // legacy 3D subdirectory
+    wxString    m_projDir;          // project directory
+
+    // the names DEFined for the inlined component models, by model file
+    std::map<wxString, std::string> m_inlineDefs;
+
+    // true for the materials DEFined in the inlined output
+    bool        m_inlineMaterials[VRML_COLOR_LAST];
+
     IFSG_TRANSFORM m_OutputPCB;
     VRML_LAYER  m_holes;
     VRML_LAYER  m_board;
@@ -175,22 +192,35 @@ public:
         for( unsigned i = 0; i < arrayDim( m_layer_z );  ++i )
             m_layer_z[i] = 0;
 
+        for( int j = 0; j < VRML_COLOR_LAST; ++j )
+        {
+            m_sgmaterial[j] = NULL;
+            m_inlineMaterials[j] = false;
+        }
+
+        m_cache = NULL;
+        m_useInlines = false;
+        m_useDefs = true;
+        m_useRelPath = false;
+        m_worldScale = 1.0;
+        m_boardScale = MM_PER_IU;
+
         m_holes.GetArcParams( m_iMaxSeg, m_arcMinLen, m_arcMaxLen );
 
         // this default only makes sense if the output is in mm
         m_brd_thickness = 1.6;
 
         // pcb green
-        colors[VRML_COLOR_PCB] = VRML_COLOR(
+        m_colors[VRML_COLOR_PCB] = VRML_COLOR(
                 0.07f, 0.3f, 0.12f, 0.01f, 0.03f, 0.01f, 0.0f, 0.0f, 0.0f, 0.8f, 0.0f, 0.02f );
         // track green
-        colors[VRML_COLOR_TRACK] = VRML_COLOR(
+        m_colors[VRML_COLOR_TRACK] = VRML_COLOR(
                 0.08f, 0.5f, 0.1f, 0.01f, 0.05f, 0.01f, 0.0f, 0.0f, 0.0f, 0.8f, 0.0f, 0.02f );
         // silkscreen white
-        colors[VRML_COLOR_SILK] = VRML_COLOR(
+        m_colors[VRML_COLOR_SILK] = VRML_COLOR(
                 0.9f, 0.9f, 0.9f, 0.1f, 0.1f, 0.1f, 0.0f, 0.0f, 0.0f, 0.9f, 0.0f, 0.02f );
         // pad silver
-        colors[VRML_COLOR_TIN] = VRML_COLOR( 0.749f, 0.756f, 0.761f, 0.749f, 0.756f, 0.761f, 0.0f,
+        m_colors[VRML_COLOR_TIN] = VRML_COLOR( 0.749f, 0.756f, 0.761f, 0.749f, 0.756f, 0.761f, 0.0f,
                 0.0f, 0.0f, 0.8f, 0.0f, 0.8f );
 
         m_plainPCB = false;
@@ -205,10 +235,10 @@ public:
         // destroy any unassociated material appearances
         for( int j = 0; j < VRML_COLOR_LAST; ++j )
         {
-            if( sgmaterial[j] && NULL == S3D::GetSGNodeParent( sgmaterial[j] ) )
-                S3D::DestroyNode( sgmaterial[j] );
+            if( m_sgmaterial[j] && NULL == S3D::GetSGNodeParent( m_sgmaterial[j] ) )
+                S3D::DestroyNode( m_sgmaterial[j] );
 
-            sgmaterial[j] = NULL;
+            m_sgmaterial[j] = NULL;
         }
 
         if( !m_components.empty() )
@@ -228,9 +258,12 @@ public:
 
     VRML_COLOR& GetColor( VRML_COLOR_INDEX aIndex )
     {
-        return colors[aIndex];
+        return m_colors[aIndex];
     }
 
+    // return the scenegraph appearance of a color, shared by all the shapes using it
+    SGNODE* GetSGColor( VRML_COLOR_INDEX aIndex );
+
     void SetOffset( double aXoff, double aYoff )
     {
         m_tx = aXoff;
@@ -267,7 +300,7 @@ public:
             throw( std::runtime_error( "WorldScale out of range (valid range is 0.001 to 10.0)" ) );
 
         m_OutputPCB.SetScale( aWorldScale * 2.54 );
-        WORLD_SCALE = aWorldScale * 2.54;
+        m_worldScale = aWorldScale * 2.54;
 
         return true;
     }
@@ -275,10 +308,6 @@ public:
 };
 
 
-// static var. for dealing with text
-static MODEL_VRML* model_vrml;
-
-
 // select the VRML layer object to draw on; return true if
 // a layer has been selected.
 static bool GetLayer( MODEL_VRML& aModel, LAYER_NUM layer, VRML_LAYER** vlayer )
@@ -293,15 +322,15 @@ static bool GetLayer( MODEL_VRML& aModel, LAYER_NUM layer, VRML_LAYER** vlayer )
     }
 }
 
-static void create_vrml_shell( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX colorID,
+static void create_vrml_shell( MODEL_VRML& aModel, VRML_COLOR_INDEX colorID,
                                VRML_LAYER* layer, double top_z, double bottom_z );
 
-static void create_vrml_plane( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX colorID,
+static void create_vrml_plane( MODEL_VRML& aModel, VRML_COLOR_INDEX colorID,
                                VRML_LAYER* layer, double aHeight, bool aTopPlane );
 
-static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
-                                VRML_LAYER* aLayer, bool aPlane, bool aTop,
-                                double aTop_z, double aBottom_z )
+static void write_triangle_bag( std::ostream& aOut_file, MODEL_VRML& aModel,
+                                VRML_COLOR_INDEX aColorID, VRML_LAYER* aLayer, bool aPlane,
+                                bool aTop, double aTop_z, double aBottom_z )
 {
     /* A lot of nodes are not required, but blender sometimes chokes
      * without them */
@@ -313,9 +342,7 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
         "      children [\n",
         "        Shape {\n",
         "          appearance Appearance {\n",
-        "            material Material {\n",
         0,                                      // Material marker
-        "            }\n",
         "          }\n",
         "          geometry IndexedFaceSet {\n",
         "            solid TRUE\n",
@@ -336,6 +363,13 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
         0    // End marker
     };
 
+    // the names of the materials, DEFined by their first triangle bag
+    static const char* material_names[VRML_COLOR_LAST] =
+    {
+        "MAT_PCB", "MAT_TRACK", "MAT_SILK", "MAT_TIN"
+    };
+
+    VRML_COLOR& aColor = aModel.GetColor( aColorID );
     int marker_found = 0, lineno = 0;
 
     while( marker_found < 4 )
@@ -349,6 +383,17 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
             switch( marker_found )
             {
             case 1:    // Material marker
+                if( aModel.m_inlineMaterials[aColorID] )
+                {
+                    aOut_file << "            material USE " << material_names[aColorID] << "\n";
+                    break;
+                }
+
+                aModel.m_inlineMaterials[aColorID] = true;
+
+                aOut_file << "            material DEF " << material_names[aColorID];
+                aOut_file << " Material {\n";
+
                 aOut_file << "              diffuseColor " << std::setprecision(3);
                 aOut_file << aColor.diffuse_red << " ";
                 aOut_file << aColor.diffuse_grn << " ";
@@ -367,6 +412,7 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
                 aOut_file << "              ambientIntensity " << aColor.ambient << "\n";
                 aOut_file << "              transparency " << aColor.transp << "\n";
                 aOut_file << "              shininess " << aColor.shiny << "\n";
+                aOut_file << "            }\n";
                 break;
 
             case 2:
@@ -399,143 +445,198 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
 }
 
 
+/**
+ * Tesselates the board layers in parallel, each one on a thread.
+ *
+ * The tesselation of a layer renumbers the vertices of its holes, and the layer is then
+ * written with this numbering: each layer is given its own copy of the holes, which must
+ * be kept until the layer is written.
+ */
+static void tesselate_layers( MODEL_VRML& aModel, const std::vector<VRML_LAYER*>& aLayers,
+                              std::vector<std::unique_ptr<VRML_LAYER>>& aHoles )
+{
+    for( size_t i = 0; i < aLayers.size(); ++i )
+    {
+        aHoles.emplace_back( new VRML_LAYER );
+        aHoles.back()->CopyContours( aModel.m_holes );
+    }
+
+    std::vector<std::function<void()>> jobs;
+
+    for( size_t i = 0; i < aLayers.size(); ++i )
+    {
+        VRML_LAYER* layer = aLayers[i];
+        VRML_LAYER* holes = aHoles[i].get();
+
+        jobs.emplace_back( [layer, holes]() { layer->Tesselate( holes ); } );
+    }
+
+    // the plated holes are tesselated alone
+    if( !aModel.m_plainPCB )
+        jobs.emplace_back( [&aModel]() { aModel.m_plated_holes.Tesselate( NULL, true ); } );
+
+    std::atomic<size_t> nextJob( 0 );
+    size_t parallelThreadCount = std::min<size_t>( std::max<size_t>( 1,
+            std::thread::hardware_concurrency() ), jobs.size() );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        returns[ii] = std::async( std::launch::async,
+                [&]()
+                {
+                    for( size_t i = nextJob++; i < jobs.size(); i = nextJob++ )
+                        jobs[i]();
+                } );
+    }
+
+    for( auto& ret : returns )
+        ret.wait();
+}
+
+
 static void write_layers( MODEL_VRML& aModel, BOARD* aPcb, const char* aFileName,
                           OSTREAM* aOutputFile )
 {
+    std::vector<VRML_LAYER*> layers = { &aModel.m_board };
+
+    if( !aModel.m_plainPCB )
+    {
+        layers.insert( layers.end(), { &aModel.m_top_copper, &aModel.m_top_tin,
+                                       &aModel.m_bot_copper, &aModel.m_bot_tin,
+                                       &aModel.m_top_silk, &aModel.m_bot_silk } );
+    }
+
+    std::vector<std::unique_ptr<VRML_LAYER>> holes;
+
+    tesselate_layers( aModel, layers, holes );
+
     // VRML_LAYER board;
-    aModel.m_board.Tesselate( &aModel.m_holes );
     double brdz = aModel.m_brd_thickness / 2.0
-                  - ( Millimeter2iu( ART_OFFSET / 2.0 ) ) * BOARD_SCALE;
+                  - ( Millimeter2iu( ART_OFFSET / 2.0 ) ) * aModel.m_boardScale;
 
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_PCB ),
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_PCB,
                             &aModel.m_board, false, false, brdz, -brdz );
     }
     else
     {
-        create_vrml_shell( aModel.m_OutputPCB, VRML_COLOR_PCB, &aModel.m_board, brdz, -brdz );
+        create_vrml_shell( aModel, VRML_COLOR_PCB, &aModel.m_board, brdz, -brdz );
     }
 
     if( aModel.m_plainPCB )
     {
-        if( !USE_INLINES )
-            S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), USE_DEFS, true );
+        if( !aModel.m_useInlines )
+            S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), aModel.m_useDefs, true );
 
         return;
     }
 
     // VRML_LAYER m_top_copper;
-    aModel.m_top_copper.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_TRACK,
                             &aModel.m_top_copper, true, true,
                             aModel.GetLayerZ( F_Cu ), 0 );
     }
     else
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TRACK, &aModel.m_top_copper,
+        create_vrml_plane( aModel, VRML_COLOR_TRACK, &aModel.m_top_copper,
                            aModel.GetLayerZ( F_Cu ), true );
     }
 
     // VRML_LAYER m_top_tin;
-    aModel.m_top_tin.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_TIN,
                             &aModel.m_top_tin, true, true,
-                            aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
+                            aModel.GetLayerZ( F_Cu )
+                            + Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale,
                             0 );
     }
     else
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_top_tin,
-                           aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
+        create_vrml_plane( aModel, VRML_COLOR_TIN, &aModel.m_top_tin,
+                           aModel.GetLayerZ( F_Cu )
+                           + Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale,
                            true );
     }
 
     // VRML_LAYER m_bot_copper;
-    aModel.m_bot_copper.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TRACK ),
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_TRACK,
                             &aModel.m_bot_copper, true, false,
                             aModel.GetLayerZ( B_Cu ), 0 );
     }
     else
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TRACK, &aModel.m_bot_copper,
+        create_vrml_plane( aModel, VRML_COLOR_TRACK, &aModel.m_bot_copper,
                            aModel.GetLayerZ( B_Cu ), false );
     }
 
     // VRML_LAYER m_bot_tin;
-    aModel.m_bot_tin.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_TIN,
                             &aModel.m_bot_tin, true, false,
                             aModel.GetLayerZ( B_Cu )
-                            - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
+                            - Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale,
                             0 );
     }
     else
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_bot_tin,
-                           aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
+        create_vrml_plane( aModel, VRML_COLOR_TIN, &aModel.m_bot_tin,
+                           aModel.GetLayerZ( B_Cu )
+                           - Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale,
                            false );
     }
 
     // VRML_LAYER PTH;
-    aModel.m_plated_holes.Tesselate( NULL, true );
-
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_TIN ),
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_TIN,
                             &aModel.m_plated_holes, false, false,
-                            aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                            aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE );
+                            aModel.GetLayerZ( F_Cu )
+                            + Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale,
+                            aModel.GetLayerZ( B_Cu )
+                            - Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale );
     }
     else
     {
-        create_vrml_shell( aModel.m_OutputPCB, VRML_COLOR_TIN, &aModel.m_plated_holes,
-                           aModel.GetLayerZ( F_Cu ) + Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE,
-                           aModel.GetLayerZ( B_Cu ) - Millimeter2iu( ART_OFFSET / 2.0 ) * BOARD_SCALE );
+        create_vrml_shell( aModel, VRML_COLOR_TIN, &aModel.m_plated_holes,
+                           aModel.GetLayerZ( F_Cu )
+                           + Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale,
+                           aModel.GetLayerZ( B_Cu )
+                           - Millimeter2iu( ART_OFFSET / 2.0 ) * aModel.m_boardScale );
     }
 
     // VRML_LAYER m_top_silk;
-    aModel.m_top_silk.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_top_silk,
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_SILK, &aModel.m_top_silk,
                             true, true, aModel.GetLayerZ( F_SilkS ), 0 );
     }
     else
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_SILK, &aModel.m_top_silk,
+        create_vrml_plane( aModel, VRML_COLOR_SILK, &aModel.m_top_silk,
                            aModel.GetLayerZ( F_SilkS ), true );
     }
 
     // VRML_LAYER m_bot_silk;
-    aModel.m_bot_silk.Tesselate( &aModel.m_holes );
-
-    if( USE_INLINES )
+    if( aModel.m_useInlines )
     {
-        write_triangle_bag( *aOutputFile, aModel.GetColor( VRML_COLOR_SILK ), &aModel.m_bot_silk,
+        write_triangle_bag( *aOutputFile, aModel, VRML_COLOR_SILK, &aModel.m_bot_silk,
                             true, false, aModel.GetLayerZ( B_SilkS ), 0 );
     }
     else
     {
-        create_vrml_plane( aModel.m_OutputPCB, VRML_COLOR_SILK, &aModel.m_bot_silk,
+        create_vrml_plane( aModel, VRML_COLOR_SILK, &aModel.m_bot_silk,
                            aModel.GetLayerZ( B_SilkS ), false );
     }
 
-    if( !USE_INLINES )
+    if( !aModel.m_useInlines )
         S3D::WriteVRML( aFileName, true, aModel.m_OutputPCB.GetRawPtr(), true, true );
 }
 
@@ -545,7 +646,7 @@ static void compute_layer_Zs( MODEL_VRML& aModel, BOARD* pcb )
     int copper_layers = pcb->GetCopperLayerCount();
 
     // We call it 'layer' thickness, but it's the whole board thickness!
-    aModel.m_brd_thickness = pcb->GetDesignSettings().GetBoardThickness() * BOARD_SCALE;
+    aModel.m_brd_thickness = pcb->GetDesignSettings().GetBoardThickness() * aModel.m_boardScale;
     double half_thickness = aModel.m_brd_thickness / 2;
 
     // Compute each layer's Z value, more or less like the 3d view
@@ -561,7 +662,7 @@ static void compute_layer_Zs( MODEL_VRML& aModel, BOARD* pcb )
 
     /* To avoid rounding interference, we apply an epsilon to each
      * successive layer */
-    double epsilon_z = Millimeter2iu( ART_OFFSET ) * BOARD_SCALE;
+    double epsilon_z = Millimeter2iu( ART_OFFSET ) * aModel.m_boardScale;
     aModel.SetLayerZ( B_Paste, -half_thickness - epsilon_z * 4 );
     aModel.SetLayerZ( B_Adhes, -half_thickness - epsilon_z * 3 );
     aModel.SetLayerZ( B_SilkS, -half_thickness - epsilon_z * 2 );
@@ -682,8 +783,8 @@ static void export_vrml_polygon( MODEL_VRML& aModel, LAYER_NUM layer, PCB_SHAPE
 
         for( int j = 0; j < outline.PointCount(); j++ )
         {
-            if( !vlayer->AddVertex( seg, outline.CPoint( j ).x * BOARD_SCALE,
-                                     -outline.CPoint( j ).y * BOARD_SCALE ) )
+            if( !vlayer->AddVertex( seg, outline.CPoint( j ).x * aModel.m_boardScale,
+                                     -outline.CPoint( j ).y * aModel.m_boardScale ) )
                 throw( std::runtime_error( vlayer->GetError() ) );
         }
 
@@ -695,11 +796,11 @@ static void export_vrml_polygon( MODEL_VRML& aModel, LAYER_NUM layer, PCB_SHAPE
 static void export_vrml_drawsegment( MODEL_VRML& aModel, PCB_SHAPE* drawseg )
 {
     LAYER_NUM layer = drawseg->GetLayer();
-    double  w   = drawseg->GetWidth() * BOARD_SCALE;
-    double  x   = drawseg->GetStart().x * BOARD_SCALE;
-    double  y   = drawseg->GetStart().y * BOARD_SCALE;
-    double  xf  = drawseg->GetEnd().x * BOARD_SCALE;
-    double  yf  = drawseg->GetEnd().y * BOARD_SCALE;
+    double  w   = drawseg->GetWidth() * aModel.m_boardScale;
+    double  x   = drawseg->GetStart().x * aModel.m_boardScale;
+    double  y   = drawseg->GetStart().y * aModel.m_boardScale;
+    double  xf  = drawseg->GetEnd().x * aModel.m_boardScale;
+    double  yf  = drawseg->GetEnd().y * aModel.m_boardScale;
     double  r   = sqrt( pow( x - xf, 2 ) + pow( y - yf, 2 ) );
 
     // Items on the edge layer are handled elsewhere; just return
@@ -710,10 +811,10 @@ static void export_vrml_drawsegment( MODEL_VRML& aModel, PCB_SHAPE* drawseg )
     {
     case S_ARC:
         export_vrml_arc( aModel, layer,
-                         (double) drawseg->GetCenter().x * BOARD_SCALE,
-                         (double) drawseg->GetCenter().y * BOARD_SCALE,
-                         (double) drawseg->GetArcStart().x * BOARD_SCALE,
-                         (double) drawseg->GetArcStart().y * BOARD_SCALE,
+                         (double) drawseg->GetCenter().x * aModel.m_boardScale,
+                         (double) drawseg->GetCenter().y * aModel.m_boardScale,
+                         (double) drawseg->GetArcStart().x * aModel.m_boardScale,
+                         (double) drawseg->GetArcStart().y * aModel.m_boardScale,
                          w, drawseg->GetAngle() / 10 );
         break;
 
@@ -749,13 +850,14 @@ static void export_vrml_drawsegment( MODEL_VRML& aModel, PCB_SHAPE* drawseg )
  * for coupling the vrml_text_callback with the common parameters */
 static void vrml_text_callback( int x0, int y0, int xf, int yf, void* aData )
 {
-    LAYER_NUM m_text_layer = model_vrml->m_text_layer;
-    int m_text_width = model_vrml->m_text_width;
-
-    export_vrml_line( *model_vrml, m_text_layer,
-                      x0 * BOARD_SCALE, y0 * BOARD_SCALE,
-                      xf * BOARD_SCALE, yf * BOARD_SCALE,
-                      m_text_width * BOARD_SCALE );
+    MODEL_VRML& aModel = *static_cast<MODEL_VRML*>( aData );
+    LAYER_NUM m_text_layer = aModel.m_text_layer;
+    int m_text_width = aModel.m_text_width;
+
+    export_vrml_line( aModel, m_text_layer,
+                      x0 * aModel.m_boardScale, y0 * aModel.m_boardScale,
+                      xf * aModel.m_boardScale, yf * aModel.m_boardScale,
+                      m_text_width * aModel.m_boardScale );
 }
 
 
@@ -770,8 +872,8 @@ static void export_vrml_pcbtext( MODEL_VRML& aModel, PCB_TEXT* text )
     int     penWidth = text->GetEffectiveTextPenWidth();
     COLOR4D color = COLOR4D::BLACK;  // not actually used, but needed by GRText
 
-    model_vrml->m_text_layer    = text->GetLayer();
-    model_vrml->m_text_width    = penWidth;
+    aModel.m_text_layer    = text->GetLayer();
+    aModel.m_text_width    = penWidth;
 
     if( text->IsMultilineAllowed() )
     {
@@ -785,14 +887,14 @@ static void export_vrml_pcbtext( MODEL_VRML& aModel, PCB_TEXT* text )
         {
             GRText( nullptr, positions[ii], color, strings_list[ii], text->GetTextAngle(), size,
                     text->GetHorizJustify(), text->GetVertJustify(), penWidth, text->IsItalic(),
-                    forceBold, vrml_text_callback );
+                    forceBold, vrml_text_callback, &aModel );
         }
     }
     else
     {
         GRText( nullptr, text->GetTextPos(), color, text->GetShownText(), text->GetTextAngle(),
                 size, text->GetHorizJustify(), text->GetVertJustify(), penWidth, text->IsItalic(),
-                forceBold, vrml_text_callback );
+                forceBold, vrml_text_callback, &aModel );
     }
 }
 
@@ -847,8 +949,8 @@ static void export_vrml_board( MODEL_VRML& aModel, BOARD* aPcb )
 
         for( int j = 0; j < outline.PointCount(); j++ )
         {
-            aModel.m_board.AddVertex( seg, (double)outline.CPoint(j).x * BOARD_SCALE,
-                                        -((double)outline.CPoint(j).y * BOARD_SCALE ) );
+            aModel.m_board.AddVertex( seg, (double)outline.CPoint(j).x * aModel.m_boardScale,
+                                        -((double)outline.CPoint(j).y * aModel.m_boardScale ) );
 
         }
 
@@ -872,8 +974,8 @@ static void export_vrml_board( MODEL_VRML& aModel, BOARD* aPcb )
 
             for( int j = 0; j < hole.PointCount(); j++ )
             {
-                aModel.m_holes.AddVertex( seg, (double)hole.CPoint(j).x * BOARD_SCALE,
-                                          -((double)hole.CPoint(j).y * BOARD_SCALE ) );
+                aModel.m_holes.AddVertex( seg, (double)hole.CPoint(j).x * aModel.m_boardScale,
+                                          -((double)hole.CPoint(j).y * aModel.m_boardScale ) );
 
             }
 
@@ -933,10 +1035,10 @@ static void export_vrml_via( MODEL_VRML& aModel, BOARD* aPcb, const VIA* aVia )
     double       x, y, r, hole;
     PCB_LAYER_ID top_layer, bottom_layer;
 
-    hole = aVia->GetDrillValue() * BOARD_SCALE / 2.0;
-    r    = aVia->GetWidth() * BOARD_SCALE / 2.0;
-    x    = aVia->GetStart().x * BOARD_SCALE;
-    y    = aVia->GetStart().y * BOARD_SCALE;
+    hole = aVia->GetDrillValue() * aModel.m_boardScale / 2.0;
+    r    = aVia->GetWidth() * aModel.m_boardScale / 2.0;
+    x    = aVia->GetStart().x * aModel.m_boardScale;
+    y    = aVia->GetStart().y * aModel.m_boardScale;
     aVia->LayerPair( &top_layer, &bottom_layer );
 
     // do not render a buried via
@@ -971,29 +1073,29 @@ static void export_vrml_tracks( MODEL_VRML& aModel, BOARD* pcb )
                 if( arc_angle_degree < -1.0 || arc_angle_degree > 1.0 )
                 {
                     export_vrml_arc( aModel, track->GetLayer(),
-                                     center.x * BOARD_SCALE, center.y * BOARD_SCALE,
-                                     arc->GetStart().x * BOARD_SCALE,
-                                     arc->GetStart().y * BOARD_SCALE,
-                                     arc->GetWidth() * BOARD_SCALE, arc_angle_degree );
+                                     center.x * aModel.m_boardScale, center.y * aModel.m_boardScale,
+                                     arc->GetStart().x * aModel.m_boardScale,
+                                     arc->GetStart().y * aModel.m_boardScale,
+                                     arc->GetWidth() * aModel.m_boardScale, arc_angle_degree );
                 }
                 else
                 {
                     export_vrml_line( aModel, arc->GetLayer(),
-                                      arc->GetStart().x * BOARD_SCALE,
-                                      arc->GetStart().y * BOARD_SCALE,
-                                      arc->GetEnd().x * BOARD_SCALE,
-                                      arc->GetEnd().y * BOARD_SCALE,
-                                      arc->GetWidth() * BOARD_SCALE );
+                                      arc->GetStart().x * aModel.m_boardScale,
+                                      arc->GetStart().y * aModel.m_boardScale,
+                                      arc->GetEnd().x * aModel.m_boardScale,
+                                      arc->GetEnd().y * aModel.m_boardScale,
+                                      arc->GetWidth() * aModel.m_boardScale );
                 }
             }
             else
             {
                 export_vrml_line( aModel, track->GetLayer(),
-                                  track->GetStart().x * BOARD_SCALE,
-                                  track->GetStart().y * BOARD_SCALE,
-                                  track->GetEnd().x * BOARD_SCALE,
-                                  track->GetEnd().y * BOARD_SCALE,
-                                  track->GetWidth() * BOARD_SCALE );
+                                  track->GetStart().x * aModel.m_boardScale,
+                                  track->GetStart().y * aModel.m_boardScale,
+                                  track->GetEnd().x * aModel.m_boardScale,
+                                  track->GetEnd().y * aModel.m_boardScale,
+                                  track->GetWidth() * aModel.m_boardScale );
             }
         }
     }
@@ -1033,8 +1135,8 @@ static void export_vrml_zones( MODEL_VRML& aModel, BOARD* aPcb, COMMIT* aCommit
 
                 for( int j = 0; j < outline.PointCount(); j++ )
                 {
-                    if( !vl->AddVertex( seg, (double) outline.CPoint( j ).x * BOARD_SCALE,
-                                -( (double) outline.CPoint( j ).y * BOARD_SCALE ) ) )
+                    if( !vl->AddVertex( seg, (double) outline.CPoint( j ).x * aModel.m_boardScale,
+                                -( (double) outline.CPoint( j ).y * aModel.m_boardScale ) ) )
                     {
                         throw( std::runtime_error( vl->GetError() ) );
                     }
@@ -1047,7 +1149,7 @@ static void export_vrml_zones( MODEL_VRML& aModel, BOARD* aPcb, COMMIT* aCommit
 }
 
 
-static void export_vrml_text_module( FP_TEXT* item )
+static void export_vrml_text_module( MODEL_VRML& aModel, FP_TEXT* item )
 {
     if( item->IsVisible() )
     {
@@ -1059,12 +1161,12 @@ static void export_vrml_text_module( FP_TEXT* item )
         bool forceBold = true;
         int  penWidth = item->GetEffectiveTextPenWidth();
 
-        model_vrml->m_text_layer = item->GetLayer();
-        model_vrml->m_text_width = penWidth;
+        aModel.m_text_layer = item->GetLayer();
+        aModel.m_text_width = penWidth;
 
         GRText( NULL, item->GetTextPos(), BLACK, item->GetShownText(), item->GetDrawRotation(),
                 size, item->GetHorizJustify(), item->GetVertJustify(), penWidth, item->IsItalic(),
-                forceBold, vrml_text_callback );
+                forceBold, vrml_text_callback, &aModel );
     }
 }
 
@@ -1072,11 +1174,11 @@ static void export_vrml_text_module( FP_TEXT* item )
 static void export_vrml_edge_module( MODEL_VRML& aModel, FP_SHAPE* aOutline, MODULE* aModule )
 {
     LAYER_NUM layer = aOutline->GetLayer();
-    double  x   = aOutline->GetStart().x * BOARD_SCALE;
-    double  y   = aOutline->GetStart().y * BOARD_SCALE;
-    double  xf  = aOutline->GetEnd().x * BOARD_SCALE;
-    double  yf  = aOutline->GetEnd().y * BOARD_SCALE;
-    double  w   = aOutline->GetWidth() * BOARD_SCALE;
+    double  x   = aOutline->GetStart().x * aModel.m_boardScale;
+    double  y   = aOutline->GetStart().y * aModel.m_boardScale;
+    double  xf  = aOutline->GetEnd().x * aModel.m_boardScale;
+    double  yf  = aOutline->GetEnd().y * aModel.m_boardScale;
+    double  w   = aOutline->GetWidth() * aModel.m_boardScale;
 
     switch( aOutline->GetShape() )
     {
@@ -1114,15 +1216,15 @@ static void export_vrml_padshape( MODEL_VRML& aModel, VRML_LAYER* aTinLayer, D_P
 {
     // The (maybe offset) pad position
     wxPoint pad_pos = aPad->ShapePos();
-    double  pad_x   = pad_pos.x * BOARD_SCALE;
-    double  pad_y   = pad_pos.y * BOARD_SCALE;
+    double  pad_x   = pad_pos.x * aModel.m_boardScale;
+    double  pad_y   = pad_pos.y * aModel.m_boardScale;
     wxSize  pad_delta = aPad->GetDelta();
 
-    double  pad_dx  = pad_delta.x * BOARD_SCALE / 2.0;
-    double  pad_dy  = pad_delta.y * BOARD_SCALE / 2.0;
+    double  pad_dx  = pad_delta.x * aModel.m_boardScale / 2.0;
+    double  pad_dy  = pad_delta.y * aModel.m_boardScale / 2.0;
 
-    double  pad_w   = aPad->GetSize().x * BOARD_SCALE / 2.0;
-    double  pad_h   = aPad->GetSize().y * BOARD_SCALE / 2.0;
+    double  pad_w   = aPad->GetSize().x * aModel.m_boardScale / 2.0;
+    double  pad_h   = aPad->GetSize().y * aModel.m_boardScale / 2.0;
 
     switch( aPad->GetShape() )
     {
@@ -1155,7 +1257,7 @@ static void export_vrml_padshape( MODEL_VRML& aModel, VRML_LAYER* aTinLayer, D_P
         cornerList.reserve( poly.PointCount() );
         for( int ii = 0; ii < poly.PointCount(); ++ii )
             cornerList.emplace_back(
-                    poly.CPoint( ii ).x * BOARD_SCALE, -poly.CPoint( ii ).y * BOARD_SCALE );
+                    poly.CPoint( ii ).x * aModel.m_boardScale, -poly.CPoint( ii ).y * aModel.m_boardScale );
 
         // Close polygon
         cornerList.push_back( cornerList[0] );
@@ -1178,7 +1280,7 @@ static void export_vrml_padshape( MODEL_VRML& aModel, VRML_LAYER* aTinLayer, D_P
 
             for( int ii = 0; ii < poly.PointCount(); ++ii )
                 cornerList.emplace_back(
-                        poly.CPoint( ii ).x * BOARD_SCALE, -poly.CPoint( ii ).y * BOARD_SCALE );
+                        poly.CPoint( ii ).x * aModel.m_boardScale, -poly.CPoint( ii ).y * aModel.m_boardScale );
 
             // Close polygon
             cornerList.push_back( cornerList[0] );
@@ -1245,11 +1347,11 @@ static void export_vrml_padshape( MODEL_VRML& aModel, VRML_LAYER* aTinLayer, D_P
 
 static void export_vrml_pad( MODEL_VRML& aModel, BOARD* aPcb, D_PAD* aPad )
 {
-    double  hole_drill_w    = (double) aPad->GetDrillSize().x * BOARD_SCALE / 2.0;
-    double  hole_drill_h    = (double) aPad->GetDrillSize().y * BOARD_SCALE / 2.0;
+    double  hole_drill_w    = (double) aPad->GetDrillSize().x * aModel.m_boardScale / 2.0;
+    double  hole_drill_h    = (double) aPad->GetDrillSize().y * aModel.m_boardScale / 2.0;
     double  hole_drill      = std::min( hole_drill_w, hole_drill_h );
-    double  hole_x          = aPad->GetPosition().x * BOARD_SCALE;
-    double  hole_y          = aPad->GetPosition().y * BOARD_SCALE;
+    double  hole_x          = aPad->GetPosition().x * aModel.m_boardScale;
+    double  hole_y          = aPad->GetPosition().y * aModel.m_boardScale;
 
     // Export the hole on the edge layer
     if( hole_drill > 0 )
@@ -1368,10 +1470,10 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
     {
         // Reference and value
         if( aModule->Reference().IsVisible() )
-            export_vrml_text_module( &aModule->Reference() );
+            export_vrml_text_module( aModel, &aModule->Reference() );
 
         if( aModule->Value().IsVisible() )
-            export_vrml_text_module( &aModule->Value() );
+            export_vrml_text_module( aModel, &aModule->Value() );
 
         // Export module edges
 
@@ -1380,7 +1482,7 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
             switch( item->Type() )
             {
             case PCB_FP_TEXT_T:
-                export_vrml_text_module( static_cast<FP_TEXT*>( item ) );
+                export_vrml_text_module( aModel, static_cast<FP_TEXT*>( item ) );
                 break;
 
             case PCB_FP_SHAPE_T:
@@ -1403,11 +1505,11 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
     auto sM = aModule->Models().begin();
     auto eM = aModule->Models().end();
 
-    wxFileName subdir( SUBDIR_3D, "" );
+    wxFileName subdir( aModel.m_subdir3D, "" );
 
     while( sM != eM )
     {
-        SGNODE* mod3d = (SGNODE*) cache->Load( sM->m_Filename );
+        SGNODE* mod3d = (SGNODE*) aModel.m_cache->Load( sM->m_Filename );
 
         if( NULL == mod3d )
         {
@@ -1461,43 +1563,56 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
         RotatePoint( &offsetx, &offsety, aModule->GetOrientation() );
 
         SGPOINT trans;
-        trans.x = ( offsetx + aModule->GetPosition().x ) * BOARD_SCALE + aModel.m_tx;
-        trans.y = -(offsety + aModule->GetPosition().y) * BOARD_SCALE - aModel.m_ty;
-        trans.z = (offsetz * BOARD_SCALE ) + aModel.GetLayerZ( aModule->GetLayer() );
+        trans.x = ( offsetx + aModule->GetPosition().x ) * aModel.m_boardScale + aModel.m_tx;
+        trans.y = -(offsety + aModule->GetPosition().y) * aModel.m_boardScale - aModel.m_ty;
+        trans.z = (offsetz * aModel.m_boardScale ) + aModel.GetLayerZ( aModule->GetLayer() );
 
-        if( USE_INLINES )
+        if( aModel.m_useInlines )
         {
-            wxFileName srcFile = cache->GetResolver()->ResolvePath( sM->m_Filename );
+            wxFileName srcFile = aModel.m_cache->GetResolver()->ResolvePath( sM->m_Filename );
             wxFileName dstFile;
-            dstFile.SetPath( SUBDIR_3D );
+            dstFile.SetPath( aModel.m_subdir3D );
             dstFile.SetName( srcFile.GetName() );
             dstFile.SetExt( "wrl"  );
 
-            // copy the file if necessary
-            wxDateTime srcModTime = srcFile.GetModificationTime();
-            wxDateTime destModTime = srcModTime;
+            // each model file is copied and DEFined once, then instanced with USE
+            auto inlineDef = aModel.m_inlineDefs.find( dstFile.GetFullPath() );
 
-            destModTime.SetToCurrent();
+            if( inlineDef == aModel.m_inlineDefs.end() )
+            {
+                // copy the file if necessary
+                wxDateTime srcModTime = srcFile.GetModificationTime();
+                wxDateTime destModTime = srcModTime;
 
-            if( dstFile.FileExists() )
-                destModTime = dstFile.GetModificationTime();
+                destModTime.SetToCurrent();
 
-            if( srcModTime != destModTime )
-            {
-                wxString fileExt = srcFile.GetExt();
-                fileExt.LowerCase();
+                if( dstFile.FileExists() )
+                    destModTime = dstFile.GetModificationTime();
 
-                // copy VRML models and use the scenegraph library to
-                // translate other model types
-                if( fileExt == "wrl" )
+                if( srcModTime != destModTime )
                 {
-                    if( !wxCopyFile( srcFile.GetFullPath(), dstFile.GetFullPath() ) )
-                        continue;
-                }
-                else
-                {
-                    if( !S3D::WriteVRML( dstFile.GetFullPath().ToUTF8(), true, mod3d, USE_DEFS, true ) )
-                        continue;
+                    wxString fileExt = srcFile.GetExt();
+                    fileExt.LowerCase();
+
+                    // copy VRML models and use the scenegraph library to
+                    // translate other model types
+                    if( fileExt == "wrl" )
+                    {
+                        if( !wxCopyFile( srcFile.GetFullPath(), dstFile.GetFullPath() ) )
+                        {
+                            ++sM;
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        if( !S3D::WriteVRML( dstFile.GetFullPath().ToUTF8(), true, mod3d,
+                                             aModel.m_useDefs, true ) )
+                        {
+                            ++sM;
+                            continue;
+                        }
+                    }
                 }
             }
 
@@ -1520,20 +1635,31 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
             (*aOutputFile) << sM->m_Scale.y << " ";
             (*aOutputFile) << sM->m_Scale.z << "\n";
 
-            (*aOutputFile) << "  children [\n    Inline {\n      url \"";
-
-            if( USE_RELPATH )
+            if( inlineDef != aModel.m_inlineDefs.end() )
+            {
+                (*aOutputFile) << "  children [ USE " << inlineDef->second << " ]\n";
+            }
+            else
             {
-                wxFileName tmp = dstFile;
-                tmp.SetExt( "" );
-                tmp.SetName( "" );
-                tmp.RemoveLastDir();
-                dstFile.MakeRelativeTo( tmp.GetPath() );
+                std::string defName = "MODEL_" + std::to_string( aModel.m_inlineDefs.size() );
+                aModel.m_inlineDefs[ dstFile.GetFullPath() ] = defName;
+
+                (*aOutputFile) << "  children [\n    DEF " << defName << " Inline {\n      url \"";
+
+                if( aModel.m_useRelPath )
+                {
+                    wxFileName tmp = dstFile;
+                    tmp.SetExt( "" );
+                    tmp.SetName( "" );
+                    tmp.RemoveLastDir();
+                    dstFile.MakeRelativeTo( tmp.GetPath() );
+                }
+
+                wxString fn = dstFile.GetFullPath();
+                fn.Replace( "\\", "/" );
+                (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
             }
 
-            wxString fn = dstFile.GetFullPath();
-            fn.Replace( "\\", "/" );
-            (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
             (*aOutputFile) << "  }\n";
         }
         else
@@ -1574,25 +1700,25 @@ bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMt
     BOARD_COMMIT    commit( this );     // We may need to modify the board (for instance to
                                         // fill zones), so make sure we can revert.
 
-    USE_INLINES = aExport3DFiles;
-    USE_DEFS = true;
-    USE_RELPATH = aUseRelativePaths;
-
-    cache = Prj().Get3DCacheManager();
-    PROJ_DIR = Prj().GetProjectPath();
-    SUBDIR_3D = a3D_Subdir;
     MODEL_VRML model3d;
-    model_vrml = &model3d;
+
+    model3d.m_useInlines = aExport3DFiles;
+    model3d.m_useDefs = true;
+    model3d.m_useRelPath = aUseRelativePaths;
+
+    model3d.m_cache = Prj().Get3DCacheManager();
+    model3d.m_projDir = Prj().GetProjectPath();
+    model3d.m_subdir3D = a3D_Subdir;
     model3d.SetScale( aMMtoWRMLunit );
 
-    if( USE_INLINES )
+    if( model3d.m_useInlines )
     {
-        BOARD_SCALE = MM_PER_IU / 2.54;
+        model3d.m_boardScale = MM_PER_IU / 2.54;
         model3d.SetOffset( -aXRef / 2.54, aYRef / 2.54 );
     }
     else
     {
-        BOARD_SCALE = MM_PER_IU;
+        model3d.m_boardScale = MM_PER_IU;
         model3d.SetOffset( -aXRef, aYRef );
     }
 
@@ -1618,10 +1744,10 @@ bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMt
         if( !aUsePlainPCB )
             export_vrml_zones( model3d, pcb, &commit );
 
-        if( USE_INLINES )
+        if( model3d.m_useInlines )
         {
             // check if the 3D Subdir exists - create if not
-            wxFileName subdir( SUBDIR_3D, "" );
+            wxFileName subdir( model3d.m_subdir3D, "" );
 
             if( ! subdir.DirExists() )
             {
@@ -1649,9 +1775,9 @@ bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMt
             output_file << "}\n";
             output_file << "Transform {\n";
             output_file << "  scale " << std::setprecision( PRECISION );
-            output_file << WORLD_SCALE << " ";
-            output_file << WORLD_SCALE << " ";
-            output_file << WORLD_SCALE << "\n";
+            output_file << model3d.m_worldScale << " ";
+            output_file << model3d.m_worldScale << " ";
+            output_file << model3d.m_worldScale << "\n";
             output_file << "  children [\n";
 
             // Export footprints
@@ -1690,18 +1816,18 @@ bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMt
 }
 
 
-static SGNODE* getSGColor( VRML_COLOR_INDEX colorIdx )
+SGNODE* MODEL_VRML::GetSGColor( VRML_COLOR_INDEX colorIdx )
 {
     if( colorIdx == -1 )
         colorIdx = VRML_COLOR_PCB;
     else if( colorIdx == VRML_COLOR_LAST )
         return NULL;
 
-    if( sgmaterial[colorIdx] )
-        return sgmaterial[colorIdx];
+    if( m_sgmaterial[colorIdx] )
+        return m_sgmaterial[colorIdx];
 
     IFSG_APPEARANCE vcolor( (SGNODE*) NULL );
-    VRML_COLOR* cp = &colors[colorIdx];
+    VRML_COLOR* cp = &m_colors[colorIdx];
 
     vcolor.SetSpecular( cp->spec_red, cp->spec_grn, cp->spec_blu );
     vcolor.SetDiffuse( cp->diffuse_red, cp->diffuse_grn, cp->diffuse_blu );
@@ -1711,13 +1837,13 @@ static SGNODE* getSGColor( VRML_COLOR_INDEX colorIdx )
     vcolor.SetAmbient( cp->ambient, cp->ambient, cp->ambient );
     vcolor.SetTransparency( cp->transp );
 
-    sgmaterial[colorIdx] = vcolor.GetRawPtr();
+    m_sgmaterial[colorIdx] = vcolor.GetRawPtr();
 
-    return sgmaterial[colorIdx];
+    return m_sgmaterial[colorIdx];
 }
 
 
-static void create_vrml_plane( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX colorID,
+static void create_vrml_plane( MODEL_VRML& aModel, VRML_COLOR_INDEX colorID,
     VRML_LAYER* layer, double top_z, bool aTopPlane )
 {
     std::vector< double > vertices;
@@ -1741,7 +1867,7 @@ static void create_vrml_plane( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX color
         vlist.emplace_back( vertices[j], vertices[j+1], vertices[j+2] );
 
     // create the intermediate scenegraph
-    IFSG_TRANSFORM tx0( PcbOutput.GetRawPtr() );    // tx0 = Transform for this outline
+    IFSG_TRANSFORM tx0( aModel.m_OutputPCB.GetRawPtr() );    // tx0 = Transform for this outline
     IFSG_SHAPE shape( tx0 );            // shape will hold (a) all vertices and (b) a local list of normals
     IFSG_FACESET face( shape );         // this face shall represent the top and bottom planes
     IFSG_COORDS cp( face );             // coordinates for all faces
@@ -1763,7 +1889,7 @@ static void create_vrml_plane( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX color
     }
 
     // assign a color from the palette
-    SGNODE* modelColor = getSGColor( colorID );
+    SGNODE* modelColor = aModel.GetSGColor( colorID );
 
     if( NULL != modelColor )
     {
@@ -1775,7 +1901,7 @@ static void create_vrml_plane( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX color
 }
 
 
-static void create_vrml_shell( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX colorID,
+static void create_vrml_shell( MODEL_VRML& aModel, VRML_COLOR_INDEX colorID,
     VRML_LAYER* layer, double top_z, double bottom_z )
 {
     std::vector< double > vertices;
@@ -1809,7 +1935,7 @@ static void create_vrml_shell( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX color
         vlist.emplace_back( vertices[j], vertices[j+1], vertices[j+2] );
 
     // create the intermediate scenegraph
-    IFSG_TRANSFORM tx0( PcbOutput.GetRawPtr() );    // tx0 = Transform for this outline
+    IFSG_TRANSFORM tx0( aModel.m_OutputPCB.GetRawPtr() );    // tx0 = Transform for this outline
     IFSG_SHAPE shape( tx0 );            // shape will hold (a) all vertices and (b) a local list of normals
     IFSG_FACESET face( shape );         // this face shall represent the top and bottom planes
     IFSG_COORDS cp( face );             // coordinates for all faces
@@ -1830,7 +1956,7 @@ static void create_vrml_shell( IFSG_TRANSFORM& PcbOutput, VRML_COLOR_INDEX color
         norms.AddNormal( 0.0, 0.0, -1.0 );
 
     // assign a color from the palette
-    SGNODE* modelColor = getSGColor( colorID );
+    SGNODE* modelColor = aModel.GetSGColor( colorID );
 
     if( NULL != modelColor )
     {
@@ -49,6 +49,9 @@
 
 #include <pcb_edit_frame.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 
 BOARD_NETLIST_UPDATER::BOARD_NETLIST_UPDATER( PCB_EDIT_FRAME* aFrame, BOARD* aBoard ) :
     m_frame( aFrame ),
@@ -67,6 +70,9 @@ BOARD_NETLIST_UPDATER::BOARD_NETLIST_UPDATER( PCB_EDIT_FRAME* aFrame, BOARD* aBo
     m_warningCount = 0;
     m_errorCount = 0;
     m_newFootprintsCount = 0;
+
+    // The whole board can change: update the connectivity once, when the commit is pushed
+    m_commit.SetRebuildConnectivity( true );
 }
 
 
@@ -347,16 +353,29 @@ bool BOARD_NETLIST_UPDATER::updateComponentParameters( MODULE* aPcbComponent,
 bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( MODULE* aPcbComponent,
                                                            COMPONENT* aNewComponent )
 {
+    static const COMPONENT_NET noNet;
+
     wxString msg;
 
     // Create a copy only if the module has not been added during this update
     MODULE* copy = m_commit.GetStatus( aPcbComponent ) ? nullptr : (MODULE*) aPcbComponent->Clone();
     bool changed = false;
 
+    // Index the nets of the component by pin name, as COMPONENT::GetNet() searches them
+    // for each pad.  The first net of a pin is kept, as GetNet() does.
+    std::unordered_map<wxString, const COMPONENT_NET*> netsByPin;
+
+    for( unsigned ii = 0; ii < aNewComponent->GetNetCount(); ii++ )
+    {
+        const COMPONENT_NET& net = aNewComponent->GetNet( ii );
+        netsByPin.emplace( net.GetPinName(), &net );
+    }
+
     // At this point, the component footprint is updated.  Now update the nets.
     for( D_PAD* pad : aPcbComponent->Pads() )
     {
-        const COMPONENT_NET& net = aNewComponent->GetNet( pad->GetName() );
+        auto                 netIt = netsByPin.find( pad->GetName() );
+        const COMPONENT_NET& net = netIt != netsByPin.end() ? *netIt->second : noNet;
 
         wxString pinFunction;
 
@@ -623,15 +642,28 @@ bool BOARD_NETLIST_UPDATER::deleteUnusedComponents( NETLIST& aNetlist )
     wxString msg;
     const COMPONENT* component;
 
+    // Index the components by path or reference; the first component of a key is kept, as
+    // NETLIST::GetComponentByPath() and GetComponentByReference() do.
+    std::unordered_map<wxString, const COMPONENT*> components;
+
+    for( unsigned ii = 0; ii < aNetlist.GetCount(); ii++ )
+    {
+        component = aNetlist.GetComponent( ii );
+
+        if( m_lookupByTimestamp )
+            components.emplace( component->GetPath().AsString(), component );
+        else
+            components.emplace( component->GetReference(), component );
+    }
+
     for( MODULE* module : m_board->Modules() )
     {
         if( ( module->GetAttributes() & MOD_BOARD_ONLY ) > 0 )
             continue;
 
-        if( m_lookupByTimestamp )
-            component = aNetlist.GetComponentByPath( module->GetPath() );
-        else
-            component = aNetlist.GetComponentByReference( module->GetReference() );
+        auto it = components.find( m_lookupByTimestamp ? module->GetPath().AsString()
+                                                       : module->GetReference() );
+        component = it != components.end() ? it->second : nullptr;
 
         if( component == NULL || component->GetProperties().count( "exclude_from_board" ) )
         {
@@ -747,21 +779,37 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist )
     wxString msg;
     wxString padname;
 
+    // Index the footprints by reference, keeping the first one as
+    // BOARD::FindModuleByReference() does
+    std::unordered_map<wxString, MODULE*> footprints;
+
+    for( MODULE* footprint : m_board->Modules() )
+        footprints.emplace( footprint->GetReference(), footprint );
+
+    std::unordered_set<wxString> padnames;
+
     for( int i = 0; i < (int) aNetlist.GetCount(); i++ )
     {
         const COMPONENT* component = aNetlist.GetComponent( i );
-        MODULE* footprint = m_board->FindModuleByReference( component->GetReference() );
+        auto             it = footprints.find( component->GetReference() );
 
-        if( footprint == NULL )    // It can be missing in partial designs
+        if( it == footprints.end() )    // It can be missing in partial designs
             continue;
 
+        MODULE* footprint = it->second;
+
+        padnames.clear();
+
+        for( D_PAD* pad : footprint->Pads() )
+            padnames.insert( pad->GetName() );
+
         // Explore all pins/pads in component
         for( unsigned jj = 0; jj < component->GetNetCount(); jj++ )
         {
             const COMPONENT_NET& net = component->GetNet( jj );
             padname = net.GetPinName();
 
-            if( footprint->FindPadByName( padname ) )
+            if( padnames.count( padname ) )
                 continue;   // OK, pad found
 
             // not found: bad footprint, report error
@@ -784,7 +832,6 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
     m_errorCount = 0;
     m_warningCount = 0;
     m_newFootprintsCount = 0;
-    MODULE* lastPreexistingFootprint = m_board->Modules().empty() ? NULL : m_board->Modules().back();
 
     cacheCopperZoneConnections();
 
@@ -798,6 +845,23 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
             net->SetIsCurrent( net->GetNet() == 0 );
     }
 
+    // Index the footprints of the board by path or by reference (case insensitive), instead
+    // of searching the board for each component.  The footprints of a key stay in the board
+    // order.  The footprints added by the update are only in the commit, so they are not
+    // indexed.
+    auto footprintKey = [this]( const KIID_PATH& aPath, const wxString& aReference ) -> wxString
+                        {
+                            return m_lookupByTimestamp ? aPath.AsString() : aReference.Lower();
+                        };
+
+    std::unordered_map<wxString, std::vector<MODULE*>> footprints;
+
+    for( MODULE* footprint : m_board->Modules() )
+    {
+        footprints[ footprintKey( footprint->GetPath(), footprint->GetReference() ) ]
+                .push_back( footprint );
+    }
+
     for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
     {
         COMPONENT* component = aNetlist.GetComponent( i );
@@ -812,19 +876,12 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
                     component->GetFPID().Format().wx_str() );
         m_reporter->Report( msg, RPT_SEVERITY_INFO );
 
-        for( auto footprint : m_board->Modules() )
-        {
-            bool     match = false;
-
-            if( footprint )
-            {
-                if( m_lookupByTimestamp )
-                    match = footprint->GetPath() == component->GetPath();
-                else
-                    match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
-            }
+        auto it = footprints.find( footprintKey( component->GetPath(),
+                                                 component->GetReference() ) );
 
-            if( match )
+        if( it != footprints.end() )
+        {
+            for( MODULE* footprint : it->second )
             {
                 tmp = footprint;
 
@@ -839,12 +896,6 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
                 matchCount++;
             }
-
-            if( footprint == lastPreexistingFootprint )
-            {
-                // No sense going through the newly-created footprints: end of loop
-                break;
-            }
         }
 
         if( matchCount == 0 )
@@ -872,10 +923,9 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     if( !m_isDryRun )
     {
-        m_board->GetConnectivity()->Build( m_board );
         testConnectivity( aNetlist );
 
-        // Now the connectivity data is rebuilt, we can delete single pads nets
+        // The connectivity is rebuilt once, when the commit is pushed
         if( m_deleteSinglePadNets )
             deleteSinglePadNets();
 
@@ -211,6 +211,14 @@ public:
      */
     void ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aItemCount = -1 ) override;
 
+    /**
+     * Function GetCommandMemoryUsage
+     * estimates the memory held by an undo/redo command from the size of its copies
+     * of footprints, zones (a fill shared with the board or with other copies is split
+     * between its owners) and other items.
+     */
+    size_t GetCommandMemoryUsage( const PICKED_ITEMS_LIST& aCommand ) const override;
+
     /**
      * Returns the absolute path to the design rules file for the currently-loaded board.
      * Note that there is no guarantee that this file actually exists and can be opened!
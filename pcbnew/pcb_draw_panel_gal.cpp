@@ -481,13 +481,19 @@ void PCB_DRAW_PANEL_GAL::OnShow()
 
 
 void PCB_DRAW_PANEL_GAL::setDefaultLayerOrder()
+{
+    SetDefaultLayerOrder( m_view );
+}
+
+
+void PCB_DRAW_PANEL_GAL::SetDefaultLayerOrder( KIGFX::VIEW* aView )
 {
     for( LAYER_NUM i = 0; (unsigned) i < sizeof( GAL_LAYER_ORDER ) / sizeof( LAYER_NUM ); ++i )
     {
         LAYER_NUM layer = GAL_LAYER_ORDER[i];
         wxASSERT( layer < KIGFX::VIEW::VIEW_MAX_LAYERS );
 
-        m_view->SetLayerOrder( layer, i );
+        aView->SetLayerOrder( layer, i );
     }
 }
 
@@ -520,10 +526,16 @@ BOX2I PCB_DRAW_PANEL_GAL::GetDefaultViewBBox() const
 void PCB_DRAW_PANEL_GAL::setDefaultLayerDeps()
 {
     // caching makes no sense for Cairo and other software renderers
-    auto target = m_backend == GAL_TYPE_OPENGL ? KIGFX::TARGET_CACHED : KIGFX::TARGET_NONCACHED;
+    SetDefaultLayerDeps( m_view, m_backend == GAL_TYPE_OPENGL );
+}
+
+
+void PCB_DRAW_PANEL_GAL::SetDefaultLayerDeps( KIGFX::VIEW* aView, bool aCached )
+{
+    auto target = aCached ? KIGFX::TARGET_CACHED : KIGFX::TARGET_NONCACHED;
 
     for( int i = 0; i < KIGFX::VIEW::VIEW_MAX_LAYERS; i++ )
-        m_view->SetLayerTarget( i, target );
+        aView->SetLayerTarget( i, target );
 
     for( LAYER_NUM i = 0; (unsigned) i < sizeof( GAL_LAYER_ORDER ) / sizeof( LAYER_NUM ); ++i )
     {
@@ -533,55 +545,55 @@ void PCB_DRAW_PANEL_GAL::setDefaultLayerDeps()
         // Set layer display dependencies & targets
         if( IsCopperLayer( layer ) )
         {
-            m_view->SetRequired( ZONE_LAYER_FOR( layer ), layer );
-            m_view->SetRequired( GetNetnameLayer( layer ), layer );
+            aView->SetRequired( ZONE_LAYER_FOR( layer ), layer );
+            aView->SetRequired( GetNetnameLayer( layer ), layer );
         }
         else if( IsNonCopperLayer( layer ) )
-            m_view->SetRequired( ZONE_LAYER_FOR( layer ), layer );
+            aView->SetRequired( ZONE_LAYER_FOR( layer ), layer );
         else if( IsNetnameLayer( layer ) )
-            m_view->SetLayerDisplayOnly( layer );
+            aView->SetLayerDisplayOnly( layer );
     }
 
-    m_view->SetLayerTarget( LAYER_ANCHOR, KIGFX::TARGET_NONCACHED );
-    m_view->SetLayerDisplayOnly( LAYER_ANCHOR );
+    aView->SetLayerTarget( LAYER_ANCHOR, KIGFX::TARGET_NONCACHED );
+    aView->SetLayerDisplayOnly( LAYER_ANCHOR );
 
     // Some more required layers settings
-    m_view->SetRequired( LAYER_VIAS_HOLES, LAYER_VIA_THROUGH );
-    m_view->SetRequired( LAYER_VIAS_NETNAMES, LAYER_VIA_THROUGH );
-    m_view->SetRequired( LAYER_PADS_PLATEDHOLES, LAYER_PADS_TH );
-    m_view->SetRequired( LAYER_NON_PLATEDHOLES, LAYER_PADS_TH );
-    m_view->SetRequired( LAYER_PADS_NETNAMES, LAYER_PADS_TH );
+    aView->SetRequired( LAYER_VIAS_HOLES, LAYER_VIA_THROUGH );
+    aView->SetRequired( LAYER_VIAS_NETNAMES, LAYER_VIA_THROUGH );
+    aView->SetRequired( LAYER_PADS_PLATEDHOLES, LAYER_PADS_TH );
+    aView->SetRequired( LAYER_NON_PLATEDHOLES, LAYER_PADS_TH );
+    aView->SetRequired( LAYER_PADS_NETNAMES, LAYER_PADS_TH );
 
     // Via visibility
-    m_view->SetRequired( LAYER_VIA_MICROVIA, LAYER_VIAS );
-    m_view->SetRequired( LAYER_VIA_BBLIND, LAYER_VIAS );
-    m_view->SetRequired( LAYER_VIA_THROUGH, LAYER_VIAS );
+    aView->SetRequired( LAYER_VIA_MICROVIA, LAYER_VIAS );
+    aView->SetRequired( LAYER_VIA_BBLIND, LAYER_VIAS );
+    aView->SetRequired( LAYER_VIA_THROUGH, LAYER_VIAS );
 
     // Pad visibility
-    m_view->SetRequired( LAYER_PADS_TH, LAYER_PADS );
-    m_view->SetRequired( LAYER_PAD_FR, LAYER_PADS );
-    m_view->SetRequired( LAYER_PAD_BK, LAYER_PADS );
+    aView->SetRequired( LAYER_PADS_TH, LAYER_PADS );
+    aView->SetRequired( LAYER_PAD_FR, LAYER_PADS );
+    aView->SetRequired( LAYER_PAD_BK, LAYER_PADS );
 
     // Front modules
-    m_view->SetRequired( LAYER_PAD_FR, F_Cu );
-    m_view->SetRequired( LAYER_MOD_TEXT_FR, LAYER_MOD_FR );
-    m_view->SetRequired( LAYER_PAD_FR_NETNAMES, LAYER_PAD_FR );
+    aView->SetRequired( LAYER_PAD_FR, F_Cu );
+    aView->SetRequired( LAYER_MOD_TEXT_FR, LAYER_MOD_FR );
+    aView->SetRequired( LAYER_PAD_FR_NETNAMES, LAYER_PAD_FR );
 
     // Back modules
-    m_view->SetRequired( LAYER_PAD_BK, B_Cu );
-    m_view->SetRequired( LAYER_MOD_TEXT_BK, LAYER_MOD_BK );
-    m_view->SetRequired( LAYER_PAD_BK_NETNAMES, LAYER_PAD_BK );
-
-    m_view->SetLayerTarget( LAYER_SELECT_OVERLAY , KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_SELECT_OVERLAY ) ;
-    m_view->SetLayerTarget( LAYER_GP_OVERLAY , KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_GP_OVERLAY ) ;
-    m_view->SetLayerTarget( LAYER_RATSNEST, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_RATSNEST );
-
-    m_view->SetLayerTarget( LAYER_WORKSHEET, KIGFX::TARGET_NONCACHED );
-    m_view->SetLayerDisplayOnly( LAYER_WORKSHEET ) ;
-    m_view->SetLayerDisplayOnly( LAYER_GRID );
+    aView->SetRequired( LAYER_PAD_BK, B_Cu );
+    aView->SetRequired( LAYER_MOD_TEXT_BK, LAYER_MOD_BK );
+    aView->SetRequired( LAYER_PAD_BK_NETNAMES, LAYER_PAD_BK );
+
+    aView->SetLayerTarget( LAYER_SELECT_OVERLAY , KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_SELECT_OVERLAY ) ;
+    aView->SetLayerTarget( LAYER_GP_OVERLAY , KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_GP_OVERLAY ) ;
+    aView->SetLayerTarget( LAYER_RATSNEST, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_RATSNEST );
+
+    aView->SetLayerTarget( LAYER_WORKSHEET, KIGFX::TARGET_NONCACHED );
+    aView->SetLayerDisplayOnly( LAYER_WORKSHEET ) ;
+    aView->SetLayerDisplayOnly( LAYER_GRID );
 }
 
 
@@ -109,6 +109,12 @@ public:
 
     virtual KIGFX::PCB_VIEW* GetView() const override;
 
+    ///> Sets the default layer order of a view displaying a board.
+    static void SetDefaultLayerOrder( KIGFX::VIEW* aView );
+
+    ///> Sets the rendering targets & dependencies of the layers of a view displaying a board.
+    static void SetDefaultLayerDeps( KIGFX::VIEW* aView, bool aCached );
+
 protected:
 
     ///> Reassigns layer order to the initial settings.
@@ -892,23 +892,24 @@ void PCB_PAINTER::draw( const D_PAD* aPad, int aLayer )
             break;
         }
 
+        // Different margins in x and y make a bigger pad.  Resize a copy of the pad rather
+        // than the pad itself: the board can be drawn by several views at the same time.
+        std::unique_ptr<D_PAD> resizedPad;
+        const D_PAD*           pad = aPad;
+
         if( margin.x != margin.y )
         {
-            const_cast<D_PAD*>( aPad )->SetSize( pad_size + margin + margin );
+            resizedPad = std::make_unique<D_PAD>( *aPad );
+            resizedPad->SetSize( pad_size + margin + margin );
+            pad = resizedPad.get();
             margin.x = margin.y = 0;
         }
 
         // Once we change the size of the pad, check that there is still a pad remaining
-        if( !aPad->GetSize().x || !aPad->GetSize().y )
-        {
-            // Reset the stored pad size
-            if( aPad->GetSize() != pad_size )
-                const_cast<D_PAD*>( aPad )->SetSize( pad_size );
-
+        if( !pad->GetSize().x || !pad->GetSize().y )
             return;
-        }
 
-        auto shapes = std::dynamic_pointer_cast<SHAPE_COMPOUND>( aPad->GetEffectiveShape() );
+        auto shapes = std::dynamic_pointer_cast<SHAPE_COMPOUND>( pad->GetEffectiveShape() );
 
         if( shapes && shapes->Size() == 1 && shapes->Shapes()[0]->Type() == SH_SEGMENT )
         {
@@ -923,12 +924,9 @@ void PCB_PAINTER::draw( const D_PAD* aPad, int aLayer )
         else
         {
             SHAPE_POLY_SET polySet;
-            aPad->TransformShapeWithClearanceToPolygon( polySet, ToLAYER_ID( aLayer ), margin.x );
+            pad->TransformShapeWithClearanceToPolygon( polySet, ToLAYER_ID( aLayer ), margin.x );
             m_gal->DrawPolygon( polySet );
         }
-
-        if( aPad->GetSize() != pad_size )
-            const_cast<D_PAD*>( aPad )->SetSize( pad_size );
     }
 
     // Clearance outlines
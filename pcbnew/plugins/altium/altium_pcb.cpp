@@ -46,6 +46,35 @@
 #include <wx/wfstream.h>
 #include <wx/zstream.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
+
+/**
+ * Decodes all the records of a binary stream.  It only reads the stream, so the streams can be
+ * decoded by several threads.
+ */
+template <typename RECORD, typename... ARGS>
+static std::vector<RECORD> readRecords( const CFB::CompoundFileReader& aReader,
+        const CFB::COMPOUND_FILE_ENTRY* aEntry, const char* aStreamName, ARGS... aArgs )
+{
+    ALTIUM_PARSER       reader( aReader, aEntry );
+    std::vector<RECORD> records;
+
+    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    {
+        records.emplace_back( reader, aArgs... );
+    }
+
+    if( reader.GetRemainingBytes() != 0 )
+    {
+        THROW_IO_ERROR( wxString::Format( "%s stream is not fully parsed", aStreamName ) );
+    }
+
+    return records;
+}
+
 
 void ParseAltiumPcb( BOARD* aBoard, const wxString& aFileName,
                      const std::map<ALTIUM_PCB_DIR, std::string>& aFileMapping )
@@ -254,6 +283,7 @@ ALTIUM_PCB::ALTIUM_PCB( BOARD* aBoard )
     m_board              = aBoard;
     m_num_nets           = 0;
     m_highest_pour_index = 0;
+    m_modelsDirFailed    = false;
 }
 
 ALTIUM_PCB::~ALTIUM_PCB()
@@ -263,6 +293,100 @@ ALTIUM_PCB::~ALTIUM_PCB()
 void ALTIUM_PCB::Parse( const CFB::CompoundFileReader& aReader,
         const std::map<ALTIUM_PCB_DIR, std::string>&   aFileMapping )
 {
+    // the records of the binary streams do not depend on each other nor on the board: they
+    // are decoded in parallel first, then added to the board in the order below.
+    std::vector<ACOMPONENTBODY6> componentBodies;
+    std::vector<AARC6>           arcs;
+    std::vector<APAD6>           pads;
+    std::vector<AVIA6>           vias;
+    std::vector<ATRACK6>         tracks;
+    std::vector<ATEXT6>          texts;
+    std::vector<AFILL6>          fills;
+    std::vector<AREGION6>        boardRegions;
+    std::vector<AREGION6>        shapeBasedRegions;
+    std::vector<AREGION6>        regions;
+
+    const std::vector<std::tuple<ALTIUM_PCB_DIR, PARSE_FUNCTION_POINTER_fp>> decoderList = {
+        { ALTIUM_PCB_DIR::COMPONENTBODIES6,
+                [&]( auto aReader, auto fileHeader ) {
+                    componentBodies = readRecords<ACOMPONENTBODY6>( aReader, fileHeader,
+                                                                    "ComponentsBodies6" );
+                } },
+        { ALTIUM_PCB_DIR::ARCS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    arcs = readRecords<AARC6>( aReader, fileHeader, "Arcs6" );
+                } },
+        { ALTIUM_PCB_DIR::PADS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    pads = readRecords<APAD6>( aReader, fileHeader, "Pads6" );
+                } },
+        { ALTIUM_PCB_DIR::VIAS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    vias = readRecords<AVIA6>( aReader, fileHeader, "Vias6" );
+                } },
+        { ALTIUM_PCB_DIR::TRACKS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    tracks = readRecords<ATRACK6>( aReader, fileHeader, "Tracks6" );
+                } },
+        { ALTIUM_PCB_DIR::TEXTS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    texts = readRecords<ATEXT6>( aReader, fileHeader, "Texts6" );
+                } },
+        { ALTIUM_PCB_DIR::FILLS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    fills = readRecords<AFILL6>( aReader, fileHeader, "Fills6" );
+                } },
+        { ALTIUM_PCB_DIR::BOARDREGIONS,
+                [&]( auto aReader, auto fileHeader ) {
+                    boardRegions = readRecords<AREGION6>( aReader, fileHeader, "BoardRegions",
+                                                          false );
+                } },
+        { ALTIUM_PCB_DIR::SHAPEBASEDREGIONS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    shapeBasedRegions = readRecords<AREGION6>( aReader, fileHeader,
+                                                               "ShapeBasedRegions6", true );
+                } },
+        { ALTIUM_PCB_DIR::REGIONS6,
+                [&]( auto aReader, auto fileHeader ) {
+                    regions = readRecords<AREGION6>( aReader, fileHeader, "Regions6", false );
+                } }
+    };
+
+    // the streams are looked up here, the threads only read them
+    std::vector<std::pair<const CFB::COMPOUND_FILE_ENTRY*, PARSE_FUNCTION_POINTER_fp>> decoders;
+
+    for( const std::tuple<ALTIUM_PCB_DIR, PARSE_FUNCTION_POINTER_fp>& cur : decoderList )
+    {
+        const auto& mappedDirectory = aFileMapping.find( std::get<0>( cur ) );
+
+        if( mappedDirectory == aFileMapping.end() )
+            continue;
+
+        const CFB::COMPOUND_FILE_ENTRY* file =
+                FindStream( aReader, mappedDirectory->second.c_str() );
+
+        if( file != nullptr )
+            decoders.emplace_back( file, std::get<1>( cur ) );
+    }
+
+    std::atomic<size_t> nextDecoder( 0 );
+    size_t parallelThreadCount = std::min<size_t>( std::max<size_t>( 1,
+            std::thread::hardware_concurrency() ), decoders.size() );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        returns[ii] = std::async( std::launch::async, [&]()
+        {
+            for( size_t i = nextDecoder++; i < decoders.size(); i = nextDecoder++ )
+                decoders[i].second( aReader, decoders[i].first );
+        } );
+    }
+
+    // get() rethrows the error of a stream which cannot be decoded
+    for( auto& ret : returns )
+        ret.get();
+
     // this vector simply declares in which order which functions to call.
     const std::vector<std::tuple<bool, ALTIUM_PCB_DIR, PARSE_FUNCTION_POINTER_fp>> parserOrder = {
         { true, ALTIUM_PCB_DIR::FILE_HEADER,
@@ -284,8 +408,8 @@ void ALTIUM_PCB::Parse( const CFB::CompoundFileReader& aReader,
                     this->ParseModelsData( aReader, fileHeader, dir );
                 } },
         { true, ALTIUM_PCB_DIR::COMPONENTBODIES6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseComponentsBodies6Data( aReader, fileHeader );
+                [this, &componentBodies]( auto aReader, auto fileHeader ) {
+                    this->ParseComponentsBodies6Data( aReader, componentBodies );
                 } },
         { true, ALTIUM_PCB_DIR::NETS6,
                 [this]( auto aReader, auto fileHeader ) {
@@ -308,40 +432,40 @@ void ALTIUM_PCB::Parse( const CFB::CompoundFileReader& aReader,
                     this->ParsePolygons6Data( aReader, fileHeader );
                 } },
         { true, ALTIUM_PCB_DIR::ARCS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseArcs6Data( aReader, fileHeader );
+                [this, &arcs]( auto aReader, auto fileHeader ) {
+                    this->ParseArcs6Data( arcs );
                 } },
         { true, ALTIUM_PCB_DIR::PADS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParsePads6Data( aReader, fileHeader );
+                [this, &pads]( auto aReader, auto fileHeader ) {
+                    this->ParsePads6Data( pads );
                 } },
         { true, ALTIUM_PCB_DIR::VIAS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseVias6Data( aReader, fileHeader );
+                [this, &vias]( auto aReader, auto fileHeader ) {
+                    this->ParseVias6Data( vias );
                 } },
         { true, ALTIUM_PCB_DIR::TRACKS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseTracks6Data( aReader, fileHeader );
+                [this, &tracks]( auto aReader, auto fileHeader ) {
+                    this->ParseTracks6Data( tracks );
                 } },
         { true, ALTIUM_PCB_DIR::TEXTS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseTexts6Data( aReader, fileHeader );
+                [this, &texts]( auto aReader, auto fileHeader ) {
+                    this->ParseTexts6Data( texts );
                 } },
         { true, ALTIUM_PCB_DIR::FILLS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseFills6Data( aReader, fileHeader );
+                [this, &fills]( auto aReader, auto fileHeader ) {
+                    this->ParseFills6Data( fills );
                 } },
         { false, ALTIUM_PCB_DIR::BOARDREGIONS,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseBoardRegionsData( aReader, fileHeader );
+                [this, &boardRegions]( auto aReader, auto fileHeader ) {
+                    this->ParseBoardRegionsData( boardRegions );
                 } },
         { true, ALTIUM_PCB_DIR::SHAPEBASEDREGIONS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseShapeBasedRegions6Data( aReader, fileHeader );
+                [this, &shapeBasedRegions]( auto aReader, auto fileHeader ) {
+                    this->ParseShapeBasedRegions6Data( shapeBasedRegions );
                 } },
         { true, ALTIUM_PCB_DIR::REGIONS6,
-                [this]( auto aReader, auto fileHeader ) {
-                    this->ParseRegions6Data( aReader, fileHeader );
+                [this, &regions]( auto aReader, auto fileHeader ) {
+                    this->ParseRegions6Data( regions );
                 } }
     };
 
@@ -742,15 +866,11 @@ void ALTIUM_PCB::ParseComponents6Data(
 }
 
 
-void ALTIUM_PCB::ParseComponentsBodies6Data(
-        const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseComponentsBodies6Data( const CFB::CompoundFileReader& aReader,
+        const std::vector<ACOMPONENTBODY6>& aComponentBodies )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const ACOMPONENTBODY6& elem : aComponentBodies )
     {
-        ACOMPONENTBODY6 elem( reader ); // TODO: implement
-
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
             continue; // TODO: we do not support components for the board yet
@@ -768,12 +888,11 @@ void ALTIUM_PCB::ParseComponentsBodies6Data(
             continue;
         }
 
-        auto modelTuple = m_models.find( elem.modelId );
-        if( modelTuple == m_models.end() )
+        wxString modelPath = HelperExtractModel( aReader, elem.modelId );
+
+        if( modelPath.IsEmpty() )
         {
-            THROW_IO_ERROR( wxString::Format(
-                    "ComponentsBodies6 stream tries to access model id %s which does not exist",
-                    elem.modelId ) );
+            continue;
         }
 
         MODULE*        module         = m_components.at( elem.component );
@@ -781,7 +900,7 @@ void ALTIUM_PCB::ParseComponentsBodies6Data(
 
         MODULE_3D_SETTINGS modelSettings;
 
-        modelSettings.m_Filename = modelTuple->second;
+        modelSettings.m_Filename = modelPath;
 
         modelSettings.m_Offset.x = Iu2Millimeter( (int) elem.modelPosition.x - modulePosition.x );
         modelSettings.m_Offset.y = -Iu2Millimeter( (int) elem.modelPosition.y - modulePosition.y );
@@ -806,11 +925,6 @@ void ALTIUM_PCB::ParseComponentsBodies6Data(
 
         module->Models().push_back( modelSettings );
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "ComponentsBodies6 stream is not fully parsed" );
-    }
 }
 
 
@@ -1075,75 +1189,114 @@ void ALTIUM_PCB::ParseModelsData( const CFB::CompoundFileReader& aReader,
 {
     ALTIUM_PARSER reader( aReader, aEntry );
 
-    if( reader.GetRemainingBytes() == 0 )
+    // The models are only listed here: they are extracted when a component body uses them,
+    // most libraries embed far more models than the board places
+    int idx = 0;
+    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
     {
-        return; // fast path: no 3d-models present which need to be imported -> no directory needs to be created
-    }
-
-    wxString projectPath = wxPathOnly( m_board->GetFileName() );
-    // TODO: set KIPRJMOD always after import (not only when loading project)?
-    wxSetEnv( PROJECT_VAR_NAME, projectPath );
+        AMODEL elem( reader );
 
-    // TODO: make this path configurable?
-    const wxString altiumModelDir = "ALTIUM_EMBEDDED_MODELS";
+        wxString stepPath = aRootDir + std::to_string( idx++ );
 
-    wxFileName altiumModelsPath = wxFileName::DirName( projectPath );
-    wxString   kicadModelPrefix = "${KIPRJMOD}/" + altiumModelDir + "/";
-    if( !altiumModelsPath.AppendDir( altiumModelDir ) )
-    {
-        THROW_IO_ERROR( "Cannot construct directory path for step models" );
+        m_embeddedModels.insert( { elem.id, { elem.name, stepPath.ToStdString() } } );
     }
 
-    // Create dir if it does not exist
-    if( !altiumModelsPath.DirExists() )
+    if( reader.GetRemainingBytes() != 0 )
     {
-        if( !altiumModelsPath.Mkdir() )
-        {
-            wxLogError( wxString::Format(
-                    _( "Cannot create directory \"%s\" -> no 3D-models will be imported." ),
-                    GetChars( altiumModelsPath.GetFullPath() ) ) );
-            return;
-        }
+        THROW_IO_ERROR( "Models stream is not fully parsed" );
     }
+}
 
-    int idx = 0;
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+
+wxString ALTIUM_PCB::HelperExtractModel( const CFB::CompoundFileReader& aReader,
+                                         const wxString& aModelId )
+{
+    auto extracted = m_models.find( aModelId );
+
+    if( extracted != m_models.end() )
+        return extracted->second;
+
+    auto embedded = m_embeddedModels.find( aModelId );
+
+    if( embedded == m_embeddedModels.end() )
     {
-        AMODEL elem( reader );
+        THROW_IO_ERROR( wxString::Format(
+                "ComponentsBodies6 stream tries to access model id %s which does not exist",
+                aModelId ) );
+    }
 
-        wxString stepPath = aRootDir + std::to_string( idx++ );
+    if( m_modelsDirFailed )
+        return wxEmptyString;
 
-        const CFB::COMPOUND_FILE_ENTRY* stepEntry = FindStream( aReader, stepPath.c_str() );
+    // TODO: make this path configurable?
+    const wxString altiumModelDir = "ALTIUM_EMBEDDED_MODELS";
+    wxString       kicadModelPrefix = "${KIPRJMOD}/" + altiumModelDir + "/";
 
-        size_t                  stepSize = static_cast<size_t>( stepEntry->size );
-        std::unique_ptr<char[]> stepContent( new char[stepSize] );
+    if( m_modelsDir.IsEmpty() )
+    {
+        wxString projectPath = wxPathOnly( m_board->GetFileName() );
+        // TODO: set KIPRJMOD always after import (not only when loading project)?
+        wxSetEnv( PROJECT_VAR_NAME, projectPath );
 
-        // read file into buffer
-        aReader.ReadFile( stepEntry, 0, stepContent.get(), stepSize );
+        wxFileName altiumModelsPath = wxFileName::DirName( projectPath );
+        if( !altiumModelsPath.AppendDir( altiumModelDir ) )
+        {
+            THROW_IO_ERROR( "Cannot construct directory path for step models" );
+        }
 
-        wxFileName storagePath( altiumModelsPath.GetPath(), elem.name );
-        if( !storagePath.IsDirWritable() )
+        // Create dir if it does not exist
+        if( !altiumModelsPath.DirExists() )
         {
-            wxLogError(
-                    wxString::Format( _( "You do not have write permissions to save file \"%s\"." ),
-                            GetChars( storagePath.GetFullPath() ) ) );
-            continue;
+            if( !altiumModelsPath.Mkdir() )
+            {
+                wxLogError( wxString::Format(
+                        _( "Cannot create directory \"%s\" -> no 3D-models will be imported." ),
+                        GetChars( altiumModelsPath.GetFullPath() ) ) );
+                m_modelsDirFailed = true;
+                return wxEmptyString;
+            }
         }
 
-        wxMemoryInputStream stepStream( stepContent.get(), stepSize );
-        wxZlibInputStream   zlibInputStream( stepStream );
+        m_modelsDir = altiumModelsPath.GetPath();
+    }
 
-        wxFileOutputStream outputStream( storagePath.GetFullPath() );
-        outputStream.Write( zlibInputStream );
-        outputStream.Close();
+    const wxString& modelName = embedded->second.first;
 
-        m_models.insert( { elem.id, kicadModelPrefix + elem.name } );
+    const CFB::COMPOUND_FILE_ENTRY* stepEntry =
+            FindStream( aReader, embedded->second.second.c_str() );
+
+    if( stepEntry == nullptr )
+    {
+        wxLogError( wxString::Format( _( "File not found: '%s'" ), embedded->second.second ) );
+        return wxEmptyString;
     }
 
-    if( reader.GetRemainingBytes() != 0 )
+    size_t                  stepSize = static_cast<size_t>( stepEntry->size );
+    std::unique_ptr<char[]> stepContent( new char[stepSize] );
+
+    // read file into buffer
+    aReader.ReadFile( stepEntry, 0, stepContent.get(), stepSize );
+
+    wxFileName storagePath( m_modelsDir, modelName );
+    if( !storagePath.IsDirWritable() )
     {
-        THROW_IO_ERROR( "Models stream is not fully parsed" );
+        wxLogError(
+                wxString::Format( _( "You do not have write permissions to save file \"%s\"." ),
+                        GetChars( storagePath.GetFullPath() ) ) );
+        return wxEmptyString;
     }
+
+    wxMemoryInputStream stepStream( stepContent.get(), stepSize );
+    wxZlibInputStream   zlibInputStream( stepStream );
+
+    wxFileOutputStream outputStream( storagePath.GetFullPath() );
+    outputStream.Write( zlibInputStream );
+    outputStream.Close();
+
+    wxString modelPath = kicadModelPrefix + modelName;
+    m_models.insert( { aModelId, modelPath } );
+
+    return modelPath;
 }
 
 
@@ -1310,33 +1463,15 @@ void ALTIUM_PCB::ParseRules6Data(
     }
 }
 
-void ALTIUM_PCB::ParseBoardRegionsData(
-        const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseBoardRegionsData( const std::vector<AREGION6>& aRegions )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
-    {
-        AREGION6 elem( reader, false );
-
-        // TODO: implement?
-    }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "BoardRegions stream is not fully parsed" );
-    }
+    // TODO: implement?
 }
 
-void ALTIUM_PCB::ParseShapeBasedRegions6Data(
-        const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseShapeBasedRegions6Data( const std::vector<AREGION6>& aRegions )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AREGION6& elem : aRegions )
     {
-        AREGION6 elem( reader, true );
-
         if( elem.kind == ALTIUM_REGION_KIND::BOARD_CUTOUT )
         {
             HelperCreateBoardOutline( elem.vertices );
@@ -1415,18 +1550,10 @@ void ALTIUM_PCB::ParseShapeBasedRegions6Data(
                     elem.kind, LSET::Name( GetKicadLayer( elem.layer ) ) ) );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "ShapeBasedRegions6 stream is not fully parsed" );
-    }
 }
 
-void ALTIUM_PCB::ParseRegions6Data(
-        const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseRegions6Data( const std::vector<AREGION6>& aRegions )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
     for( ZONE_CONTAINER* zone : m_polygons )
     {
         if( zone != nullptr )
@@ -1435,11 +1562,9 @@ void ALTIUM_PCB::ParseRegions6Data(
         }
     }
 
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
-    {
-        AREGION6 elem( reader, false );
-
 #if 0 // TODO: it seems this code has multiple issues right now, and we can manually fill anyways
+    for( const AREGION6& elem : aRegions )
+    {
         if( elem.subpolyindex != ALTIUM_POLYGON_NONE )
         {
             if( m_polygons.size() <= elem.subpolyindex )
@@ -1471,25 +1596,15 @@ void ALTIUM_PCB::ParseRegions6Data(
             zone->SetFilledPolysList( polyset );
             zone->SetIsFilled( true );
         }
-#endif
-    }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "Regions6 stream is not fully parsed" );
     }
+#endif
 }
 
 
-void ALTIUM_PCB::ParseArcs6Data( const CFB::CompoundFileReader& aReader,
-                                 const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseArcs6Data( const std::vector<AARC6>& aArcs )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AARC6& elem : aArcs )
     {
-        AARC6 elem( reader );
-
         if( elem.is_polygonoutline || elem.subpolyindex != ALTIUM_POLYGON_NONE )
             continue;
 
@@ -1590,23 +1705,13 @@ void ALTIUM_PCB::ParseArcs6Data( const CFB::CompoundFileReader& aReader,
             HelperDrawsegmentSetLocalCoord( shape, elem.component );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "Arcs6 stream is not fully parsed" );
-    }
 }
 
 
-void ALTIUM_PCB::ParsePads6Data( const CFB::CompoundFileReader& aReader,
-                                 const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParsePads6Data( const std::vector<APAD6>& aPads )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const APAD6& elem : aPads )
     {
-        APAD6 elem( reader );
-
         // It is possible to place altium pads on non-copper layers -> we need to interpolate them using drawings!
         if( !IsAltiumLayerCopper( elem.layer ) && !IsAltiumLayerAPlane( elem.layer )
                 && elem.layer != ALTIUM_LAYER::MULTI_LAYER )
@@ -1804,11 +1909,6 @@ void ALTIUM_PCB::ParsePads6Data( const CFB::CompoundFileReader& aReader,
             pad->SetLayerSet( pad->GetLayerSet().reset( B_Mask ) );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "Pads6 stream is not fully parsed" );
-    }
 }
 
 
@@ -1994,15 +2094,10 @@ void ALTIUM_PCB::HelperParsePad6NonCopper( const APAD6& aElem )
     }
 }
 
-void ALTIUM_PCB::ParseVias6Data( const CFB::CompoundFileReader& aReader,
-                                 const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseVias6Data( const std::vector<AVIA6>& aVias )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AVIA6& elem : aVias )
     {
-        AVIA6 elem( reader );
-
         VIA* via = new VIA( m_board );
         m_board->Add( via, ADD_MODE::APPEND );
 
@@ -2043,22 +2138,12 @@ void ALTIUM_PCB::ParseVias6Data( const CFB::CompoundFileReader& aReader,
         // we need VIATYPE set!
         via->SetLayerPair( start_klayer, end_klayer );
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "Vias6 stream is not fully parsed" );
-    }
 }
 
-void ALTIUM_PCB::ParseTracks6Data( const CFB::CompoundFileReader& aReader,
-                                   const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseTracks6Data( const std::vector<ATRACK6>& aTracks )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const ATRACK6& elem : aTracks )
     {
-        ATRACK6 elem( reader );
-
         if( elem.is_polygonoutline || elem.subpolyindex != ALTIUM_POLYGON_NONE )
             continue;
 
@@ -2122,25 +2207,13 @@ void ALTIUM_PCB::ParseTracks6Data( const CFB::CompoundFileReader& aReader,
             shape->SetLayer( klayer );
             HelperDrawsegmentSetLocalCoord( shape, elem.component );
         }
-
-        reader.SkipSubrecord();
-    }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "Tracks6 stream is not fully parsed" );
     }
 }
 
-void ALTIUM_PCB::ParseTexts6Data(
-        const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseTexts6Data( const std::vector<ATEXT6>& aTexts )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const ATEXT6& elem : aTexts )
     {
-        ATEXT6 elem( reader );
-
         if( elem.fonttype == ALTIUM_TEXT_TYPE::BARCODE )
         {
             wxLogWarning( wxString::Format(
@@ -2305,22 +2378,12 @@ void ALTIUM_PCB::ParseTexts6Data(
             }
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "Texts6 stream is not fully parsed" );
-    }
 }
 
-void ALTIUM_PCB::ParseFills6Data(
-        const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry )
+void ALTIUM_PCB::ParseFills6Data( const std::vector<AFILL6>& aFills )
 {
-    ALTIUM_PARSER reader( aReader, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AFILL6& elem : aFills )
     {
-        AFILL6 elem( reader );
-
         wxPoint p11( elem.pos1.x, elem.pos1.y );
         wxPoint p12( elem.pos1.x, elem.pos2.y );
         wxPoint p22( elem.pos2.x, elem.pos2.y );
@@ -2388,9 +2451,4 @@ void ALTIUM_PCB::ParseFills6Data(
                 shape->Rotate( center, elem.rotation * 10 );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-    {
-        THROW_IO_ERROR( "Fills6 stream is not fully parsed" );
-    }
 }
@@ -147,27 +147,18 @@ private:
     void ParseRules6Data(
             const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
 
-    // Binary Format
-    void ParseArcs6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseComponentsBodies6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParsePads6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseVias6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseTracks6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseTexts6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseFills6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseBoardRegionsData(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseShapeBasedRegions6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
-    void ParseRegions6Data(
-            const CFB::CompoundFileReader& aReader, const CFB::COMPOUND_FILE_ENTRY* aEntry );
+    // Binary Format, the records are decoded in parallel before being added to the board
+    void ParseArcs6Data( const std::vector<AARC6>& aArcs );
+    void ParseComponentsBodies6Data( const CFB::CompoundFileReader& aReader,
+            const std::vector<ACOMPONENTBODY6>& aComponentBodies );
+    void ParsePads6Data( const std::vector<APAD6>& aPads );
+    void ParseVias6Data( const std::vector<AVIA6>& aVias );
+    void ParseTracks6Data( const std::vector<ATRACK6>& aTracks );
+    void ParseTexts6Data( const std::vector<ATEXT6>& aTexts );
+    void ParseFills6Data( const std::vector<AFILL6>& aFills );
+    void ParseBoardRegionsData( const std::vector<AREGION6>& aRegions );
+    void ParseShapeBasedRegions6Data( const std::vector<AREGION6>& aRegions );
+    void ParseRegions6Data( const std::vector<AREGION6>& aRegions );
 
     // Helper Functions
     void HelperParseDimensions6Linear( const ADIMENSION6& aElem );
@@ -179,19 +170,32 @@ private:
 
     void HelperCreateBoardOutline( const std::vector<ALTIUM_VERTICE>& aVertices );
 
+    /**
+     * Extracts an embedded model to the models directory of the project, the first time a
+     * component body uses it.
+     *
+     * @return the path of the model in the board, or an empty string if it cannot be extracted.
+     */
+    wxString HelperExtractModel( const CFB::CompoundFileReader& aReader, const wxString& aModelId );
+
     PCB_SHAPE* HelperCreateAndAddDrawsegment( uint16_t aComponent );
     void HelperDrawsegmentSetLocalCoord( PCB_SHAPE* aShape, uint16_t aComponent );
 
     BOARD*                               m_board;
     std::vector<MODULE*>                 m_components;
     std::vector<ZONE_CONTAINER*>         m_polygons;
-    std::map<wxString, wxString>         m_models;
+    std::map<wxString, wxString>         m_models;  // model id -> path, once extracted
     size_t                               m_num_nets;
     std::map<ALTIUM_LAYER, PCB_LAYER_ID> m_layermap; // used to correctly map copper layers
     std::map<ALTIUM_RULE_KIND, std::vector<ARULE6>> m_rules;
 
     std::map<ALTIUM_LAYER, ZONE_CONTAINER*> m_outer_plane;
 
+    /// Embedded models, by id: their file name and their stream, extracted only when used
+    std::map<wxString, std::pair<wxString, std::string>> m_embeddedModels;
+    wxString                                             m_modelsDir; // empty until created
+    bool                                                 m_modelsDirFailed;
+
     /// Altium stores pour order across all layers
     int m_highest_pour_index;
 };
@@ -33,6 +33,9 @@ void CADSTAR_PCB_ARCHIVE_PARSER::Parse()
 
     XNODE* cNode = fileRootNode->GetChildren();
 
+    // The sections after the header are independent: they are parsed concurrently
+    std::vector<std::function<void()>> sectionParsers;
+
     if( !cNode )
         THROW_MISSING_NODE_IO_ERROR( wxT( "HEADER" ), wxT( "CADSTARPCB" ) );
 
@@ -71,11 +74,11 @@ void CADSTAR_PCB_ARCHIVE_PARSER::Parse()
         }
         else if( cNode->GetName() == wxT( "ASSIGNMENTS" ) )
         {
-            Assignments.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Assignments.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "LIBRARY" ) )
         {
-            Library.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Library.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "DEFAULTS" ) )
         {
@@ -85,11 +88,11 @@ void CADSTAR_PCB_ARCHIVE_PARSER::Parse()
         }
         else if( cNode->GetName() == wxT( "PARTS" ) )
         {
-            Parts.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Parts.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "LAYOUT" ) )
         {
-            Layout.Parse( cNode );
+            sectionParsers.push_back( [this, cNode]() { Layout.Parse( cNode ); } );
         }
         else if( cNode->GetName() == wxT( "DISPLAY" ) )
         {
@@ -103,6 +106,8 @@ void CADSTAR_PCB_ARCHIVE_PARSER::Parse()
         }
     }
 
+    ParseConcurrently( sectionParsers );
+
     delete fileRootNode;
 }
 
@@ -72,6 +72,7 @@ Load() TODO's
 #include <class_dimension.h>
 
 #include <plugins/eagle/eagle_plugin.h>
+#include <plugins/eagle/eagle_xml_reader.h>
 
 using namespace std;
 
@@ -309,10 +310,13 @@ wxSize inline EAGLE_PLUGIN::kicad_fontz( const ECOORD& d, int aTextThickness ) c
 BOARD* EAGLE_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,  const PROPERTIES* aProperties )
 {
     LOCALE_IO       toggle;     // toggles on, then off, the C locale.
-    wxXmlNode*      doc;
 
     init( aProperties );
 
+    // The templates are made from the packages of this board
+    deleteTemplates();
+    m_lib_path.clear();
+
     m_board = aAppendToMe ? aAppendToMe : new BOARD();
 
     // Give the filename to the board if it's new
@@ -324,22 +328,14 @@ BOARD* EAGLE_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,  const
 
     try
     {
-        // Load the document
-        wxXmlDocument xmlDocument;
         wxFileName fn = aFileName;
 
-        if( !xmlDocument.Load( fn.GetFullPath() ) )
-            THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ),
-                                              fn.GetFullPath() ) );
-
-        doc = xmlDocument.GetRoot();
-
         m_min_trace    = INT_MAX;
         m_min_hole     = INT_MAX;
         m_min_via      = INT_MAX;
         m_min_annulus  = INT_MAX;
 
-        loadAllSections( doc );
+        loadAllSections( fn.GetFullPath() );
 
         BOARD_DESIGN_SETTINGS& designSettings = m_board->GetDesignSettings();
 
@@ -407,6 +403,7 @@ void EAGLE_PLUGIN::init( const PROPERTIES* aProperties )
     m_min_annulus = 0;
     m_xpath->clear();
     m_pads_to_nets.clear();
+    m_packages.clear();
 
     m_board = NULL;
     m_props = aProperties;
@@ -426,51 +423,78 @@ void EAGLE_PLUGIN::clear_cu_map()
 }
 
 
-void EAGLE_PLUGIN::loadAllSections( wxXmlNode* aDoc )
+void EAGLE_PLUGIN::loadAllSections( const wxString& aFileName )
 {
-    wxXmlNode* drawing       = MapChildren( aDoc )["drawing"];
-    NODE_MAP drawingChildren = MapChildren( drawing );
+    // The file is parsed as a stream, and each section is converted as soon as it has been
+    // read, so the XML document is never held in full.  The <elements> need the nets of the
+    // <signals> which follow them, so they are kept until the end along with the <libraries>
+    // holding their packages.
+    std::unique_ptr<wxXmlNode> libraries;
+    std::unique_ptr<wxXmlNode> elements;
+    int                        netCode = 1;
 
-    wxXmlNode* board         = drawingChildren["board"];
-    NODE_MAP boardChildren   = MapChildren( board );
+    EAGLE_XML_READER reader;
 
     m_xpath->push( "eagle.drawing" );
 
-    {
-        m_xpath->push( "board" );
-
-        wxXmlNode* designrules = boardChildren["designrules"];
-        loadDesignRules( designrules );
+    reader.AddHandler( "eagle/drawing/layers",
+            [&]( std::unique_ptr<wxXmlNode> aLayers )
+            {
+                m_xpath->push( "layers" );
+                loadLayerDefs( aLayers.get() );
+                m_xpath->pop();
+            } );
 
-        m_xpath->pop();
-    }
+    reader.AddHandler( "eagle/drawing/board/plain",
+            [&]( std::unique_ptr<wxXmlNode> aPlain )
+            {
+                m_xpath->push( "board" );
+                loadPlain( aPlain.get() );
+                m_xpath->pop();
+            } );
 
-    {
-        m_xpath->push( "layers" );
+    reader.AddHandler( "eagle/drawing/board/libraries",
+            [&]( std::unique_ptr<wxXmlNode> aLibraries )
+            {
+                m_xpath->push( "board" );
+                loadLibraries( aLibraries.get() );
+                m_xpath->pop();
 
-        wxXmlNode* layers = drawingChildren["layers"];
-        loadLayerDefs( layers );
+                libraries = std::move( aLibraries );
+            } );
 
-        m_xpath->pop();
-    }
-
-    {
-        m_xpath->push( "board" );
+    reader.AddHandler( "eagle/drawing/board/designrules",
+            [&]( std::unique_ptr<wxXmlNode> aDesignRules )
+            {
+                m_xpath->push( "board" );
+                loadDesignRules( aDesignRules.get() );
+                m_xpath->pop();
+            } );
 
-        wxXmlNode* plain = boardChildren["plain"];
-        loadPlain( plain );
+    reader.AddHandler( "eagle/drawing/board/elements",
+            [&]( std::unique_ptr<wxXmlNode> aElements )
+            {
+                elements = std::move( aElements );
+            } );
 
-        wxXmlNode*  signals = boardChildren["signals"];
-        loadSignals( signals );
+    reader.AddHandler( "eagle/drawing/board/signals/signal",
+            [&]( std::unique_ptr<wxXmlNode> aSignal )
+            {
+                m_xpath->push( "board" );
+                m_xpath->push( "signals.signal", "name" );
+                loadSignal( aSignal.get(), netCode );
+                m_xpath->pop();
+                m_xpath->pop();
+            } );
 
-        wxXmlNode*  libs = boardChildren["libraries"];
-        loadLibraries( libs );
+    reader.Read( aFileName );
 
-        wxXmlNode* elems = boardChildren["elements"];
-        loadElements( elems );
+    m_xpath->push( "board" );
+    loadElements( elements.get() );
+    m_xpath->pop();
 
-        m_xpath->pop();     // "board"
-    }
+    // The templates were made from the packages used by the elements
+    m_packages.clear();
 
     m_xpath->pop();     // "eagle.drawing"
 }
@@ -918,9 +942,10 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
 
     m_xpath->push( "packages" );
 
-    // Create a MODULE for all the eagle packages, for use later via a copy constructor
-    // to instantiate needed MODULES in our BOARD.  Save the MODULE templates in
-    // a MODULE_MAP using a single lookup key consisting of libname+pkgname.
+    // The packages are only registered here: a MODULE is made for a package when an element
+    // uses it, for use later via a copy constructor to instantiate needed MODULES in our BOARD.
+    // The MODULE templates are saved in a MODULE_MAP using a single lookup key consisting of
+    // libname+pkgname.
 
     // Get the first package and iterate
     wxXmlNode* package = packages->GetChildren();
@@ -936,10 +961,7 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
 
         wxString key = aLibName ? makeKey( *aLibName, pack_ref ) : pack_ref;
 
-        MODULE* m = makeModule( package, pack_ref );
-
-        // add the templating MODULE to the MODULE template factory "m_templates"
-        std::pair<MODULE_ITER, bool> r = m_templates.insert( {key, m} );
+        std::pair<NODE_MAP::iterator, bool> r = m_packages.insert( { key, package } );
 
         if( !r.second /* && !( m_props && m_props->Value( "ignore_duplicates" ) ) */ )
         {
@@ -963,6 +985,35 @@ void EAGLE_PLUGIN::loadLibrary( wxXmlNode* aLib, const wxString* aLibName )
 }
 
 
+MODULE* EAGLE_PLUGIN::findTemplate( const wxString& aKey )
+{
+    MODULE_CITER mi = m_templates.find( aKey );
+
+    if( mi != m_templates.end() )
+        return mi->second;
+
+    NODE_MAP::const_iterator pi = m_packages.find( aKey );
+
+    if( pi == m_packages.end() )
+        return nullptr;
+
+    m_xpath->push( "package", "name" );
+
+    wxString pack_ref = pi->second->GetAttribute( "name" );
+    ReplaceIllegalFileNameChars( pack_ref, '_' );
+
+    m_xpath->Value( pack_ref.ToUTF8() );
+
+    // add the templating MODULE to the MODULE template factory "m_templates"
+    MODULE* m = makeModule( pi->second, pack_ref );
+    m_templates[aKey] = m;
+
+    m_xpath->pop();
+
+    return m;
+}
+
+
 void EAGLE_PLUGIN::loadLibraries( wxXmlNode* aLibs )
 {
     if( !aLibs )
@@ -1020,9 +1071,9 @@ void EAGLE_PLUGIN::loadElements( wxXmlNode* aElements )
 
         wxString pkg_key = makeKey( e.library, e.package );
 
-        MODULE_CITER mi = m_templates.find( pkg_key );
+        MODULE* tmpl = findTemplate( pkg_key );
 
-        if( mi == m_templates.end() )
+        if( !tmpl )
         {
             wxString emsg = wxString::Format( _( "No \"%s\" package in library \"%s\"" ),
                                               GetChars( FROM_UTF8( e.package.c_str() ) ),
@@ -1031,7 +1082,7 @@ void EAGLE_PLUGIN::loadElements( wxXmlNode* aElements )
         }
 
         // copy constructor to clone the template
-        MODULE* m = new MODULE( *mi->second );
+        MODULE* m = new MODULE( *tmpl );
         const_cast<KIID&>( m->m_Uuid ) = KIID();
 
         m_board->Add( m, ADD_MODE::APPEND );
@@ -2215,236 +2266,218 @@ void EAGLE_PLUGIN::deleteTemplates()
 }
 
 
-void EAGLE_PLUGIN::loadSignals( wxXmlNode* aSignals )
+void EAGLE_PLUGIN::loadSignal( wxXmlNode* aSignal, int& aNetCode )
 {
     ZONES zones;      // per net
+    bool  sawPad = false;
 
-    m_xpath->push( "signals.signal", "name" );
+    const wxString& netName = escapeName( aSignal->GetAttribute( "name" ) );
+    m_board->Add( new NETINFO_ITEM( m_board, netName, aNetCode ) );
 
-    int netCode = 1;
+    m_xpath->Value( netName.c_str() );
 
-    // Get the first signal and iterate
-    wxXmlNode* net = aSignals->GetChildren();
+    // Get the first net item and iterate
+    wxXmlNode* netItem = aSignal->GetChildren();
 
-    while( net )
+    // (contactref | polygon | wire | via)*
+    while( netItem )
     {
-        bool    sawPad = false;
-
-        zones.clear();
-
-        const wxString& netName = escapeName( net->GetAttribute( "name" ) );
-        m_board->Add( new NETINFO_ITEM( m_board, netName, netCode ) );
+        const wxString& itemName = netItem->GetName();
 
-        m_xpath->Value( netName.c_str() );
-
-        // Get the first net item and iterate
-        wxXmlNode* netItem = net->GetChildren();
-
-        // (contactref | polygon | wire | via)*
-        while( netItem )
+        if( itemName == "wire" )
         {
-            const wxString& itemName = netItem->GetName();
-
-            if( itemName == "wire" )
-            {
-                m_xpath->push( "wire" );
+            m_xpath->push( "wire" );
 
-                EWIRE        w( netItem );
-                PCB_LAYER_ID layer = kicad_layer( w.layer );
+            EWIRE        w( netItem );
+            PCB_LAYER_ID layer = kicad_layer( w.layer );
 
-                if( IsCopperLayer( layer ) )
+            if( IsCopperLayer( layer ) )
+            {
+                wxPoint start( kicad_x( w.x1 ), kicad_y( w.y1 ) );
+                double angle = 0.0;
+                double end_angle = 0.0;
+                double radius = 0.0;
+                double delta_angle = 0.0;
+                wxPoint center;
+
+                int width = w.width.ToPcbUnits();
+                if( width < m_min_trace )
+                    m_min_trace = width;
+
+                if( w.curve )
                 {
-                    wxPoint start( kicad_x( w.x1 ), kicad_y( w.y1 ) );
-                    double angle = 0.0;
-                    double end_angle = 0.0;
-                    double radius = 0.0;
-                    double delta_angle = 0.0;
-                    wxPoint center;
-
-                    int width = w.width.ToPcbUnits();
-                    if( width < m_min_trace )
-                        m_min_trace = width;
-
-                    if( w.curve )
-                    {
-                        center = ConvertArcCenter(
-                                wxPoint( kicad_x( w.x1 ), kicad_y( w.y1 ) ),
-                                wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ),
-                                *w.curve );
-
-                        angle = DEG2RAD( *w.curve );
-
-                        end_angle = atan2( kicad_y( w.y2 ) - center.y,
-                                           kicad_x( w.x2 ) - center.x );
-
-                        radius = sqrt( pow( center.x - kicad_x( w.x1 ), 2 ) +
-                                       pow( center.y - kicad_y( w.y1 ), 2 ) );
+                    center = ConvertArcCenter(
+                            wxPoint( kicad_x( w.x1 ), kicad_y( w.y1 ) ),
+                            wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ),
+                            *w.curve );
 
-                        int segs = GetArcToSegmentCount( KiROUND( radius ), ARC_HIGH_DEF, *w.curve );
-                        delta_angle = angle / segs;
-                    }
-
-                    while( fabs( angle ) > fabs( delta_angle ) )
-                    {
-                        wxASSERT( radius > 0.0 );
-                        wxPoint end( KiROUND( radius * cos( end_angle + angle ) + center.x ),
-                                     KiROUND( radius * sin( end_angle + angle ) + center.y ) );
+                    angle = DEG2RAD( *w.curve );
 
-                        TRACK*  t = new TRACK( m_board );
+                    end_angle = atan2( kicad_y( w.y2 ) - center.y,
+                                       kicad_x( w.x2 ) - center.x );
 
-                        t->SetPosition( start );
-                        t->SetEnd( end );
-                        t->SetWidth( width );
-                        t->SetLayer( layer );
-                        t->SetNetCode( netCode );
+                    radius = sqrt( pow( center.x - kicad_x( w.x1 ), 2 ) +
+                                   pow( center.y - kicad_y( w.y1 ), 2 ) );
 
-                        m_board->Add( t );
+                    int segs = GetArcToSegmentCount( KiROUND( radius ), ARC_HIGH_DEF, *w.curve );
+                    delta_angle = angle / segs;
+                }
 
-                        start = end;
-                        angle -= delta_angle;
-                    }
+                while( fabs( angle ) > fabs( delta_angle ) )
+                {
+                    wxASSERT( radius > 0.0 );
+                    wxPoint end( KiROUND( radius * cos( end_angle + angle ) + center.x ),
+                                 KiROUND( radius * sin( end_angle + angle ) + center.y ) );
 
                     TRACK*  t = new TRACK( m_board );
 
                     t->SetPosition( start );
-                    t->SetEnd( wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ) );
+                    t->SetEnd( end );
                     t->SetWidth( width );
                     t->SetLayer( layer );
-                    t->SetNetCode( netCode );
+                    t->SetNetCode( aNetCode );
 
                     m_board->Add( t );
-                }
-                else
-                {
-                    // put non copper wires where the sun don't shine.
+
+                    start = end;
+                    angle -= delta_angle;
                 }
 
-                m_xpath->pop();
-            }
+                TRACK*  t = new TRACK( m_board );
+
+                t->SetPosition( start );
+                t->SetEnd( wxPoint( kicad_x( w.x2 ), kicad_y( w.y2 ) ) );
+                t->SetWidth( width );
+                t->SetLayer( layer );
+                t->SetNetCode( aNetCode );
 
-            else if( itemName == "via" )
+                m_board->Add( t );
+            }
+            else
             {
-                m_xpath->push( "via" );
-                EVIA    v( netItem );
+                // put non copper wires where the sun don't shine.
+            }
 
-                PCB_LAYER_ID  layer_front_most = kicad_layer( v.layer_front_most );
-                PCB_LAYER_ID  layer_back_most  = kicad_layer( v.layer_back_most );
+            m_xpath->pop();
+        }
 
-                if( IsCopperLayer( layer_front_most ) &&
-                    IsCopperLayer( layer_back_most ) )
-                {
-                    int  kidiam;
-                    int  drillz = v.drill.ToPcbUnits();
-                    VIA* via = new VIA( m_board );
-                    m_board->Add( via );
+        else if( itemName == "via" )
+        {
+            m_xpath->push( "via" );
+            EVIA    v( netItem );
 
-                    via->SetLayerPair( layer_front_most, layer_back_most );
+            PCB_LAYER_ID  layer_front_most = kicad_layer( v.layer_front_most );
+            PCB_LAYER_ID  layer_back_most  = kicad_layer( v.layer_back_most );
 
-                    if( v.diam )
-                    {
-                        kidiam = v.diam->ToPcbUnits();
-                        via->SetWidth( kidiam );
-                    }
-                    else
-                    {
-                        double annulus = drillz * m_rules->rvViaOuter;  // eagle "restring"
-                        annulus = eagleClamp( m_rules->rlMinViaOuter, annulus,
-                                              m_rules->rlMaxViaOuter );
-                        kidiam = KiROUND( drillz + 2 * annulus );
-                        via->SetWidth( kidiam );
-                    }
+            if( IsCopperLayer( layer_front_most ) &&
+                IsCopperLayer( layer_back_most ) )
+            {
+                int  kidiam;
+                int  drillz = v.drill.ToPcbUnits();
+                VIA* via = new VIA( m_board );
+                m_board->Add( via );
 
-                    via->SetDrill( drillz );
+                via->SetLayerPair( layer_front_most, layer_back_most );
 
-                    // make sure the via diameter respects the restring rules
+                if( v.diam )
+                {
+                    kidiam = v.diam->ToPcbUnits();
+                    via->SetWidth( kidiam );
+                }
+                else
+                {
+                    double annulus = drillz * m_rules->rvViaOuter;  // eagle "restring"
+                    annulus = eagleClamp( m_rules->rlMinViaOuter, annulus,
+                                          m_rules->rlMaxViaOuter );
+                    kidiam = KiROUND( drillz + 2 * annulus );
+                    via->SetWidth( kidiam );
+                }
 
-                    if( !v.diam || via->GetWidth() <= via->GetDrill() )
-                    {
-                        double annulus = eagleClamp( m_rules->rlMinViaOuter,
-                                (double)( via->GetWidth() / 2 - via->GetDrill() ),
-                                m_rules->rlMaxViaOuter );
-                        via->SetWidth( drillz + 2 * annulus );
-                    }
+                via->SetDrill( drillz );
 
-                    if( kidiam < m_min_via )
-                        m_min_via = kidiam;
+                // make sure the via diameter respects the restring rules
 
-                    if( drillz < m_min_hole )
-                        m_min_hole = drillz;
+                if( !v.diam || via->GetWidth() <= via->GetDrill() )
+                {
+                    double annulus = eagleClamp( m_rules->rlMinViaOuter,
+                            (double)( via->GetWidth() / 2 - via->GetDrill() ),
+                            m_rules->rlMaxViaOuter );
+                    via->SetWidth( drillz + 2 * annulus );
+                }
 
-                    if( ( kidiam - drillz ) / 2 < m_min_annulus )
-                        m_min_annulus = ( kidiam - drillz ) / 2;
+                if( kidiam < m_min_via )
+                    m_min_via = kidiam;
 
-                    if( layer_front_most == F_Cu && layer_back_most == B_Cu )
-                        via->SetViaType( VIATYPE::THROUGH );
-                    else if( layer_front_most == F_Cu || layer_back_most == B_Cu )
-                        via->SetViaType( VIATYPE::MICROVIA );
-                    else
-                        via->SetViaType( VIATYPE::BLIND_BURIED );
+                if( drillz < m_min_hole )
+                    m_min_hole = drillz;
+
+                if( ( kidiam - drillz ) / 2 < m_min_annulus )
+                    m_min_annulus = ( kidiam - drillz ) / 2;
 
-                    wxPoint pos( kicad_x( v.x ), kicad_y( v.y ) );
+                if( layer_front_most == F_Cu && layer_back_most == B_Cu )
+                    via->SetViaType( VIATYPE::THROUGH );
+                else if( layer_front_most == F_Cu || layer_back_most == B_Cu )
+                    via->SetViaType( VIATYPE::MICROVIA );
+                else
+                    via->SetViaType( VIATYPE::BLIND_BURIED );
 
-                    via->SetPosition( pos  );
-                    via->SetEnd( pos );
+                wxPoint pos( kicad_x( v.x ), kicad_y( v.y ) );
 
-                    via->SetNetCode( netCode );
-                }
+                via->SetPosition( pos  );
+                via->SetEnd( pos );
 
-                m_xpath->pop();
+                via->SetNetCode( aNetCode );
             }
 
-            else if( itemName == "contactref" )
-            {
-                m_xpath->push( "contactref" );
-                // <contactref element="RN1" pad="7"/>
+            m_xpath->pop();
+        }
 
-                const wxString& reference = netItem->GetAttribute( "element" );
-                const wxString& pad       = netItem->GetAttribute( "pad" );
-                wxString key = makeKey( reference, pad ) ;
+        else if( itemName == "contactref" )
+        {
+            m_xpath->push( "contactref" );
+            // <contactref element="RN1" pad="7"/>
 
-                m_pads_to_nets[ key ] = ENET( netCode, netName );
+            const wxString& reference = netItem->GetAttribute( "element" );
+            const wxString& pad       = netItem->GetAttribute( "pad" );
+            wxString key = makeKey( reference, pad ) ;
 
-                m_xpath->pop();
+            m_pads_to_nets[ key ] = ENET( aNetCode, netName );
 
-                sawPad = true;
-            }
+            m_xpath->pop();
 
-            else if( itemName == "polygon" )
-            {
-                m_xpath->push( "polygon" );
-                auto* zone = loadPolygon( netItem );
+            sawPad = true;
+        }
 
-                if( zone )
-                {
-                    zones.push_back( zone );
+        else if( itemName == "polygon" )
+        {
+            m_xpath->push( "polygon" );
+            auto* zone = loadPolygon( netItem );
 
-                    if( !zone->GetIsRuleArea() )
-                        zone->SetNetCode( netCode );
-                }
+            if( zone )
+            {
+                zones.push_back( zone );
 
-                m_xpath->pop();     // "polygon"
+                if( !zone->GetIsRuleArea() )
+                    zone->SetNetCode( aNetCode );
             }
 
-            netItem = netItem->GetNext();
+            m_xpath->pop();     // "polygon"
         }
 
-        if( zones.size() && !sawPad )
-        {
-            // KiCad does not support an unconnected zone with its own non-zero netcode,
-            // but only when assigned netcode = 0 w/o a name...
-            for( ZONE_CONTAINER* zone : zones )
-                zone->SetNetCode( NETINFO_LIST::UNCONNECTED );
+        netItem = netItem->GetNext();
+    }
 
-            // therefore omit this signal/net.
-        }
-        else
-            netCode++;
+    if( zones.size() && !sawPad )
+    {
+        // KiCad does not support an unconnected zone with its own non-zero netcode,
+        // but only when assigned netcode = 0 w/o a name...
+        for( ZONE_CONTAINER* zone : zones )
+            zone->SetNetCode( NETINFO_LIST::UNCONNECTED );
 
-        // Get next signal
-        net = net->GetNext();
+        // therefore omit this signal/net.
     }
-
-    m_xpath->pop();     // "signals.signal"
+    else
+        aNetCode++;
 }
 
 
@@ -2582,10 +2615,10 @@ void EAGLE_PLUGIN::cacheLib( const wxString& aLibPath )
 
         if( aLibPath != m_lib_path || load )
         {
-            wxXmlNode*  doc;
             LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
             deleteTemplates();
+            m_packages.clear();
 
             // Set this before completion of loading, since we rely on it for
             // text of an exception.  Delay setting m_mod_time until after successful load
@@ -2597,31 +2630,36 @@ void EAGLE_PLUGIN::cacheLib( const wxString& aLibPath )
             // and is not necessarily utf8.
             string filename = (const char*) aLibPath.char_str( wxConvFile );
 
-            // Load the document
-            wxXmlDocument xmlDocument;
             wxFileName fn( filename );
 
-            if( !xmlDocument.Load( fn.GetFullPath() ) )
-                THROW_IO_ERROR( wxString::Format( _( "Unable to read file \"%s\"" ),
-                                                  fn.GetFullPath() ) );
+            // clear the cu map and then rebuild it.
+            clear_cu_map();
+
+            EAGLE_XML_READER reader;
 
-            doc = xmlDocument.GetRoot();
+            reader.AddHandler( "eagle/drawing/layers",
+                    [&]( std::unique_ptr<wxXmlNode> aLayers )
+                    {
+                        m_xpath->push( "eagle.drawing.layers" );
+                        loadLayerDefs( aLayers.get() );
+                        m_xpath->pop();
+                    } );
 
-            wxXmlNode* drawing       = MapChildren( doc )["drawing"];
-            NODE_MAP drawingChildren = MapChildren( drawing );
+            reader.AddHandler( "eagle/drawing/library",
+                    [&]( std::unique_ptr<wxXmlNode> aLibrary )
+                    {
+                        m_xpath->push( "eagle.drawing.library" );
+                        loadLibrary( aLibrary.get(), NULL );
 
-            // clear the cu map and then rebuild it.
-            clear_cu_map();
+                        // All the footprints of a library are listed: make all the templates
+                        for( const std::pair<const wxString, wxXmlNode*>& package : m_packages )
+                            findTemplate( package.first );
 
-            m_xpath->push( "eagle.drawing.layers" );
-            wxXmlNode* layers  = drawingChildren["layers"];
-            loadLayerDefs( layers );
-            m_xpath->pop();
+                        m_packages.clear();
+                        m_xpath->pop();
+                    } );
 
-            m_xpath->push( "eagle.drawing.library" );
-            wxXmlNode* library = drawingChildren["library"];
-            loadLibrary( library, NULL );
-            m_xpath->pop();
+            reader.Read( fn.GetFullPath() );
 
             m_mod_time = modtime;
         }
@@ -184,6 +184,9 @@ private:
                                     ///< lookup key is either libname.packagename or simply
                                     ///< packagename if FootprintLoad() or FootprintEnumberate()
 
+    NODE_MAP    m_packages;         ///< the package nodes of the loaded document, by the keys
+                                    ///< of m_templates: a template is made on first use
+
     const PROPERTIES* m_props;            ///< passed via Save() or Load(), no ownership, may be NULL.
     BOARD*      m_board;            ///< which BOARD is being worked on, no ownership here
 
@@ -221,11 +224,25 @@ private:
 
     // all these loadXXX() throw IO_ERROR or ptree_error exceptions:
 
-    void loadAllSections( wxXmlNode* aDocument );
+    /**
+     * Function loadAllSections
+     * reads a board file as a stream, and loads each section of the board as soon as it
+     * has been read.
+     * @param aFileName is the name of the board file.
+     */
+    void loadAllSections( const wxString& aFileName );
     void loadDesignRules( wxXmlNode* aDesignRules );
     void loadLayerDefs( wxXmlNode* aLayers );
     void loadPlain( wxXmlNode* aPlain );
-    void loadSignals( wxXmlNode* aSignals );
+
+    /**
+     * Function loadSignal
+     * loads the net of an Eagle "signal" XML element, with its tracks, vias and zones.
+     * @param aSignal is the "signal" element.
+     * @param aNetCode is the net code to give to the signal, it is incremented when the
+     *   signal makes a net.
+     */
+    void loadSignal( wxXmlNode* aSignal, int& aNetCode );
 
     /**
      * Function loadLibrary
@@ -240,6 +257,15 @@ private:
      */
     void loadLibrary( wxXmlNode* aLib, const wxString* aLibName );
 
+    /**
+     * Function findTemplate
+     * returns the MODULE template of a package, making it from the package node the first
+     * time it is needed.
+     * @param aKey is the key of the package in m_templates.
+     * @return the template or NULL if there is no such package.
+     */
+    MODULE* findTemplate( const wxString& aKey );
+
     void loadLibraries( wxXmlNode* aLibs );
     void loadElements( wxXmlNode* aElements );
 
@@ -3551,10 +3551,6 @@ int ELEM_HOLDER::FindElem( T     aType, int instanceNum )
 }
 
 
-// a reasonably small memory price to pay for improved performance
-STRING_FORMATTER  ELEM::sf;
-
-
 //-----<UNIT_RES>---------------------------------------------------------
 
 UNIT_RES UNIT_RES::Default( NULL, T_resolution );
@@ -36,6 +36,7 @@
 #include <pcbnew.h>
 
 #include <memory>
+#include <unordered_map>
 
 // all outside the DSN namespace:
 class BOARD;
@@ -210,16 +211,15 @@ protected:
      */
     std::string makeHash()
     {
-        sf.Clear();
+        // not static: the images and their padstacks are hashed by several threads
+        STRING_FORMATTER sf;
+
         FormatContents( &sf, 0 );
         sf.StripUseless();
 
         return sf.GetString();
     }
 
-    // avoid creating this for every compare, make static.
-    static STRING_FORMATTER  sf;
-
 
 public:
 
@@ -2237,12 +2237,19 @@ class LIBRARY : public ELEM
     PADSTACKS       padstacks;      ///< all except vias, which are in 'vias'
     PADSTACKS       vias;
 
+    /// the index in 'images' of each IMAGE hash, and the count of each image_id,
+    /// for the first 'indexedImages' images.  See FindIMAGE().
+    std::unordered_map<std::string, int>    imageIndex;
+    std::unordered_map<std::string, int>    imageIdCount;
+    unsigned        indexedImages;
+
 public:
 
     LIBRARY( ELEM* aParent, DSN_T aType = T_library ) :
         ELEM( aType, aParent )
     {
         unit = 0;
+        indexedImages = 0;
 //        via_start_index = -1;       // 0 or greater means there is at least one via
     }
     ~LIBRARY()
@@ -2275,21 +2282,33 @@ public:
      */
     int FindIMAGE( IMAGE* aImage )
     {
-        unsigned i;
-        for( i=0;  i<images.size();  ++i )
+        // Index the images appended since the last call, the first image of a given
+        // hash is the one found, as with a linear search.
+        for( ;  indexedImages<images.size();  ++indexedImages )
         {
-            if( 0 == IMAGE::Compare( aImage, &images[i] ) )
-                return (int) i;
+            IMAGE& image = images[indexedImages];
+
+            if( !image.hash.size() )
+                image.hash = image.makeHash();
+
+            imageIndex.emplace( image.hash, (int) indexedImages );
+            ++imageIdCount[ image.image_id ];
         }
 
+        if( !aImage->hash.size() )
+            aImage->hash = aImage->makeHash();
+
+        auto found = imageIndex.find( aImage->hash );
+
+        if( found != imageIndex.end() )
+            return found->second;
+
         // There is no match to the IMAGE contents, but now generate a unique
         // name for it.
-        int dups = 1;
-        for( i=0;  i<images.size();  ++i )
-        {
-            if( 0 == aImage->image_id.compare( images[i].image_id ) )
-                aImage->duplicated = dups++;
-        }
+        auto dups = imageIdCount.find( aImage->image_id );
+
+        if( dups != imageIdCount.end() )
+            aImage->duplicated = dups->second;
 
         return -1;
     }
@@ -3643,6 +3662,9 @@ class SPECCTRA_DB : public SPECCTRA_LEXER
     int     m_top_via_layer;
     int     m_bot_via_layer;
 
+    /// the threads making the images in FromBOARD(), 0 for one per core
+    size_t  m_threadCount;
+
 
     /**
      * Function buildLayerMaps
@@ -3764,11 +3786,14 @@ class SPECCTRA_DB : public SPECCTRA_LEXER
      * Function makeIMAGE
      * allocates an IMAGE on the heap and creates all the PINs according
      * to the D_PADs in the MODULE.
+     * It does not modify this SPECCTRA_DB, so several images can be made concurrently.
      * @param aBoard The owner of the MODULE.
      * @param aModule The MODULE from which to build the IMAGE.
+     * @param aPadstacks receives the PADSTACKs of the PINs, in the PINs order, not
+     *                   tested for duplication yet.  The caller takes their ownership.
      * @return IMAGE* - not tested for duplication yet.
      */
-    IMAGE* makeIMAGE( BOARD* aBoard, MODULE* aModule );
+    IMAGE* makeIMAGE( BOARD* aBoard, MODULE* aModule, std::vector<PADSTACK*>& aPadstacks );
 
     /**
      * Function makePADSTACK
@@ -3860,6 +3885,7 @@ public:
         sessionBoard = NULL;
         m_top_via_layer = 0;
         m_bot_via_layer = 0;
+        m_threadCount = 0;
     }
 
     virtual ~SPECCTRA_DB()
@@ -3898,6 +3924,13 @@ public:
     }
     SESSION* GetSESSION() { return session; }
 
+    /**
+     * Function SetThreadCount
+     * sets the number of threads making the images in FromBOARD(), 0 to use all the cores.
+     * The output does not depend on it.
+     */
+    void SetThreadCount( size_t aCount ) { m_threadCount = aCount; }
+
     /**
      * Function LoadPCB
      * is a recursive descent parser for a SPECCTRA DSN "design" file.
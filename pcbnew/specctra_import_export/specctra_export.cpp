@@ -40,6 +40,9 @@
 
 #include <set>                  // std::set
 #include <map>                  // std::map
+#include <atomic>
+#include <future>
+#include <thread>
 
 #include <class_board.h>
 #include <class_module.h>
@@ -591,7 +594,8 @@ PADSTACK* SPECCTRA_DB::makePADSTACK( BOARD* aBoard, D_PAD* aPad )
 typedef std::map<wxString, int> PINMAP;
 
 
-IMAGE* SPECCTRA_DB::makeIMAGE( BOARD* aBoard, MODULE* aModule )
+IMAGE* SPECCTRA_DB::makeIMAGE( BOARD* aBoard, MODULE* aModule,
+                               std::vector<PADSTACK*>& aPadstacks )
 {
     PINMAP      pinmap;
     wxString    padName;
@@ -644,19 +648,10 @@ IMAGE* SPECCTRA_DB::makeIMAGE( BOARD* aBoard, MODULE* aModule )
             if( !mask_copper_layers.any() )
                 continue;
 
-            PADSTACK*               padstack = makePADSTACK( aBoard, pad );
-            PADSTACKSET::iterator   iter = padstackset.find( *padstack );
-
-            if( iter != padstackset.end() )
-            {
-                // padstack is a duplicate, delete it and use the original
-                delete padstack;
-                padstack = (PADSTACK*) *iter.base();    // folklore, be careful here
-            }
-            else
-            {
-                padstackset.insert( padstack );
-            }
+            // the padstack is hashed here, it is tested for duplication by the caller
+            PADSTACK* padstack = makePADSTACK( aBoard, pad );
+            padstack->hash = padstack->makeHash();
+            aPadstacks.push_back( padstack );
 
             PIN* pin = new PIN( image );
 
@@ -772,6 +767,9 @@ IMAGE* SPECCTRA_DB::makeIMAGE( BOARD* aBoard, MODULE* aModule )
 
 #endif
 
+    // hash the image here, while the images are made concurrently
+    image->hash = image->makeHash();
+
     return image;
 }
 
@@ -1331,11 +1329,47 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
 
         padstackset.clear();
 
+        // Make the images concurrently.  Their padstacks are merged into padstackset
+        // below in the modules order, so the output does not depend on the threads.
+        std::vector<IMAGE*>                 images( items.GetCount() );
+        std::vector<std::vector<PADSTACK*>> imagePadstacks( items.GetCount() );
+        std::atomic<size_t>                 nextModule( 0 );
+        size_t parallelThreadCount = m_threadCount ? m_threadCount
+                                                   : std::thread::hardware_concurrency();
+
+        parallelThreadCount = std::min<size_t>( std::max<size_t>( 1, parallelThreadCount ),
+                                                images.size() );
+        std::vector<std::future<void>> returns( parallelThreadCount );
+
+        auto image_lambda = [&]()
+        {
+            for( size_t i = nextModule++; i < images.size(); i = nextModule++ )
+                images[i] = makeIMAGE( aBoard, (MODULE*) items[i], imagePadstacks[i] );
+        };
+
+        for( std::future<void>& ret : returns )
+            ret = std::async( std::launch::async, image_lambda );
+
+        for( std::future<void>& ret : returns )
+            ret.wait();
+
         for( int m = 0; m<items.GetCount(); ++m )
         {
             MODULE* module = (MODULE*) items[m];
 
-            IMAGE*  image = makeIMAGE( aBoard, module );
+            IMAGE*  image = images[m];
+
+            for( PADSTACK* padstack : imagePadstacks[m] )
+            {
+                PADSTACKSET::iterator iter = padstackset.find( *padstack );
+
+                // padstack is a duplicate, delete it: the pins use the padstack_id of
+                // the original, which is the same
+                if( iter != padstackset.end() )
+                    delete padstack;
+                else
+                    padstackset.insert( padstack );
+            }
 
             componentId = TO_UTF8( module->GetReference() );
 
@@ -31,6 +31,7 @@
 #undef HAVE_CLOCK_GETTIME  // macro is defined in Python.h and causes redefine warning
 
 #include <action_plugin.h>
+#include <board_snapshot.h>
 #include <class_board.h>
 #include <class_marker_pcb.h>
 #include <cstdlib>
@@ -39,6 +40,7 @@
 #include <fp_lib_table.h>
 #include <io_mgr.h>
 #include <kicad_string.h>
+#include <pcb_draw_panel_gal.h>
 #include <pcbnew_scripting_helpers.h>
 #include <project.h>
 #include <settings/settings_manager.h>
@@ -453,3 +455,25 @@ bool WriteDRCReport( BOARD* aBoard, const wxString& aFileName, EDA_UNITS aUnits,
 
     return true;
 }
+
+
+double ExportBoardSnapshot( BOARD* aBoard, const wxString& aFileName, double aDPI,
+                            int aThreadCount )
+{
+    wxCHECK( aBoard, -1.0 );
+
+    // The items of the board opened in the editor are already in the view of the editor
+    bool           inEditor = s_PcbEditFrame && s_PcbEditFrame->GetBoard() == aBoard;
+    BOARD_SNAPSHOT snapshot( aBoard, inEditor ? s_PcbEditFrame->GetCanvas()->GetView() : nullptr );
+
+    snapshot.SetDPI( aDPI );
+    snapshot.SetThreadCount( std::max( 0, aThreadCount ) );
+
+    if( inEditor )
+        snapshot.SetColorSettings( s_PcbEditFrame->GetColorSettings() );
+
+    if( !snapshot.Write( aFileName ) )
+        return -1.0;
+
+    return snapshot.GetRenderTime();
+}
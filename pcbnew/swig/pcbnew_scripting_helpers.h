@@ -158,4 +158,17 @@ bool IsActionRunning();
 bool WriteDRCReport( BOARD* aBoard, const wxString& aFileName, EDA_UNITS aUnits,
                      bool aTestTracksAgainstZones, bool aReportAllTrackErrors );
 
+/**
+ * Renders an image of the given board offscreen and writes it to a file.  PNG images are
+ * split into tiles rendered in parallel; SVG images are rendered by a single thread.
+ *
+ * @param aBoard is a valid loaded board
+ * @param aFileName is the full path and name of the image, with a .png or .svg extension
+ * @param aDPI is the resolution of the PNG images
+ * @param aThreadCount is the number of rendering threads, 0 to use all the cores
+ * @return the render time in milliseconds, or a negative value if the image was not written
+ */
+double ExportBoardSnapshot( BOARD* aBoard, const wxString& aFileName, double aDPI = 300.0,
+                            int aThreadCount = 0 );
+
 #endif      // __PCBNEW_SCRIPTING_HELPERS_H
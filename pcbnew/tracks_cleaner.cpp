@@ -23,6 +23,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <reporter.h>
 #include <board_commit.h>
 #include <cleanup_item.h>
@@ -32,6 +36,43 @@
 #include <tools/pcb_actions.h>
 #include <tools/global_edit_tool.h>
 #include <tracks_cleaner.h>
+#include <hash_eda.h>
+
+
+/**
+ * The ends, width and layer of a track segment, to find the duplicated segments.  The ends
+ * are sorted so the key does not depend on the direction of the segment.
+ */
+struct SEGMENT_KEY
+{
+    SEGMENT_KEY( const wxPoint& aStart, const wxPoint& aEnd, int aWidth, PCB_LAYER_ID aLayer ) :
+            m_start( std::min( aStart, aEnd, std::less<wxPoint>() ) ),
+            m_end( std::max( aStart, aEnd, std::less<wxPoint>() ) ),
+            m_width( aWidth ),
+            m_layer( aLayer )
+    {
+    }
+
+    bool operator==( const SEGMENT_KEY& aOther ) const
+    {
+        return m_start == aOther.m_start && m_end == aOther.m_end && m_width == aOther.m_width
+               && m_layer == aOther.m_layer;
+    }
+
+    wxPoint      m_start;
+    wxPoint      m_end;
+    int          m_width;
+    PCB_LAYER_ID m_layer;
+};
+
+
+struct SEGMENT_KEY_HASH
+{
+    std::size_t operator()( const SEGMENT_KEY& aKey ) const
+    {
+        return hash_val( aKey.m_start, aKey.m_end, aKey.m_width, (int) aKey.m_layer );
+    }
+};
 
 
 TRACKS_CLEANER::TRACKS_CLEANER( BOARD* aPcb, BOARD_COMMIT& aCommit ) :
@@ -98,46 +139,60 @@ void TRACKS_CLEANER::CleanupBoard( bool aDryRun, std::vector<std::shared_ptr<CLE
 
 void TRACKS_CLEANER::removeShortingTrackSegments()
 {
-    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
+    std::shared_ptr<CONNECTIVITY_DATA>    connectivity = m_brd->GetConnectivity();
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> connAlgo = connectivity->GetConnectivityAlgo();
 
     std::set<BOARD_ITEM *> toRemove;
 
+    // The items connected to a segment are read directly from its connectivity items, instead
+    // of building the sets of connected pads and of connected tracks
     for( TRACK* segment : m_brd->Tracks() )
     {
-        for( D_PAD* testedPad : connectivity->GetConnectedPads( segment ) )
+        bool shorting = false;
+
+        for( CN_ITEM* citem : connAlgo->ItemEntry( segment ).GetItems() )
         {
-            if( segment->GetNetCode() != testedPad->GetNetCode() )
+            for( CN_ITEM* connected : citem->ConnectedItems() )
             {
-                std::shared_ptr<CLEANUP_ITEM> item;
+                if( !connected->Valid() )
+                    continue;
 
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
+                BOARD_CONNECTED_ITEM* testedItem = connected->Parent();
 
-                item->SetItems( segment );
-                m_itemsList->push_back( item );
+                switch( testedItem->Type() )
+                {
+                case PCB_PAD_T:
+                case PCB_TRACE_T:
+                case PCB_ARC_T:
+                case PCB_VIA_T:
+                    shorting |= segment->GetNetCode() != testedItem->GetNetCode();
+                    break;
+
+                default:
+                    break;
+                }
 
-                toRemove.insert( segment );
+                if( shorting )
+                    break;
             }
+
+            if( shorting )
+                break;
         }
 
-        for( TRACK* testedTrack : connectivity->GetConnectedTracks( segment ) )
+        if( shorting )
         {
-            if( segment->GetNetCode() != testedTrack->GetNetCode() )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item;
+            std::shared_ptr<CLEANUP_ITEM> item;
 
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
+            if( segment->Type() == PCB_VIA_T )
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
+            else
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
 
-                item->SetItems( segment );
-                m_itemsList->push_back( item );
+            item->SetItems( segment );
+            m_itemsList->push_back( item );
 
-                toRemove.insert( segment );
-            }
+            toRemove.insert( segment );
         }
     }
 
@@ -157,9 +212,16 @@ void TRACKS_CLEANER::cleanupVias()
             vias.push_back( static_cast<VIA*>( track ) );
     }
 
-    for( auto via1_it = vias.begin(); via1_it != vias.end(); via1_it++ )
+    // Index the vias by position: the vias at the same position as a via are searched
+    // in this index, in the order of the board
+    std::unordered_map<wxPoint, std::vector<size_t>> viasAtPosition;
+
+    for( size_t ii = 0; ii < vias.size(); ii++ )
+        viasAtPosition[ vias[ii]->GetPosition() ].push_back( ii );
+
+    for( size_t ii = 0; ii < vias.size(); ii++ )
     {
-        VIA* via1 = *via1_it;
+        VIA* via1 = vias[ii];
 
         if( via1->IsLocked() )
             continue;
@@ -189,11 +251,11 @@ void TRACKS_CLEANER::cleanupVias()
             }
         }
 
-        for( auto via2_it = via1_it + 1; via2_it != vias.end(); via2_it++ )
+        for( size_t jj : viasAtPosition[ via1->GetPosition() ] )
         {
-            VIA* via2 = *via2_it;
+            VIA* via2 = vias[jj];
 
-            if( via1->GetPosition() != via2->GetPosition() || via2->IsLocked() )
+            if( jj <= ii || via2->IsLocked() )
                 continue;
 
             if( via1->GetViaType() == via2->GetViaType() )
@@ -248,55 +310,86 @@ bool TRACKS_CLEANER::testTrackEndpointIsNode( TRACK* aTrack, bool aTstStart )
 
 bool TRACKS_CLEANER::deleteDanglingTracks( bool aVia )
 {
-    bool item_erased = false;
     bool modified = false;
 
-    do // Iterate when at least one track is deleted
-    {
-        item_erased = false;
-        // Ensure the connectivity is up to date, especially after removind a dangling segment
-        m_brd->BuildConnectivity();
+    // Ensure the connectivity is up to date, especially after removing segments
+    m_brd->BuildConnectivity();
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
+    std::set<BOARD_ITEM*>              toRemove;
 
-        // Keep a duplicate deque to all deleting in the primary
-        std::deque<TRACK*> temp_tracks( m_brd->Tracks() );
+    auto isCandidate =
+            [aVia]( BOARD_CONNECTED_ITEM* aItem )
+            {
+                switch( aItem->Type() )
+                {
+                case PCB_VIA_T:  return aVia;
+                case PCB_TRACE_T:
+                case PCB_ARC_T:  return !aVia;
+                default:         return false;
+                }
+            };
+
+    // The tracks to test.  When a track is deleted, only the tracks which were connected to
+    // it are tested again: the connectivity is not rebuilt, but the deleted track is marked
+    // as invalid, and is no longer counted as a connected item.
+    std::deque<TRACK*>         worklist;
+    std::unordered_set<TRACK*> queued;
 
-        for( TRACK* track : temp_tracks )
+    for( TRACK* track : m_brd->Tracks() )
+    {
+        if( isCandidate( track ) )
         {
-            bool    flag_erase = false; // Start without a good reason to erase it
+            worklist.push_back( track );
+            queued.insert( track );
+        }
+    }
 
-            if( aVia && track->Type() != PCB_VIA_T )
-                continue;
-            else if( !aVia && track->Type() == PCB_VIA_T )
-                continue;
+    while( !worklist.empty() )
+    {
+        TRACK* track = worklist.front();
+        worklist.pop_front();
+        queued.erase( track );
 
-            // Tst if a track (or a via) endpoint is not connected to another track or to a zone.
-            if( m_brd->GetConnectivity()->TestTrackEndpointDangling( track ) )
-                flag_erase = true;
+        // Tst if a track (or a via) endpoint is not connected to another track or to a zone.
+        if( !connectivity->TestTrackEndpointDangling( track ) )
+            continue;
+
+        int errorCode =
+                ( track->Type() != PCB_VIA_T ) ?
+                        CLEANUP_DANGLING_TRACK : CLEANUP_DANGLING_VIA;
+        std::shared_ptr<CLEANUP_ITEM> item( new CLEANUP_ITEM( errorCode ) );
+        item->SetItems( track );
+        m_itemsList->push_back( item );
 
-            if( flag_erase )
+        // Fix me: In dry run we should disable the track to erase and retry with this disabled track
+        // However the connectivity algo does not handle disabled items.
+        if( m_dryRun )
+            continue;
+
+        /* test again the tracks connected to the deleted track, because they perhaps
+         * are not connected now and should be deleted */
+        for( CN_ITEM* citem : connectivity->GetConnectivityAlgo()->ItemEntry( track ).GetItems() )
+        {
+            for( CN_ITEM* connected : citem->ConnectedItems() )
             {
-                int errorCode =
-                        ( track->Type() != PCB_VIA_T ) ?
-                                CLEANUP_DANGLING_TRACK : CLEANUP_DANGLING_VIA;
-                std::shared_ptr<CLEANUP_ITEM> item( new CLEANUP_ITEM( errorCode ) );
-                item->SetItems( track );
-                m_itemsList->push_back( item );
+                if( !connected->Valid() || !isCandidate( connected->Parent() ) )
+                    continue;
 
-                if( !m_dryRun )
-                {
-                    m_brd->Remove( track );
-                    m_commit.Removed( track );
+                TRACK* candidate = static_cast<TRACK*>( connected->Parent() );
 
-                    /* keep iterating, because a track connected to the deleted track
-                     * now perhaps is not connected and should be deleted */
-                    item_erased = true;
-                    modified = true;
-                }
-                // Fix me: In dry run we should disable the track to erase and retry with this disabled track
-                // However the connectivity algo does not handle disabled items.
+                if( queued.insert( candidate ).second )
+                    worklist.push_back( candidate );
             }
         }
-    } while( item_erased ); // A segment was erased: test for some new dangling segments
+
+        connectivity->Remove( track );
+        toRemove.insert( track );
+        modified = true;
+    }
+
+    if( !m_dryRun )
+        removeItems( toRemove );
 
     return modified;
 }
@@ -336,9 +429,20 @@ void TRACKS_CLEANER::deleteTracksInPads()
         if( track->Type() == PCB_VIA_T )
             continue;
 
+        EDA_RECT trackBox = track->GetBoundingBox();
+
         // Mark track if connected to pads
         for( D_PAD* pad : connectivity->GetConnectedPads( track ) )
         {
+            // A track going out of the bounding box of the pad cannot be inside the pad: the
+            // polygon test is only done for the tracks which can be.  The box of the track is
+            // rounded up, so the box of the pad is inflated by the same amount
+            EDA_RECT padBox = pad->GetBoundingBox();
+            padBox.Inflate( 1 );
+
+            if( !padBox.Contains( trackBox ) )
+                continue;
+
             if( pad->HitTest( track->GetStart() ) && pad->HitTest( track->GetEnd() ) )
             {
                 SHAPE_POLY_SET poly;
@@ -347,12 +451,13 @@ void TRACKS_CLEANER::deleteTracksInPads()
                 poly.BooleanSubtract( *pad->GetEffectivePolygon(), SHAPE_POLY_SET::PM_FAST );
 
                 if( poly.IsEmpty() )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item( new CLEANUP_ITEM( CLEANUP_TRACK_IN_PAD ) );
-                item->SetItems( track );
-                m_itemsList->push_back( item );
+                {
+                    std::shared_ptr<CLEANUP_ITEM> item( new CLEANUP_ITEM( CLEANUP_TRACK_IN_PAD ) );
+                    item->SetItems( track );
+                    m_itemsList->push_back( item );
 
-                toRemove.insert( track );
+                    toRemove.insert( track );
+                    break;      // the track is removed once, whatever the other pads
                 }
             }
         }
@@ -371,51 +476,91 @@ void TRACKS_CLEANER::cleanupSegments()
 
     std::set<BOARD_ITEM*> toRemove;
 
-    // Remove duplicate segments (2 superimposed identical segments):
-    for( auto it = m_brd->Tracks().begin(); it != m_brd->Tracks().end(); it++ )
+    // Remove duplicate segments (2 superimposed identical segments).
+    // The segments are indexed by their ends: the duplicates of a segment have the same
+    // ends, or are null segments on one of its ends.
+    std::vector<TRACK*> tracks( m_brd->Tracks().begin(), m_brd->Tracks().end() );
+    std::unordered_map<SEGMENT_KEY, std::vector<size_t>, SEGMENT_KEY_HASH> tracksByEnds;
+
+    for( size_t ii = 0; ii < tracks.size(); ii++ )
     {
-        TRACK* track1 = *it;
+        TRACK* track = tracks[ii];
+
+        tracksByEnds[ SEGMENT_KEY( track->GetStart(), track->GetEnd(), track->GetWidth(),
+                                   track->GetLayer() ) ].push_back( ii );
+    }
+
+    for( size_t ii = 0; ii < tracks.size(); ii++ )
+    {
+        TRACK* track1 = tracks[ii];
 
         if( track1->Type() != PCB_TRACE_T || track1->HasFlag( IS_DELETED ) || track1->IsLocked() )
             continue;
 
-        for( auto it2 = it + 1; it2 != m_brd->Tracks().end(); it2++ )
+        int          width = track1->GetWidth();
+        PCB_LAYER_ID layer = track1->GetLayer();
+        SEGMENT_KEY  keys[] = { SEGMENT_KEY( track1->GetStart(), track1->GetEnd(), width, layer ),
+                                SEGMENT_KEY( track1->GetStart(), track1->GetStart(), width, layer ),
+                                SEGMENT_KEY( track1->GetEnd(), track1->GetEnd(), width, layer ) };
+
+        // The duplicates following track1, in the order of the board
+        std::vector<size_t> duplicates;
+
+        for( int jj = 0; jj < 3; jj++ )
         {
-            TRACK* track2 = *it2;
+            if( ( jj > 0 && keys[jj] == keys[0] ) || ( jj > 1 && keys[jj] == keys[1] ) )
+                continue;
 
-            if( track2->HasFlag( IS_DELETED ) )
+            auto found = tracksByEnds.find( keys[jj] );
+
+            if( found == tracksByEnds.end() )
                 continue;
 
-            if( track1->IsPointOnEnds( track2->GetStart() )
-                    && track1->IsPointOnEnds( track2->GetEnd() )
-                    && track1->GetWidth() == track2->GetWidth()
-                    && track1->GetLayer() == track2->GetLayer() )
+            for( size_t kk : found->second )
             {
-                std::shared_ptr<CLEANUP_ITEM> item( new CLEANUP_ITEM( CLEANUP_DUPLICATE_TRACK ) );
-                item->SetItems( track2 );
-                m_itemsList->push_back( item );
-
-                track2->SetFlags( IS_DELETED );
-                toRemove.insert( track2 );
+                if( kk > ii )
+                    duplicates.push_back( kk );
             }
         }
+
+        std::sort( duplicates.begin(), duplicates.end() );
+
+        for( size_t kk : duplicates )
+        {
+            TRACK* track2 = tracks[kk];
+
+            if( track2->HasFlag( IS_DELETED ) )
+                continue;
+
+            std::shared_ptr<CLEANUP_ITEM> item( new CLEANUP_ITEM( CLEANUP_DUPLICATE_TRACK ) );
+            item->SetItems( track2 );
+            m_itemsList->push_back( item );
+
+            track2->SetFlags( IS_DELETED );
+            toRemove.insert( track2 );
+        }
     }
 
     if( !m_dryRun )
         removeItems( toRemove );
 
-    bool merged;
+    toRemove.clear();
 
-    do
-    {
-        merged = false;
-        m_brd->BuildConnectivity();
+    m_brd->BuildConnectivity();
 
-        // Keep a duplicate deque to all deleting in the primary
-        std::deque<TRACK*> temp_segments( m_brd->Tracks() );
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
+
+    // The segments to merge.  After the first pass, only the segments merged in the previous
+    // pass are examined again: the connections of the merged segments are searched again,
+    // instead of rebuilding the connectivity of the whole board.
+    std::vector<TRACK*> worklist( m_brd->Tracks().begin(), m_brd->Tracks().end() );
+
+    while( !worklist.empty() )
+    {
+        std::vector<TRACK*> mergedSegments;
 
         // merge collinear segments:
-        for( TRACK* segment : temp_segments )
+        for( TRACK* segment : worklist )
         {
             if( segment->Type() != PCB_TRACE_T )    // one can merge only track collinear segments, not vias.
                 continue;
@@ -423,11 +568,10 @@ void TRACKS_CLEANER::cleanupSegments()
             if( segment->HasFlag( IS_DELETED ) )  // already taken in account
                 continue;
 
-            auto connectivity = m_brd->GetConnectivity();
-
-            auto& entry = connectivity->GetConnectivityAlgo()->ItemEntry( segment );
+            // A copy: the entry of the segment is replaced when it is merged
+            auto citems = connectivity->GetConnectivityAlgo()->ItemEntry( segment ).GetItems();
 
-            for( CN_ITEM* citem : entry.GetItems() )
+            for( CN_ITEM* citem : citems )
             {
                 for( CN_ITEM* connected : citem->ConnectedItems() )
                 {
@@ -445,17 +589,39 @@ void TRACKS_CLEANER::cleanupSegments()
                         if( candidateSegment->GetWidth() != segment->GetWidth() )
                             continue;
 
-                        if( segment->ApproxCollinear( *candidateSegment ) )
-                            merged = mergeCollinearSegments( segment, candidateSegment );
+                        if( segment->ApproxCollinear( *candidateSegment )
+                                && mergeCollinearSegments( segment, candidateSegment, toRemove ) )
+                        {
+                            mergedSegments.push_back( segment );
+                        }
                     }
                 }
             }
         }
-    } while( merged );
+
+        // Search the connections of the merged segments
+        if( !mergedSegments.empty() && !m_dryRun )
+            connectivity->RecalculateRatsnest();
+
+        worklist.clear();
+
+        for( TRACK* segment : mergedSegments )
+        {
+            if( !segment->HasFlag( IS_DELETED )
+                    && ( worklist.empty() || worklist.back() != segment ) )
+            {
+                worklist.push_back( segment );
+            }
+        }
+    }
+
+    if( !m_dryRun )
+        removeItems( toRemove );
 }
 
 
-bool TRACKS_CLEANER::mergeCollinearSegments( TRACK* aSeg1, TRACK* aSeg2 )
+bool TRACKS_CLEANER::mergeCollinearSegments( TRACK* aSeg1, TRACK* aSeg2,
+                                             std::set<BOARD_ITEM*>& aToRemove )
 {
     if( aSeg1->IsLocked() || aSeg2->IsLocked() )
         return false;
@@ -522,8 +688,8 @@ bool TRACKS_CLEANER::mergeCollinearSegments( TRACK* aSeg1, TRACK* aSeg2 )
         }
 
         // Merge succesful, seg2 has to go away
-        m_brd->Remove( aSeg2 );
-        m_commit.Removed( aSeg2 );
+        connectivity->Remove( aSeg2 );
+        aToRemove.insert( aSeg2 );
     }
 
     return true;
@@ -532,9 +698,8 @@ bool TRACKS_CLEANER::mergeCollinearSegments( TRACK* aSeg1, TRACK* aSeg2 )
 
 void TRACKS_CLEANER::removeItems( std::set<BOARD_ITEM*>& aItems )
 {
+    m_brd->RemoveItems( aItems );
+
     for( auto item : aItems )
-    {
-        m_brd->Remove( item );
         m_commit.Removed( item );
-    }
 }
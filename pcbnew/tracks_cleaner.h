@@ -85,8 +85,10 @@ private:
      * @return true if the segments are merged, false if not
      * @param aSeg1 is the reference
      * @param aSeg2 is the candidate, and after merging, the removed segment
+     * @param aToRemove receives aSeg2 after merging: it is removed from the connectivity,
+     * and must be removed from the board by the caller
      */
-    bool mergeCollinearSegments( TRACK* aSeg1, TRACK* aSeg2 );
+    bool mergeCollinearSegments( TRACK* aSeg1, TRACK* aSeg2, std::set<BOARD_ITEM*>& aToRemove );
 
     /**
      * @return true if a track end position is a node, i.e. a end connected
@@ -34,6 +34,8 @@ using namespace std::placeholders;
 #include <class_pcb_target.h>
 #include <class_module.h>
 #include <class_dimension.h>
+#include <class_zone.h>
+#include <pcb_shape.h>
 #include <origin_viewitem.h>
 #include <connectivity/connectivity_data.h>
 #include <pcbnew_settings.h>
@@ -611,11 +613,10 @@ void PCB_BASE_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aIt
 
     for( unsigned ii = 0; ii < icnt; ii++ )
     {
-        if( list.m_CommandsList.size() == 0 )
-            break;
+        PICKED_ITEMS_LIST* curr_cmd = list.PopOldestCommand();
 
-        PICKED_ITEMS_LIST* curr_cmd = list.m_CommandsList[0];
-        list.m_CommandsList.erase( list.m_CommandsList.begin() );
+        if( !curr_cmd )
+            break;
 
         curr_cmd->ClearListAndDeleteItems();
         delete curr_cmd;    // Delete command
@@ -623,6 +624,68 @@ void PCB_BASE_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aIt
 }
 
 
+/**
+ * Function undoItemMemoryUsage
+ * @return an estimate of the memory used by an item held by an undo/redo command
+ */
+static size_t undoItemMemoryUsage( const EDA_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_ZONE_AREA_T:
+    case PCB_FP_ZONE_AREA_T:
+        return static_cast<const ZONE_CONTAINER*>( aItem )->GetMemoryUsage();
+
+    case PCB_SHAPE_T:
+    case PCB_FP_SHAPE_T:
+    {
+        const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
+        return sizeof( PCB_SHAPE ) + shape->GetPolyShape().TotalVertices() * sizeof( VECTOR2I );
+    }
+
+    case PCB_MODULE_T:
+    {
+        const MODULE* module = static_cast<const MODULE*>( aItem );
+        size_t        usage = sizeof( MODULE ) + module->Pads().size() * sizeof( D_PAD );
+
+        for( const BOARD_ITEM* item : module->GraphicalItems() )
+            usage += undoItemMemoryUsage( item );
+
+        for( const MODULE_ZONE_CONTAINER* zone : module->Zones() )
+            usage += zone->GetMemoryUsage();
+
+        return usage;
+    }
+
+    case PCB_PAD_T:    return sizeof( D_PAD );
+    case PCB_TRACE_T:  return sizeof( TRACK );
+    case PCB_ARC_T:    return sizeof( ARC );
+    case PCB_VIA_T:    return sizeof( VIA );
+    default:           return sizeof( TRACK );     // a rough size for the other items
+    }
+}
+
+
+size_t PCB_BASE_EDIT_FRAME::GetCommandMemoryUsage( const PICKED_ITEMS_LIST& aCommand ) const
+{
+    size_t usage = 0;
+
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ii++ )
+    {
+        // The command owns the copies of the changed items and the deleted items
+        if( EDA_ITEM* link = aCommand.GetPickedItemLink( ii ) )
+            usage += undoItemMemoryUsage( link );
+
+        EDA_ITEM* item = aCommand.GetPickedItem( ii );
+
+        if( item && aCommand.GetPickedItemStatus( ii ) == UNDO_REDO::DELETED )
+            usage += undoItemMemoryUsage( item );
+    }
+
+    return usage;
+}
+
+
 void PCB_BASE_EDIT_FRAME::RollbackFromUndo()
 {
     PICKED_ITEMS_LIST* undo = PopCommandFromUndoList();
@@ -60,6 +60,9 @@ ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
 {
     // To enable add "DebugZoneFiller=1" to kicad_advanced settings file.
     m_debugZoneFiller = ADVANCED_CFG::GetCfg().m_DebugZoneFiller;
+
+    // To enable add "ZoneFillTiles=8" (or any other count per axis) to kicad_advanced.
+    m_tileCount = ADVANCED_CFG::GetCfg().m_ZoneFillTiles;
 }
 
 
@@ -159,6 +162,10 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
     size_t cores = std::thread::hardware_concurrency();
     std::atomic<size_t> nextItem;
 
+    // The cores left to each worker for the tiled polygon operations and the triangulation
+    // (TILED_THREAD_BUDGET gives at least one)
+    size_t workerThreadBudget = 1;
+
     auto check_fill_dependency =
             [&]( ZONE_CONTAINER* aZone, PCB_LAYER_ID aLayer, ZONE_CONTAINER* aOtherZone ) -> bool
             {
@@ -196,7 +203,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
     auto fill_lambda =
             [&]( PROGRESS_REPORTER* aReporter )
             {
-                size_t num = 0;
+                SHAPE_POLY_SET::TILED_THREAD_BUDGET budget( workerThreadBudget );
+                size_t                              num = 0;
 
                 for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
                 {
@@ -261,6 +269,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         std::vector<std::future<size_t>> returns( parallelThreadCount );
 
         nextItem = 0;
+        workerThreadBudget = cores / std::max<size_t>( 1, parallelThreadCount );
 
         if( parallelThreadCount <= 1 )
             fill_lambda( m_progressReporter );
@@ -321,75 +330,120 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
         zone->SetIsFilled( true );
     }
 
-    // Now remove insulated copper islands
-    for( CN_ZONE_ISOLATED_ISLAND_LIST& zone : islandsList )
-    {
-        for( PCB_LAYER_ID layer : zone.m_zone->GetLayerSet().Seq() )
-        {
-            if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
-                continue;
+    // Now remove insulated copper islands and islands outside the board edge.  The polygons to
+    // delete are marked first and each fill is compacted once.  Zones are independent, so they
+    // are handled in parallel.
+    nextItem = 0;
 
-            if( !zone.m_islands.count( layer ) )
-                continue;
+    auto island_lambda =
+            [&]( PROGRESS_REPORTER* aReporter ) -> size_t
+            {
+                size_t num = 0;
 
-            std::vector<int>& islands = zone.m_islands.at( layer );
+                for( size_t i = nextItem++; i < islandsList.size(); i = nextItem++ )
+                {
+                    CN_ZONE_ISOLATED_ISLAND_LIST& zone = islandsList[i];
+                    long long int                 minArea = zone.m_zone->GetMinIslandArea();
+                    ISLAND_REMOVAL_MODE           mode = zone.m_zone->GetIslandRemovalMode();
+                    LSET                          zoneCopperLayers = zone.m_zone->GetLayerSet();
 
-            // The list of polygons to delete must be explored from last to first in list,
-            // to allow deleting a polygon from list without breaking the remaining of the list
-            std::sort( islands.begin(), islands.end(), std::greater<int>() );
+                    zoneCopperLayers &= LSET::AllCuMask( MAX_CU_LAYERS );
 
-            SHAPE_POLY_SET      poly = zone.m_zone->GetFilledPolysList( layer );
-            long long int       minArea = zone.m_zone->GetMinIslandArea();
-            ISLAND_REMOVAL_MODE mode    = zone.m_zone->GetIslandRemovalMode();
+                    for( PCB_LAYER_ID layer : zoneCopperLayers.Seq() )
+                    {
+                        if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
+                            continue;
 
-            for( int idx : islands )
-            {
-                SHAPE_LINE_CHAIN& outline = poly.Outline( idx );
+                        const SHAPE_POLY_SET& fill = zone.m_zone->GetFilledPolysList( layer );
+                        std::vector<bool>     isolated( fill.OutlineCount(), false );
+                        std::vector<bool>     deleted( fill.OutlineCount(), false );
+                        bool                  anyDeleted = false;
 
-                if( mode == ISLAND_REMOVAL_MODE::ALWAYS )
-                    poly.DeletePolygon( idx );
-                else if ( mode == ISLAND_REMOVAL_MODE::AREA && outline.Area() < minArea )
-                    poly.DeletePolygon( idx );
-                else
-                    zone.m_zone->SetIsIsland( layer, idx );
-            }
+                        if( zone.m_islands.count( layer ) )
+                        {
+                            for( int idx : zone.m_islands.at( layer ) )
+                                isolated[idx] = true;
+                        }
 
-            zone.m_zone->SetFilledPolysList( layer, poly );
-            zone.m_zone->CalculateFilledArea();
+                        for( int ii = 0; ii < fill.OutlineCount(); ii++ )
+                        {
+                            const SHAPE_POLY_SET::POLYGON& island = fill.CPolygon( ii );
 
-            if( m_progressReporter && m_progressReporter->IsCancelled() )
-                return false;
-        }
-    }
+                            if( island.empty()
+                                    || !m_boardOutline.Contains( island.front().CPoint( 0 ) ) )
+                            {
+                                deleted[ii] = true;
+                            }
+                            else if( isolated[ii] )
+                            {
+                                if( mode == ISLAND_REMOVAL_MODE::ALWAYS )
+                                    deleted[ii] = true;
+                                else if( mode == ISLAND_REMOVAL_MODE::AREA
+                                            && island.front().Area() < minArea )
+                                    deleted[ii] = true;
+                            }
 
-    // Now remove islands outside the board edge
-    for( ZONE_CONTAINER* zone : aZones )
-    {
-        LSET zoneCopperLayers = zone->GetLayerSet() & LSET::AllCuMask( MAX_CU_LAYERS );
+                            anyDeleted |= deleted[ii];
+                        }
 
-        for( PCB_LAYER_ID layer : zoneCopperLayers.Seq() )
-        {
-            if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
-                continue;
+                        // The kept islands are flagged by their index in the compacted fill
+                        for( int ii = 0, kept = 0; ii < fill.OutlineCount(); ii++ )
+                        {
+                            if( deleted[ii] )
+                                continue;
 
-            SHAPE_POLY_SET poly = zone->GetFilledPolysList( layer );
+                            if( isolated[ii] )
+                                zone.m_zone->SetIsIsland( layer, kept );
 
-            for( int ii = poly.OutlineCount() - 1; ii >= 0; ii-- )
-            {
-                std::vector<SHAPE_LINE_CHAIN>& island = poly.Polygon( ii );
+                            kept++;
+                        }
 
-                if( island.empty() || !m_boardOutline.Contains( island.front().CPoint( 0 ) ) )
-                    poly.DeletePolygon( ii );
-            }
+                        if( anyDeleted )
+                        {
+                            SHAPE_POLY_SET poly = fill;
+                            poly.DeletePolygons( deleted );
+                            zone.m_zone->SetFilledPolysList( layer, poly );
+                        }
+                    }
 
-            zone->SetFilledPolysList( layer, poly );
-            zone->CalculateFilledArea();
+                    zone.m_zone->CalculateFilledArea();
+                    num++;
 
-            if( m_progressReporter && m_progressReporter->IsCancelled() )
-                return false;
+                    if( m_progressReporter && m_progressReporter->IsCancelled() )
+                        break;
+                }
+
+                return num;
+            };
+
+    size_t islandThreadCount = std::min( cores, islandsList.size() );
+
+    if( islandThreadCount <= 1 )
+        island_lambda( m_progressReporter );
+    else
+    {
+        std::vector<std::future<size_t>> islandReturns( islandThreadCount );
+
+        for( size_t ii = 0; ii < islandThreadCount; ++ii )
+            islandReturns[ii] = std::async( std::launch::async, island_lambda, m_progressReporter );
+
+        for( size_t ii = 0; ii < islandThreadCount; ++ii )
+        {
+            // Here we balance returns with a 100ms timeout to allow UI updating
+            std::future_status status;
+            do
+            {
+                if( m_progressReporter )
+                    m_progressReporter->KeepRefreshing();
+
+                status = islandReturns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
         }
     }
 
+    if( m_progressReporter && m_progressReporter->IsCancelled() )
+        return false;
+
     if( aCheck )
     {
         bool outOfDate = false;
@@ -436,7 +490,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
     auto tri_lambda =
             [&]( PROGRESS_REPORTER* aReporter ) -> size_t
             {
-                size_t num = 0;
+                SHAPE_POLY_SET::TILED_THREAD_BUDGET budget( workerThreadBudget );
+                size_t                              num = 0;
 
                 for( size_t i = nextItem++; i < islandsList.size(); i = nextItem++ )
                 {
@@ -458,6 +513,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE_CONTAINER*>& aZones, bool aCheck, wxWin
     size_t parallelThreadCount = std::min( cores, islandsList.size() );
     std::vector<std::future<size_t>> returns( parallelThreadCount );
 
+    workerThreadBudget = cores / std::max<size_t>( 1, parallelThreadCount );
+
     if( parallelThreadCount <= 1 )
         tri_lambda( m_progressReporter );
     else
@@ -987,16 +1044,18 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     // because the "real" subtract-clearance-holes has to be done after the spokes are added.
     static const bool USE_BBOX_CACHES = true;
     SHAPE_POLY_SET testAreas = aRawPolys;
-    testAreas.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    testAreas.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST, m_tileCount );
     DUMP_POLYS_TO_COPPER_LAYER( testAreas, In3_Cu, "minus-clearance-holes" );
 
     // Prune features that don't meet minimum-width criteria
     if( half_min_width - epsilon > epsilon )
     {
-        testAreas.Deflate( half_min_width - epsilon, numSegs, fastCornerStrategy );
+        testAreas.InflateTiled( -( half_min_width - epsilon ), numSegs, fastCornerStrategy,
+                                m_tileCount );
         DUMP_POLYS_TO_COPPER_LAYER( testAreas, In4_Cu, "spoke-test-deflated" );
 
-        testAreas.Inflate( half_min_width - epsilon, numSegs, fastCornerStrategy );
+        testAreas.InflateTiled( half_min_width - epsilon, numSegs, fastCornerStrategy,
+                                m_tileCount );
         DUMP_POLYS_TO_COPPER_LAYER( testAreas, In5_Cu, "spoke-test-reinflated" );
     }
 
@@ -1043,12 +1102,15 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return;
 
-    aRawPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST, m_tileCount );
     DUMP_POLYS_TO_COPPER_LAYER( aRawPolys, In7_Cu, "trimmed-spokes" );
 
     // Prune features that don't meet minimum-width criteria
     if( half_min_width - epsilon > epsilon )
-        aRawPolys.Deflate( half_min_width - epsilon, numSegs, cornerStrategy );
+    {
+        aRawPolys.InflateTiled( -( half_min_width - epsilon ), numSegs, cornerStrategy,
+                                m_tileCount );
+    }
 
     DUMP_POLYS_TO_COPPER_LAYER( aRawPolys, In8_Cu, "deflated" );
 
@@ -1072,17 +1134,17 @@ void ZONE_FILLER::computeRawFilledArea( const ZONE_CONTAINER* aZone, PCB_LAYER_I
     }
     else if( half_min_width - epsilon > epsilon )
     {
-        aRawPolys.Inflate( half_min_width - epsilon, numSegs, cornerStrategy );
+        aRawPolys.InflateTiled( half_min_width - epsilon, numSegs, cornerStrategy, m_tileCount );
     }
 
     DUMP_POLYS_TO_COPPER_LAYER( aRawPolys, In10_Cu, "after-reinflating" );
 
     // Ensure additive changes (thermal stubs and particularly inflating acute corners) do not
     // add copper outside the zone boundary or inside the clearance holes
-    aRawPolys.BooleanIntersection( aSmoothedOutline, SHAPE_POLY_SET::PM_FAST );
-    aRawPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.BooleanIntersectionTiled( aSmoothedOutline, SHAPE_POLY_SET::PM_FAST, m_tileCount );
+    aRawPolys.BooleanSubtractTiled( clearanceHoles, SHAPE_POLY_SET::PM_FAST, m_tileCount );
 
-    aRawPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+    aRawPolys.FractureTiled( SHAPE_POLY_SET::PM_FAST, m_tileCount );
 
     aFinalPolys = aRawPolys;
 }
@@ -120,6 +120,8 @@ private:
     int                   m_maxError;
 
     bool                  m_debugZoneFiller;
+
+    int                   m_tileCount;          // tiles per axis for polygon ops; <= 1 disables
 };
 
 #endif
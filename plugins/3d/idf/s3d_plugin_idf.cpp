@@ -28,6 +28,7 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <mutex>
 #include <wx/filename.h>
 #include <wx/log.h>
 #include <wx/string.h>
@@ -74,15 +75,19 @@ static SCENEGRAPH* vrmlToSG( VRML_LAYER& vpcb, int idxColor, SGNODE* aParent, do
 
 class LOCALESWITCH
 {
+    // Store the user locale name, to restore this locale later, in dtor
+    std::string m_locale;
+
 public:
     LOCALESWITCH()
     {
+        m_locale = setlocale( LC_NUMERIC, 0 );
         setlocale( LC_NUMERIC, "C" );
     }
 
     ~LOCALESWITCH()
     {
-        setlocale( LC_NUMERIC, "" );
+        setlocale( LC_NUMERIC, m_locale.c_str() );
     }
 };
 
@@ -291,6 +296,11 @@ SCENEGRAPH* Load( char const* aFileName )
 
     SCENEGRAPH* data = NULL;
 
+    // The color index of the components is shared by all the loads, which may be
+    // requested by several threads at once
+    static std::mutex loadMutex;
+    std::lock_guard<std::mutex> lock( loadMutex );
+
     if( !ext.Cmp( wxT( "idf" ) ) || !ext.Cmp( wxT( "IDF" ) ) )
     {
         data = loadIDFOutline( fname.GetFullPath() );
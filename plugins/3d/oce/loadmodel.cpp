@@ -22,12 +22,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
@@ -393,6 +395,10 @@ void addItems( SGNODE* parent, std::vector< SGNODE* >* lp )
 }
 
 
+// Serializes the translation of the files: the models may be loaded by several threads
+static std::mutex readMutex;
+
+
 bool readIGES( Handle(TDocStd_Document)& m_doc, const char* fname )
 {
     IGESCAFControl_Reader reader;
@@ -512,33 +518,39 @@ SCENEGRAPH* LoadModel( char const* filename )
 {
     DATA data;
 
-    Handle(XCAFApp_Application) m_app = XCAFApp_Application::GetApplication();
-    m_app->NewDocument( "MDTV-XCAF", data.m_doc );
-    FormatType modelFmt = fileType( filename );
-
-    switch( modelFmt )
     {
-        case FMT_IGES:
-            data.renderBoth = true;
+        // The application and the translation settings (Interface_Static) are shared by
+        // all the loads; the meshing of the shapes which follows may run concurrently
+        std::lock_guard<std::mutex> lock( readMutex );
 
-            if( !readIGES( data.m_doc, filename ) )
-                return NULL;
-            break;
+        Handle(XCAFApp_Application) m_app = XCAFApp_Application::GetApplication();
+        m_app->NewDocument( "MDTV-XCAF", data.m_doc );
+        FormatType modelFmt = fileType( filename );
 
-        case FMT_STEP:
-            if( !readSTEP( data.m_doc, filename ) )
-                return NULL;
-            break;
+        switch( modelFmt )
+        {
+            case FMT_IGES:
+                data.renderBoth = true;
 
-        case FMT_STPZ:
-            if( !readSTEPZ( data.m_doc, filename ) )
-                return NULL;
-            break;
+                if( !readIGES( data.m_doc, filename ) )
+                    return NULL;
+                break;
 
+            case FMT_STEP:
+                if( !readSTEP( data.m_doc, filename ) )
+                    return NULL;
+                break;
 
-        default:
-            return NULL;
-            break;
+            case FMT_STPZ:
+                if( !readSTEPZ( data.m_doc, filename ) )
+                    return NULL;
+                break;
+
+
+            default:
+                return NULL;
+                break;
+        }
     }
 
     data.m_assy = XCAFDoc_DocumentTool::ShapeTool( data.m_doc->Main() );
@@ -626,7 +638,7 @@ bool processSolid( const TopoDS_Shape& shape, DATA& data, SGNODE* parent,
 
     if( label.IsNull() )
     {
-        static int i = 0;
+        static std::atomic<int> i( 0 );
         std::ostringstream ostr;
         ostr << "KMISC_" << i++;
         partID = ostr.str();
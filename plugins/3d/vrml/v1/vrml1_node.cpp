@@ -30,6 +30,7 @@
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <mutex>
 #include <wx/log.h>
 
 #include "vrml1_node.h"
@@ -97,7 +98,11 @@ WRL1NODE::WRL1NODE( NAMEREGISTER* aDictionary )
     m_Type = WRL1_END;
     m_dictionary = aDictionary;
 
-    if( nodenames.empty() )
+    // The tables are filled by the first node created: the models may be loaded
+    // by several threads at once
+    static std::once_flag tablesFilled;
+
+    std::call_once( tablesFilled, []()
     {
         nodenames.insert( NODEITEM( "AsciiText", WRL1_ASCIITEXT ) );
         nodenames.insert( NODEITEM( "Cone", WRL1_CONE ) );
@@ -134,7 +139,7 @@ WRL1NODE::WRL1NODE( NAMEREGISTER* aDictionary )
         nodenames.insert( NODEITEM( "Translation", WRL1_TRANSLATION ) );
         nodenames.insert( NODEITEM( "WWWAnchor", WRL1_WWWANCHOR ) );
         nodenames.insert( NODEITEM( "WWWInline", WRL1_WWWINLINE ) );
-    }
+    } );
 
     return;
 }
@@ -30,6 +30,7 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <mutex>
 #include <wx/log.h>
 
 #include "vrml2_node.h"
@@ -48,7 +49,11 @@ WRL2NODE::WRL2NODE()
     m_Parent = NULL;
     m_Type = WRL2_END;
 
-    if( badNames.empty() )
+    // The tables are filled by the first node created: the models may be loaded
+    // by several threads at once
+    static std::once_flag tablesFilled;
+
+    std::call_once( tablesFilled, []()
     {
         badNames.insert( "DEF" );
         badNames.insert( "EXTERNPROTO" );
@@ -64,10 +69,7 @@ WRL2NODE::WRL2NODE()
         badNames.insert( "eventOut" );
         badNames.insert( "exposedField" );
         badNames.insert( "field" );
-    }
 
-    if( nodenames.empty() )
-    {
         nodenames.insert( NODEITEM( "Anchor", WRL2_ANCHOR ) );
         nodenames.insert( NODEITEM( "Appearance", WRL2_APPEARANCE ) );
         nodenames.insert( NODEITEM( "Audioclip", WRL2_AUDIOCLIP ) );
@@ -122,7 +124,7 @@ WRL2NODE::WRL2NODE()
         nodenames.insert( NODEITEM( "ViewPoint", WRL2_VIEWPOINT ) );
         nodenames.insert( NODEITEM( "VisibilitySensor", WRL2_VISIBILITYSENSOR ) );
         nodenames.insert( NODEITEM( "WorldInfo", WRL2_WORLDINFO ) );
-    }
+    } );
 
     return;
 }
@@ -41,7 +41,6 @@
 #include "x3d.h"
 #include <clocale>
 #include <wx/filename.h>
-#include <wx/stdpaths.h>
 #include <wx/string.h>
 #include <wx/wfstream.h>
 #include <wx/log.h>
@@ -168,21 +167,26 @@ SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline )
     if( aFileName.Upper().EndsWith( "WRZ" ) )
     {
         wxFileInputStream ifile( aFileName );
-        tmpfilename = wxFileName( aFileName );
-
-        tmpfilename.SetPath( wxStandardPaths::Get().GetTempDir() );
-        tmpfilename.SetExt( "WRL" );
-
         wxFileOffset size = ifile.GetLength();
 
         if( size == wxInvalidOffset )
             return nullptr;
 
+        // The models are loaded concurrently and two of them can have the same base name,
+        // so each one is expanded to a file with a unique name
+        tmpfilename = wxFileName::CreateTempFileName( wxT( "kicad_wrz" ) );
+
+        if( !tmpfilename.IsOk() )
+            return nullptr;
+
         {
             wxFileOutputStream ofile( tmpfilename.GetFullPath() );
 
             if( !ofile.IsOk() )
+            {
+                wxRemoveFile( tmpfilename.GetFullPath() );
                 return nullptr;
+            }
 
             char *buffer = new char[size];
 
@@ -196,6 +200,8 @@ SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline )
             catch(...)
             {
                 delete[] buffer;
+                ofile.Close();
+                wxRemoveFile( tmpfilename.GetFullPath() );
                 return nullptr;
             }
 
@@ -217,6 +223,10 @@ SCENEGRAPH* LoadVRML( const wxString& aFileName, bool useInline )
     catch( IO_ERROR & )
     {
         wxLogError( _( " * [INFO] load failed: input line too long\n" ) );
+
+        if( tmpfilename.IsOk() )
+            wxRemoveFile( tmpfilename.GetFullPath() );
+
         return NULL;
     }
 
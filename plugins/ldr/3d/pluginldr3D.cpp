@@ -398,6 +398,8 @@ char const* KICAD_PLUGIN_LDR_3D::GetFileFilter( int aIndex )
 
 bool KICAD_PLUGIN_LDR_3D::CanRender( void )
 {
+    std::lock_guard<std::mutex> lock( m_mutex );
+
     m_error.clear();
 
     if( !ok && !reopen() )
@@ -428,29 +430,37 @@ bool KICAD_PLUGIN_LDR_3D::CanRender( void )
 
 SCENEGRAPH* KICAD_PLUGIN_LDR_3D::Load( char const* aFileName )
 {
-    m_error.clear();
+    PLUGIN_3D_LOAD load = NULL;
 
-    if( !ok && !reopen() )
     {
-        if( m_error.empty() )
-            m_error = "[INFO] no open plugin / plugin could not be opened";
+        std::lock_guard<std::mutex> lock( m_mutex );
 
-        return NULL;
-    }
+        m_error.clear();
 
-    if( NULL == m_load )
-    {
-        m_error = "[BUG] Load is not linked";
+        if( !ok && !reopen() )
+        {
+            if( m_error.empty() )
+                m_error = "[INFO] no open plugin / plugin could not be opened";
 
-        #ifdef DEBUG
-        std::ostringstream ostr;
-        ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
-        ostr << " * " << m_error;
-        wxLogTrace( MASK_PLUGINLDR, "%s\n", ostr.str().c_str() );
-        #endif
+            return NULL;
+        }
 
-        return NULL;
+        if( NULL == m_load )
+        {
+            m_error = "[BUG] Load is not linked";
+
+            #ifdef DEBUG
+            std::ostringstream ostr;
+            ostr << __FILE__ << ": " << __FUNCTION__ << ": " << __LINE__ << "\n";
+            ostr << " * " << m_error;
+            wxLogTrace( MASK_PLUGINLDR, "%s\n", ostr.str().c_str() );
+            #endif
+
+            return NULL;
+        }
+
+        load = m_load;
     }
 
-    return m_load( aFileName );
+    return load( aFileName );
 }
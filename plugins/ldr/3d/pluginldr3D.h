@@ -30,6 +30,7 @@
 #ifndef PLUGINLDR3D_H
 #define PLUGINLDR3D_H
 
+#include <mutex>
 #include "../pluginldr.h"
 
 class SCENEGRAPH;
@@ -59,6 +60,9 @@ private:
     PLUGIN_3D_CAN_RENDER            m_canRender;
     PLUGIN_3D_LOAD                  m_load;
 
+    // protects the state of the loader: the models may be loaded by several threads
+    std::mutex                      m_mutex;
+
 public:
     KICAD_PLUGIN_LDR_3D();
     virtual ~KICAD_PLUGIN_LDR_3D();
@@ -84,6 +88,11 @@ public:
 
     bool CanRender( void );
 
+    /**
+     * Function Load
+     * loads a model with the plugin.  May be called by several threads at once: the
+     * plugin function is called outside of the loader lock.
+     */
     SCENEGRAPH* Load( char const* aFileName );
 };
 
@@ -0,0 +1,324 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the model files of the 3D cache (S3D_MODEL_DATA)
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <3d_model_data.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+
+/**
+ * A temporary model file name, removed when going out of scope.
+ */
+struct MODEL_FILE
+{
+    MODEL_FILE() :
+            m_fileName( wxFileName::CreateTempFileName( "3d_model_data" ) )
+    {
+    }
+
+    ~MODEL_FILE()
+    {
+        wxRemoveFile( m_fileName );
+    }
+
+    wxString m_fileName;
+};
+
+
+/**
+ * A model of two meshes: a quad with all its arrays, and a triangle with no normal,
+ * texcoord and color arrays.
+ */
+struct MODEL_FIXTURE
+{
+    MODEL_FIXTURE() :
+            m_positions( { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+                           { 1.0f, 1.0f, 0.5f } } ),
+            m_normals( 4, SFVEC3F( 0.0f, 0.0f, 1.0f ) ),
+            m_texcoords( { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f } } ),
+            m_colors( { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+                        { 1.0f, 1.0f, 1.0f } } ),
+            m_quadFaces( { 0, 1, 2, 2, 1, 3 } ),
+            m_triangleFaces( { 2, 1, 0 } ),
+            m_materials( 2 ),
+            m_meshes( 2 )
+    {
+        m_materials[0].m_Diffuse = SFVEC3F( 0.5f, 0.25f, 0.125f );
+        m_materials[1].m_Transparency = 0.75f;
+
+        SMESH& quad = m_meshes[0];
+        quad.m_VertexSize = m_positions.size();
+        quad.m_Positions = m_positions.data();
+        quad.m_Normals = m_normals.data();
+        quad.m_Texcoords = m_texcoords.data();
+        quad.m_Color = m_colors.data();
+        quad.m_FaceIdxSize = m_quadFaces.size();
+        quad.m_FaceIdx = m_quadFaces.data();
+        quad.m_MaterialIdx = 1;
+
+        SMESH& triangle = m_meshes[1];
+        triangle.m_VertexSize = 3;
+        triangle.m_Positions = m_positions.data();
+        triangle.m_Normals = NULL;
+        triangle.m_Texcoords = NULL;
+        triangle.m_Color = NULL;
+        triangle.m_FaceIdxSize = m_triangleFaces.size();
+        triangle.m_FaceIdx = m_triangleFaces.data();
+        triangle.m_MaterialIdx = 0;
+
+        m_model.m_MeshesSize = m_meshes.size();
+        m_model.m_Meshes = m_meshes.data();
+        m_model.m_MaterialsSize = m_materials.size();
+        m_model.m_Materials = m_materials.data();
+    }
+
+    bool Write( const wxString& aFileName, const S3DMODEL& aModel )
+    {
+        return S3D_MODEL_DATA::Write( aFileName, aModel, wxULongLong( 1234 ),
+                                      wxDateTime( wxLongLong( 1600000000000LL ) ), m_sha1 );
+    }
+
+    std::vector<SFVEC3F>      m_positions;
+    std::vector<SFVEC3F>      m_normals;
+    std::vector<SFVEC2F>      m_texcoords;
+    std::vector<SFVEC3F>      m_colors;
+    std::vector<unsigned int> m_quadFaces;
+    std::vector<unsigned int> m_triangleFaces;
+    std::vector<SMATERIAL>    m_materials;
+    std::vector<SMESH>        m_meshes;
+    S3DMODEL                  m_model;
+
+    const unsigned char       m_sha1[20] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                             11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+};
+
+
+/**
+ * Checks an array read from a model file holds the values written, and is aligned to be
+ * used as it is mapped.
+ */
+template <typename T>
+void CheckArray( const T* aArray, const T* aExpected, size_t aCount )
+{
+    if( aExpected == NULL )
+    {
+        BOOST_CHECK( aArray == NULL );
+        return;
+    }
+
+    BOOST_REQUIRE( aArray != NULL );
+    BOOST_CHECK( reinterpret_cast<uintptr_t>( aArray ) % 16 == 0 );
+
+    for( size_t i = 0; i < aCount; ++i )
+        BOOST_CHECK_MESSAGE( aArray[i] == aExpected[i], "element " << i << " differs" );
+}
+
+
+std::vector<char> ReadFile( const wxString& aFileName )
+{
+    wxFFile           file( aFileName, "rb" );
+    std::vector<char> content;
+
+    BOOST_REQUIRE( file.IsOpened() );
+    content.resize( file.Length() );
+    BOOST_REQUIRE_EQUAL( file.Read( content.data(), content.size() ), content.size() );
+
+    return content;
+}
+
+
+void WriteFile( const wxString& aFileName, const std::vector<char>& aContent )
+{
+    wxFFile file( aFileName, "wb" );
+
+    BOOST_REQUIRE( file.IsOpened() );
+    BOOST_REQUIRE_EQUAL( file.Write( aContent.data(), aContent.size() ), aContent.size() );
+}
+
+
+/**
+ * Overwrites the first bytes of a file matching a pattern.
+ */
+void PatchFile( const wxString& aFileName, const void* aPattern, const void* aReplacement,
+                size_t aSize )
+{
+    std::vector<char> content = ReadFile( aFileName );
+    const char*       pattern = static_cast<const char*>( aPattern );
+
+    auto found = std::search( content.begin(), content.end(), pattern, pattern + aSize );
+
+    BOOST_REQUIRE( found != content.end() );
+    memcpy( &*found, aReplacement, aSize );
+
+    WriteFile( aFileName, content );
+}
+
+} // namespace
+
+
+BOOST_FIXTURE_TEST_SUITE( ModelData3D, MODEL_FIXTURE )
+
+
+/**
+ * A model read back holds the data written, with its NULL arrays, and aligned arrays
+ */
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    MODEL_FILE file;
+
+    BOOST_REQUIRE( Write( file.m_fileName, m_model ) );
+
+    S3D_MODEL_DATA data;
+    BOOST_REQUIRE( data.Open( file.m_fileName ) );
+
+    BOOST_CHECK( data.GetSourceSize() == wxULongLong( 1234 ) );
+    BOOST_CHECK( data.GetSourceModTime() == wxDateTime( wxLongLong( 1600000000000LL ) ) );
+    BOOST_CHECK( memcmp( data.GetSourceSHA1(), m_sha1, sizeof( m_sha1 ) ) == 0 );
+
+    const S3DMODEL* model = data.GetModel();
+
+    BOOST_REQUIRE_EQUAL( model->m_MaterialsSize, m_materials.size() );
+    BOOST_REQUIRE_EQUAL( model->m_MeshesSize, m_meshes.size() );
+    BOOST_CHECK( memcmp( model->m_Materials, m_materials.data(),
+                         sizeof( SMATERIAL ) * m_materials.size() ) == 0 );
+    BOOST_CHECK( reinterpret_cast<uintptr_t>( model->m_Materials ) % 16 == 0 );
+
+    for( unsigned int i = 0; i < model->m_MeshesSize; ++i )
+    {
+        BOOST_TEST_CONTEXT( "Mesh " << i )
+        {
+            const SMESH& mesh = model->m_Meshes[i];
+            const SMESH& expected = m_meshes[i];
+
+            BOOST_CHECK_EQUAL( mesh.m_VertexSize, expected.m_VertexSize );
+            BOOST_CHECK_EQUAL( mesh.m_FaceIdxSize, expected.m_FaceIdxSize );
+            BOOST_CHECK_EQUAL( mesh.m_MaterialIdx, expected.m_MaterialIdx );
+
+            CheckArray( mesh.m_Positions, expected.m_Positions, expected.m_VertexSize );
+            CheckArray( mesh.m_Normals, expected.m_Normals, expected.m_VertexSize );
+            CheckArray( mesh.m_Texcoords, expected.m_Texcoords, expected.m_VertexSize );
+            CheckArray( mesh.m_Color, expected.m_Color, expected.m_VertexSize );
+            CheckArray( mesh.m_FaceIdx, expected.m_FaceIdx, expected.m_FaceIdxSize );
+        }
+    }
+}
+
+
+/**
+ * A model without meshes or materials is read back empty
+ */
+BOOST_AUTO_TEST_CASE( EmptyModel )
+{
+    MODEL_FILE file;
+    S3DMODEL   empty = { 0, NULL, 0, NULL };
+
+    BOOST_REQUIRE( Write( file.m_fileName, empty ) );
+
+    S3D_MODEL_DATA data;
+    BOOST_REQUIRE( data.Open( file.m_fileName ) );
+
+    BOOST_CHECK_EQUAL( data.GetModel()->m_MeshesSize, 0u );
+    BOOST_CHECK( data.GetModel()->m_Meshes == NULL );
+    BOOST_CHECK_EQUAL( data.GetModel()->m_MaterialsSize, 0u );
+    BOOST_CHECK( data.GetModel()->m_Materials == NULL );
+}
+
+
+/**
+ * A model file with a face index out of the vertices of its mesh is rejected
+ */
+BOOST_AUTO_TEST_CASE( CorruptedFaceIndex )
+{
+    MODEL_FILE file;
+
+    BOOST_REQUIRE( Write( file.m_fileName, m_model ) );
+
+    std::vector<unsigned int> corrupted = m_quadFaces;
+    corrupted[5] = m_positions.size();
+
+    PatchFile( file.m_fileName, m_quadFaces.data(), corrupted.data(),
+               sizeof( unsigned int ) * m_quadFaces.size() );
+
+    S3D_MODEL_DATA data;
+    BOOST_CHECK( !data.Open( file.m_fileName ) );
+    BOOST_CHECK_EQUAL( data.GetModel()->m_MeshesSize, 0u );
+    BOOST_CHECK( data.GetModel()->m_Meshes == NULL );
+}
+
+
+/**
+ * A truncated model file is rejected
+ */
+BOOST_AUTO_TEST_CASE( TruncatedFile )
+{
+    MODEL_FILE file;
+
+    BOOST_REQUIRE( Write( file.m_fileName, m_model ) );
+
+    // Cut the last face index
+    std::vector<char> content = ReadFile( file.m_fileName );
+    content.resize( content.size() - sizeof( unsigned int ) );
+    WriteFile( file.m_fileName, content );
+
+    S3D_MODEL_DATA data;
+    BOOST_CHECK( !data.Open( file.m_fileName ) );
+}
+
+
+/**
+ * Models which would be rejected when read are not written
+ */
+BOOST_AUTO_TEST_CASE( InvalidFacesAreNotWritten )
+{
+    MODEL_FILE file;
+
+    m_quadFaces[2] = m_positions.size();
+    BOOST_CHECK( !Write( file.m_fileName, m_model ) );
+
+    m_quadFaces[2] = 2;
+    m_meshes[0].m_FaceIdxSize = 5;
+    BOOST_CHECK( !Write( file.m_fileName, m_model ) );
+
+    m_meshes[0].m_FaceIdxSize = 6;
+    BOOST_CHECK( Write( file.m_fileName, m_model ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,221 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for reading CADSTAR Archive files into XNODE trees
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <plugins/cadstar/cadstar_archive_parser.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <memory>
+
+
+namespace
+{
+
+/**
+ * Writes an archive to a temporary file, removed when going out of scope.
+ */
+struct ARCHIVE_FILE
+{
+    ARCHIVE_FILE( const std::string& aText )
+    {
+        m_fileName = wxFileName::CreateTempFileName( "cadstar" );
+
+        wxFFile file( m_fileName, "wb" );
+        file.Write( aText.data(), aText.size() );
+    }
+
+    ~ARCHIVE_FILE()
+    {
+        wxRemoveFile( m_fileName );
+    }
+
+    wxString m_fileName;
+};
+
+
+/**
+ * Checks two XNODE trees have the same nodes, with the same attributes in the same order.
+ */
+void CheckSameTree( const wxXmlNode* aNode, const wxXmlNode* aExpected )
+{
+    BOOST_REQUIRE( aNode );
+    BOOST_REQUIRE( aExpected );
+    BOOST_CHECK_EQUAL( aNode->GetName().ToStdString(), aExpected->GetName().ToStdString() );
+
+    const wxXmlAttribute* attr = aNode->GetAttributes();
+    const wxXmlAttribute* expectedAttr = aExpected->GetAttributes();
+
+    for( ; attr && expectedAttr; attr = attr->GetNext(), expectedAttr = expectedAttr->GetNext() )
+    {
+        BOOST_CHECK_EQUAL( attr->GetName().ToStdString(), expectedAttr->GetName().ToStdString() );
+        BOOST_CHECK_EQUAL( attr->GetValue().ToStdString(),
+                           expectedAttr->GetValue().ToStdString() );
+    }
+
+    BOOST_CHECK( !attr && !expectedAttr );
+
+    const wxXmlNode* child = aNode->GetChildren();
+    const wxXmlNode* expectedChild = aExpected->GetChildren();
+
+    for( ; child && expectedChild;
+            child = child->GetNext(), expectedChild = expectedChild->GetNext() )
+    {
+        CheckSameTree( child, expectedChild );
+    }
+
+    BOOST_CHECK( !child && !expectedChild );
+}
+
+
+/**
+ * Reads an archive with its sections read concurrently, and in a single pass: both trees must
+ * be the same.
+ * @return the tree read concurrently.
+ */
+std::unique_ptr<XNODE> LoadAndCompare( const std::string& aText )
+{
+    ARCHIVE_FILE file( aText );
+
+    std::unique_ptr<XNODE> concurrent( CADSTAR_ARCHIVE_PARSER::LoadArchiveFile(
+            file.m_fileName, wxT( "CADSTARPCB" ) ) );
+    std::unique_ptr<XNODE> serial( CADSTAR_ARCHIVE_PARSER::LoadArchiveFile(
+            file.m_fileName, wxT( "CADSTARPCB" ), false ) );
+
+    CheckSameTree( concurrent.get(), serial.get() );
+
+    return concurrent;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( CadstarArchiveParser )
+
+
+/**
+ * Parentheses in quoted strings do not open or close sections
+ */
+BOOST_AUTO_TEST_CASE( QuotedParentheses )
+{
+    std::unique_ptr<XNODE> root = LoadAndCompare(
+            "(CADSTARPCB\n"
+            "(HEADER (FORMAT LAYOUT 8 0) (JOBTITLE \"title ) with (parens\"))\n"
+            "(TEXTCODES (TEXTCODE TC1 \"Code (1\" 10 10))\n"
+            ")\n" );
+
+    BOOST_CHECK_EQUAL( root->GetChildren()->GetName().ToStdString(), "HEADER" );
+    BOOST_CHECK_EQUAL( root->GetChildren()->GetNext()->GetName().ToStdString(), "TEXTCODES" );
+    BOOST_CHECK( !root->GetChildren()->GetNext()->GetNext() );
+}
+
+
+/**
+ * An escaped quote does not end a quoted string, an escaped backslash does not escape the quote
+ * after it
+ */
+BOOST_AUTO_TEST_CASE( EscapedQuotes )
+{
+    std::unique_ptr<XNODE> root = LoadAndCompare(
+            "(CADSTARPCB\n"
+            "(HEADER (JOBTITLE \"say \\\"(hi\\\" \\\\\"))\n"
+            "(TEXTCODES (TEXTCODE TC1 \"\\\\\" 10 10))\n"
+            ")\n" );
+
+    XNODE*   title = root->GetChildren()->GetChildren();
+    wxString value;
+
+    BOOST_REQUIRE( title->GetAttribute( wxT( "attr0" ), &value ) );
+    BOOST_CHECK_EQUAL( value.ToStdString(), "say \"(hi\" \\" );
+}
+
+
+/**
+ * Lines whose first non-blank character is # are comments, whatever they hold
+ */
+BOOST_AUTO_TEST_CASE( CommentLines )
+{
+    std::unique_ptr<XNODE> root = LoadAndCompare(
+            "# a comment ( with \" unbalanced\n"
+            "(CADSTARPCB\n"
+            "   # an indented comment )\n"
+            "(HEADER (FORMAT LAYOUT 8 0))\n"
+            "# (NOTASECTION)\n"
+            "(TEXTCODES (TEXTCODE TC1 \"#not a comment\" 10 10))\n"
+            ")\n" );
+
+    XNODE* textcodes = root->GetChildren()->GetNext();
+
+    BOOST_REQUIRE( textcodes );
+    BOOST_CHECK_EQUAL( textcodes->GetName().ToStdString(), "TEXTCODES" );
+    BOOST_CHECK( !textcodes->GetNext() );
+}
+
+
+/**
+ * A root node holding more than its name and its sections is read in a single pass
+ */
+BOOST_AUTO_TEST_CASE( RootAttributeReadSerially )
+{
+    std::unique_ptr<XNODE> root = LoadAndCompare(
+            "(CADSTARPCB 1.0\n"
+            "(HEADER (FORMAT LAYOUT 8 0))\n"
+            "(TEXTCODES (TEXTCODE TC1 \"Code\" 10 10))\n"
+            ")\n" );
+
+    wxString value;
+
+    BOOST_REQUIRE( root->GetAttribute( wxT( "attr0" ), &value ) );
+    BOOST_CHECK_EQUAL( value.ToStdString(), "1.0" );
+}
+
+
+/**
+ * The attributes are in the order InsertAttributeAtEnd() makes them: numAttributes is just
+ * before the last attribute
+ */
+BOOST_AUTO_TEST_CASE( AttributeOrder )
+{
+    std::unique_ptr<XNODE> root = LoadAndCompare(
+            "(CADSTARPCB\n"
+            "(HEADER (FORMAT LAYOUT 8 0))\n"
+            ")\n" );
+
+    XNODE expected( wxXML_ELEMENT_NODE, wxT( "FORMAT" ) );
+
+    for( const wxString& value : { wxT( "LAYOUT" ), wxT( "8" ), wxT( "0" ) } )
+        CADSTAR_ARCHIVE_PARSER::InsertAttributeAtEnd( &expected, value );
+
+    CheckSameTree( root->GetChildren()->GetChildren(), &expected );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,301 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the streaming reader of the Eagle XML files
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <plugins/eagle/eagle_xml_reader.h>
+
+#include <ki_exception.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+/**
+ * Writes an XML file to a temporary file, removed when going out of scope.
+ */
+struct XML_FILE
+{
+    XML_FILE( const std::string& aText )
+    {
+        m_fileName = wxFileName::CreateTempFileName( "eagle" );
+
+        wxFFile file( m_fileName, "wb" );
+        file.Write( aText.data(), aText.size() );
+    }
+
+    ~XML_FILE()
+    {
+        wxRemoveFile( m_fileName );
+    }
+
+    wxString m_fileName;
+};
+
+
+/**
+ * Checks two wxXmlNode trees have the same nodes, with the same attributes in the same order.
+ */
+void CheckSameTree( const wxXmlNode* aNode, const wxXmlNode* aExpected )
+{
+    BOOST_REQUIRE( aNode );
+    BOOST_REQUIRE( aExpected );
+    BOOST_CHECK_EQUAL( aNode->GetType(), aExpected->GetType() );
+    BOOST_CHECK_EQUAL( aNode->GetName().ToStdString(), aExpected->GetName().ToStdString() );
+    BOOST_CHECK_EQUAL( aNode->GetContent().ToStdString(),
+                       aExpected->GetContent().ToStdString() );
+    BOOST_CHECK_EQUAL( aNode->GetLineNumber(), aExpected->GetLineNumber() );
+
+    const wxXmlAttribute* attr = aNode->GetAttributes();
+    const wxXmlAttribute* expectedAttr = aExpected->GetAttributes();
+
+    for( ; attr && expectedAttr; attr = attr->GetNext(), expectedAttr = expectedAttr->GetNext() )
+    {
+        BOOST_CHECK_EQUAL( attr->GetName().ToStdString(), expectedAttr->GetName().ToStdString() );
+        BOOST_CHECK_EQUAL( attr->GetValue().ToStdString(),
+                           expectedAttr->GetValue().ToStdString() );
+    }
+
+    BOOST_CHECK( !attr && !expectedAttr );
+
+    const wxXmlNode* child = aNode->GetChildren();
+    const wxXmlNode* expectedChild = aExpected->GetChildren();
+
+    for( ; child && expectedChild;
+            child = child->GetNext(), expectedChild = expectedChild->GetNext() )
+    {
+        CheckSameTree( child, expectedChild );
+    }
+
+    BOOST_CHECK( !child && !expectedChild );
+}
+
+
+/**
+ * Returns the first child of a node with a name.
+ */
+const wxXmlNode* FindChild( const wxXmlNode* aNode, const wxString& aName )
+{
+    for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+    {
+        if( child->GetName() == aName )
+            return child;
+    }
+
+    return nullptr;
+}
+
+
+const std::string board =
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<!DOCTYPE eagle SYSTEM \"eagle.dtd\">\n"
+        "<eagle version=\"9.6.2\">\n"
+        "<drawing>\n"
+        "<layers>\n"
+        "<layer number=\"1\" name=\"Top\" color=\"4\" fill=\"1\" visible=\"yes\" active=\"yes\"/>\n"
+        "<layer number=\"16\" name=\"Bottom\" color=\"1\" fill=\"1\" visible=\"yes\" active=\"yes\"/>\n"
+        "</layers>\n"
+        "<board>\n"
+        "<description>A &amp; B\n"
+        "<![CDATA[<b>bold</b>]]> and more</description>\n"
+        "<signals>\n"
+        "<!-- the first net -->\n"
+        "<signal name=\"GND\">\n"
+        "<contactref element=\"R1\" pad=\"1\"/>\n"
+        "<wire x1=\"0\" y1=\"0\" x2=\"1.27\" y2=\"0\" width=\"0.254\" layer=\"1\"/>\n"
+        "</signal>\n"
+        "<signal name=\"N$1\">\n"
+        "<contactref element=\"R1\" pad=\"2\"/>\n"
+        "</signal>\n"
+        "</signals>\n"
+        "</board>\n"
+        "</drawing>\n"
+        "</eagle>\n";
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( EagleXmlReader )
+
+
+/**
+ * The elements given to the handlers are the trees of wxXmlDocument
+ */
+BOOST_AUTO_TEST_CASE( SameTrees )
+{
+    XML_FILE file( board );
+
+    wxXmlDocument document;
+    BOOST_REQUIRE( document.Load( file.m_fileName ) );
+
+    const wxXmlNode* drawing = FindChild( document.GetRoot(), "drawing" );
+    const wxXmlNode* boardNode = FindChild( drawing, "board" );
+
+    std::vector<std::unique_ptr<wxXmlNode>> layers;
+    std::vector<std::unique_ptr<wxXmlNode>> descriptions;
+    std::vector<std::unique_ptr<wxXmlNode>> signals;
+
+    EAGLE_XML_READER reader;
+
+    reader.AddHandler( "eagle/drawing/layers",
+            [&]( std::unique_ptr<wxXmlNode> aNode )
+            {
+                layers.push_back( std::move( aNode ) );
+            } );
+
+    reader.AddHandler( "eagle/drawing/board/description",
+            [&]( std::unique_ptr<wxXmlNode> aNode )
+            {
+                descriptions.push_back( std::move( aNode ) );
+            } );
+
+    reader.AddHandler( "eagle/drawing/board/signals/signal",
+            [&]( std::unique_ptr<wxXmlNode> aNode )
+            {
+                signals.push_back( std::move( aNode ) );
+            } );
+
+    reader.Read( file.m_fileName );
+
+    BOOST_REQUIRE_EQUAL( layers.size(), 1u );
+    CheckSameTree( layers[0].get(), FindChild( drawing, "layers" ) );
+
+    BOOST_REQUIRE_EQUAL( descriptions.size(), 1u );
+    CheckSameTree( descriptions[0].get(), FindChild( boardNode, "description" ) );
+
+    const wxXmlNode* expectedSignal = FindChild( FindChild( boardNode, "signals" ), "signal" );
+
+    BOOST_REQUIRE_EQUAL( signals.size(), 2u );
+
+    for( const std::unique_ptr<wxXmlNode>& signal : signals )
+    {
+        BOOST_TEST_CONTEXT( "Signal " << signal->GetAttribute( "name" ).ToStdString() )
+        {
+            CheckSameTree( signal.get(), expectedSignal );
+        }
+
+        expectedSignal = expectedSignal->GetNext();
+    }
+}
+
+
+/**
+ * Without children, the handlers get the element and its attributes, and the elements below
+ * it are still given to their handlers
+ */
+BOOST_AUTO_TEST_CASE( AttributesOnly )
+{
+    XML_FILE file( board );
+
+    std::string              version;
+    std::vector<std::string> order;
+
+    EAGLE_XML_READER reader;
+
+    reader.AddHandler( "eagle",
+            [&]( std::unique_ptr<wxXmlNode> aNode )
+            {
+                BOOST_CHECK( !aNode->GetChildren() );
+                version = aNode->GetAttribute( "version" ).ToStdString();
+                order.push_back( aNode->GetName().ToStdString() );
+            },
+            false );
+
+    reader.AddHandler( "eagle/drawing/board/signals/signal",
+            [&]( std::unique_ptr<wxXmlNode> aNode )
+            {
+                BOOST_CHECK( !aNode->GetChildren() );
+                order.push_back( aNode->GetAttribute( "name" ).ToStdString() );
+            },
+            false );
+
+    reader.AddHandler( "eagle/drawing/board/signals/signal/contactref",
+            [&]( std::unique_ptr<wxXmlNode> aNode )
+            {
+                order.push_back( aNode->GetAttribute( "pad" ).ToStdString() );
+            } );
+
+    reader.Read( file.m_fileName );
+
+    BOOST_CHECK_EQUAL( version, "9.6.2" );
+
+    const std::vector<std::string> expected = { "eagle", "GND", "1", "N$1", "2" };
+
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), expected.begin(), expected.end() );
+}
+
+
+/**
+ * The exceptions of the handlers stop the reading and are passed to the caller
+ */
+BOOST_AUTO_TEST_CASE( HandlerException )
+{
+    XML_FILE file( board );
+
+    int count = 0;
+
+    EAGLE_XML_READER reader;
+
+    reader.AddHandler( "eagle/drawing/board/signals/signal",
+            [&]( std::unique_ptr<wxXmlNode> )
+            {
+                count++;
+                THROW_IO_ERROR( "stop" );
+            } );
+
+    BOOST_CHECK_THROW( reader.Read( file.m_fileName ), IO_ERROR );
+    BOOST_CHECK_EQUAL( count, 1 );
+}
+
+
+/**
+ * The files which cannot be read or are not well formed are reported
+ */
+BOOST_AUTO_TEST_CASE( Errors )
+{
+    EAGLE_XML_READER reader;
+
+    XML_FILE truncated( board.substr( 0, board.size() / 2 ) );
+
+    BOOST_CHECK_THROW( reader.Read( truncated.m_fileName ), IO_ERROR );
+
+    wxString missing = truncated.m_fileName + "_missing";
+
+    BOOST_CHECK_THROW( reader.Read( missing ), IO_ERROR );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
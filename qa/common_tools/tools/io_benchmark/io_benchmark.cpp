@@ -22,6 +22,7 @@
  */
 
 #include <wx/wx.h>
+#include <base_units.h>
 #include <richio.h>
 
 #include <chrono>
@@ -30,6 +31,7 @@
 #include <iostream>
 
 #include <fstream>
+#include <vector>
 
 #include <wx/wfstream.h>
 #include <wx/filename.h>
@@ -303,6 +305,101 @@ static void bench_wxbis_reuse( const wxFileName& aFile, int aReps, BENCH_REPORT&
     }
 }
 
+/**
+ * Write the lines of a file as the items of a board file: a segment, with coordinates
+ * made from the line number and length, and a text holding the line, on one of a few
+ * layers.  This uses the formatting functions of the board files: FormatInternalUnits(),
+ * Quotew() and Print().
+ */
+static void save_lines( OUTPUTFORMATTER& aOut, const std::vector<wxString>& aLines,
+                        BENCH_REPORT& report )
+{
+    static const wxString layers[] = { "F.Cu", "B.Cu", "In1.Cu", "F.SilkS" };
+
+    aOut.Print( 0, "(kicad_pcb (version %d) (generator %s)\n", 20200829,
+                aOut.Quotew( "io_benchmark" ).c_str() );
+
+    for( size_t i = 0; i < aLines.size(); ++i )
+    {
+        const wxString& layer = layers[ i % 4 ];
+        wxPoint         start( (int) i * 1270, (int) aLines[i].length() * 2540 );
+        wxPoint         end( start.x + 25400, -start.y );
+
+        aOut.Print( 1, "(segment (start %s) (end %s) (width %s) (layer %s) (net %d))\n",
+                    FormatInternalUnits( start ).c_str(),
+                    FormatInternalUnits( end ).c_str(),
+                    FormatInternalUnits( 250000 ).c_str(),
+                    aOut.Quotew( layer ).c_str(),
+                    (int) i % 1000 );
+
+        const std::string& text = aOut.Quotew( aLines[i] );
+
+        aOut.Print( 1, "(gr_text %s (at %s %s) (layer %s))\n",
+                    text.c_str(),
+                    FormatInternalUnits( start ).c_str(),
+                    FormatAngle( 900.0 * ( i % 4 ) ).c_str(),
+                    aOut.Quotew( layer ).c_str() );
+
+        report.linesRead++;
+        report.charAcc += (unsigned char) text[1];
+    }
+
+    aOut.Print( 0, ")\n" );
+}
+
+
+/**
+ * Read all the lines of a file to be saved by save_lines()
+ */
+static std::vector<wxString> read_lines( const wxFileName& aFile )
+{
+    std::vector<wxString> lines;
+    FILE_LINE_READER      reader( aFile.GetFullPath() );
+
+    while( reader.ReadLine() )
+        lines.push_back( wxString::FromUTF8( reader.Line() ).Trim() );
+
+    return lines;
+}
+
+
+/**
+ * Benchmark of the save of a board file to a STRING_FORMATTER.
+ * The formatter is recreated for each cycle.
+ */
+static void bench_save_string( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    std::vector<wxString> lines = read_lines( aFile );
+
+    for( int i = 0; i < aReps; ++i )
+    {
+        STRING_FORMATTER formatter;
+
+        save_lines( formatter, lines, report );
+    }
+}
+
+
+/**
+ * Benchmark of the save of a board file to a temporary file with a FILE_OUTPUTFORMATTER.
+ * The formatter is recreated for each cycle.
+ */
+static void bench_save_file( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    std::vector<wxString> lines = read_lines( aFile );
+    wxString              tempFile = wxFileName::CreateTempFileName( "io_benchmark" );
+
+    for( int i = 0; i < aReps; ++i )
+    {
+        FILE_OUTPUTFORMATTER formatter( tempFile );
+
+        save_lines( formatter, lines, report );
+    }
+
+    wxRemoveFile( tempFile );
+}
+
+
 /**
  * List of available benchmarks
  */
@@ -324,6 +421,8 @@ static std::vector<BENCHMARK> benchmarkList =
     { 'B', bench_wxbis_reuse<wxFileInputStream>, "wxFileIStream, buf'd, reused" },
     { 'c', bench_wxbis<wxFFileInputStream>, "wxFFileIStream. buf'd" },
     { 'C', bench_wxbis_reuse<wxFFileInputStream>, "wxFFileIStream, buf'd, reused" },
+    { 'o', bench_save_string, "RichIO STRING_O_F save" },
+    { 'O', bench_save_file, "RichIO FILE_O_F save" },
 };
 
 
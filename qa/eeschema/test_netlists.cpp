@@ -21,6 +21,7 @@
 #include "eeschema_test_utils.h"
 
 #include <connection_graph.h>
+#include <netlist_exporter_generic.h>
 #include <netlist_exporter_kicad.h>
 #include <netlist_reader/netlist_reader.h>
 #include <netlist_reader/pcb_netlist.h>
@@ -31,6 +32,8 @@
 #include <settings/settings_manager.h>
 #include <wildcards_and_files_ext.h>
 
+#include <wx/mstream.h>
+
 
 class TEST_NETLISTS_FIXTURE
 {
@@ -54,6 +57,8 @@ public:
 
     void doNetlistTest( const wxString& aBaseName );
 
+    void doXmlNetlistTest( const wxString& aBaseName );
+
     ///> Schematic to load
     SCHEMATIC m_schematic;
 
@@ -208,6 +213,79 @@ void TEST_NETLISTS_FIXTURE::doNetlistTest( const wxString& aBaseName )
 }
 
 
+/**
+ * Gives access to the two ways of the generic exporter to make the XML netlist.
+ */
+class TEST_NETLIST_EXPORTER_GENERIC : public NETLIST_EXPORTER_GENERIC
+{
+public:
+    TEST_NETLIST_EXPORTER_GENERIC( SCHEMATIC* aSchematic ) :
+            NETLIST_EXPORTER_GENERIC( aSchematic )
+    {
+    }
+
+    /// The netlist saved by wxXmlDocument from the tree of the whole netlist
+    std::string SaveTree( unsigned aCtl )
+    {
+        wxXmlDocument        xdoc;
+        wxMemoryOutputStream stream;
+
+        xdoc.SetRoot( makeRoot( aCtl ) );
+        BOOST_REQUIRE( xdoc.Save( stream, 2 ) );
+
+        std::string text( stream.GetLength(), '\0' );
+        stream.CopyTo( &text[0], text.size() );
+
+        return text;
+    }
+
+    /// The netlist streamed by WriteNetlist()
+    std::string Format( unsigned aCtl )
+    {
+        STRING_FORMATTER formatter;
+
+        formatXml( &formatter, aCtl );
+
+        return formatter.GetString();
+    }
+};
+
+
+/**
+ * Removes the date of the header of an XML netlist, the netlists compared being made one
+ * after the other.
+ */
+static std::string withoutDate( std::string aNetlist )
+{
+    size_t start = aNetlist.find( "<date>" );
+    size_t end = aNetlist.find( "</date>", start );
+
+    if( start != std::string::npos && end != std::string::npos )
+        aNetlist.erase( start, end - start );
+
+    return aNetlist;
+}
+
+
+void TEST_NETLISTS_FIXTURE::doXmlNetlistTest( const wxString& aBaseName )
+{
+    loadSchematic( aBaseName );
+
+    TEST_NETLIST_EXPORTER_GENERIC exporter( &m_schematic );
+
+    for( unsigned ctl : { GNL_ALL, GNL_ALL | GNL_OPT_BOM, GNL_ALL | GNL_OPT_KICAD } )
+    {
+        BOOST_TEST_CONTEXT( "Options " << ctl )
+        {
+            std::string tree = withoutDate( exporter.SaveTree( ctl ) );
+            std::string streamed = withoutDate( exporter.Format( ctl ) );
+
+            BOOST_CHECK_EQUAL( streamed, tree );
+        }
+    }
+}
+
+
 BOOST_FIXTURE_TEST_SUITE( Netlists, TEST_NETLISTS_FIXTURE )
 
 
@@ -247,5 +325,20 @@ BOOST_AUTO_TEST_CASE( WeakVectorBusDisambiguation )
 }
 
 
+/**
+ * The streamed XML netlist has the same bytes as the netlist saved from the whole tree
+ */
+BOOST_AUTO_TEST_CASE( XmlVideo )
+{
+    doXmlNetlistTest( "video" );
+}
+
+
+BOOST_AUTO_TEST_CASE( XmlComplexHierarchy )
+{
+    doXmlNetlistTest( "complex_hierarchy" );
+}
+
+
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,228 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the flash arrays of the gerber images (GERBER_DRAW_ITEM::IsFlashArray())
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <gerber_file_image.h>
+
+#include <convert_to_biu.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <set>
+
+
+namespace
+{
+
+/**
+ * A temporary gerber file, removed when going out of scope.
+ */
+struct GERBER_FILE
+{
+    GERBER_FILE( const std::string& aContent ) :
+            m_fileName( wxFileName::CreateTempFileName( "flash_arrays" ) )
+    {
+        wxFFile file( m_fileName, "wb" );
+        file.Write( aContent.data(), aContent.size() );
+    }
+
+    ~GERBER_FILE()
+    {
+        wxRemoveFile( m_fileName );
+    }
+
+    wxString m_fileName;
+};
+
+
+/**
+ * Flashes D10 three times, D11 once and D10 again, dark then clear, then draws a line
+ * with D10.
+ */
+const std::string flashesFile =
+        "%FSLAX26Y26*%\n"
+        "%MOMM*%\n"
+        "%ADD10C,1.000000*%\n"
+        "%ADD11R,2.000000X1.000000*%\n"
+        "G01*\n"
+        "D10*\n"
+        "X0Y0D03*\n"
+        "X5000000Y0D03*\n"
+        "X10000000Y0D03*\n"
+        "D11*\n"
+        "X0Y5000000D03*\n"
+        "D10*\n"
+        "X0Y10000000D03*\n"
+        "%LPC*%\n"
+        "X5000000Y10000000D03*\n"
+        "%LPD*%\n"
+        "X0Y0D02*\n"
+        "X10000000Y0D01*\n"
+        "M02*\n";
+
+
+/**
+ * Flashes D10 once, repeated 3 times on X axis and 2 times on Y axis.
+ */
+const std::string stepAndRepeatFile =
+        "%FSLAX26Y26*%\n"
+        "%MOMM*%\n"
+        "%ADD10C,1.000000*%\n"
+        "%SRX3Y2I5.0J5.0*%\n"
+        "D10*\n"
+        "X0Y0D03*\n"
+        "%SR*%\n"
+        "M02*\n";
+
+
+wxPoint mmPoint( double aX, double aY )
+{
+    return wxPoint( Millimeter2iu( aX ), Millimeter2iu( aY ) );
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( FlashArrays )
+
+
+/**
+ * Consecutive flashes of a D_CODE with the same polarity share one item
+ */
+BOOST_AUTO_TEST_CASE( Grouping )
+{
+    GERBER_FILE       file( flashesFile );
+    GERBER_FILE_IMAGE image( 0 );
+
+    BOOST_REQUIRE( image.LoadGerberFile( file.m_fileName ) );
+
+    GERBER_DRAW_ITEMS& items = image.GetItems();
+
+    BOOST_REQUIRE_EQUAL( items.size(), 5u );
+
+    BOOST_CHECK_EQUAL( items[0]->m_DCode, 10 );
+    BOOST_CHECK_EQUAL( items[0]->GetFlashCount(), 3u );
+    BOOST_CHECK_EQUAL( items[1]->m_DCode, 11 );
+    BOOST_CHECK_EQUAL( items[1]->GetFlashCount(), 1u );
+    BOOST_CHECK_EQUAL( items[2]->m_DCode, 10 );
+    BOOST_CHECK_EQUAL( items[2]->GetFlashCount(), 1u );
+    BOOST_CHECK( !items[2]->GetLayerPolarity() );
+    BOOST_CHECK_EQUAL( items[3]->GetFlashCount(), 1u );
+    BOOST_CHECK( items[3]->GetLayerPolarity() );
+    BOOST_CHECK( !items[4]->IsFlashArray() );
+    BOOST_CHECK_EQUAL( items[4]->m_Shape, GBR_SEGMENT );
+
+    BOOST_CHECK_EQUAL( image.GetDCODE( 10 )->m_Flashes.size(), 5u );
+    BOOST_CHECK_EQUAL( image.GetDCODE( 11 )->m_Flashes.size(), 1u );
+}
+
+
+/**
+ * The flashes of an array are single flashed items at the flash positions
+ */
+BOOST_AUTO_TEST_CASE( Flashes )
+{
+    GERBER_FILE       file( flashesFile );
+    GERBER_FILE_IMAGE image( 0 );
+
+    BOOST_REQUIRE( image.LoadGerberFile( file.m_fileName ) );
+
+    GERBER_DRAW_ITEM* array = image.GetItems()[0];
+
+    BOOST_CHECK( array->GetPosition() == mmPoint( 0, 0 ) );
+
+    for( unsigned ii = 0; ii < array->GetFlashCount(); ii++ )
+    {
+        BOOST_TEST_CONTEXT( "Flash " << ii )
+        {
+            GERBER_DRAW_ITEM flash = array->GetFlash( ii );
+
+            BOOST_CHECK( !flash.IsFlashArray() );
+            BOOST_CHECK( flash.m_Flashed );
+            BOOST_CHECK_EQUAL( flash.m_DCode, 10 );
+            BOOST_CHECK_EQUAL( flash.m_Shape, GBR_SPOT_CIRCLE );
+            BOOST_CHECK( flash.GetPosition() == mmPoint( 5 * ii, 0 ) );
+
+            // The array is found where its flashes are
+            wxPoint pos = flash.GetABPosition( flash.GetPosition() );
+
+            BOOST_CHECK( array->HitTest( pos ) );
+            BOOST_CHECK( array->GetBoundingBox().Contains( pos ) );
+        }
+    }
+
+    // But not between them
+    BOOST_CHECK( !array->HitTest( array->GetABPosition( mmPoint( 2.5, 0 ) ) ) );
+    BOOST_CHECK( !array->HitTest( array->GetABPosition( mmPoint( 0, 2.5 ) ) ) );
+
+    // The clear flash keeps its polarity
+    GERBER_DRAW_ITEM clearFlash = image.GetItems()[3]->GetFlash( 0 );
+
+    BOOST_CHECK( clearFlash.GetLayerPolarity() );
+    BOOST_CHECK( clearFlash.GetPosition() == mmPoint( 5, 10 ) );
+}
+
+
+/**
+ * The copies of a step and repeat flash are added to the same flash array
+ */
+BOOST_AUTO_TEST_CASE( StepAndRepeat )
+{
+    GERBER_FILE       file( stepAndRepeatFile );
+    GERBER_FILE_IMAGE image( 0 );
+
+    BOOST_REQUIRE( image.LoadGerberFile( file.m_fileName ) );
+    BOOST_REQUIRE_EQUAL( image.GetItems().size(), 1u );
+
+    GERBER_DRAW_ITEM* array = image.GetItems()[0];
+
+    BOOST_REQUIRE_EQUAL( array->GetFlashCount(), 6u );
+
+    std::set<std::pair<int, int>> positions;
+
+    for( unsigned ii = 0; ii < array->GetFlashCount(); ii++ )
+    {
+        wxPoint pos = array->GetFlash( ii ).GetPosition();
+        positions.emplace( pos.x, pos.y );
+    }
+
+    for( int x = 0; x < 3; x++ )
+    {
+        for( int y = 0; y < 2; y++ )
+        {
+            wxPoint pos = mmPoint( 5 * x, 5 * y );
+            BOOST_CHECK( positions.count( { pos.x, pos.y } ) == 1 );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/polygon_triangulation.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/geometry/poly_set_construction.h>
+
+#include <cmath>
+
+
+namespace
+{
+
+using KI_TEST::PolySetArea;
+
+/**
+ * Triangles reuse the polygon's vertices, so the areas only differ by summation rounding.
+ * The tolerance is in percent.
+ */
+const double AREA_TOL_PCT = 1e-6;
+
+/**
+ * A plane with a dense grid of octagonal holes: enough vertices for the triangulation to be
+ * spread over threads, and plenty of bridges from the fracturing.
+ */
+struct TriangulationFixture
+{
+    SHAPE_POLY_SET m_plane;
+    SHAPE_POLY_SET m_holes;
+
+    TriangulationFixture()
+    {
+        m_plane = KI_TEST::BuildPolyset( {
+                KI_TEST::BuildRectChain( { 1000000, 800000 }, { 500000, 400000 } ),
+        } );
+
+        m_holes = KI_TEST::BuildOctagonGrid( { 10000, 10000 }, { 1000000, 800000 },
+                                             { 25000, 20000 }, 4000, 6000 );
+
+        m_plane.BooleanSubtract( m_holes, SHAPE_POLY_SET::PM_FAST );
+    }
+
+    static double triangleArea( const SHAPE_POLY_SET::TRIANGULATED_POLYGON& aPoly )
+    {
+        double total = 0.0;
+
+        for( size_t ii = 0; ii < aPoly.GetTriangleCount(); ii++ )
+        {
+            VECTOR2I a, b, c;
+            aPoly.GetTriangle( ii, a, b, c );
+
+            total += std::abs( (double) ( b.x - a.x ) * ( c.y - a.y )
+                               - (double) ( c.x - a.x ) * ( b.y - a.y ) ) / 2.0;
+        }
+
+        return total;
+    }
+
+    static double triangleArea( const SHAPE_POLY_SET& aSet )
+    {
+        double total = 0.0;
+
+        for( unsigned ii = 0; ii < aSet.TriangulatedPolyCount(); ii++ )
+            total += triangleArea( *aSet.TriangulatedPolygon( ii ) );
+
+        return total;
+    }
+};
+
+} // namespace
+
+
+BOOST_FIXTURE_TEST_SUITE( PolyTriangulation, TriangulationFixture )
+
+
+/**
+ * A simple polygon with n vertices always splits into n - 2 triangles
+ */
+BOOST_AUTO_TEST_CASE( SimplePolygon )
+{
+    SHAPE_LINE_CHAIN                     chain = KI_TEST::BuildOctagonChain( { 0, 0 }, 100000 );
+    SHAPE_POLY_SET::TRIANGULATED_POLYGON result;
+    PolygonTriangulation                 tess( result );
+
+    BOOST_CHECK( tess.TesselatePolygon( chain ) );
+    BOOST_CHECK_EQUAL( result.GetTriangleCount(), chain.PointCount() - 2 );
+    BOOST_CHECK_CLOSE( triangleArea( result ), std::abs( chain.Area() ), AREA_TOL_PCT );
+}
+
+
+BOOST_AUTO_TEST_CASE( PlaneWithHoles )
+{
+    for( bool partition : { false, true } )
+    {
+        BOOST_TEST_CONTEXT( ( partition ? "partitioned" : "whole" ) )
+        {
+            SHAPE_POLY_SET poly = m_plane;
+            poly.CacheTriangulation( partition );
+
+            BOOST_CHECK( poly.IsTriangulationUpToDate() );
+            BOOST_CHECK_CLOSE( triangleArea( poly ), PolySetArea( m_plane ), AREA_TOL_PCT );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( ManyOutlines )
+{
+    SHAPE_POLY_SET poly = m_holes;
+    poly.CacheTriangulation( false );
+
+    BOOST_CHECK( poly.IsTriangulationUpToDate() );
+    BOOST_CHECK_EQUAL( poly.TriangulatedPolyCount(), m_holes.OutlineCount() );
+    BOOST_CHECK_CLOSE( triangleArea( poly ), PolySetArea( m_holes ), AREA_TOL_PCT );
+}
+
+/**
+ * An outline the tesselator rejects gets a second pass, and is dropped when fracturing it
+ * leaves nothing.  The triangles of the other outlines, found in the first pass, are kept.
+ */
+BOOST_AUTO_TEST_CASE( DegenerateOutlineIsDropped )
+{
+    SHAPE_LINE_CHAIN degenerate( { { 0, 0 }, { 50000, 0 }, { 100000, 0 } } );
+    degenerate.SetClosed( true );
+
+    SHAPE_POLY_SET poly = KI_TEST::BuildPolyset( {
+            KI_TEST::BuildOctagonChain( { 0, 300000 }, 100000 ),
+            degenerate,
+            KI_TEST::BuildOctagonChain( { 300000, 300000 }, 100000 ),
+    } );
+
+    poly.CacheTriangulation( false );
+
+    BOOST_CHECK( poly.IsTriangulationUpToDate() );
+    BOOST_CHECK_EQUAL( poly.TriangulatedPolyCount(), 2 );
+    BOOST_CHECK_CLOSE( triangleArea( poly ), PolySetArea( poly ), AREA_TOL_PCT );
+
+    // Only the cache is affected: the set keeps its outlines
+    BOOST_CHECK_EQUAL( poly.OutlineCount(), 3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/geometry/line_chain_construction.h>
+#include <qa_utils/geometry/poly_set_construction.h>
+
+
+namespace
+{
+
+/**
+ * A row of squares of increasing sizes, so each polygon can be told from its area
+ */
+SHAPE_POLY_SET buildSquares( int aCount )
+{
+    std::vector<SHAPE_LINE_CHAIN> outlines;
+
+    for( int ii = 0; ii < aCount; ++ii )
+        outlines.push_back( KI_TEST::BuildRectChain( { 10 + ii, 10 + ii }, { 100 * ii, 0 } ) );
+
+    return KI_TEST::BuildPolyset( outlines );
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( ShapePolySetDelete )
+
+
+/**
+ * Check that DeletePolygons() deletes the marked polygons and keeps the others in order,
+ * like the same deletions done with DeletePolygon() from the last to the first.
+ */
+BOOST_AUTO_TEST_CASE( DeleteMarkedPolygons )
+{
+    const int         count = 9;
+    std::vector<bool> deleted = { true, false, false, true, true, false, true, false, true };
+
+    SHAPE_POLY_SET polys = buildSquares( count );
+    SHAPE_POLY_SET expected = buildSquares( count );
+
+    for( int ii = count - 1; ii >= 0; --ii )
+    {
+        if( deleted[ii] )
+            expected.DeletePolygon( ii );
+    }
+
+    polys.DeletePolygons( deleted );
+
+    BOOST_REQUIRE_EQUAL( polys.OutlineCount(), expected.OutlineCount() );
+
+    for( int ii = 0; ii < polys.OutlineCount(); ++ii )
+        BOOST_CHECK_EQUAL( polys.COutline( ii ).Area(), expected.COutline( ii ).Area() );
+}
+
+
+/**
+ * Check that the polygons beyond the size of the mask are kept
+ */
+BOOST_AUTO_TEST_CASE( ShortMask )
+{
+    SHAPE_POLY_SET polys = buildSquares( 4 );
+    double         lastArea = polys.COutline( 3 ).Area();
+
+    polys.DeletePolygons( { true } );
+
+    BOOST_REQUIRE_EQUAL( polys.OutlineCount(), 3 );
+    BOOST_CHECK_EQUAL( polys.COutline( 2 ).Area(), lastArea );
+
+    polys.DeletePolygons( {} );
+
+    BOOST_CHECK_EQUAL( polys.OutlineCount(), 3 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
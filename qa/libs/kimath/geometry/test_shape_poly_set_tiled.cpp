@@ -0,0 +1,191 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/geometry/poly_set_construction.h>
+
+#include <cmath>
+
+
+namespace
+{
+
+using KI_TEST::PolySetArea;
+
+/**
+ * Tiles cut edges along their seams, and the rounded cut points move the edges by up to half
+ * a unit, so the areas only match to within a few parts in 10^7.  The tolerance is in percent.
+ */
+const double AREA_TOL_PCT = 1e-4;
+
+/**
+ * A plane with a regular grid of octagonal "clearance holes", several of which straddle the
+ * tile seams, plus a second set of overlapping octagons to union.
+ */
+struct TiledFixture
+{
+    SHAPE_POLY_SET m_plane;
+    SHAPE_POLY_SET m_holes;
+
+    TiledFixture()
+    {
+        m_plane = KI_TEST::BuildPolyset( {
+                KI_TEST::BuildRectChain( { 1000000, 800000 }, { 500000, 400000 } ),
+        } );
+
+        m_holes = KI_TEST::BuildOctagonGrid( { 10000, 10000 }, { 1000000, 800000 },
+                                             { 37000, 29000 }, 9000, 11000 );
+    }
+};
+
+} // namespace
+
+
+BOOST_FIXTURE_TEST_SUITE( SPSTiled, TiledFixture )
+
+
+BOOST_AUTO_TEST_CASE( Subtract )
+{
+    SHAPE_POLY_SET expected = m_plane;
+    expected.BooleanSubtract( m_holes, SHAPE_POLY_SET::PM_FAST );
+
+    for( int tiles : { 2, 3, 8 } )
+    {
+        BOOST_TEST_CONTEXT( tiles << " tiles" )
+        {
+            SHAPE_POLY_SET tiled = m_plane;
+            tiled.BooleanSubtractTiled( m_holes, SHAPE_POLY_SET::PM_FAST, tiles );
+
+            BOOST_CHECK_EQUAL( tiled.OutlineCount(), expected.OutlineCount() );
+            BOOST_CHECK_EQUAL( tiled.HoleCount( 0 ), expected.HoleCount( 0 ) );
+            BOOST_CHECK_CLOSE( PolySetArea( tiled ), PolySetArea( expected ), AREA_TOL_PCT );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( AddAndIntersect )
+{
+    SHAPE_POLY_SET shifted = m_holes;
+    shifted.Move( { 7000, 5000 } );
+
+    SHAPE_POLY_SET expectedAdd = m_holes;
+    expectedAdd.BooleanAdd( shifted, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET expectedIntersect = m_holes;
+    expectedIntersect.BooleanIntersection( shifted, SHAPE_POLY_SET::PM_FAST );
+
+    for( int tiles : { 2, 5 } )
+    {
+        BOOST_TEST_CONTEXT( tiles << " tiles" )
+        {
+            SHAPE_POLY_SET tiledAdd = m_holes;
+            tiledAdd.BooleanAddTiled( shifted, SHAPE_POLY_SET::PM_FAST, tiles );
+
+            BOOST_CHECK_EQUAL( tiledAdd.OutlineCount(), expectedAdd.OutlineCount() );
+            BOOST_CHECK_CLOSE( PolySetArea( tiledAdd ), PolySetArea( expectedAdd ), AREA_TOL_PCT );
+
+            SHAPE_POLY_SET tiledIntersect = m_holes;
+            tiledIntersect.BooleanIntersectionTiled( shifted, SHAPE_POLY_SET::PM_FAST, tiles );
+
+            // Pieces which only touch at a vertex may get joined across a seam
+            BOOST_CHECK_LE( tiledIntersect.OutlineCount(), expectedIntersect.OutlineCount() );
+            BOOST_CHECK_CLOSE( PolySetArea( tiledIntersect ), PolySetArea( expectedIntersect ),
+                               AREA_TOL_PCT );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( InflateAndFracture )
+{
+    SHAPE_POLY_SET expected = m_plane;
+    expected.BooleanSubtract( m_holes, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET tiled = m_plane;
+    tiled.BooleanSubtractTiled( m_holes, SHAPE_POLY_SET::PM_FAST, 4 );
+
+    expected.Deflate( 2000, 16 );
+    tiled.InflateTiled( -2000, 16, SHAPE_POLY_SET::ROUND_ALL_CORNERS, 4 );
+    BOOST_CHECK_CLOSE( PolySetArea( tiled ), PolySetArea( expected ), AREA_TOL_PCT );
+
+    SHAPE_POLY_SET expectedHoles = m_holes;
+    expectedHoles.Inflate( 6000, 16 );
+
+    SHAPE_POLY_SET tiledHoles = m_holes;
+    tiledHoles.InflateTiled( 6000, 16, SHAPE_POLY_SET::ROUND_ALL_CORNERS, 4 );
+    BOOST_CHECK_EQUAL( tiledHoles.OutlineCount(), expectedHoles.OutlineCount() );
+    BOOST_CHECK_CLOSE( PolySetArea( tiledHoles ), PolySetArea( expectedHoles ), AREA_TOL_PCT );
+
+    double before = PolySetArea( tiled );
+    tiled.FractureTiled( SHAPE_POLY_SET::PM_FAST, 4 );
+    expected.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK( !tiled.HasHoles() );
+    BOOST_CHECK_EQUAL( tiled.OutlineCount(), expected.OutlineCount() );
+    BOOST_CHECK_CLOSE( PolySetArea( tiled ), before, AREA_TOL_PCT );
+}
+
+
+/**
+ * A polygon which is final in the first tile, then a plane crossing the seam whose hole is
+ * held back by a later tile: the hole must go back into the plane, after the final polygons
+ * of the earlier tiles were collected.
+ */
+BOOST_AUTO_TEST_CASE( HoleHeldInLaterTile )
+{
+    SHAPE_POLY_SET polys = KI_TEST::BuildPolyset( {
+            KI_TEST::BuildRectChain( { 50, 50 }, { 125, 125 } ),
+            KI_TEST::BuildRectChain( { 1000, 400 }, { 500, 800 } ),
+    } );
+
+    polys.AddHole( KI_TEST::BuildRectChain( { 50, 50 }, { 800, 800 } ) );
+
+    SHAPE_POLY_SET expected = polys;
+    expected.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET tiled = polys;
+    tiled.SimplifyTiled( SHAPE_POLY_SET::PM_FAST, 2 );
+
+    BOOST_REQUIRE_EQUAL( tiled.OutlineCount(), 2 );
+    BOOST_CHECK_EQUAL( tiled.HoleCount( 0 ) + tiled.HoleCount( 1 ), 1 );
+    BOOST_CHECK_CLOSE( PolySetArea( tiled ), PolySetArea( expected ), AREA_TOL_PCT );
+}
+
+
+BOOST_AUTO_TEST_CASE( SingleTileFallsBack )
+{
+    SHAPE_POLY_SET expected = m_plane;
+    expected.BooleanSubtract( m_holes, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET tiled = m_plane;
+    tiled.BooleanSubtractTiled( m_holes, SHAPE_POLY_SET::PM_FAST, 1 );
+
+    BOOST_CHECK_EQUAL( tiled.Format(), expected.Format() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
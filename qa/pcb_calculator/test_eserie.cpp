@@ -0,0 +1,251 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the E-series solver of pcb_calculator, compared to the brute force search
+ * of all the combinations
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Code under test
+#include <eserie.h>
+
+
+/**
+ * Best deviations of all the 2R, 3R and 4R combinations of some values
+ */
+struct BRUTE_FORCE_RESULT
+{
+    double m_dev2R;
+    double m_dev3R;
+    double m_dev4R;
+};
+
+
+static BRUTE_FORCE_RESULT bruteForce( const std::vector<double>& aValues, double aReqR,
+                                      bool aWith4R )
+{
+    const double     max = std::numeric_limits<double>::max();
+    BRUTE_FORCE_RESULT result = { max, max, max };
+    std::vector<double> cmb;
+
+    for( double a : aValues )
+    {
+        for( double b : aValues )
+        {
+            cmb.push_back( a + b );
+            cmb.push_back( a * b / ( a + b ) );
+        }
+    }
+
+    for( double c : cmb )
+        result.m_dev2R = std::min( result.m_dev2R, std::abs( c - aReqR ) );
+
+    for( double a : aValues )
+    {
+        for( double c : cmb )
+        {
+            result.m_dev3R = std::min( result.m_dev3R, std::abs( c + a - aReqR ) );
+            result.m_dev3R = std::min( result.m_dev3R, std::abs( a * c / ( a + c ) - aReqR ) );
+        }
+    }
+
+    if( aWith4R )
+    {
+        for( double c : cmb )
+        {
+            for( double d : cmb )
+            {
+                result.m_dev4R = std::min( result.m_dev4R, std::abs( c + d - aReqR ) );
+                result.m_dev4R = std::min( result.m_dev4R, std::abs( c * d / ( c + d ) - aReqR ) );
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Values of the E1 to E12 series, in the same decades as the solver
+ */
+static std::vector<double> serieValues( int aSerie )
+{
+    static const std::vector<std::vector<int>> mantissas = {
+        { 10 },
+        { 10, 22, 47 },
+        { 10, 15, 22, 33, 47, 68 },
+        { 10, 12, 15, 18, 22, 27, 33, 39, 47, 56, 68, 82 }
+    };
+
+    std::vector<double> values;
+
+    for( double decade = 1; decade < 1e5; decade *= 10 )
+    {
+        for( int m : mantissas[aSerie] )
+            values.push_back( m * decade );
+    }
+
+    values.push_back( 1e6 );
+    return values;
+}
+
+
+/**
+ * Solves aReqR and compares the solutions to the brute force search.  Like the calculator,
+ * the required value is excluded, with aExclude.
+ */
+static void checkSolution( int aSerie, double aReqR, double aExclude, bool aWith4R )
+{
+    eserie solver;
+
+    solver.set_rb( aSerie );
+    solver.set_reqR( aReqR );
+    solver.new_calc();
+    solver.exclude( aReqR );
+    solver.exclude( aExclude );
+    solver.calculate();
+
+    std::vector<double> values;
+
+    for( double v : serieValues( aSerie ) )
+    {
+        if( v != aReqR && v != aExclude )
+            values.push_back( v );
+    }
+
+    BRUTE_FORCE_RESULT expected = bruteForce( values, aReqR, aWith4R );
+    std::array<r_data, S4R + 1> rslt = solver.get_rslt();
+
+    // Equal deviations can be reached by different combinations and rounding
+    const double tol = aReqR * 1e-12;
+
+    BOOST_TEST_CONTEXT( "Serie " << aSerie << ", R = " << aReqR << ", excluded " << aExclude )
+    {
+        BOOST_REQUIRE( rslt[S2R].e_use );
+        BOOST_CHECK_SMALL( std::abs( rslt[S2R].e_value ) - expected.m_dev2R, tol );
+
+        if( expected.m_dev2R == 0.0 )
+            return;
+
+        if( expected.m_dev3R < expected.m_dev2R - tol )
+        {
+            BOOST_REQUIRE( rslt[S3R].e_use );
+            BOOST_CHECK_SMALL( std::abs( rslt[S3R].e_value ) - expected.m_dev3R, tol );
+        }
+        else if( expected.m_dev3R > expected.m_dev2R + tol )
+        {
+            BOOST_CHECK( !rslt[S3R].e_use );
+        }
+
+        if( !aWith4R || !rslt[S3R].e_use || rslt[S3R].e_value == 0.0 )
+            return;
+
+        if( expected.m_dev4R < expected.m_dev3R - tol )
+        {
+            BOOST_REQUIRE( rslt[S4R].e_use );
+            BOOST_CHECK_SMALL( std::abs( rslt[S4R].e_value ) - expected.m_dev4R, tol );
+        }
+        else if( expected.m_dev4R > expected.m_dev3R + tol )
+        {
+            BOOST_CHECK( !rslt[S4R].e_use );
+        }
+    }
+}
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_AUTO_TEST_SUITE( ESerie )
+
+
+/**
+ * 2R and 3R solutions of the E1 to E12 series, over the whole range of the calculator
+ */
+BOOST_AUTO_TEST_CASE( BruteForce3R )
+{
+    for( int serie = E1; serie <= E12; serie++ )
+    {
+        for( double reqR = 2.5; reqR < 4e6; reqR *= 1.37 )
+        {
+            checkSolution( serie, reqR, 0, false );
+            checkSolution( serie, reqR, 4700, false );
+        }
+
+        // Values of the serie are excluded from their own solutions
+        for( double reqR : serieValues( serie ) )
+            checkSolution( serie, reqR, 0, false );
+    }
+}
+
+
+/**
+ * 4R solutions, only for a few values of the largest series: the brute force search is slow
+ */
+BOOST_AUTO_TEST_CASE( BruteForce4R )
+{
+    for( int serie = E1; serie <= E6; serie++ )
+    {
+        for( double reqR = 3.1; reqR < 4e6; reqR *= 4.7 )
+            checkSolution( serie, reqR, 0, true );
+    }
+
+    for( double reqR : { 9.0, 1234.5, 5000.0, 77777.0 } )
+        checkSolution( E12, reqR, 3900, true );
+}
+
+
+/**
+ * The series E24 to E192 are built from IEC 60063, with its irregular values
+ */
+BOOST_AUTO_TEST_CASE( LargeSeries )
+{
+    eserie solver;
+
+    // 920 is an irregular value of E192, 10R + 9K2 is the first of the exact solutions
+    solver.set_rb( E192 );
+    solver.set_reqR( 9210 );
+    solver.new_calc();
+    solver.calculate();
+
+    BOOST_CHECK_EQUAL( solver.get_rslt()[S2R].e_value, 0.0 );
+    BOOST_CHECK_EQUAL( solver.get_rslt()[S2R].e_name, "10R + 9K2" );
+
+    // E48 is every 4th value of E192: 10K2 is not in E48, but 10K5 is
+    solver.set_rb( E48 );
+    solver.set_reqR( 10510 );
+    solver.new_calc();
+    solver.calculate();
+
+    BOOST_CHECK_EQUAL( solver.get_rslt()[S2R].e_value, 0.0 );
+    BOOST_CHECK_EQUAL( solver.get_rslt()[S2R].e_name, "10R + 10K5" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,226 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for TRANSLINE_SWEEP, compared to the analysis of single lines, and its throughput
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <memory>
+
+// Code under test
+#include <transline_sweep.h>
+#include <c_microstrip.h>
+#include <microstrip.h>
+#include <stripline.h>
+#include <units_scales.h>
+
+
+/*
+ * The lines are analyzed without the dialog, but the transline classes are linked with
+ * their dialog accessors: these ones must never be called.
+ */
+void SetPropertyInDialog( enum PRMS_ID aPrmId, double value )
+{
+    BOOST_ERROR( "SetPropertyInDialog called" );
+}
+
+
+void SetResultInDialog( int line, const char* text )
+{
+    BOOST_ERROR( "SetResultInDialog called" );
+}
+
+
+void SetResultInDialog( int aLineNumber, double aValue, const char* aText )
+{
+    BOOST_ERROR( "SetResultInDialog called" );
+}
+
+
+double GetPropertyInDialog( enum PRMS_ID aPrmId )
+{
+    BOOST_ERROR( "GetPropertyInDialog called" );
+    return 1.0;
+}
+
+
+bool IsSelectedInDialog( enum PRMS_ID aPrmId )
+{
+    BOOST_ERROR( "IsSelectedInDialog called" );
+    return false;
+}
+
+
+void SetPropertyBgColorInDialog( enum PRMS_ID aPrmId, const KIGFX::COLOR4D* aCol )
+{
+    BOOST_ERROR( "SetPropertyBgColorInDialog called" );
+}
+
+
+/**
+ * Sets the default parameters of the calculator: a 0.2 mm line on 0.2 mm FR4, at 1 GHz
+ */
+static void setDefaults( TRANSLINE& aLine )
+{
+    for( int ii = 0; ii < DUMMY_PRM; ++ii )
+        aLine.setParameter( ii, 1.0 );
+
+    aLine.setParameter( EPSILONR_PRM, 4.6 );
+    aLine.setParameter( TAND_PRM, 2e-2 );
+    aLine.setParameter( RHO_PRM, 1.72e-8 );
+    aLine.setParameter( FREQUENCY_PRM, 1e9 );
+    aLine.setParameter( H_PRM, 0.2 * UNIT_MM );
+    aLine.setParameter( H_T_PRM, 1e20 * UNIT_MM );
+    aLine.setParameter( STRIPLINE_A_PRM, 0.2 * UNIT_MM );
+    aLine.setParameter( T_PRM, 0.035 * UNIT_MM );
+    aLine.setParameter( ROUGH_PRM, 0.0 );
+    aLine.setParameter( PHYS_WIDTH_PRM, 0.2 * UNIT_MM );
+    aLine.setParameter( PHYS_S_PRM, 0.2 * UNIT_MM );
+    aLine.setParameter( PHYS_LEN_PRM, 50 * UNIT_MM );
+}
+
+
+/**
+ * Sweeps aLine over widths and heights with aThreadCount threads, and checks every point
+ * gives exactly the results of the line analyzed alone
+ */
+static void checkSweep( const TRANSLINE& aLine, const std::vector<int>& aResults,
+                        size_t aThreadCount )
+{
+    TRANSLINE_SWEEP sweep( aLine );
+
+    sweep.AddAxis( PHYS_WIDTH_PRM, TRANSLINE_SWEEP::LinearValues( 0.1 * UNIT_MM,
+                                                                  0.5 * UNIT_MM, 9 ) );
+    sweep.AddAxis( H_PRM, TRANSLINE_SWEEP::LinearValues( 0.5 * UNIT_MM, 1.6 * UNIT_MM, 70 ) );
+
+    for( int result : aResults )
+        sweep.AddResult( result );
+
+    sweep.SetThreadCount( aThreadCount );
+    sweep.Run();
+
+    BOOST_REQUIRE_EQUAL( sweep.GetPointCount(), 9 * 70 );
+
+    std::unique_ptr<TRANSLINE> line( aLine.clone() );
+
+    for( size_t pt = 0; pt < sweep.GetPointCount(); ++pt )
+    {
+        // The last axis changes first
+        BOOST_CHECK_EQUAL( sweep.GetInputs( 0 )[pt], sweep.GetInputs( 0 )[( pt / 70 ) * 70] );
+
+        line->setParameter( PHYS_WIDTH_PRM, sweep.GetInputs( 0 )[pt] );
+        line->setParameter( H_PRM, sweep.GetInputs( 1 )[pt] );
+        line->analyzeParameters();
+
+        for( size_t res = 0; res < aResults.size(); ++res )
+            BOOST_CHECK_EQUAL( sweep.GetResults( res )[pt], line->getParameter( aResults[res] ) );
+    }
+}
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_AUTO_TEST_SUITE( TranslineSweep )
+
+
+BOOST_AUTO_TEST_CASE( LinearValues )
+{
+    std::vector<double> values = TRANSLINE_SWEEP::LinearValues( 1.0, 2.0, 5 );
+
+    BOOST_REQUIRE_EQUAL( values.size(), 5 );
+    BOOST_CHECK_EQUAL( values[0], 1.0 );
+    BOOST_CHECK_EQUAL( values[2], 1.5 );
+    BOOST_CHECK_EQUAL( values[4], 2.0 );
+
+    BOOST_CHECK_EQUAL( TRANSLINE_SWEEP::LinearValues( 1.0, 2.0, 1 ).size(), 1 );
+    BOOST_CHECK( TRANSLINE_SWEEP::LinearValues( 1.0, 2.0, 0 ).empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( Microstrip )
+{
+    MICROSTRIP line;
+    setDefaults( line );
+
+    std::vector<int> results = { Z0_PRM, EPSILON_EFF_PRM, LOSS_CONDUCTOR_PRM,
+                                 LOSS_DIELECTRIC_PRM };
+
+    checkSweep( line, results, 1 );
+    checkSweep( line, results, 4 );
+
+    // The calculator default line is close to 50 Ohm
+    line.analyzeParameters();
+    BOOST_CHECK_CLOSE( line.getParameter( Z0_PRM ), 50.0, 15.0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Stripline )
+{
+    STRIPLINE line;
+    setDefaults( line );
+
+    checkSweep( line, { Z0_PRM, LOSS_CONDUCTOR_PRM, LOSS_DIELECTRIC_PRM }, 4 );
+}
+
+
+BOOST_AUTO_TEST_CASE( CoupledMicrostrip )
+{
+    C_MICROSTRIP line;
+    setDefaults( line );
+
+    checkSweep( line, { Z0_E_PRM, Z0_O_PRM }, 4 );
+}
+
+
+/**
+ * Reports the throughput of the sweep, for a stackup planning grid of microstrips
+ */
+BOOST_AUTO_TEST_CASE( Throughput )
+{
+    MICROSTRIP line;
+    setDefaults( line );
+
+    for( size_t threads : { 1, 0 } )
+    {
+        TRANSLINE_SWEEP sweep( line );
+
+        sweep.AddAxis( EPSILONR_PRM, { 3.5, 4.0, 4.6 } );
+        sweep.AddAxis( H_PRM, TRANSLINE_SWEEP::LinearValues( 0.07 * UNIT_MM, 1.6 * UNIT_MM, 100 ) );
+        sweep.AddAxis( PHYS_WIDTH_PRM,
+                       TRANSLINE_SWEEP::LinearValues( 0.075 * UNIT_MM, 1.0 * UNIT_MM, 200 ) );
+        sweep.AddResult( Z0_PRM );
+        sweep.SetThreadCount( threads );
+        sweep.Run();
+
+        BOOST_TEST_MESSAGE( sweep.GetPointCount() << " microstrips, "
+                            << ( threads ? "1 thread: " : "all threads: " )
+                            << sweep.GetRunTime() * 1000 / sweep.GetPointCount()
+                            << " ms per thousand geometries" );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,10 @@
 #include <boost/test/unit_test.hpp>
 
 
+#ifndef QA_PCBNEW_DATA_LOCATION
+    #define QA_PCBNEW_DATA_LOCATION "???"
+#endif
+
 namespace KI_TEST
 {
 
@@ -50,4 +54,17 @@ void BOARD_DUMPER::DumpBoardToFile( BOARD& aBoard, const std::string& aName ) co
     ::KI_TEST::DumpBoardToFile( aBoard, path.string() );
 }
 
+
+std::string GetPcbnewTestDataDir()
+{
+    const char* env = std::getenv( "KICAD_TEST_PCBNEW_DATA_DIR" );
+
+    // Use the env var if given, or the compiled-in location of the data dir (i.e. where the
+    // files were at build time)
+    std::string dir = env ? env : QA_PCBNEW_DATA_LOCATION;
+
+    // Ensure the string ends in / to force a directory interpretation
+    return dir + "/";
+}
+
 } // namespace KI_TEST
\ No newline at end of file
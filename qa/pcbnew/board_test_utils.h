@@ -58,6 +58,17 @@ public:
     const bool m_dump_boards;
 };
 
+
+/**
+ * Get the configured location of the Pcbnew test data (the boards in qa/data).
+ *
+ * By default, this is the test data directory in the source tree, but it can be overridden
+ * by the KICAD_TEST_PCBNEW_DATA_DIR environment variable.
+ *
+ * @return the directory, ending with a separator
+ */
+std::string GetPcbnewTestDataDir();
+
 } // namespace KI_TEST
 
 #endif // QA_PCBNEW_BOARD_TEST_UTILS__H
\ No newline at end of file
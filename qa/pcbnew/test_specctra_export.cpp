@@ -0,0 +1,86 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2019 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <class_board.h>
+#include <pcbnew_utils/board_file_utils.h>
+#include <richio.h>
+#include <specctra_import_export/specctra.h>
+
+#include "board_test_utils.h"
+
+
+/**
+ * Exports aBoard to the Specctra DSN format with aThreadCount threads making the images,
+ * in the same steps as PCB_EDIT_FRAME::ExportSpecctraFile()
+ */
+static std::string exportDSN( BOARD& aBoard, size_t aThreadCount )
+{
+    DSN::SPECCTRA_DB db;
+    STRING_FORMATTER formatter;
+    LOCALE_IO        toggle;
+
+    db.SetPCB( DSN::SPECCTRA_DB::MakePCB() );
+    db.SetThreadCount( aThreadCount );
+    db.FlipMODULEs( &aBoard );
+
+    aBoard.SynchronizeNetsAndNetClasses();
+    db.FromBOARD( &aBoard );
+    db.GetPCB()->Format( &formatter, 0 );
+
+    db.RevertMODULEs( &aBoard );
+
+    return formatter.GetString();
+}
+
+
+BOOST_AUTO_TEST_SUITE( SpecctraExport )
+
+
+/**
+ * The images are made in parallel: the output must not depend on the thread count
+ */
+BOOST_AUTO_TEST_CASE( ParallelImagesMatchSerial )
+{
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+            KI_TEST::GetPcbnewTestDataDir() + "complex_hierarchy.kicad_pcb" );
+
+    BOOST_REQUIRE( board );
+    BOOST_REQUIRE( !board->Modules().empty() );
+
+    std::string serial = exportDSN( *board, 1 );
+
+    BOOST_CHECK_NE( serial.find( "(image " ), std::string::npos );
+
+    for( size_t threads : { 2, 4, 0 } )
+    {
+        BOOST_TEST_CONTEXT( threads << " threads" )
+        {
+            BOOST_CHECK( exportDSN( *board, threads ) == serial );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
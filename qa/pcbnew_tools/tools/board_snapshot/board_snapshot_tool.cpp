@@ -0,0 +1,119 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include <wx/cmdline.h>
+
+#include <board_snapshot.h>
+#include <class_board.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+
+/**
+ * Renders an image of a board file offscreen, and reports the render time.
+ */
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "d", "dpi", _( "resolution of PNG images (default 300)" ).mb_str(),
+            wxCMD_LINE_VAL_DOUBLE },
+    { wxCMD_LINE_OPTION, "j", "threads",
+            _( "number of rendering threads (default: all the cores)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input board file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "output image (.png or .svg)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum BOARD_SNAPSHOT_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    WRITE_FAILED,
+};
+
+
+int board_snapshot_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program renders an image of a board without any window, "
+                               "and reports the time spent rendering it." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    double dpi = 300.0;
+    long   threads = 0;
+
+    cl_parser.Found( "dpi", &dpi );
+    cl_parser.Found( "threads", &threads );
+
+    const std::string boardFile = cl_parser.GetParam( 0 ).ToStdString();
+    const wxString    imageFile = cl_parser.GetParam( 1 );
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( boardFile );
+
+    if( !board )
+        return BOARD_SNAPSHOT_RET_CODES::LOAD_FAILED;
+
+    BOARD_SNAPSHOT snapshot( board.get() );
+
+    snapshot.SetDPI( dpi );
+    snapshot.SetThreadCount( std::max( 0L, threads ) );
+
+    if( !snapshot.Write( imageFile ) )
+    {
+        std::cerr << "Could not write " << imageFile << std::endl;
+        return BOARD_SNAPSHOT_RET_CODES::WRITE_FAILED;
+    }
+
+    const VECTOR2I& size = snapshot.GetImageSize();
+
+    std::cout << boardFile << ": " << size.x << "x" << size.y << " at " << dpi << " DPI, "
+              << snapshot.GetRenderTime() << " ms" << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "board_snapshot",
+        "Render an image of a board offscreen and report the render time",
+        board_snapshot_main_func,
+} );
@@ -0,0 +1,249 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <common.h>
+#include <plugins/eagle/eagle_plugin.h>
+#include <profile.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/resource.h>
+#endif
+
+
+/**
+ * Benchmark of the Eagle board importer on a synthetic large board.
+ *
+ * The board is a grid of 2 pad SMD resistors, all from the same package of a library which
+ * also holds many unused packages.  Each resistor is connected to the next one by a signal
+ * made of a contact pair and a track.
+ *
+ * The board file is written to a temporary file, then imported.  The tool reports the import
+ * time and the growth of the peak memory of the process during the import.
+ */
+
+
+static const int UNUSED_PACKAGE_COUNT = 500;
+
+
+///> Returns the peak resident memory of the process in kiB, or -1 if it is not known
+static long peakMemory()
+{
+#if defined( __APPLE__ )
+    struct rusage usage;
+    return getrusage( RUSAGE_SELF, &usage ) == 0 ? usage.ru_maxrss / 1024 : -1;
+#elif defined( __unix__ )
+    struct rusage usage;
+    return getrusage( RUSAGE_SELF, &usage ) == 0 ? usage.ru_maxrss : -1;
+#else
+    return -1;
+#endif
+}
+
+
+/**
+ * Writes the board line by line, not to raise the peak memory of the process before the import.
+ */
+static bool writeBoard( const wxString& aFileName, int aElementCount )
+{
+    wxFFile file( aFileName, "w" );
+
+    if( !file.IsOpened() )
+        return false;
+
+    LOCALE_IO toggle;   // the coordinates use a dot as decimal separator
+    char      buf[512];
+    int       columns = std::max( 1, (int) sqrt( aElementCount ) );
+    bool      ok = true;
+
+    auto write = [&]( const char* aLine )
+    {
+        ok = ok && file.Write( aLine, strlen( aLine ) ) == strlen( aLine );
+    };
+
+    write( "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+           "<!DOCTYPE eagle SYSTEM \"eagle.dtd\">\n"
+           "<eagle version=\"9.6.2\">\n<drawing>\n<layers>\n"
+           "<layer number=\"1\" name=\"Top\" color=\"4\" fill=\"1\"/>\n"
+           "<layer number=\"16\" name=\"Bottom\" color=\"1\" fill=\"1\"/>\n"
+           "<layer number=\"20\" name=\"Dimension\" color=\"15\" fill=\"1\"/>\n"
+           "<layer number=\"21\" name=\"tPlace\" color=\"7\" fill=\"1\"/>\n"
+           "<layer number=\"25\" name=\"tNames\" color=\"7\" fill=\"1\"/>\n"
+           "<layer number=\"27\" name=\"tValues\" color=\"7\" fill=\"1\"/>\n"
+           "</layers>\n<board>\n<plain>\n" );
+
+    double width = columns * 5.0;
+    double height = ( aElementCount / columns + 1 ) * 5.0;
+
+    snprintf( buf, sizeof( buf ),
+              "<wire x1=\"-5\" y1=\"-5\" x2=\"%g\" y2=\"-5\" width=\"0\" layer=\"20\"/>\n"
+              "<wire x1=\"%g\" y1=\"-5\" x2=\"%g\" y2=\"%g\" width=\"0\" layer=\"20\"/>\n"
+              "<wire x1=\"%g\" y1=\"%g\" x2=\"-5\" y2=\"%g\" width=\"0\" layer=\"20\"/>\n"
+              "<wire x1=\"-5\" y1=\"%g\" x2=\"-5\" y2=\"-5\" width=\"0\" layer=\"20\"/>\n",
+              width, width, width, height, width, height, height, height );
+    write( buf );
+
+    write( "</plain>\n<libraries>\n<library name=\"synthetic\">\n<packages>\n" );
+
+    for( int ii = 0; ii <= UNUSED_PACKAGE_COUNT; ++ii )
+    {
+        // The first package is the one of the resistors
+        snprintf( buf, sizeof( buf ),
+                  "<package name=\"R%d\">\n"
+                  "<smd name=\"1\" x=\"-0.8\" y=\"0\" dx=\"0.9\" dy=\"0.9\" layer=\"1\"/>\n"
+                  "<smd name=\"2\" x=\"0.8\" y=\"0\" dx=\"0.9\" dy=\"0.9\" layer=\"1\"/>\n"
+                  "<wire x1=\"-1.5\" y1=\"0.7\" x2=\"1.5\" y2=\"0.7\" width=\"0.1\" layer=\"21\"/>\n"
+                  "<wire x1=\"-1.5\" y1=\"-0.7\" x2=\"1.5\" y2=\"-0.7\" width=\"0.1\" layer=\"21\"/>\n"
+                  "<text x=\"0\" y=\"1\" size=\"0.8\" layer=\"25\">&gt;NAME</text>\n"
+                  "<text x=\"0\" y=\"-1.8\" size=\"0.8\" layer=\"27\">&gt;VALUE</text>\n"
+                  "</package>\n", ii );
+        write( buf );
+    }
+
+    write( "</packages>\n</library>\n</libraries>\n<elements>\n" );
+
+    for( int ii = 0; ii < aElementCount; ++ii )
+    {
+        snprintf( buf, sizeof( buf ),
+                  "<element name=\"R%d\" library=\"synthetic\" package=\"R0\" value=\"10k\" "
+                  "x=\"%g\" y=\"%g\"/>\n",
+                  ii + 1, ( ii % columns ) * 5.0, ( ii / columns ) * 5.0 );
+        write( buf );
+    }
+
+    write( "</elements>\n<signals>\n" );
+
+    for( int ii = 0; ii + 1 < aElementCount; ++ii )
+    {
+        double x1 = ( ii % columns ) * 5.0 + 0.8;
+        double y1 = ( ii / columns ) * 5.0;
+        double x2 = ( ( ii + 1 ) % columns ) * 5.0 - 0.8;
+        double y2 = ( ( ii + 1 ) / columns ) * 5.0;
+
+        snprintf( buf, sizeof( buf ),
+                  "<signal name=\"N%d\">\n"
+                  "<contactref element=\"R%d\" pad=\"2\"/>\n"
+                  "<contactref element=\"R%d\" pad=\"1\"/>\n"
+                  "<wire x1=\"%g\" y1=\"%g\" x2=\"%g\" y2=\"%g\" width=\"0.25\" layer=\"1\"/>\n"
+                  "</signal>\n",
+                  ii + 1, ii + 1, ii + 2, x1, y1, x2, y2 );
+        write( buf );
+    }
+
+    write( "</signals>\n</board>\n</drawing>\n</eagle>\n" );
+
+    return file.Close() && ok;
+}
+
+
+enum EAGLE_IMPORT_RET_CODES
+{
+    IMPORT_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC
+};
+
+
+int eagle_import_main( int argc, char* argv[] )
+{
+    int elementCount = 20000;
+
+    if( argc > 2 )
+    {
+        std::cout << "Usage: " << argv[0] << " [ELEMENT_COUNT]\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    if( argc > 1 )
+        elementCount = std::max( 2, atoi( argv[1] ) );
+
+    wxString tempName = wxFileName::CreateTempFileName( "eagle_import" );
+    wxString fileName = tempName + ".brd";
+
+    if( !writeBoard( fileName, elementCount ) )
+    {
+        std::cout << "Cannot write " << fileName << "\n";
+        wxRemoveFile( tempName );
+        return EAGLE_IMPORT_RET_CODES::IMPORT_FAILED;
+    }
+
+    long fileSize = wxFileName::GetSize( fileName ).ToULong() / 1024;
+    long memoryBefore = peakMemory();
+
+    std::unique_ptr<BOARD> board;
+    PROF_COUNTER           cnt;
+
+    try
+    {
+        EAGLE_PLUGIN plugin;
+        board.reset( plugin.Load( fileName, nullptr, nullptr ) );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cout << "Import failed: " << ioe.What() << "\n";
+    }
+
+    double ms = cnt.msecs();
+    long   memoryAfter = peakMemory();
+
+    wxRemoveFile( fileName );
+    wxRemoveFile( tempName );
+
+    if( !board )
+        return EAGLE_IMPORT_RET_CODES::IMPORT_FAILED;
+
+    std::cout << elementCount << " elements, " << fileSize << " kiB file, " << ms << " ms";
+
+    if( memoryBefore >= 0 )
+        std::cout << ", peak memory +" << memoryAfter - memoryBefore << " kiB";
+
+    std::cout << ", " << board->Modules().size() << " footprints, " << board->Tracks().size()
+              << " tracks\n";
+
+    bool ok = board->Modules().size() == (size_t) elementCount
+              && board->Tracks().size() == (size_t) elementCount - 1;
+
+    return ok ? KI_TEST::RET_CODES::OK : EAGLE_IMPORT_RET_CODES::IMPORT_FAILED;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "eagle_import",
+        "Benchmark the Eagle board importer on a synthetic large board",
+        eagle_import_main,
+} );
@@ -0,0 +1,185 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <convert_to_biu.h>
+#include <profile.h>
+
+#include <cmath>
+#include <iostream>
+
+
+/**
+ * Benchmark of the tiled polygon operations against the monolithic ones.
+ *
+ * For every copper layer of a board (the same boards polygon_generator dumps) this builds the
+ * kind of operands ZONE_FILLER::computeRawFilledArea() works on: a plane covering the board
+ * and the clearance outlines of every pad, track and via on the layer.  The plane minus the
+ * holes is then computed and fractured with the monolithic operations and with a range of tile
+ * counts, and the results are checked to cover the same area.
+ */
+
+
+static double polySetArea( const SHAPE_POLY_SET& aSet )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+    {
+        area += std::abs( aSet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aSet.HoleCount( ii ); jj++ )
+            area -= std::abs( aSet.CHole( ii, jj ).Area() );
+    }
+
+    return area;
+}
+
+
+struct POLY_BOOL_RESULT
+{
+    double m_subtractMs;
+    double m_fractureMs;
+    double m_area;
+    int    m_outlines;
+};
+
+
+static POLY_BOOL_RESULT runCase( const SHAPE_POLY_SET& aPlane, const SHAPE_POLY_SET& aHoles,
+                                 int aTileCount )
+{
+    POLY_BOOL_RESULT result;
+    SHAPE_POLY_SET   fill = aPlane;
+
+    PROF_COUNTER subtract;
+    fill.BooleanSubtractTiled( aHoles, SHAPE_POLY_SET::PM_FAST, aTileCount );
+    result.m_subtractMs = subtract.msecs();
+
+    // Measure the area before fracturing: fractured outlines have no holes to subtract
+    result.m_area = polySetArea( fill );
+
+    PROF_COUNTER fracture;
+    fill.FractureTiled( SHAPE_POLY_SET::PM_FAST, aTileCount );
+    result.m_fractureMs = fracture.msecs();
+
+    result.m_outlines = fill.OutlineCount();
+
+    return result;
+}
+
+
+enum POLY_BOOL_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RESULT_MISMATCH
+};
+
+
+int polygon_boolean_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        std::cout << "Usage: " << argv[0] << " <BOARD> [CLEARANCE_MM]\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::string filename = argv[1];
+    int         clearance = Millimeter2iu( argc > 2 ? std::atof( argv[2] ) : 0.2 );
+
+    auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !brd )
+        return POLY_BOOL_RET_CODES::LOAD_FAILED;
+
+    bool mismatch = false;
+
+    for( PCB_LAYER_ID layer : LSET::AllCuMask( brd->GetCopperLayerCount() ).Seq() )
+    {
+        SHAPE_POLY_SET plane, holes;
+        EDA_RECT       bbox = brd->GetBoardEdgesBoundingBox();
+
+        plane.NewOutline();
+        plane.Append( bbox.GetLeft(), bbox.GetTop() );
+        plane.Append( bbox.GetRight(), bbox.GetTop() );
+        plane.Append( bbox.GetRight(), bbox.GetBottom() );
+        plane.Append( bbox.GetLeft(), bbox.GetBottom() );
+
+        for( TRACK* track : brd->Tracks() )
+        {
+            if( track->IsOnLayer( layer ) )
+                track->TransformShapeWithClearanceToPolygon( holes, layer, clearance );
+        }
+
+        for( MODULE* module : brd->Modules() )
+        {
+            for( D_PAD* pad : module->Pads() )
+            {
+                if( pad->IsOnLayer( layer ) )
+                    pad->TransformShapeWithClearanceToPolygon( holes, layer, clearance );
+            }
+        }
+
+        if( holes.OutlineCount() == 0 )
+            continue;
+
+        std::cout << brd->GetLayerName( layer ).ToStdString() << ": " << holes.OutlineCount() << " holes\n";
+
+        POLY_BOOL_RESULT reference = runCase( plane, holes, 1 );
+
+        for( int tiles : { 1, 2, 4, 8, 16 } )
+        {
+            POLY_BOOL_RESULT r = ( tiles == 1 ) ? reference : runCase( plane, holes, tiles );
+
+            // Seam cuts are rounded to the nearest unit, so the areas differ very slightly
+            bool same = std::abs( r.m_area - reference.m_area ) <= 1e-6 * reference.m_area;
+
+            std::cout << "  tiles " << tiles << "x" << tiles
+                      << ": subtract " << r.m_subtractMs << " ms"
+                      << ", fracture " << r.m_fractureMs << " ms"
+                      << ", outlines " << r.m_outlines
+                      << ", area " << ( same ? "matches" : "MISMATCH" ) << "\n";
+
+            mismatch |= !same;
+        }
+    }
+
+    return mismatch ? POLY_BOOL_RET_CODES::RESULT_MISMATCH : KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "polygon_boolean",
+        "Benchmark tiled polygon booleans against the monolithic ones on a PCB",
+        polygon_boolean_main,
+} );
@@ -24,7 +24,6 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
-#include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 
 #include <pcbnew_utils/board_file_utils.h>
@@ -35,247 +34,141 @@
 #include <class_zone.h>
 #include <profile.h>
 
-#include <atomic>
-#include <thread>
-#include <unordered_set>
-#include <utility>
+#include <cmath>
+#include <iostream>
+#include <vector>
 
 
-void unfracture( SHAPE_POLY_SET::POLYGON* aPoly, SHAPE_POLY_SET::POLYGON* aResult )
-{
-    assert( aPoly->size() == 1 );
-
-    struct EDGE
-    {
-        int m_index = 0;
-        SHAPE_LINE_CHAIN* m_poly = nullptr;
-        bool m_duplicate = false;
-
-        EDGE( SHAPE_LINE_CHAIN *aPolygon, int aIndex ) :
-            m_index(aIndex),
-            m_poly(aPolygon)
-            {}
-
-        bool compareSegs( const SEG& s1, const SEG& s2) const
-        {
-            return (s1.A == s2.A && s1.B == s2.B) || (s1.A == s2.B && s1.B == s2.A);
-        }
-
-        bool operator==( const EDGE& aOther ) const
-        {
-            return compareSegs(
-                    m_poly->Segment( m_index ), aOther.m_poly->Segment( aOther.m_index ) );
-        }
-
-        bool operator!=( const EDGE& aOther ) const
-        {
-            return !compareSegs(
-                    m_poly->Segment( m_index ), aOther.m_poly->Segment( aOther.m_index ) );
-        }
-
-        struct HASH
-        {
-            std::size_t operator()(  const EDGE& aEdge ) const
-            {
-                const auto& a = aEdge.m_poly->Segment( aEdge.m_index );
-                return (std::size_t) ( a.A.x + a.B.x + a.A.y + a.B.y );
-            }
-        };
-
-    };
-
-    struct EDGE_LIST_ENTRY
-    {
-        int index;
-        EDGE_LIST_ENTRY *next;
-    };
-
-    std::unordered_set<EDGE, EDGE::HASH> uniqueEdges;
+/**
+ * Throughput benchmark of SHAPE_POLY_SET::CacheTriangulation().
+ *
+ * The filled areas of every zone of each board given on the command line are triangulated,
+ * with and without the partitioning used by the GAL.  The time and triangle rate are reported
+ * per board, and each triangulation is checked for covering exactly the area of its polygons.
+ */
 
-    auto lc = (*aPoly)[0];
-    lc.Simplify();
 
-    auto edgeList = std::make_unique<EDGE_LIST_ENTRY []>( lc.SegmentCount() );
+static double polySetArea( const SHAPE_POLY_SET& aSet )
+{
+    double area = 0.0;
 
-    for(int i = 0; i < lc.SegmentCount(); i++)
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
     {
-        edgeList[i].index = i;
-        edgeList[i].next = &edgeList[ (i != lc.SegmentCount() - 1) ? i + 1 : 0 ];
-    }
-
-    std::unordered_set<EDGE_LIST_ENTRY*> queue;
+        area += std::abs( aSet.COutline( ii ).Area() );
 
-    for(int i = 0; i < lc.SegmentCount(); i++)
-    {
-        EDGE e ( &lc, i );
-        uniqueEdges.insert( e );
+        for( int jj = 0; jj < aSet.HoleCount( ii ); jj++ )
+            area -= std::abs( aSet.CHole( ii, jj ).Area() );
     }
 
-    for(int i = 0; i < lc.SegmentCount(); i++)
-    {
-        EDGE e ( &lc, i );
-        auto it = uniqueEdges.find(e);
-        if (it != uniqueEdges.end() && it->m_index != i )
-        {
-            int e1 = it->m_index;
-            int e2 = i;
-            if( e1 > e2 )
-                std::swap(e1, e2);
-
-            int e1_prev = e1 - 1;
-            if (e1_prev < 0)
-                e1_prev = lc.SegmentCount() - 1;
-
-            int e2_prev = e2 - 1;
-            if (e2_prev < 0)
-                e2_prev = lc.SegmentCount() - 1;
-
-            int e1_next = e1 + 1;
-            if (e1_next == lc.SegmentCount() )
-                e1_next = 0;
-
-            int e2_next = e2 + 1;
-                if (e2_next == lc.SegmentCount() )
-                    e2_next = 0;
-
-            edgeList[e1_prev].next = &edgeList[ e2_next ];
-            edgeList[e2_prev].next = &edgeList[ e1_next ];
-            edgeList[i].next = nullptr;
-            edgeList[it->m_index].next = nullptr;
-        }
-    }
+    return area;
+}
 
-    for(int i = 0; i < lc.SegmentCount(); i++)
-    {
-        if ( edgeList[i].next )
-            queue.insert ( &edgeList[i] );
-    }
 
-    auto edgeBuf = std::make_unique<EDGE_LIST_ENTRY* []>( lc.SegmentCount() );
+static double triangulationArea( const SHAPE_POLY_SET& aSet, size_t& aTriangleCount )
+{
+    double area = 0.0;
 
-    int n = 0;
-    int outline = -1;
-aResult->clear();
-    while (queue.size())
+    for( unsigned ii = 0; ii < aSet.TriangulatedPolyCount(); ii++ )
     {
-        auto e_first = (*queue.begin());
-        auto e = e_first;
-        int cnt=0;
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* poly = aSet.TriangulatedPolygon( ii );
 
-        do
+        for( size_t jj = 0; jj < poly->GetTriangleCount(); jj++ )
         {
-            edgeBuf[cnt++] = e;
-            e = e->next;
-        } while( e != e_first );
+            VECTOR2I a, b, c;
+            poly->GetTriangle( jj, a, b, c );
 
-        SHAPE_LINE_CHAIN outl;
-
-        for(int i = 0; i < cnt ;i++)
-        {
-            auto p = lc.CPoint(edgeBuf[i]->index);
-            outl.Append( p );
-            queue.erase( edgeBuf[i] );
+            area += std::abs( (double) ( b.x - a.x ) * ( c.y - a.y )
+                              - (double) ( c.x - a.x ) * ( b.y - a.y ) ) / 2.0;
         }
 
-        //        auto p_last = lc.Point( edgeBuf[cnt-1]->index + 1 );
-        //        outl.Append( p_last );
-
-        outl.SetClosed(true);
-
-        bool cw = outl.Area() > 0.0;
-
-        if(cw)
-            outline = n;
-
-        aResult->push_back(outl);
-        n++;
+        aTriangleCount += poly->GetTriangleCount();
     }
 
-    assert(outline >= 0);
-
-    if(outline !=0 )
-        std::swap( (*aResult) [0], (*aResult)[outline] );
+    return area;
 }
 
 
 enum POLY_TRI_RET_CODES
 {
     LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    TRIANGULATION_MISMATCH
 };
 
 
 int polygon_triangulation_main( int argc, char *argv[] )
 {
-    std::string filename;
+    if( argc < 2 )
+    {
+        std::cout << "Usage: " << argv[0] << " <BOARD> [BOARD...]\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
 
-    if( argc > 1 )
-        filename = argv[1];
+    bool mismatch = false;
 
-    auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+    for( int arg = 1; arg < argc; arg++ )
+    {
+        auto brd = KI_TEST::ReadBoardFromFileOrStream( argv[arg] );
 
-    if( !brd )
-        return POLY_TRI_RET_CODES::LOAD_FAILED;
+        if( !brd )
+            return POLY_TRI_RET_CODES::LOAD_FAILED;
 
+        std::vector<SHAPE_POLY_SET> polys;
 
-    PROF_COUNTER cnt( "allBoard" );
+        for( int areaId = 0; areaId < brd->GetAreaCount(); areaId++ )
+        {
+            ZONE_CONTAINER* zone = brd->GetArea( areaId );
 
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            {
+                if( zone->GetFilledPolysList( layer ).OutlineCount() )
+                    polys.push_back( zone->GetFilledPolysList( layer ) );
+            }
+        }
 
-    std::atomic<size_t> zonesToTriangulate( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
+        std::cout << argv[arg] << ": " << polys.size() << " filled areas\n";
 
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-    {
-        std::thread t = std::thread( [&brd, &zonesToTriangulate, &threadsFinished]() {
-            for( size_t areaId = zonesToTriangulate.fetch_add( 1 );
-                        areaId < static_cast<size_t>( brd->GetAreaCount() );
-                        areaId = zonesToTriangulate.fetch_add( 1 ) )
-            {
-                auto zone = brd->GetArea( areaId );
+        for( bool partition : { false, true } )
+        {
+            std::vector<SHAPE_POLY_SET> work = polys;
+            size_t                      triangles = 0;
+            int                         failures = 0;
 
-                // NOTE: this could be refactored to do multiple layers from the same zone in
-                // parallel, but since the test case doesn't have any of these, I'm not bothering
-                // to do that right now.
-                for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
-                {
-                    SHAPE_POLY_SET poly = zone->GetFilledPolysList( layer );
+            PROF_COUNTER cnt;
 
-                    poly.CacheTriangulation();
+            for( SHAPE_POLY_SET& poly : work )
+                poly.CacheTriangulation( partition );
 
-                    (void) poly;
-#if 0
-                PROF_COUNTER unfrac("unfrac");
-                poly.Unfracture( SHAPE_POLY_SET::PM_FAST );
-                unfrac.Show();
+            double ms = cnt.msecs();
 
-                PROF_COUNTER triangulate("triangulate");
+            for( size_t ii = 0; ii < work.size(); ii++ )
+            {
+                double expected = polySetArea( polys[ii] );
+                double actual = triangulationArea( work[ii], triangles );
 
-                for(int i =0; i< poly.OutlineCount(); i++)
+                // Triangle vertices are the polygon's own, so only summation rounding remains
+                if( !work[ii].IsTriangulationUpToDate()
+                        || std::abs( actual - expected ) > 1e-6 * expected )
                 {
-                    poly.triangulatePoly( &poly.Polygon(i) );
-                }
-                triangulate.Show();
-#endif
+                    failures++;
                 }
             }
 
-            threadsFinished++;
-        } );
+            std::cout << "  " << ( partition ? "partitioned" : "whole" )
+                      << ": " << ms << " ms"
+                      << ", " << triangles << " triangles"
+                      << ", " << ( ms > 0.0 ? triangles / ms * 1000.0 : 0.0 ) << " triangles/s"
+                      << ", " << failures << " mismatches\n";
 
-        t.detach();
+            mismatch |= ( failures > 0 );
+        }
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-
-    cnt.Show();
-
-    return KI_TEST::RET_CODES::OK;
+    return mismatch ? POLY_TRI_RET_CODES::TRIANGULATION_MISMATCH : KI_TEST::RET_CODES::OK;
 }
 
 
 static bool registered = UTILITY_REGISTRY::Register( {
         "polygon_triangulation",
-        "Process polygon triangulation on a PCB",
+        "Benchmark polygon triangulation on one or more PCBs",
         polygon_triangulation_main,
 } );
@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <board_commit.h>
+#include <class_board.h>
+#include <class_track.h>
+#include <cleanup_item.h>
+#include <convert_to_biu.h>
+#include <profile.h>
+#include <tracks_cleaner.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+
+/**
+ * Regression benchmark of TRACKS_CLEANER on a synthetic board of fragmented tracks.
+ *
+ * Each track of the board is a horizontal line cut into many collinear segments, with one
+ * duplicated segment and a fragmented vertical stub in its middle.  Nothing is connected to
+ * the ends of the tracks, so they are all dangling.
+ *
+ * The board is cleaned twice: merging the segments only, which must leave 3 segments per
+ * track (the 2 halves of the line and the stub), and then also deleting the dangling tracks,
+ * which must delete everything.
+ */
+
+
+static const int SEGMENT_LENGTH = Millimeter2iu( 0.1 );
+static const int TRACK_PITCH = Millimeter2iu( 1.0 );
+static const int TRACK_WIDTH = Millimeter2iu( 0.2 );
+
+
+static void addSegment( BOARD* aBoard, NETINFO_ITEM* aNet, const wxPoint& aStart,
+                        const wxPoint& aEnd )
+{
+    TRACK* track = new TRACK( aBoard );
+
+    track->SetStart( aStart );
+    track->SetEnd( aEnd );
+    track->SetWidth( TRACK_WIDTH );
+    track->SetLayer( F_Cu );
+    track->SetNet( aNet );
+
+    aBoard->Add( track );
+}
+
+
+static std::unique_ptr<BOARD> makeFragmentedBoard( int aTrackCount, int aSegmentCount )
+{
+    std::unique_ptr<BOARD> board = std::make_unique<BOARD>();
+
+    NETINFO_ITEM* net = new NETINFO_ITEM( board.get(), wxT( "FRAGMENTED" ), 1 );
+    board->Add( net );
+
+    for( int ii = 0; ii < aTrackCount; ii++ )
+    {
+        wxPoint pos( 0, ii * TRACK_PITCH );
+
+        for( int jj = 0; jj < aSegmentCount; jj++ )
+        {
+            wxPoint next = pos + wxPoint( SEGMENT_LENGTH, 0 );
+
+            addSegment( board.get(), net, pos, next );
+
+            // A duplicate of the first segment, drawn in the other direction
+            if( jj == 0 )
+                addSegment( board.get(), net, next, pos );
+
+            // A stub of 4 segments in the middle of the line
+            if( jj == aSegmentCount / 2 )
+            {
+                for( int kk = 0; kk < 4; kk++ )
+                {
+                    addSegment( board.get(), net, pos - wxPoint( 0, kk * SEGMENT_LENGTH ),
+                                pos - wxPoint( 0, ( kk + 1 ) * SEGMENT_LENGTH ) );
+                }
+            }
+
+            pos = next;
+        }
+    }
+
+    return board;
+}
+
+
+enum TRACKS_CLEANER_RET_CODES
+{
+    CLEANUP_MISMATCH = KI_TEST::RET_CODES::TOOL_SPECIFIC
+};
+
+
+int tracks_cleaner_main( int argc, char* argv[] )
+{
+    int trackCount = 1000;
+    int segmentCount = 100;
+
+    if( argc > 3 )
+    {
+        std::cout << "Usage: " << argv[0] << " [TRACK_COUNT [SEGMENTS_PER_TRACK]]\n";
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    if( argc > 1 )
+        trackCount = std::max( 1, atoi( argv[1] ) );
+
+    if( argc > 2 )
+        segmentCount = std::max( 2, atoi( argv[2] ) );
+
+    bool mismatch = false;
+
+    for( bool deleteDangling : { false, true } )
+    {
+        std::unique_ptr<BOARD> board = makeFragmentedBoard( trackCount, segmentCount );
+        size_t                 initialCount = board->Tracks().size();
+
+        BOARD_COMMIT                                commit;
+        TRACKS_CLEANER                              cleaner( board.get(), commit );
+        std::vector<std::shared_ptr<CLEANUP_ITEM>>  items;
+
+        PROF_COUNTER cnt;
+
+        cleaner.CleanupBoard( false, &items, false, false, true, deleteDangling, false, false );
+
+        double ms = cnt.msecs();
+
+        // Deletes the removed segments, which belong to the commit
+        commit.Push( wxT( "Clean tracks" ), false, false );
+
+        size_t expected = deleteDangling ? 0 : 3 * (size_t) trackCount;
+        size_t remaining = board->Tracks().size();
+
+        std::cout << ( deleteDangling ? "merge and delete dangling" : "merge" )
+                  << ": " << initialCount << " segments, " << ms << " ms"
+                  << ", " << items.size() << " cleanup items"
+                  << ", " << remaining << " segments left (expected " << expected << ")\n";
+
+        mismatch |= ( remaining != expected );
+    }
+
+    return mismatch ? TRACKS_CLEANER_RET_CODES::CLEANUP_MISMATCH : KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "tracks_cleaner",
+        "Benchmark the tracks cleaner on a synthetic board of fragmented tracks",
+        tracks_cleaner_main,
+} );
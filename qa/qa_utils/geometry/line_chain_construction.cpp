@@ -23,6 +23,10 @@
 
 #include <qa_utils/geometry/line_chain_construction.h>
 
+#include <math/util.h>
+
+#include <cmath>
+
 namespace KI_TEST
 {
 
@@ -46,4 +50,20 @@ SHAPE_LINE_CHAIN BuildSquareChain( int aSize, const VECTOR2I& aCentre )
     return BuildRectChain( { aSize, aSize }, aCentre );
 }
 
+SHAPE_LINE_CHAIN BuildOctagonChain( const VECTOR2I& aCentre, int aRadius )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < 8; ++ii )
+    {
+        double angle = ii * M_PI / 4;
+        chain.Append( aCentre.x + KiROUND( aRadius * cos( angle ) ),
+                      aCentre.y + KiROUND( aRadius * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+
+    return chain;
+}
+
 } // namespace KI_TEST
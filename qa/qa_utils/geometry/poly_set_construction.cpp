@@ -25,6 +25,8 @@
 
 #include <qa_utils/geometry/line_chain_construction.h>
 
+#include <cmath>
+
 namespace KI_TEST
 {
 
@@ -51,4 +53,38 @@ SHAPE_POLY_SET BuildHollowSquare( int aOuterSize, int aInnerSize, const VECTOR2I
     return polyset;
 }
 
+
+SHAPE_POLY_SET BuildOctagonGrid( const VECTOR2I& aStart, const VECTOR2I& aEnd,
+                                 const VECTOR2I& aPitch, int aMinRadius, int aRadiusRange )
+{
+    SHAPE_POLY_SET polyset;
+
+    for( int x = aStart.x; x < aEnd.x; x += aPitch.x )
+    {
+        for( int y = aStart.y; y < aEnd.y; y += aPitch.y )
+        {
+            int radius = aMinRadius + ( x + y ) % aRadiusRange;
+            polyset.AddOutline( BuildOctagonChain( { x, y }, radius ) );
+        }
+    }
+
+    return polyset;
+}
+
+
+double PolySetArea( const SHAPE_POLY_SET& aSet )
+{
+    double total = 0.0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+    {
+        total += std::abs( aSet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aSet.HoleCount( ii ); jj++ )
+            total -= std::abs( aSet.CHole( ii, jj ).Area() );
+    }
+
+    return total;
+}
+
 } // namespace KI_TEST
\ No newline at end of file
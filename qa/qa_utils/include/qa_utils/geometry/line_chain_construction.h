@@ -51,6 +51,14 @@ SHAPE_LINE_CHAIN BuildRectChain( const VECTOR2I& aSize, const VECTOR2I& aCentre
  */
 SHAPE_LINE_CHAIN BuildSquareChain( int aSize, const VECTOR2I& aCentre = { 0, 0 } );
 
+/**
+ * Builds a regular octagonal #SHAPE_LINE_CHAIN, with a vertex on the +X axis
+ * @param  aCentre centre of the octagon
+ * @param  aRadius distance from the centre to the vertices
+ * @return         a closed line chain of the octagon
+ */
+SHAPE_LINE_CHAIN BuildOctagonChain( const VECTOR2I& aCentre, int aRadius );
+
 } // namespace KI_TEST
 
 #endif // QA_UTILS_GEOMETRY_LINE_CHAIN_CONSTRUCTION__H
\ No newline at end of file
@@ -54,6 +54,26 @@ SHAPE_POLY_SET BuildPolyset( const std::vector<SHAPE_LINE_CHAIN>& aOutlines );
 SHAPE_POLY_SET BuildHollowSquare(
         int aOuterSize, int aInnerSize, const VECTOR2I& aCentre = { 0, 0 } );
 
+/**
+ * Build a #SHAPE_POLY_SET of a grid of octagonal outlines of varying sizes, such
+ * as the clearance holes of a plane.
+ * @param  aStart       the centre of the first octagon
+ * @param  aEnd         the limit (exclusive) of the centres in x and y
+ * @param  aPitch       the distance between the centres in x and y
+ * @param  aMinRadius   the smallest octagon radius
+ * @param  aRadiusRange the radius of an octagon centred at (x, y) is
+ *                      aMinRadius + ( x + y ) % aRadiusRange
+ * @return              a SHAPE_POLY_SET of the octagons (which may overlap)
+ */
+SHAPE_POLY_SET BuildOctagonGrid( const VECTOR2I& aStart, const VECTOR2I& aEnd,
+                                 const VECTOR2I& aPitch, int aMinRadius, int aRadiusRange );
+
+/**
+ * @return the area of a #SHAPE_POLY_SET: the areas of the outlines, less the
+ * areas of their holes.  Overlapping outlines are counted several times.
+ */
+double PolySetArea( const SHAPE_POLY_SET& aSet );
+
 } // namespace KI_TEST
 
 #endif // QA_UTILS_GEOMETRY_POLY_SET_CONSTRUCTION__H
\ No newline at end of file
@@ -269,6 +269,37 @@ void VRML_LAYER::Clear( void )
 }
 
 
+// copy the contours of another layer
+bool VRML_LAYER::CopyContours( const VRML_LAYER& aLayer )
+{
+    if( aLayer.fix )
+    {
+        error = "CopyContours(): the source layer was previously tesselated";
+        return false;
+    }
+
+    Clear();
+
+    maxArcSeg = aLayer.maxArcSeg;
+    minSegLength = aLayer.minSegLength;
+    maxSegLength = aLayer.maxSegLength;
+    offsetX = aLayer.offsetX;
+    offsetY = aLayer.offsetY;
+    idx = aLayer.idx;
+
+    for( unsigned int i = 0; i < aLayer.vertices.size(); ++i )
+        vertices.push_back( new VERTEX_3D( *aLayer.vertices[i] ) );
+
+    for( unsigned int i = 0; i < aLayer.contours.size(); ++i )
+        contours.push_back( new std::list<int>( *aLayer.contours[i] ) );
+
+    pth = aLayer.pth;
+    areas = aLayer.areas;
+
+    return true;
+}
+
+
 // clear ephemeral data in between invocations of the tesselation routine
 void VRML_LAYER::clearTmp( void )
 {
@@ -185,6 +185,18 @@ public:
      */
     void Clear( void );
 
+    /**
+     * Function CopyContours
+     * replaces the contours of this layer by a copy of the contours of another layer.
+     * None of the layers may have been tesselated; the copy can then be used as the holes
+     * of another tesselation, independently of the original.
+     *
+     * @param aLayer is the layer to copy
+     *
+     * @return bool: true if the contours were copied
+     */
+    bool CopyContours( const VRML_LAYER& aLayer );
+
     /**
      * Function GetSize
      * returns the total number of vertices indexed
@@ -490,6 +490,15 @@ bool KICADPCB::ComposePCB( bool aComposeVirtual )
         m_pcb_model->AddOutlineSegment( &lcurve );
     }
 
+    // read the model files in parallel first; the footprints then add them in their order,
+    // so the assembly is the same as if the files were read one at a time
+    std::vector< std::string > modelFiles;
+
+    for( auto i : m_modules )
+        i->GetModelFiles( &m_resolver, modelFiles, aComposeVirtual );
+
+    m_pcb_model->LoadModels( modelFiles );
+
     for( auto i : m_modules )
         i->ComposePCB( m_pcb_model, &m_resolver, origin, aComposeVirtual );
 
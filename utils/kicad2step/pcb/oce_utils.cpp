@@ -22,9 +22,12 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <future>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <wx/wx.h>
 #include <wx/filename.h>
@@ -47,6 +50,7 @@
 #include <Quantity_Color.hxx>
 #include <STEPCAFControl_Reader.hxx>
 #include <STEPCAFControl_Writer.hxx>
+#include <STEPControl_Controller.hxx>
 #include <APIHeaderSection_MakeHeader.hxx>
 #include <Standard_Version.hxx>
 #include <TCollection_ExtendedString.hxx>
@@ -228,6 +232,71 @@ FormatType fileType( const char* aFileName )
 }
 
 
+// find the files which can replace a VRML model for MCAD export, in order of preference
+static std::vector< std::string > alternateModels( const std::string& aFileName )
+{
+    wxFileName wrlName( aFileName );
+
+    wxString basePath = wrlName.GetPath();
+    wxString baseName = wrlName.GetName();
+
+    // List of alternate files to look for
+    // Given in order of preference
+    wxArrayString alts;
+
+    // Step files
+    alts.Add( "stp" );
+    alts.Add( "step" );
+    alts.Add( "STP" );
+    alts.Add( "STEP" );
+    alts.Add( "Stp" );
+    alts.Add( "Step" );
+    alts.Add( "stpz" );
+    alts.Add( "stpZ" );
+    alts.Add( "STPZ" );
+    alts.Add( "step.gz" );
+
+    // IGES files
+    alts.Add( "iges" );
+    alts.Add( "IGES" );
+    alts.Add( "igs" );
+    alts.Add( "IGS" );
+
+    //TODO - Other alternative formats?
+
+    std::vector< std::string > altFileNames;
+
+    for( const auto& alt : alts )
+    {
+        wxFileName altFile( basePath, baseName + "." + alt );
+
+        if( altFile.IsOk() && altFile.FileExists() )
+            altFileNames.push_back( altFile.GetFullPath().ToStdString() );
+    }
+
+    return altFileNames;
+}
+
+
+// set the translation parameters of the IGES and STEP readers; they are global
+// to all the readers, so they are set once, before reading any model
+static bool setReaderParameters()
+{
+    IGESControl_Controller::Init();
+    STEPControl_Controller::Init();
+
+    // Enable user-defined shape precision
+    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
+        return false;
+
+    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
+    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
+        return false;
+
+    return true;
+}
+
+
 PCBMODEL::PCBMODEL()
 {
     m_app = XCAFApp_Application::GetApplication();
@@ -243,6 +312,10 @@ PCBMODEL::PCBMODEL()
     m_minx = 1.0e10;    // absurdly large number; any valid PCB X value will be smaller
     m_mincurve = m_curves.end();
     BRepBuilderAPI::Precision( 1.0e-6 );
+
+    if( !setReaderParameters() )
+        ReportMessage( "could not set the precision of the model readers\n" );
+
     return;
 }
 
@@ -931,6 +1004,138 @@ bool PCBMODEL::WriteSTEP( const wxString& aFileName )
 }
 
 
+void PCBMODEL::LoadModels( const std::vector< std::string >& aFileNames )
+{
+    std::vector< std::string >                  files;
+    std::vector< FormatType >                   formats;
+    std::vector< Handle( TDocStd_Document ) >   docs;
+
+    for( const std::string& fileName : aFileNames )
+    {
+        if( !wxFileName::FileExists( wxString::FromUTF8Unchecked( fileName.c_str() ) ) )
+            continue;   // AddComponent() reports it
+
+        std::string modelName = fileName;
+        FormatType  modelFmt = fileType( modelName.c_str() );
+
+        // a VRML model is exported as its first replacement, as in getModelLabel()
+        if( modelFmt == FMT_WRL || modelFmt == FMT_WRZ )
+        {
+            std::vector< std::string > alts = alternateModels( fileName );
+
+            if( alts.empty() )
+                continue;
+
+            modelName = alts.front();
+            modelFmt = fileType( modelName.c_str() );
+        }
+
+        // compressed STEP files are expanded and read by getModelLabel()
+        if( ( modelFmt != FMT_IGES && modelFmt != FMT_STEP )
+                || m_loadedDocs.find( modelName ) != m_loadedDocs.end() )
+        {
+            continue;
+        }
+
+        m_loadedDocs[ modelName ] = Handle( TDocStd_Document )();
+        files.push_back( modelName );
+        formats.push_back( modelFmt );
+
+        // the documents are created here: the application is not thread safe
+        docs.emplace_back();
+        m_app->NewDocument( "MDTV-XCAF", docs.back() );
+    }
+
+    if( files.empty() )
+        return;
+
+    ReportMessage( wxString::Format( "Read %d model files\n", (int) files.size() ) );
+
+    // The STEP reader is reentrant since OCCT 7.5 only.  The older STEP readers (and OCE) and
+    // all the IGES readers share a global lexer state, so those files are read one at a time.
+#if ( defined OCC_VERSION_HEX ) && ( OCC_VERSION_HEX >= 0x070500 )
+    const bool concurrentSTEP = true;
+#else
+    const bool concurrentSTEP = false;
+#endif
+
+    std::vector< char >   success( files.size(), 0 );
+    std::vector< char >   concurrent( files.size(), 0 );
+    size_t                concurrentCount = 0;
+    std::atomic< size_t > nextFile( 0 );
+
+    for( size_t i = 0; i < files.size(); ++i )
+    {
+        concurrent[i] = concurrentSTEP && formats[i] == FMT_STEP;
+        concurrentCount += concurrent[i];
+    }
+
+    auto readModel = [&]( size_t i )
+    {
+        try
+        {
+            if( formats[i] == FMT_IGES )
+                success[i] = readIGES( docs[i], files[i].c_str() );
+            else
+                success[i] = readSTEP( docs[i], files[i].c_str() );
+        }
+        catch( const Standard_Failure& )
+        {
+            success[i] = false;
+        }
+    };
+
+    auto readModels = [&]()
+    {
+        for( size_t i = nextFile++; i < files.size(); i = nextFile++ )
+        {
+            if( concurrent[i] )
+                readModel( i );
+        }
+    };
+
+    if( concurrentCount > 0 )
+    {
+        size_t parallelThreadCount = std::max<size_t>( 1,
+                std::min<size_t>( std::thread::hardware_concurrency(), concurrentCount ) );
+        std::vector< std::future< void > > returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, readModels );
+
+        for( auto& ret : returns )
+            ret.wait();
+    }
+
+    for( size_t i = 0; i < files.size(); ++i )
+    {
+        if( !concurrent[i] )
+            readModel( i );
+    }
+
+    // the failed files are read again by getModelLabel(), which reports the errors
+    for( size_t i = 0; i < files.size(); ++i )
+    {
+        if( success[i] )
+            m_loadedDocs[ files[i] ] = docs[i];
+        else
+            docs[i]->Close();
+    }
+}
+
+
+bool PCBMODEL::getLoadedModel( const std::string& aFileName, Handle( TDocStd_Document )& aDoc )
+{
+    DOCUMENT_MAP::const_iterator md = m_loadedDocs.find( aFileName );
+
+    if( md == m_loadedDocs.end() || md->second.IsNull() )
+        return false;
+
+    aDoc = md->second;
+    return true;
+}
+
+
 bool PCBMODEL::getModelLabel( const std::string aFileName, TRIPLET aScale, TDF_Label& aLabel )
 {
     std::string model_key = aFileName + "_" + std::to_string( aScale.x )
@@ -947,15 +1152,21 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TRIPLET aScale, TDF_L
     aLabel.Nullify();
 
     Handle( TDocStd_Document )  doc;
-    m_app->NewDocument( "MDTV-XCAF", doc );
+
+    // the file may already be read by LoadModels()
+    bool loaded = getLoadedModel( aFileName, doc );
+
+    if( !loaded )
+        m_app->NewDocument( "MDTV-XCAF", doc );
 
     FormatType modelFmt = fileType( aFileName.c_str() );
 
     switch( modelFmt )
     {
         case FMT_IGES:
-            if( !readIGES( doc, aFileName.c_str() ) )
+            if( !loaded && !readIGES( doc, aFileName.c_str() ) )
             {
+                doc->Close();
                 ReportMessage( wxString::Format( "readIGES() failed on filename %s\n",
                                aFileName ) );
                 return false;
@@ -963,8 +1174,9 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TRIPLET aScale, TDF_L
             break;
 
         case FMT_STEP:
-            if( !readSTEP( doc, aFileName.c_str() ) )
+            if( !loaded && !readSTEP( doc, aFileName.c_str() ) )
             {
+                doc->Close();
                 ReportMessage( wxString::Format( "readSTEP() failed on filename %s\n",
                                aFileName ) );
                 return false;
@@ -1037,50 +1249,11 @@ bool PCBMODEL::getModelLabel( const std::string aFileName, TRIPLET aScale, TDF_L
              * for THAT file will be associated with the .wrl file
              *
              */
+            for( const std::string& altFileName : alternateModels( aFileName ) )
             {
-                wxFileName wrlName( aFileName );
-
-                wxString basePath = wrlName.GetPath();
-                wxString baseName = wrlName.GetName();
-
-                // List of alternate files to look for
-                // Given in order of preference
-                // (Break if match is found)
-                wxArrayString alts;
-
-                // Step files
-                alts.Add( "stp" );
-                alts.Add( "step" );
-                alts.Add( "STP" );
-                alts.Add( "STEP" );
-                alts.Add( "Stp" );
-                alts.Add( "Step" );
-                alts.Add( "stpz" );
-                alts.Add( "stpZ" );
-                alts.Add( "STPZ" );
-                alts.Add( "step.gz" );
-
-                // IGES files
-                alts.Add( "iges" );
-                alts.Add( "IGES" );
-                alts.Add( "igs" );
-                alts.Add( "IGS" );
-
-                //TODO - Other alternative formats?
-
-                for( const auto& alt : alts )
+                if( getModelLabel( altFileName, aScale, aLabel ) )
                 {
-                    wxFileName altFile( basePath, baseName + "." + alt );
-
-                    if( altFile.IsOk() && altFile.FileExists() )
-                    {
-                        std::string altFileName = altFile.GetFullPath().ToStdString();
-
-                        if( getModelLabel( altFileName, aScale, aLabel ) )
-                        {
-                            return true;
-                        }
-                    }
+                    return true;
                 }
             }
 
@@ -1171,38 +1344,24 @@ bool PCBMODEL::getModelLocation( bool aBottom, DOUBLET aPosition, double aRotati
 
 bool PCBMODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
 {
-    IGESControl_Controller::Init();
+    // note: the precision is set by setReaderParameters()
     IGESCAFControl_Reader reader;
     IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
 
     if( stat != IFSelect_RetDone )
         return false;
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
-        return false;
-
     // set other translation options
     reader.SetColorMode(true);  // use model colors
     reader.SetNameMode(false);  // don't use IGES label names
     reader.SetLayerMode(false); // ignore LAYER data
 
     if ( !reader.Transfer( doc ) )
-    {
-        doc->Close();
         return false;
-    }
 
     // are there any shapes to translate?
     if( reader.NbShapes() < 1 )
-    {
-        doc->Close();
         return false;
-    }
 
     return true;
 }
@@ -1210,37 +1369,24 @@ bool PCBMODEL::readIGES( Handle( TDocStd_Document )& doc, const char* fname )
 
 bool PCBMODEL::readSTEP( Handle(TDocStd_Document)& doc, const char* fname )
 {
+    // note: the precision is set by setReaderParameters()
     STEPCAFControl_Reader reader;
     IFSelect_ReturnStatus stat  = reader.ReadFile( fname );
 
     if( stat != IFSelect_RetDone )
         return false;
 
-    // Enable user-defined shape precision
-    if( !Interface_Static::SetIVal( "read.precision.mode", 1 ) )
-        return false;
-
-    // Set the shape conversion precision to USER_PREC (default 0.0001 has too many triangles)
-    if( !Interface_Static::SetRVal( "read.precision.val", USER_PREC ) )
-        return false;
-
     // set other translation options
     reader.SetColorMode(true);  // use model colors
     reader.SetNameMode(false);  // don't use label names
     reader.SetLayerMode(false); // ignore LAYER data
 
     if ( !reader.Transfer( doc ) )
-    {
-        doc->Close();
         return false;
-    }
 
     // are there any shapes to translate?
     if( reader.NbRootsForTransfer() < 1 )
-    {
-        doc->Close();
         return false;
-    }
 
     return true;
 }
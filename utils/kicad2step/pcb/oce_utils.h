@@ -43,6 +43,7 @@
 
 typedef std::pair< std::string, TDF_Label > MODEL_DATUM;
 typedef std::map< std::string, TDF_Label > MODEL_MAP;
+typedef std::map< std::string, Handle( TDocStd_Document ) > DOCUMENT_MAP;
 
 class KICADPAD;
 
@@ -88,6 +89,7 @@ class PCBMODEL
     bool                            m_hasPCB;       // set true if CreatePCB() has been invoked
     TDF_Label                       m_pcb_label;    // label for the PCB model
     MODEL_MAP                       m_models;       // map of file names to model labels
+    DOCUMENT_MAP                    m_loadedDocs;   // map of file names to documents read by LoadModels()
     int                             m_components;   // number of successfully loaded components;
     double                          m_precision;    // model (length unit) numeric precision
     double                          m_angleprec;    // angle numeric precision
@@ -104,8 +106,13 @@ class PCBMODEL
     bool getModelLocation( bool aBottom, DOUBLET aPosition, double aRotation,
         TRIPLET aOffset, TRIPLET aOrientation, TopLoc_Location& aLocation );
 
-    bool readIGES( Handle( TDocStd_Document )& m_doc, const char* fname );
-    bool readSTEP( Handle( TDocStd_Document )& m_doc, const char* fname );
+    // retrieve the document of a file read by LoadModels(); false if the file was not read
+    bool getLoadedModel( const std::string& aFileName, Handle( TDocStd_Document )& aDoc );
+
+    // read a model file into a document; they do not use the PCB document nor the
+    // application, so several files can be read at once into separate documents
+    static bool readIGES( Handle( TDocStd_Document )& m_doc, const char* fname );
+    static bool readSTEP( Handle( TDocStd_Document )& m_doc, const char* fname );
 
     TDF_Label transferModel( Handle( TDocStd_Document )& source,
         Handle( TDocStd_Document )& dest, TRIPLET aScale );
@@ -125,6 +132,11 @@ public:
         bool aBottom, DOUBLET aPosition, double aRotation,
         TRIPLET aOffset, TRIPLET aOrientation, TRIPLET aScale );
 
+    // read the IGES and STEP files of the given models, each into its own document (the
+    // STEP files in parallel with OCCT 7.5 and later); AddComponent() then transfers the
+    // documents instead of reading the files
+    void LoadModels( const std::vector< std::string >& aFileNames );
+
     // set the thickness of the PCB (mm); the top of the PCB shall be at Z = aThickness
     // aThickness < 0.0 == use default thickness
     // aThickness <= THICKNESS_MIN == use THICKNESS_MIN